@@ -63,6 +63,17 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
 
   dnl Check for internationalization functions in libewf/libewf_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers and functions used in libewf/libewf_file_mapping.c
+  AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+  AC_CHECK_FUNCS([mmap munmap])
+
+  dnl Headers and functions used in libewf/libewf_compression_controller.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([sys/time.h])
+    AC_CHECK_FUNCS([clock_gettime])
+  ])
 ])
 
 dnl Function to detect if ewftools dependencies are available
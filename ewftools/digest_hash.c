@@ -25,6 +25,173 @@
 #include "digest_hash.h"
 #include "ewftools_libcerror.h"
 
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) && defined( _MSC_VER )
+#include <intrin.h>
+
+#elif defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+#include <cpuid.h>
+
+#elif defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS ) && defined( __linux__ )
+#include <sys/auxv.h>
+
+#endif
+
+#if defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS ) && defined( __linux__ )
+
+#if !defined( HWCAP_SHA1 )
+#define HWCAP_SHA1	( 1 << 5 )
+#endif
+
+#if !defined( HWCAP_SHA2 )
+#define HWCAP_SHA2	( 1 << 6 )
+#endif
+
+#endif /* defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS ) && defined( __linux__ ) */
+
+/* Retrieves the digest hash types the CPU provides instructions for
+ * and if the CPU provides the AVX2 instructions
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_get_hardware_flags(
+     uint8_t *hardware_flags,
+     libcerror_error_t **error )
+{
+	static char *function      = "digest_hash_get_hardware_flags";
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) && defined( _MSC_VER )
+	int cpu_information[ 4 ];
+	int feature_flags          = 0;
+
+#elif defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+	unsigned int eax           = 0;
+	unsigned int ebx           = 0;
+	unsigned int ecx           = 0;
+	unsigned int edx           = 0;
+	unsigned int feature_flags = 0;
+
+#elif defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS ) && defined( __linux__ )
+	unsigned long hwcap        = 0;
+#endif
+
+	if( hardware_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hardware flags.",
+		 function );
+
+		return( -1 );
+	}
+	*hardware_flags = 0;
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) && defined( _MSC_VER )
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	if( cpu_information[ 0 ] >= 7 )
+	{
+		__cpuid(
+		 cpu_information,
+		 1 );
+
+		feature_flags = cpu_information[ 2 ];
+
+		__cpuidex(
+		 cpu_information,
+		 7,
+		 0 );
+
+		/* The SHA instructions require SSSE3 and SSE4.1
+		 */
+		if( ( ( feature_flags & 0x00000200UL ) != 0 )
+		 && ( ( feature_flags & 0x00080000UL ) != 0 )
+		 && ( ( cpu_information[ 1 ] & 0x20000000UL ) != 0 ) )
+		{
+			*hardware_flags = DIGEST_HASH_HARDWARE_FLAG_SHA1 | DIGEST_HASH_HARDWARE_FLAG_SHA256;
+		}
+		/* The AVX2 instructions require the operating system to save
+		 * the AVX registers, which is indicated by OSXSAVE and XCR0
+		 */
+		if( ( ( feature_flags & 0x18000000UL ) == 0x18000000UL )
+		 && ( ( cpu_information[ 1 ] & 0x00000020UL ) != 0 ) )
+		{
+			if( ( _xgetbv( 0 ) & 0x06 ) == 0x06 )
+			{
+				*hardware_flags |= DIGEST_HASH_HARDWARE_FLAG_AVX2;
+			}
+		}
+	}
+#elif defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) >= 7 )
+	{
+		__cpuid(
+		 1,
+		 eax,
+		 ebx,
+		 ecx,
+		 edx );
+
+		feature_flags = ecx;
+
+		__cpuid_count(
+		 7,
+		 0,
+		 eax,
+		 ebx,
+		 ecx,
+		 edx );
+
+		/* The SHA instructions require SSSE3 and SSE4.1
+		 */
+		if( ( ( feature_flags & 0x00000200UL ) != 0 )
+		 && ( ( feature_flags & 0x00080000UL ) != 0 )
+		 && ( ( ebx & 0x20000000UL ) != 0 ) )
+		{
+			*hardware_flags = DIGEST_HASH_HARDWARE_FLAG_SHA1 | DIGEST_HASH_HARDWARE_FLAG_SHA256;
+		}
+		/* The AVX2 instructions require the operating system to save
+		 * the AVX registers, which is indicated by OSXSAVE and XCR0
+		 */
+		if( ( ( feature_flags & 0x18000000UL ) == 0x18000000UL )
+		 && ( ( ebx & 0x00000020UL ) != 0 ) )
+		{
+			__asm__ __volatile__ (
+			 "xgetbv"
+			 : "=a" ( eax ), "=d" ( edx )
+			 : "c" ( 0 ) );
+
+			if( ( eax & 0x06 ) == 0x06 )
+			{
+				*hardware_flags |= DIGEST_HASH_HARDWARE_FLAG_AVX2;
+			}
+		}
+	}
+#elif defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS ) && defined( __linux__ )
+	hwcap = getauxval(
+	         AT_HWCAP );
+
+	if( ( hwcap & HWCAP_SHA1 ) != 0 )
+	{
+		*hardware_flags |= DIGEST_HASH_HARDWARE_FLAG_SHA1;
+	}
+	if( ( hwcap & HWCAP_SHA2 ) != 0 )
+	{
+		*hardware_flags |= DIGEST_HASH_HARDWARE_FLAG_SHA256;
+	}
+#elif defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	/* The binary was built for a CPU with the cryptographic extension
+	 */
+	*hardware_flags = DIGEST_HASH_HARDWARE_FLAG_SHA1 | DIGEST_HASH_HARDWARE_FLAG_SHA256;
+#endif
+
+	return( 1 );
+}
+
 /* Converts the digest hash to a printable string
  * Returns 1 if successful or -1 on error
  */
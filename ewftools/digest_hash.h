@@ -31,6 +31,34 @@
 extern "C" {
 #endif
 
+/* The SHA instructions are used by means of compiler intrinsics
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS
+
+#elif ( defined( _M_X64 ) || defined( _M_IX86 ) ) && defined( _MSC_VER ) && ( _MSC_VER >= 1900 )
+#define HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS
+
+#elif defined( __aarch64__ ) && ( defined( __ARM_FEATURE_CRYPTO ) || defined( __ARM_FEATURE_SHA2 ) )
+#define HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS
+
+#endif
+
+enum DIGEST_HASH_HARDWARE_FLAGS
+{
+	DIGEST_HASH_HARDWARE_FLAG_SHA1		= 0x01,
+	DIGEST_HASH_HARDWARE_FLAG_SHA256	= 0x02,
+
+	/* The AVX2 instructions are used to calculate the SHA-1 and SHA-256
+	 * message schedule when the SHA instructions are not available
+	 */
+	DIGEST_HASH_HARDWARE_FLAG_AVX2		= 0x04
+};
+
+int digest_hash_get_hardware_flags(
+     uint8_t *hardware_flags,
+     libcerror_error_t **error );
+
 int digest_hash_copy_to_string(
      const uint8_t *digest_hash,
      size_t digest_hash_size,
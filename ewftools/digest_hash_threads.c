@@ -0,0 +1,973 @@
+/*
+ * Digest hash threads
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash_threads.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "tree_hash.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates digest hash threads
+ * A thread is started for every digest hash context that is not NULL
+ * Make sure the value digest_hash_threads is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_initialize(
+     digest_hash_threads_t **digest_hash_threads,
+     libhmac_md5_context_t *md5_context,
+     sha1_context_t *sha1_context,
+     sha256_context_t *sha256_context,
+     tree_hash_t *sha256_tree_hash,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_threads_initialize";
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_threads != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest hash threads value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_queued_items <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of queued items value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_hash_threads = memory_allocate_structure(
+	                        digest_hash_threads_t );
+
+	if( *digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest hash threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_hash_threads,
+	     0,
+	     sizeof( digest_hash_threads_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest hash threads.",
+		 function );
+
+		memory_free(
+		 *digest_hash_threads );
+
+		*digest_hash_threads = NULL;
+
+		return( -1 );
+	}
+	( *digest_hash_threads )->md5_context                = md5_context;
+	( *digest_hash_threads )->sha1_context               = sha1_context;
+	( *digest_hash_threads )->sha256_context             = sha256_context;
+	( *digest_hash_threads )->sha256_tree_hash           = sha256_tree_hash;
+	( *digest_hash_threads )->storage_media_buffer_queue = storage_media_buffer_queue;
+
+	/* Every digest hash has a single thread so that the data is hashed in the order it is pushed
+	 */
+	if( md5_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_hash_threads )->md5_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &digest_hash_threads_md5_callback,
+		     (void *) *digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha1_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_hash_threads )->sha1_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &digest_hash_threads_sha1_callback,
+		     (void *) *digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha256_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_hash_threads )->sha256_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &digest_hash_threads_sha256_callback,
+		     (void *) *digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha256_tree_hash != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_hash_threads )->sha256_tree_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &digest_hash_threads_sha256_tree_callback,
+		     (void *) *digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 tree thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *digest_hash_threads != NULL )
+	{
+		digest_hash_threads_free(
+		 digest_hash_threads,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees digest hash threads
+ * Threads that are still running are joined
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_free(
+     digest_hash_threads_t **digest_hash_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_threads_free";
+	int result            = 1;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_threads != NULL )
+	{
+		if( ( ( *digest_hash_threads )->md5_thread_pool != NULL )
+		 || ( ( *digest_hash_threads )->sha1_thread_pool != NULL )
+		 || ( ( *digest_hash_threads )->sha256_thread_pool != NULL )
+		 || ( ( *digest_hash_threads )->sha256_tree_thread_pool != NULL ) )
+		{
+			if( digest_hash_threads_join(
+			     *digest_hash_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join digest hash threads.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The digest hash contexts and storage media buffer queue are not managed by the digest hash threads
+		 */
+		memory_free(
+		 *digest_hash_threads );
+
+		*digest_hash_threads = NULL;
+	}
+	return( result );
+}
+
+/* Updates the MD5 digest hash
+ * Callback function for the MD5 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_md5_callback(
+     digest_hash_block_t *digest_hash_block,
+     digest_hash_threads_t *digest_hash_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_hash_threads_md5_callback";
+	int result               = 1;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_block == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash block.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_threads->update_failed == 0 )
+	{
+		if( libhmac_md5_update(
+		     digest_hash_threads->md5_context,
+		     digest_hash_block->data,
+		     digest_hash_block->data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
+			 function );
+
+			digest_hash_threads->update_failed = 1;
+
+			result = -1;
+		}
+	}
+	if( digest_hash_threads_release_block(
+	     digest_hash_threads,
+	     &digest_hash_block,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release digest hash block.",
+		 function );
+
+		digest_hash_threads->update_failed = 1;
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Updates the SHA1 digest hash
+ * Callback function for the SHA1 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_sha1_callback(
+     digest_hash_block_t *digest_hash_block,
+     digest_hash_threads_t *digest_hash_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_hash_threads_sha1_callback";
+	int result               = 1;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_block == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash block.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_threads->update_failed == 0 )
+	{
+		if( sha1_context_update(
+		     digest_hash_threads->sha1_context,
+		     digest_hash_block->data,
+		     digest_hash_block->data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
+
+			digest_hash_threads->update_failed = 1;
+
+			result = -1;
+		}
+	}
+	if( digest_hash_threads_release_block(
+	     digest_hash_threads,
+	     &digest_hash_block,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release digest hash block.",
+		 function );
+
+		digest_hash_threads->update_failed = 1;
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Updates the SHA256 digest hash
+ * Callback function for the SHA256 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_sha256_callback(
+     digest_hash_block_t *digest_hash_block,
+     digest_hash_threads_t *digest_hash_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_hash_threads_sha256_callback";
+	int result               = 1;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_block == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash block.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_threads->update_failed == 0 )
+	{
+		if( sha256_context_update(
+		     digest_hash_threads->sha256_context,
+		     digest_hash_block->data,
+		     digest_hash_block->data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			digest_hash_threads->update_failed = 1;
+
+			result = -1;
+		}
+	}
+	if( digest_hash_threads_release_block(
+	     digest_hash_threads,
+	     &digest_hash_block,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release digest hash block.",
+		 function );
+
+		digest_hash_threads->update_failed = 1;
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Updates the SHA256 tree hash
+ * Callback function for the SHA256 tree thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_sha256_tree_callback(
+     digest_hash_block_t *digest_hash_block,
+     digest_hash_threads_t *digest_hash_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_hash_threads_sha256_tree_callback";
+	int result               = 1;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_block == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash block.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_threads->update_failed == 0 )
+	{
+		if( tree_hash_update(
+		     digest_hash_threads->sha256_tree_hash,
+		     digest_hash_block->data,
+		     digest_hash_block->data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 tree hash.",
+			 function );
+
+			digest_hash_threads->update_failed = 1;
+
+			result = -1;
+		}
+	}
+	if( digest_hash_threads_release_block(
+	     digest_hash_threads,
+	     &digest_hash_block,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release digest hash block.",
+		 function );
+
+		digest_hash_threads->update_failed = 1;
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Releases a digest hash block and its reference to the storage media buffer
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_release_block(
+     digest_hash_threads_t *digest_hash_threads,
+     digest_hash_block_t **digest_hash_block,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_threads_release_block";
+	int result            = 1;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash block.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_block != NULL )
+	{
+		if( ( *digest_hash_block )->storage_media_buffer != NULL )
+		{
+			if( storage_media_buffer_queue_release_buffer(
+			     digest_hash_threads->storage_media_buffer_queue,
+			     ( *digest_hash_block )->storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *digest_hash_block );
+
+		*digest_hash_block = NULL;
+	}
+	return( result );
+}
+
+/* Pushes a storage media buffer onto the digest hash threads
+ * Every digest hash thread holds a reference to the storage media buffer until
+ * the data has been hashed, after which it is released onto the storage media buffer queue
+ * The data must remain unchanged until the storage media buffer is released
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_push_buffer(
+     digest_hash_threads_t *digest_hash_threads,
+     storage_media_buffer_t *storage_media_buffer,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_pool_t *thread_pools[ 4 ];
+
+	digest_hash_block_t *digest_hash_block = NULL;
+	static char *function                  = "digest_hash_threads_push_buffer";
+	int thread_pool_index                  = 0;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_threads->update_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to update digest hash(es).",
+		 function );
+
+		return( -1 );
+	}
+	thread_pools[ 0 ] = digest_hash_threads->md5_thread_pool;
+	thread_pools[ 1 ] = digest_hash_threads->sha1_thread_pool;
+	thread_pools[ 2 ] = digest_hash_threads->sha256_thread_pool;
+	thread_pools[ 3 ] = digest_hash_threads->sha256_tree_thread_pool;
+
+	for( thread_pool_index = 0;
+	     thread_pool_index < 4;
+	     thread_pool_index++ )
+	{
+		if( thread_pools[ thread_pool_index ] == NULL )
+		{
+			continue;
+		}
+		digest_hash_block = memory_allocate_structure(
+		                     digest_hash_block_t );
+
+		if( digest_hash_block == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create digest hash block.",
+			 function );
+
+			goto on_error;
+		}
+		digest_hash_block->storage_media_buffer = NULL;
+		digest_hash_block->data                 = data;
+		digest_hash_block->data_size            = data_size;
+
+		if( storage_media_buffer_add_reference(
+		     storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add reference to storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		digest_hash_block->storage_media_buffer = storage_media_buffer;
+
+		if( libcthreads_thread_pool_push(
+		     thread_pools[ thread_pool_index ],
+		     (intptr_t *) digest_hash_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push digest hash block onto thread pool: %d queue.",
+			 function,
+			 thread_pool_index );
+
+			goto on_error;
+		}
+		digest_hash_block = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( digest_hash_block != NULL )
+	{
+		digest_hash_threads_release_block(
+		 digest_hash_threads,
+		 &digest_hash_block,
+		 NULL );
+	}
+	/* Blocks that were pushed are hashed but the digest hashes are no longer valid
+	 */
+	digest_hash_threads->update_failed = 1;
+
+	return( -1 );
+}
+
+/* Joins the digest hash threads
+ * Waits until all the pushed data has been hashed
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_join(
+     digest_hash_threads_t *digest_hash_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_threads_join";
+	int result            = 1;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_threads->md5_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( digest_hash_threads->md5_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join MD5 thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( digest_hash_threads->sha1_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( digest_hash_threads->sha1_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join SHA1 thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( digest_hash_threads->sha256_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( digest_hash_threads->sha256_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join SHA256 thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( digest_hash_threads->sha256_tree_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( digest_hash_threads->sha256_tree_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join SHA256 tree thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( digest_hash_threads->update_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to update digest hash(es).",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,162 @@
+/*
+ * Digest hash threads
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_HASH_THREADS_H )
+#define _DIGEST_HASH_THREADS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
+#include "storage_media_buffer.h"
+#include "tree_hash.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct digest_hash_block digest_hash_block_t;
+
+/* A block of data to be hashed
+ */
+struct digest_hash_block
+{
+	/* The storage media buffer that contains the data
+	 */
+	storage_media_buffer_t *storage_media_buffer;
+
+	/* The data
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+typedef struct digest_hash_threads digest_hash_threads_t;
+
+/* The digest hash threads calculate every digest hash on its own thread
+ * Every thread is passed the same storage media buffers in the same order
+ */
+struct digest_hash_threads
+{
+	/* The MD5 context, which is not managed by the digest hash threads
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The SHA1 context, which is not managed by the digest hash threads
+	 */
+	sha1_context_t *sha1_context;
+
+	/* The SHA256 context, which is not managed by the digest hash threads
+	 */
+	sha256_context_t *sha256_context;
+
+	/* The SHA256 tree hash, which is not managed by the digest hash threads
+	 */
+	tree_hash_t *sha256_tree_hash;
+
+	/* The MD5 thread pool
+	 */
+	libcthreads_thread_pool_t *md5_thread_pool;
+
+	/* The SHA1 thread pool
+	 */
+	libcthreads_thread_pool_t *sha1_thread_pool;
+
+	/* The SHA256 thread pool
+	 */
+	libcthreads_thread_pool_t *sha256_thread_pool;
+
+	/* The SHA256 tree hash thread pool
+	 */
+	libcthreads_thread_pool_t *sha256_tree_thread_pool;
+
+	/* The storage media buffer queue onto which the hashed storage media buffers are released
+	 */
+	libcthreads_queue_t *storage_media_buffer_queue;
+
+	/* Value to indicate a digest hash could not be updated
+	 */
+	int update_failed;
+};
+
+int digest_hash_threads_initialize(
+     digest_hash_threads_t **digest_hash_threads,
+     libhmac_md5_context_t *md5_context,
+     sha1_context_t *sha1_context,
+     sha256_context_t *sha256_context,
+     tree_hash_t *sha256_tree_hash,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int digest_hash_threads_free(
+     digest_hash_threads_t **digest_hash_threads,
+     libcerror_error_t **error );
+
+int digest_hash_threads_md5_callback(
+     digest_hash_block_t *digest_hash_block,
+     digest_hash_threads_t *digest_hash_threads );
+
+int digest_hash_threads_sha1_callback(
+     digest_hash_block_t *digest_hash_block,
+     digest_hash_threads_t *digest_hash_threads );
+
+int digest_hash_threads_sha256_callback(
+     digest_hash_block_t *digest_hash_block,
+     digest_hash_threads_t *digest_hash_threads );
+
+int digest_hash_threads_sha256_tree_callback(
+     digest_hash_block_t *digest_hash_block,
+     digest_hash_threads_t *digest_hash_threads );
+
+int digest_hash_threads_release_block(
+     digest_hash_threads_t *digest_hash_threads,
+     digest_hash_block_t **digest_hash_block,
+     libcerror_error_t **error );
+
+int digest_hash_threads_push_buffer(
+     digest_hash_threads_t *digest_hash_threads,
+     storage_media_buffer_t *storage_media_buffer,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int digest_hash_threads_join(
+     digest_hash_threads_t *digest_hash_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_HASH_THREADS_H ) */
+
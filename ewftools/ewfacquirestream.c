@@ -147,10 +147,12 @@ void usage_fprint(
 	                 "\t    compression method options: deflate (default)\n"
 #endif
 	                 "\t    compression level options: none (default), empty-block,\n"
-	                 "\t    fast or best\n" );
+	                 "\t    fast, best, fast-skip, best-skip or adaptive (the -skip levels\n"
+	                 "\t    store incompressible chunks without compression, adaptive\n"
+	                 "\t    lowers the deflate level when compression cannot keep up)\n" );
 	fprintf( stream, "\t-C: specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d: calculate additional digest (hash) types besides md5, options:\n"
-	                 "\t    sha1, sha256\n" );
+	                 "\t    sha1, sha256, sha256-tree\n" );
 	fprintf( stream, "\t-D: specify the description (default is description).\n" );
 	fprintf( stream, "\t-e: specify the examiner name (default is examiner_name).\n" );
 	fprintf( stream, "\t-E: specify the evidence number (default is evidence_number).\n" );
@@ -512,6 +514,10 @@ int ewfacquirestream_read_input(
 	uint8_t storage_media_buffer_mode            = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	uint64_t sequence_number                     = 0;
+#endif
+
 	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
@@ -559,6 +565,17 @@ int ewfacquirestream_read_input(
 	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* With a secondary output the chunk data is packed once by the process threads
+	 * and the packed chunk data is written to both outputs
+	 */
+	if( ( imaging_handle->number_of_threads > 0 )
+	 && ( imaging_handle->secondary_output_handle != NULL ) )
+	{
+		use_data_chunk_functions = 1;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	if( imaging_handle_get_process_buffer_size(
 	     imaging_handle,
 	     use_data_chunk_functions,
@@ -751,6 +768,12 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
+			/* The sequence number is used to write the buffers in order after processing
+			 */
+			storage_media_buffer->sequence_number = sequence_number;
+
+			sequence_number += 1;
+
 			if( libcthreads_thread_pool_push(
 			     imaging_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -835,6 +858,20 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_compression_statistics(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression statistics.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( imaging_handle_print_hashes(
@@ -851,6 +888,20 @@ int ewfacquirestream_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle_print_compression_statistics(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression statistics in log handle.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	return( 1 );
@@ -1746,6 +1797,15 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	/* The SHA256 tree hash is stored in the xhash section, which is only written in the EWFX format
+	 */
+	if( ( ewfacquirestream_imaging_handle->calculate_sha256_tree != 0 )
+	 && ( ewfacquirestream_imaging_handle->ewf_format != LIBEWF_FORMAT_EWFX ) )
+	{
+		fprintf(
+		 stderr,
+		 "SHA256 tree hash can only be stored in the ewfx format, it is calculated but not stored in the image.\n" );
+	}
 	if( ewftools_signal_attach(
 	     ewfacquirestream_signal_handler,
 	     &error ) != 1 )
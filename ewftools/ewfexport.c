@@ -145,7 +145,9 @@ void usage_fprint(
 	                 "\t           compression method options: deflate (default)\n"
 #endif
 	                 "\t           compression level options: none (default), empty-block,\n"
-	                 "\t           fast or best\n" );
+	                 "\t           fast, best, fast-skip, best-skip or adaptive (the -skip levels\n"
+	                 "\t           store incompressible chunks without compression, adaptive\n"
+	                 "\t           lowers the deflate level when compression cannot keep up)\n" );
 	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5,\n"
 	                 "\t           options: sha1, sha256 (not used for raw and files format)\n" );
 	fprintf( stream, "\t-f:        specify the output format to write to, options:\n"
@@ -52,11 +52,14 @@ system_character_t *ewfinput_compression_methods[ 1 ] = {
 	_SYSTEM_STRING( "deflate" ) };
 #endif
 
-system_character_t *ewfinput_compression_levels[ 4 ] = {
+system_character_t *ewfinput_compression_levels[ 7 ] = {
 	_SYSTEM_STRING( "none" ),
 	_SYSTEM_STRING( "empty-block" ),
 	_SYSTEM_STRING( "fast" ),
-	_SYSTEM_STRING( "best" ) };
+	_SYSTEM_STRING( "best" ),
+	_SYSTEM_STRING( "fast-skip" ),
+	_SYSTEM_STRING( "best-skip" ),
+	_SYSTEM_STRING( "adaptive" ) };
 
 system_character_t *ewfinput_format_types[ 15 ] = {
 	_SYSTEM_STRING( "ewf" ),
@@ -577,6 +580,42 @@ int ewfinput_determine_compression_values(
 			result             = 1;
 		}
 	}
+	else if( string_length == 8 )
+	{
+		/* The adaptive deflate compression level starts at best and is lowered
+		 * when the compression cannot keep up with the source
+		 */
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "adaptive" ),
+		     8 ) == 0 )
+		{
+			*compression_level = LIBEWF_COMPRESSION_LEVEL_BEST;
+			*compression_flags = LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION_LEVEL;
+			result             = 1;
+		}
+	}
+	else if( string_length == 9 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "fast-skip" ),
+		     9 ) == 0 )
+		{
+			*compression_level = LIBEWF_COMPRESSION_LEVEL_FAST;
+			*compression_flags = LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA;
+			result             = 1;
+		}
+		else if( system_string_compare(
+			  string,
+			  _SYSTEM_STRING( "best-skip" ),
+			  9 ) == 0 )
+		{
+			*compression_level = LIBEWF_COMPRESSION_LEVEL_BEST;
+			*compression_flags = LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA;
+			result             = 1;
+		}
+	}
 	else if( string_length == 11 )
 	{
 		if( system_string_compare(
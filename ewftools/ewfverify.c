@@ -82,7 +82,8 @@ void usage_fprint(
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
 	                 "\t           windows-1253, windows-1254, windows-1255, windows-1256,\n"
 	                 "\t           windows-1257 or windows-1258\n" );
-	fprintf( stream, "\t-d:        calculate digest (hash) types, options: md5, sha1, sha256.\n"
+	fprintf( stream, "\t-d:        calculate digest (hash) types, options: md5, sha1, sha256,\n"
+	                 "\t           sha256-tree.\n"
 	                 "\t           By default ewfverify will calculate the digest (hash) types\n"
 	                 "\t           that are stored in the EWF segment files or MD5 if none.\n" );
 	fprintf( stream, "\t-f:        specify the input format, options: raw (default),\n"
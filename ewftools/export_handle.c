@@ -59,12 +59,14 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
 
 #define EXPORT_HANDLE_BUFFER_SIZE			8192
 #define EXPORT_HANDLE_INPUT_BUFFER_SIZE			64
 #define EXPORT_HANDLE_STRING_SIZE			1024
 #define EXPORT_HANDLE_NOTIFY_STREAM			stderr
 #define EXPORT_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE	64 * 1024 * 1024
+#define EXPORT_HANDLE_ASYNC_IO_QUEUE_DEPTH		16
 
 /* Creates an export handle
  * Make sure the value export_handle is referencing, is set to NULL
@@ -146,6 +148,24 @@ int export_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The asynchronous IO is only used by the read-ahead of the input handle
+	 */
+	if( libewf_handle_set_async_io_queue_depth(
+	     ( *export_handle )->input_handle,
+	     EXPORT_HANDLE_ASYNC_IO_QUEUE_DEPTH,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set asynchronous IO queue depth.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *export_handle )->input_buffer = system_string_allocate(
 					    EXPORT_HANDLE_INPUT_BUFFER_SIZE );
 
@@ -335,7 +355,7 @@ int export_handle_free(
 		}
 		if( ( *export_handle )->sha1_context != NULL )
 		{
-			if( libhmac_sha1_free(
+			if( sha1_context_free(
 			     &( ( *export_handle )->sha1_context ),
 			     error ) != 1 )
 			{
@@ -356,7 +376,7 @@ int export_handle_free(
 		}
 		if( ( *export_handle )->sha256_context != NULL )
 		{
-			if( libhmac_sha256_free(
+			if( sha256_context_free(
 			     &( ( *export_handle )->sha256_context ),
 			     error ) != 1 )
 			{
@@ -1186,11 +1206,38 @@ ssize_t export_handle_write_storage_media_buffer(
 		}
 		else
 		{
-			write_count = libsmraw_handle_write_buffer(
-				       export_handle->raw_output_handle,
-				       storage_media_buffer->raw_buffer,
-				       write_size,
-				       error );
+			/* The last buffer is always written so that the output file has the full size
+			 */
+			if( ( export_handle->use_sparse_output != 0 )
+			 && ( storage_media_buffer->is_sparse != 0 )
+			 && ( (size64_t) ( storage_media_buffer->storage_media_offset + write_size ) < export_handle->export_size ) )
+			{
+				if( libsmraw_handle_seek_offset(
+				     export_handle->raw_output_handle,
+				     (off64_t) write_size,
+				     SEEK_CUR,
+				     error ) != -1 )
+				{
+					write_count = (ssize_t) write_size;
+				}
+				else
+				{
+					/* Fall back to writing the zero bytes if the output cannot seek
+					 */
+					libcerror_error_free(
+					 error );
+
+					export_handle->use_sparse_output = 0;
+				}
+			}
+			if( write_count == 0 )
+			{
+				write_count = libsmraw_handle_write_buffer(
+					       export_handle->raw_output_handle,
+					       storage_media_buffer->raw_buffer,
+					       write_size,
+					       error );
+			}
 		}
 	}
 	if( write_count < 0 )
@@ -1246,6 +1293,82 @@ off64_t export_handle_seek_offset(
 	return( offset );
 }
 
+/* Determines if a range of the input does not contain data and can be skipped
+ * The offset is relative to the start of the input media
+ * Returns 1 if the range is sparse, 0 if not or -1 on error
+ */
+int export_handle_input_range_is_sparse(
+     export_handle_t *export_handle,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_input_range_is_sparse";
+	off64_t data_offset   = 0;
+	size64_t data_size    = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The range between the last query offset and the data region is known to be sparse
+	 */
+	if( ( offset < export_handle->input_data_region_query_offset )
+	 || ( (size64_t) offset >= ( (size64_t) export_handle->input_data_region_offset + export_handle->input_data_region_size ) ) )
+	{
+		result = libewf_handle_get_next_data_region(
+		          export_handle->input_handle,
+		          offset,
+		          &data_offset,
+		          &data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next data region.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			data_offset = (off64_t) export_handle->input_media_size;
+			data_size   = 0;
+		}
+		export_handle->input_data_region_query_offset = offset;
+		export_handle->input_data_region_offset       = data_offset;
+		export_handle->input_data_region_size         = data_size;
+	}
+	if( (size64_t) ( offset + size ) <= (size64_t) export_handle->input_data_region_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
 /* Swaps the byte order of byte pairs within a buffer of a certain size
  * Returns 1 if successful, -1 on error
  */
@@ -1356,8 +1479,9 @@ int export_handle_initialize_integrity_hash(
 	}
 	if( export_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_initialize(
+		if( sha1_context_initialize(
 		     &( export_handle->sha1_context ),
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1373,8 +1497,9 @@ int export_handle_initialize_integrity_hash(
 	}
 	if( export_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_initialize(
+		if( sha256_context_initialize(
 		     &( export_handle->sha256_context ),
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1393,7 +1518,7 @@ int export_handle_initialize_integrity_hash(
 on_error:
 	if( export_handle->sha1_context != NULL )
 	{
-		libhmac_sha1_free(
+		sha1_context_free(
 		 &( export_handle->sha1_context ),
 		 NULL );
 	}
@@ -1471,7 +1596,7 @@ int export_handle_update_integrity_hash(
 	}
 	if( export_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_update(
+		if( sha1_context_update(
 		     export_handle->sha1_context,
 		     buffer,
 		     buffer_size,
@@ -1489,7 +1614,7 @@ int export_handle_update_integrity_hash(
 	}
 	if( export_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_update(
+		if( sha256_context_update(
 		     export_handle->sha256_context,
 		     buffer,
 		     buffer_size,
@@ -1590,7 +1715,7 @@ int export_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
+		if( sha1_context_finalize(
 		     export_handle->sha1_context,
 		     calculated_sha1_hash,
 		     LIBHMAC_SHA1_HASH_SIZE,
@@ -1635,7 +1760,7 @@ int export_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
+		if( sha256_context_finalize(
 		     export_handle->sha256_context,
 		     calculated_sha256_hash,
 		     LIBHMAC_SHA256_HASH_SIZE,
@@ -4577,8 +4702,6 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle )
 {
-	libcdata_list_element_t *element                    = NULL;
-	libcdata_list_element_t *next_element               = NULL;
         libcerror_error_t *error                            = NULL;
 	storage_media_buffer_t *output_storage_media_buffer = NULL;
 	uint8_t *data                                       = NULL;
@@ -4613,72 +4736,43 @@ int export_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     export_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_ring_insert_buffer(
+	     export_handle->output_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output ring.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	/* Handle the storage media buffers that are next in sequence
+	 */
+	while( export_handle->abort == 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = storage_media_buffer_ring_remove_next_buffer(
+		          export_handle->output_ring,
+		          &storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( export_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove next storage media buffer from output ring.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != export_handle->last_offset_hashed )
+		else if( result == 0 )
 		{
 			break;
 		}
@@ -4695,8 +4789,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine if storage media buffer is corrupted.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		else if( result != 0 )
@@ -4716,8 +4808,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to append read error.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4734,8 +4824,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		/* Swap byte pairs
@@ -4755,18 +4843,35 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to swap byte pairs.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
 		/* Digest hashes are calcultated after swap
 		 */
-		if( export_handle_update_integrity_hash(
-		     export_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
+		if( export_handle->digest_hash_threads != NULL )
+		{
+			if( digest_hash_threads_push_buffer(
+			     export_handle->digest_hash_threads,
+			     storage_media_buffer,
+			     data,
+			     storage_media_buffer->processed_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto digest hash threads.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( export_handle_update_integrity_hash(
+		          export_handle,
+		          data,
+		          storage_media_buffer->processed_size,
+		          &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
@@ -4775,8 +4880,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to update integrity hash(es).",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
@@ -4797,8 +4900,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to create output storage media buffer.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4818,56 +4919,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to write to export handle.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
 			goto on_error;
 		}
 /* TODO: if storage media buffer can be passed on do not release it */
@@ -4904,8 +4955,6 @@ int export_handle_output_storage_media_buffer_callback(
 				goto on_error;
 			}
 		}
-		element = next_element;
-
 		if( process_status_update(
 		     export_handle->process_status,
 		     export_handle->last_offset_hashed,
@@ -4972,17 +5021,17 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output ring
  * Returns 1 if successful or -1 on error
  */
-int export_handle_empty_output_list(
+int export_handle_empty_output_ring(
      export_handle_t *export_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "export_handle_empty_output_list";
+        static char *function                        = "export_handle_empty_output_ring";
+	int buffer_index                             = 0;
+	int result                                   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4995,46 +5044,42 @@ int export_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( export_handle->output_ring == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output ring.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	for( buffer_index = 0;
+	     buffer_index < export_handle->output_ring->number_of_buffers;
+	     buffer_index++ )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
+		result = storage_media_buffer_ring_remove_buffer_by_index(
+		          export_handle->output_ring,
+		          buffer_index,
+		          &storage_media_buffer,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer: %d from output ring.",
+			 function,
+			 buffer_index );
 
 			return( -1 );
 		}
-		if( storage_media_buffer == NULL )
+		else if( result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
+			continue;
 		}
 		if( storage_media_buffer_queue_release_buffer(
 		     export_handle->storage_media_buffer_queue,
@@ -5051,52 +5096,6 @@ int export_handle_empty_output_list(
 			return( -1 );
 		}
 		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			return( -1 );
-		}
-		element = next_element;
 	}
 	return( 1 );
 }
@@ -5127,9 +5126,15 @@ int export_handle_export_input(
 	off64_t input_storage_media_offset                  = 0;
 	uint8_t storage_media_buffer_mode                   = 0;
 	int maximum_number_of_queued_items                  = 0;
+	int number_of_read_ahead_chunks                     = 0;
+	int number_of_read_ahead_threads                    = 0;
 	int result                                          = 0;
 	int status                                          = PROCESS_STATUS_COMPLETED;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	uint64_t sequence_number                            = 0;
+#endif
+
 	if( export_handle == NULL )
 	{
 		libcerror_error_set(
@@ -5261,9 +5266,59 @@ int export_handle_export_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
+	/* Input regions without data are written as sparse regions
+	 * when the output is a single raw file
+	 */
+	if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	 && ( export_handle->use_stdout == 0 )
+	 && ( export_handle->maximum_segment_size == 0 )
+	 && ( storage_media_buffer_mode == STORAGE_MEDIA_BUFFER_MODE_BUFFERED ) )
+	{
+		export_handle->use_sparse_output = 1;
+	}
+	export_handle->input_data_region_query_offset = 0;
+	export_handle->input_data_region_offset       = 0;
+	export_handle->input_data_region_size         = 0;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( export_handle->number_of_threads != 0 )
 	{
+		/* In buffered mode the input chunks are unpacked by the input handle on the reading thread,
+		 * hence the input handle reads ahead and unpacks the next chunks on the same number of threads
+		 */
+		if( storage_media_buffer_mode == STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+		{
+			if( libewf_handle_get_read_ahead_values(
+			     export_handle->input_handle,
+			     &number_of_read_ahead_chunks,
+			     &number_of_read_ahead_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve read-ahead values.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_handle_set_read_ahead_values(
+			     export_handle->input_handle,
+			     number_of_read_ahead_chunks,
+			     export_handle->number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set read-ahead values.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		maximum_number_of_queued_items = 1 + (int) ( EXPORT_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
 
 		if( libcthreads_thread_pool_create(
@@ -5302,15 +5357,16 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( export_handle->output_list ),
+		if( storage_media_buffer_ring_initialize(
+		     &( export_handle->output_ring ),
+		     maximum_number_of_queued_items,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output ring.",
 			 function );
 
 			goto on_error;
@@ -5350,6 +5406,34 @@ int export_handle_export_input(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( export_handle->number_of_threads != 0 )
+	 && ( ( export_handle->calculate_md5 != 0 )
+	  || ( export_handle->calculate_sha1 != 0 )
+	  || ( export_handle->calculate_sha256 != 0 ) ) )
+	{
+		if( digest_hash_threads_initialize(
+		     &( export_handle->digest_hash_threads ),
+		     export_handle->md5_context,
+		     export_handle->sha1_context,
+		     export_handle->sha256_context,
+		     NULL,
+		     export_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	if( process_status_initialize(
 	     &( export_handle->process_status ),
 	     _SYSTEM_STRING( "Export" ),
@@ -5445,12 +5529,44 @@ int export_handle_export_input(
 		{
 			read_size = (size_t) remaining_export_size;
 		}
-		read_count = storage_media_buffer_read_from_handle(
-		              input_storage_media_buffer,
-		              export_handle->input_handle,
-		              read_size,
-		              error );
+		result = 0;
+
+		if( export_handle->use_sparse_output != 0 )
+		{
+			result = export_handle_input_range_is_sparse(
+			          export_handle,
+			          (off64_t) export_handle->export_offset + input_storage_media_offset,
+			          read_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if input range is sparse.",
+				 function );
 
+				goto on_error;
+			}
+		}
+		if( result != 0 )
+		{
+			read_count = storage_media_buffer_read_sparse_from_handle(
+			              input_storage_media_buffer,
+			              export_handle->input_handle,
+			              read_size,
+			              error );
+		}
+		else
+		{
+			read_count = storage_media_buffer_read_from_handle(
+			              input_storage_media_buffer,
+			              export_handle->input_handle,
+			              read_size,
+			              error );
+		}
 		if( read_count < 0 )
 		{
 			libcerror_error_set(
@@ -5481,6 +5597,12 @@ int export_handle_export_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( export_handle->number_of_threads != 0 )
 		{
+			/* The sequence number is used to write the buffers in order after processing
+			 */
+			input_storage_media_buffer->sequence_number = sequence_number;
+
+			sequence_number += 1;
+
 			if( libcthreads_thread_pool_push(
 			     export_handle->input_process_thread_pool,
 			     (intptr_t *) input_storage_media_buffer,
@@ -5728,9 +5850,9 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_ring != NULL )
 	{
-		if( export_handle_empty_output_list(
+		if( export_handle_empty_output_ring(
 		     export_handle,
 		     error ) != 1 )
 		{
@@ -5738,21 +5860,49 @@ int export_handle_export_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( export_handle->output_list ),
-		     NULL,
+		if( storage_media_buffer_ring_free(
+		     &( export_handle->output_ring ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output ring.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->digest_hash_threads != NULL )
+	{
+		if( digest_hash_threads_join(
+		     export_handle->digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_hash_threads_free(
+		     &( export_handle->digest_hash_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash threads.",
 			 function );
 
 			goto on_error;
@@ -5938,14 +6088,19 @@ on_error:
 		 &( export_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_ring != NULL )
 	{
-		export_handle_empty_output_list(
+		export_handle_empty_output_ring(
 		 export_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( export_handle->output_list ),
-		 NULL,
+		storage_media_buffer_ring_free(
+		 &( export_handle->output_ring ),
+		 NULL );
+	}
+	if( export_handle->digest_hash_threads != NULL )
+	{
+		digest_hash_threads_free(
+		 &( export_handle->digest_hash_threads ),
 		 NULL );
 	}
 	if( export_handle->storage_media_buffer_queue != NULL )
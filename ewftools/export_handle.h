@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_threads.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -34,7 +35,10 @@
 #include "ewftools_libsmraw.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -129,7 +133,7 @@ struct export_handle
 
 	/* The SHA1 digest context
 	 */
-	libhmac_sha1_context_t *sha1_context;
+	sha1_context_t *sha1_context;
 
 	/* Value to indicate the SHA1 digest context was initialized
 	 */
@@ -145,7 +149,7 @@ struct export_handle
 
 	/* The SHA256 digest context
 	 */
-	libhmac_sha256_context_t *sha256_context;
+	sha256_context_t *sha256_context;
 
 	/* Value to indicate the SHA256 digest context was initialized
 	 */
@@ -177,14 +181,18 @@ struct export_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output ring
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_ring_t *output_ring;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash threads
+	 */
+	digest_hash_threads_t *digest_hash_threads;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
@@ -199,6 +207,23 @@ struct export_handle
 	 */
 	uint8_t use_stdout;
 
+	/* Value to indicate if input data regions without data should be written
+	 * as sparse regions (holes) in the raw output file
+	 */
+	uint8_t use_sparse_output;
+
+	/* The offset of the last input data region query
+	 */
+	off64_t input_data_region_query_offset;
+
+	/* The offset of the current input data region
+	 */
+	off64_t input_data_region_offset;
+
+	/* The size of the current input data region
+	 */
+	size64_t input_data_region_size;
+
 	/* The libewf output handle
 	 */
 	libewf_handle_t *ewf_output_handle;
@@ -314,6 +339,12 @@ off64_t export_handle_seek_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int export_handle_input_range_is_sparse(
+     export_handle_t *export_handle,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error );
+
 int export_handle_swap_byte_pairs(
      export_handle_t *export_handle,
      uint8_t *buffer,
@@ -486,7 +517,7 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
 
-int export_handle_empty_output_list(
+int export_handle_empty_output_ring(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
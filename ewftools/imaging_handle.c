@@ -50,6 +50,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
 
 #define IMAGING_HANDLE_INPUT_BUFFER_SIZE		64
 #define IMAGING_HANDLE_STRING_SIZE			1024
@@ -317,7 +318,7 @@ int imaging_handle_free(
 		}
 		if( ( *imaging_handle )->sha1_context != NULL )
 		{
-			if( libhmac_sha1_free(
+			if( sha1_context_free(
 			     &( ( *imaging_handle )->sha1_context ),
 			     error ) != 1 )
 			{
@@ -338,7 +339,7 @@ int imaging_handle_free(
 		}
 		if( ( *imaging_handle )->sha256_context != NULL )
 		{
-			if( libhmac_sha256_free(
+			if( sha256_context_free(
 			     &( ( *imaging_handle )->sha256_context ),
 			     error ) != 1 )
 			{
@@ -357,6 +358,27 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->calculated_sha256_hash_string );
 		}
+		if( ( *imaging_handle )->sha256_tree_hash != NULL )
+		{
+			if( tree_hash_free(
+			     &( ( *imaging_handle )->sha256_tree_hash ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 tree hash.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *imaging_handle )->calculated_sha256_tree_hash_string != NULL )
+		{
+			memory_free(
+			 ( *imaging_handle )->calculated_sha256_tree_hash_string );
+		}
 		if( libewf_handle_free(
 		     &( ( *imaging_handle )->output_handle ),
 		     error ) != 1 )
@@ -428,9 +450,9 @@ int imaging_handle_signal_abort(
 		return( -1 );
 	}
 	if( imaging_handle->secondary_output_handle != NULL )
-	{	
+	{
 		if( libewf_handle_signal_abort(
-		     imaging_handle->output_handle,
+		     imaging_handle->secondary_output_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1293,6 +1315,7 @@ int imaging_handle_initialize_integrity_hash(
      libcerror_error_t **error )
 {
 	static char *function = "imaging_handle_initialize_integrity_hash";
+	uint32_t chunk_size   = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1324,8 +1347,9 @@ int imaging_handle_initialize_integrity_hash(
 	}
 	if( imaging_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_initialize(
+		if( sha1_context_initialize(
 		     &( imaging_handle->sha1_context ),
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1341,8 +1365,9 @@ int imaging_handle_initialize_integrity_hash(
 	}
 	if( imaging_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_initialize(
+		if( sha256_context_initialize(
 		     &( imaging_handle->sha256_context ),
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1356,12 +1381,52 @@ int imaging_handle_initialize_integrity_hash(
 		}
 		imaging_handle->sha256_context_initialized = 1;
 	}
+	if( imaging_handle->calculate_sha256_tree != 0 )
+	{
+		if( libewf_handle_get_chunk_size(
+		     imaging_handle->output_handle,
+		     &chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve output chunk size.",
+			 function );
+
+			goto on_error;
+		}
+		/* The blocks of the tree hash are the chunks of the image
+		 * so that ewfverify can calculate the block hashes in parallel
+		 */
+		if( tree_hash_initialize(
+		     &( imaging_handle->sha256_tree_hash ),
+		     (size_t) chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 tree hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
+	if( imaging_handle->sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &( imaging_handle->sha256_context ),
+		 NULL );
+	}
 	if( imaging_handle->sha1_context != NULL )
 	{
-		libhmac_sha1_free(
+		sha1_context_free(
 		 &( imaging_handle->sha1_context ),
 		 NULL );
 	}
@@ -1439,7 +1504,7 @@ int imaging_handle_update_integrity_hash(
 	}
 	if( imaging_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_update(
+		if( sha1_context_update(
 		     imaging_handle->sha1_context,
 		     buffer,
 		     buffer_size,
@@ -1457,7 +1522,7 @@ int imaging_handle_update_integrity_hash(
 	}
 	if( imaging_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_update(
+		if( sha256_context_update(
 		     imaging_handle->sha256_context,
 		     buffer,
 		     buffer_size,
@@ -1473,6 +1538,24 @@ int imaging_handle_update_integrity_hash(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->calculate_sha256_tree != 0 )
+	{
+		if( tree_hash_update(
+		     imaging_handle->sha256_tree_hash,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 tree hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -1486,6 +1569,7 @@ int imaging_handle_finalize_integrity_hash(
 	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
 	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
 	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+	uint8_t calculated_sha256_tree_hash[ TREE_HASH_SIZE ];
 
 	static char *function = "imaging_handle_finalize_integrity_hash";
 
@@ -1558,7 +1642,7 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
+		if( sha1_context_finalize(
 		     imaging_handle->sha1_context,
 		     calculated_sha1_hash,
 		     LIBHMAC_SHA1_HASH_SIZE,
@@ -1603,7 +1687,7 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
+		if( sha256_context_finalize(
 		     imaging_handle->sha256_context,
 		     calculated_sha256_hash,
 		     LIBHMAC_SHA256_HASH_SIZE,
@@ -1635,6 +1719,51 @@ int imaging_handle_finalize_integrity_hash(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->calculate_sha256_tree != 0 )
+	{
+		if( imaging_handle->calculated_sha256_tree_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid imaging handle - missing calculated SHA256 tree hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( tree_hash_finalize(
+		     imaging_handle->sha256_tree_hash,
+		     calculated_sha256_tree_hash,
+		     TREE_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 tree hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_tree_hash,
+		     TREE_HASH_SIZE,
+		     imaging_handle->calculated_sha256_tree_hash_string,
+		     65,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 tree hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -1665,6 +1794,8 @@ int imaging_handle_threads_start(
 	}
 	maximum_number_of_queued_items = 1 + (int) ( IMAGING_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
 
+	imaging_handle->maximum_number_of_queued_items = maximum_number_of_queued_items;
+
 	if( libcthreads_thread_pool_create(
 	     &( imaging_handle->process_thread_pool ),
 	     NULL,
@@ -1701,15 +1832,40 @@ int imaging_handle_threads_start(
 
 		goto on_error;
 	}
-	if( libcdata_list_initialize(
-	     &( imaging_handle->output_list ),
+	/* The secondary output is written by its own thread so that writing
+	 * to both outputs is done concurrently
+	 */
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( imaging_handle->secondary_output_thread_pool ),
+		     NULL,
+		     1,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &imaging_handle_secondary_output_storage_media_buffer_callback,
+		     (void *) imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize secondary output thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( storage_media_buffer_ring_initialize(
+	     &( imaging_handle->output_ring ),
+	     maximum_number_of_queued_items,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create output list.",
+		 "%s: unable to create output ring.",
 		 function );
 
 		goto on_error;
@@ -1746,14 +1902,19 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->secondary_output_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( imaging_handle->secondary_output_thread_pool ),
+		 NULL );
+	}
+	if( imaging_handle->output_ring != NULL )
 	{
-		imaging_handle_empty_output_list(
+		imaging_handle_empty_output_ring(
 		 imaging_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
+		storage_media_buffer_ring_free(
+		 &( imaging_handle->output_ring ),
 		 NULL );
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
@@ -1818,9 +1979,25 @@ int imaging_handle_threads_stop(
 			result = -1;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->secondary_output_thread_pool != NULL )
 	{
-		if( imaging_handle_empty_output_list(
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->secondary_output_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join secondary output thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( imaging_handle->output_ring != NULL )
+	{
+		if( imaging_handle_empty_output_ring(
 		     imaging_handle,
 		     error ) != 1 )
 		{
@@ -1828,21 +2005,49 @@ int imaging_handle_threads_stop(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output ring.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+		if( storage_media_buffer_ring_free(
+		     &( imaging_handle->output_ring ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output ring.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( imaging_handle->digest_hash_threads != NULL )
+	{
+		if( digest_hash_threads_join(
+		     imaging_handle->digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash threads.",
+			 function );
+
+			result = -1;
+		}
+		if( digest_hash_threads_free(
+		     &( imaging_handle->digest_hash_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash threads.",
 			 function );
 
 			result = -1;
@@ -1976,12 +2181,10 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-        static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
-	ssize_t write_count                   = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_output_storage_media_buffer_callback";
+	ssize_t write_count      = 0;
+	int result               = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -2009,145 +2212,109 @@ int imaging_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     imaging_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_ring_insert_buffer(
+	     imaging_handle->output_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output ring.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	/* Handle the storage media buffers that are next in sequence
+	 */
+	while( imaging_handle->abort == 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = storage_media_buffer_ring_remove_next_buffer(
+		          imaging_handle->output_ring,
+		          &storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( imaging_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove next storage media buffer from output ring.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
+		else if( result == 0 )
 		{
 			break;
 		}
-		write_count = imaging_handle_write_storage_media_buffer(
-			       imaging_handle,
-			       storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
+		if( imaging_handle->secondary_output_thread_pool != NULL )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+			/* The secondary output thread holds its own reference to the storage media buffer
+			 * and writes the same packed chunk data while the primary output is written
+			 */
+			if( storage_media_buffer_add_reference(
+			     storage_media_buffer,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add reference to storage media buffer.",
+				 function );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+				goto on_error;
+			}
+			if( libcthreads_thread_pool_push(
+			     imaging_handle->secondary_output_thread_pool,
+			     (intptr_t *) storage_media_buffer,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto secondary output thread pool queue.",
+				 function );
 
-			storage_media_buffer = NULL;
+				storage_media_buffer_queue_release_buffer(
+				 imaging_handle->storage_media_buffer_queue,
+				 storage_media_buffer,
+				 NULL );
 
-			goto on_error;
+				goto on_error;
+			}
+			write_count = storage_media_buffer_write_to_handle(
+			               storage_media_buffer,
+			               imaging_handle->output_handle,
+			               storage_media_buffer->processed_size,
+			               &error );
 		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
+			write_count = imaging_handle_write_storage_media_buffer(
+				       imaging_handle,
+				       storage_media_buffer,
+				       storage_media_buffer->processed_size,
+				       &error );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
+		if( write_count < 0 )
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer.",
 			 function );
 
 			goto on_error;
 		}
-		element = next_element;
+		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
 		if( storage_media_buffer_queue_release_buffer(
 		     imaging_handle->storage_media_buffer_queue,
@@ -2204,16 +2371,118 @@ on_error:
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( imaging_handle->abort == 0 )
+	{
+		imaging_handle_signal_abort(
+		 imaging_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a storage media buffer to the secondary output
+ * Callback function for the secondary output thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_secondary_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "imaging_handle_secondary_output_storage_media_buffer_callback";
+	ssize_t write_count      = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle->abort == 0 )
+	{
+		write_count = storage_media_buffer_write_to_handle(
+		               storage_media_buffer,
+		               imaging_handle->secondary_output_handle,
+		               storage_media_buffer->processed_size,
+		               &error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer to secondary output handle.",
 			 function );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+			goto on_error;
 		}
 	}
+	if( storage_media_buffer_queue_release_buffer(
+	     imaging_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		storage_media_buffer = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ( imaging_handle != NULL )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 imaging_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
 	if( error != NULL )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -2226,7 +2495,8 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( imaging_handle->abort == 0 )
+	if( ( imaging_handle != NULL )
+	 && ( imaging_handle->abort == 0 ) )
 	{
 		imaging_handle_signal_abort(
 		 imaging_handle,
@@ -2235,17 +2505,17 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output ring
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_empty_output_list(
+int imaging_handle_empty_output_ring(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "imaging_handle_empty_output_list";
+        static char *function                        = "imaging_handle_empty_output_ring";
+	int buffer_index                             = 0;
+	int result                                   = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -2258,46 +2528,42 @@ int imaging_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( imaging_handle->output_ring == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing output ring.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	for( buffer_index = 0;
+	     buffer_index < imaging_handle->output_ring->number_of_buffers;
+	     buffer_index++ )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
+		result = storage_media_buffer_ring_remove_buffer_by_index(
+		          imaging_handle->output_ring,
+		          buffer_index,
+		          &storage_media_buffer,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer: %d from output ring.",
+			 function,
+			 buffer_index );
 
 			return( -1 );
 		}
-		if( storage_media_buffer == NULL )
+		else if( result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
+			continue;
 		}
 		if( storage_media_buffer_queue_release_buffer(
 		     imaging_handle->storage_media_buffer_queue,
@@ -2314,52 +2580,6 @@ int imaging_handle_empty_output_list(
 			return( -1 );
 		}
 		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			return( -1 );
-		}
-		element = next_element;
 	}
 	return( 1 );
 }
@@ -4538,6 +4758,7 @@ int imaging_handle_set_additional_digest_types(
 	size_t string_segment_size                       = 0;
 	uint8_t calculate_sha1                           = 0;
 	uint8_t calculate_sha256                         = 0;
+	uint8_t calculate_sha256_tree                    = 0;
 	int number_of_segments                           = 0;
 	int result                                       = 0;
 	int segment_index                                = 0;
@@ -4746,6 +4967,23 @@ int imaging_handle_set_additional_digest_types(
 				calculate_sha256 = 1;
 			}
 		}
+		else if( string_segment_size == 12 )
+		{
+			if( system_string_compare(
+			     string_segment,
+			     _SYSTEM_STRING( "sha256-tree" ),
+			     11 ) == 0 )
+			{
+				calculate_sha256_tree = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "SHA256-TREE" ),
+			          11 ) == 0 )
+			{
+				calculate_sha256_tree = 1;
+			}
+		}
 	}
 	if( ( calculate_sha1 != 0 )
 	 && ( imaging_handle->calculate_sha1 == 0 ) )
@@ -4785,6 +5023,25 @@ int imaging_handle_set_additional_digest_types(
 		}
 		imaging_handle->calculate_sha256 = 1;
 	}
+	if( ( calculate_sha256_tree != 0 )
+	 && ( imaging_handle->calculate_sha256_tree == 0 ) )
+	{
+		imaging_handle->calculated_sha256_tree_hash_string = system_string_allocate(
+		                                                      65 );
+
+		if( imaging_handle->calculated_sha256_tree_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create calculated SHA256 tree digest hash string.",
+			 function );
+
+			goto on_error;
+		}
+		imaging_handle->calculate_sha256_tree = 1;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libcsplit_wide_split_string_free(
 	     &string_elements,
@@ -6077,6 +6334,37 @@ int imaging_handle_start(
 
 		goto on_error;
         }
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The storage media buffer queue is created when the threads are started
+	 */
+	if( ( imaging_handle->storage_media_buffer_queue != NULL )
+	 && ( ( imaging_handle->calculate_md5 != 0 )
+	  || ( imaging_handle->calculate_sha1 != 0 )
+	  || ( imaging_handle->calculate_sha256 != 0 )
+	  || ( imaging_handle->calculate_sha256_tree != 0 ) ) )
+	{
+		if( digest_hash_threads_initialize(
+		     &( imaging_handle->digest_hash_threads ),
+		     imaging_handle->md5_context,
+		     imaging_handle->sha1_context,
+		     imaging_handle->sha256_context,
+		     imaging_handle->sha256_tree_hash,
+		     imaging_handle->storage_media_buffer_queue,
+		     imaging_handle->maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	if( process_status_initialize(
 	     &( imaging_handle->process_status ),
 	     _SYSTEM_STRING( "Acquiry" ),
@@ -6111,9 +6399,17 @@ int imaging_handle_start(
 	return( 1 );
 
 on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_hash_threads != NULL )
+	{
+		digest_hash_threads_free(
+		 &( imaging_handle->digest_hash_threads ),
+		 NULL );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 	if( imaging_handle->sha1_context != NULL )
 	{
-		libhmac_sha1_free(
+		sha1_context_free(
 		 &( imaging_handle->sha1_context ),
 		 NULL );
 	}
@@ -6210,6 +6506,28 @@ int imaging_handle_update(
 	}
 	/* Integrity (digest) hashes are calcultated after swap
 	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_hash_threads != NULL )
+	{
+		if( digest_hash_threads_push_buffer(
+		     imaging_handle->digest_hash_threads,
+		     storage_media_buffer,
+		     data,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto digest hash threads.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 	if( imaging_handle_update_integrity_hash(
 	     imaging_handle,
 	     data,
@@ -6397,6 +6715,26 @@ int imaging_handle_stop(
 				return( -1 );
 			}
 		}
+		if( imaging_handle->calculate_sha256_tree != 0 )
+		{
+			if( imaging_handle_set_hash_value(
+			     imaging_handle,
+			     "SHA256-TREE",
+			     11,
+			     imaging_handle->calculated_sha256_tree_hash_string,
+			     64,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set hash value: SHA256-TREE.",
+				 function );
+
+				return( -1 );
+			}
+		}
 		write_count = libewf_handle_write_finalize(
 		               imaging_handle->output_handle,
 		               error );
@@ -6872,7 +7210,14 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "Compression level:\t\t\t" );
 
-	if( imaging_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+	if( ( imaging_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
+	 && ( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION_LEVEL ) != 0 ) )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "adaptive" );
+	}
+	else if( imaging_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
 	{
 		fprintf(
 		 imaging_handle->notify_stream,
@@ -6899,6 +7244,13 @@ int imaging_handle_print_parameters(
 			 "none" );
 		}
 	}
+	if( ( imaging_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
+	 && ( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA ) != 0 ) )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "-skip" );
+	}
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "\n" );
@@ -7085,6 +7437,143 @@ int imaging_handle_print_hashes(
 		 "SHA256 hash calculated over data:\t%" PRIs_SYSTEM "\n",
 		 imaging_handle->calculated_sha256_hash_string );
 	}
+	if( imaging_handle->calculate_sha256_tree != 0 )
+	{
+		fprintf(
+		 stream,
+		 "SHA256 tree hash calculated over data:\t%" PRIs_SYSTEM "\n",
+		 imaging_handle->calculated_sha256_tree_hash_string );
+	}
+	return( 1 );
+}
+
+/* Prints the compression statistics
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_print_compression_statistics(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function                    = "imaging_handle_print_compression_statistics";
+	uint64_t number_of_chunks                = 0;
+	uint64_t number_of_incompressible_chunks = 0;
+	int deflate_level                        = 0;
+	int result                               = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+	{
+		return( 1 );
+	}
+	if( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA ) != 0 )
+	{
+		result = libewf_handle_get_number_of_incompressible_chunks(
+		          imaging_handle->output_handle,
+		          &number_of_incompressible_chunks,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of incompressible chunks.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			fprintf(
+			 stream,
+			 "Chunks stored without compression:\t%" PRIu64 " (incompressible data)\n",
+			 number_of_incompressible_chunks );
+		}
+	}
+	if( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION_LEVEL ) != 0 )
+	{
+		result = libewf_handle_get_adaptive_deflate_level(
+		          imaging_handle->output_handle,
+		          &deflate_level,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve adaptive deflate level.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 1 );
+		}
+		fprintf(
+		 stream,
+		 "Final deflate level:\t\t\t%d\n",
+		 deflate_level );
+
+		fprintf(
+		 stream,
+		 "Chunks per deflate level:\n" );
+
+		for( deflate_level = 1;
+		     deflate_level <= 9;
+		     deflate_level++ )
+		{
+			if( libewf_handle_get_number_of_chunks_with_deflate_level(
+			     imaging_handle->output_handle,
+			     deflate_level,
+			     &number_of_chunks,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of chunks with deflate level: %d.",
+				 function,
+				 deflate_level );
+
+				return( -1 );
+			}
+			if( number_of_chunks > 0 )
+			{
+				fprintf(
+				 stream,
+				 "\tlevel %d:\t\t\t\t%" PRIu64 "\n",
+				 deflate_level,
+				 number_of_chunks );
+			}
+		}
+	}
 	return( 1 );
 }
 
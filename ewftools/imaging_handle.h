@@ -26,13 +26,18 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "digest_hash_threads.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "process_status.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
+#include "tree_hash.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -176,7 +181,7 @@ struct imaging_handle
 
 	/* The SHA1 digest context
 	 */
-	libhmac_sha1_context_t *sha1_context;
+	sha1_context_t *sha1_context;
 
 	/* Value to indicate the SHA1 digest context was initialized
 	 */
@@ -192,7 +197,7 @@ struct imaging_handle
 
 	/* The SHA256 digest context
 	 */
-	libhmac_sha256_context_t *sha256_context;
+	sha256_context_t *sha256_context;
 
 	/* Value to indicate the SHA256 digest context was initialized
 	 */
@@ -202,6 +207,18 @@ struct imaging_handle
 	 */
 	system_character_t *calculated_sha256_hash_string;
 
+	/* Value to indicate if the SHA256 tree digest hash should be calculated
+	 */
+	uint8_t calculate_sha256_tree;
+
+	/* The SHA256 tree hash
+	 */
+	tree_hash_t *sha256_tree_hash;
+
+	/* The calculated SHA256 tree digest hash string
+	 */
+	system_character_t *calculated_sha256_tree_hash_string;
+
 	/* Value to indicate if the data chunk functions instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_data_chunk_functions;
@@ -224,14 +241,26 @@ struct imaging_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The secondary output thread pool
+	 */
+	libcthreads_thread_pool_t *secondary_output_thread_pool;
+
+	/* The output ring
+	 */
+	storage_media_buffer_ring_t *output_ring;
+
+	/* The maximum number of queued items
 	 */
-	libcdata_list_t *output_list;
+	int maximum_number_of_queued_items;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash threads
+	 */
+	digest_hash_threads_t *digest_hash_threads;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf output handle
@@ -360,7 +389,11 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
 
-int imaging_handle_empty_output_list(
+int imaging_handle_secondary_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle );
+
+int imaging_handle_empty_output_ring(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
@@ -596,6 +629,11 @@ int imaging_handle_print_hashes(
      FILE *stream,
      libcerror_error_t **error );
 
+int imaging_handle_print_compression_statistics(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
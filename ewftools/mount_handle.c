@@ -33,6 +33,8 @@
 #include "mount_file_system.h"
 #include "mount_handle.h"
 
+#define MOUNT_HANDLE_NUMBER_OF_READ_AHEAD_THREADS	2
+
 /* Creates a mount handle
  * Make sure the value mount_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -332,6 +334,11 @@ int mount_handle_open(
 	static char *function                  = "mount_handle_open";
 	size_t filename_length                 = 0;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int number_of_read_ahead_chunks        = 0;
+	int number_of_read_ahead_threads       = 0;
+#endif
+
 	if( mount_handle == NULL )
 	{
 		libcerror_error_set(
@@ -426,6 +433,42 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read-ahead is only used when the handle detects sequential reads,
+	 * such as those of dd or a hashing tool, hence it does not affect random reads
+	 */
+	if( libewf_handle_get_read_ahead_values(
+	     ewf_handle,
+	     &number_of_read_ahead_chunks,
+	     &number_of_read_ahead_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read-ahead values from handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_read_ahead_values(
+	     ewf_handle,
+	     number_of_read_ahead_chunks,
+	     MOUNT_HANDLE_NUMBER_OF_READ_AHEAD_THREADS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read-ahead values in handle.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     ewf_handle,
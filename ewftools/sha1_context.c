@@ -0,0 +1,979 @@
+/*
+ * SHA-1 context functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libhmac.h"
+#include "sha1_context.h"
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+#include <immintrin.h>
+
+#elif defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+#include <arm_neon.h>
+
+#endif
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) && !defined( _MSC_VER )
+#define SHA1_CONTEXT_TARGET_ATTRIBUTE		__attribute__((target("sha,sse4.1,ssse3")))
+#define SHA1_CONTEXT_AVX2_TARGET_ATTRIBUTE	__attribute__((target("avx2")))
+#else
+#define SHA1_CONTEXT_TARGET_ATTRIBUTE
+#define SHA1_CONTEXT_AVX2_TARGET_ATTRIBUTE
+#endif
+
+/* The SHA-1 initial hash values
+ */
+static const uint32_t sha1_context_initial_hash_values[ 5 ] = {
+	0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL, 0xc3d2e1f0UL };
+
+/* The SHA-1 round constants
+ */
+static const uint32_t sha1_context_round_constants[ 4 ] = {
+	0x5a827999UL, 0x6ed9eba1UL, 0x8f1bbcdcUL, 0xca62c1d6UL };
+
+/* Calculates the SHA-1 of 64 byte blocks of data using the SHA instructions of the CPU
+ * The size must be a multitude of 64
+ */
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+
+SHA1_CONTEXT_TARGET_ATTRIBUTE
+static void sha1_context_transform(
+             uint32_t *hash_values,
+             const uint8_t *data,
+             size_t size )
+{
+	__m128i abcd;
+	__m128i abcd_saved;
+	__m128i byte_order_mask;
+	__m128i e0;
+	__m128i e0_saved;
+	__m128i e1;
+	__m128i message_words[ 4 ];
+
+	int group_index = 0;
+
+	byte_order_mask = _mm_set_epi64x(
+	                   0x0001020304050607ULL,
+	                   0x08090a0b0c0d0e0fULL );
+
+	/* The SHA instructions use the state in the order: DCBA and E
+	 */
+	abcd = _mm_loadu_si128(
+	        (const __m128i *) &( hash_values[ 0 ] ) );
+
+	abcd = _mm_shuffle_epi32( abcd, 0x1b );
+	e0   = _mm_set_epi32( (int) hash_values[ 4 ], 0, 0, 0 );
+	e1   = _mm_setzero_si128();
+
+	while( size >= 64 )
+	{
+		abcd_saved = abcd;
+		e0_saved   = e0;
+
+		for( group_index = 0;
+		     group_index < 20;
+		     group_index++ )
+		{
+			if( group_index < 4 )
+			{
+				message_words[ group_index ] = _mm_shuffle_epi8(
+				                                _mm_loadu_si128(
+				                                 (const __m128i *) &( data[ group_index * 16 ] ) ),
+				                                byte_order_mask );
+			}
+			/* E of the rounds is derived from A of the previous rounds
+			 */
+			if( group_index == 0 )
+			{
+				e0 = _mm_add_epi32(
+				      e0,
+				      message_words[ 0 ] );
+			}
+			else
+			{
+				e0 = _mm_sha1nexte_epu32(
+				      e1,
+				      message_words[ group_index & 3 ] );
+			}
+			e1 = abcd;
+
+			if( ( group_index >= 3 )
+			 && ( group_index <= 18 ) )
+			{
+				message_words[ ( group_index + 1 ) & 3 ] = _mm_sha1msg2_epu32(
+				                                            message_words[ ( group_index + 1 ) & 3 ],
+				                                            message_words[ group_index & 3 ] );
+			}
+			/* The round function must be an immediate value
+			 */
+			switch( group_index / 5 )
+			{
+				case 0:
+					abcd = _mm_sha1rnds4_epu32( abcd, e0, 0 );
+					break;
+
+				case 1:
+					abcd = _mm_sha1rnds4_epu32( abcd, e0, 1 );
+					break;
+
+				case 2:
+					abcd = _mm_sha1rnds4_epu32( abcd, e0, 2 );
+					break;
+
+				default:
+					abcd = _mm_sha1rnds4_epu32( abcd, e0, 3 );
+					break;
+			}
+			if( ( group_index >= 1 )
+			 && ( group_index <= 16 ) )
+			{
+				message_words[ ( group_index - 1 ) & 3 ] = _mm_sha1msg1_epu32(
+				                                            message_words[ ( group_index - 1 ) & 3 ],
+				                                            message_words[ group_index & 3 ] );
+			}
+			if( ( group_index >= 2 )
+			 && ( group_index <= 17 ) )
+			{
+				message_words[ ( group_index - 2 ) & 3 ] = _mm_xor_si128(
+				                                            message_words[ ( group_index - 2 ) & 3 ],
+				                                            message_words[ group_index & 3 ] );
+			}
+		}
+		e0   = _mm_sha1nexte_epu32( e1, e0_saved );
+		abcd = _mm_add_epi32( abcd, abcd_saved );
+
+		data += 64;
+		size -= 64;
+	}
+	abcd = _mm_shuffle_epi32( abcd, 0x1b );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 abcd );
+
+	hash_values[ 4 ] = (uint32_t) _mm_extract_epi32( e0, 3 );
+}
+
+#define sha1_context_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define sha1_context_avx2_rotate_left( value, number_of_bits ) \
+	_mm256_or_si256( \
+	 _mm256_slli_epi32( value, number_of_bits ), \
+	 _mm256_srli_epi32( value, 32 - ( number_of_bits ) ) )
+
+/* Calculates the SHA-1 rounds of a single 64 byte block
+ * The schedule contains the message words with the round constants added,
+ * where consecutive words are stride words apart
+ */
+static void sha1_context_transform_rounds(
+             uint32_t *hash_values,
+             const uint32_t *schedule,
+             size_t stride )
+{
+	uint32_t a         = hash_values[ 0 ];
+	uint32_t b         = hash_values[ 1 ];
+	uint32_t c         = hash_values[ 2 ];
+	uint32_t d         = hash_values[ 3 ];
+	uint32_t e         = hash_values[ 4 ];
+	uint32_t temporary = 0;
+	int round_index    = 0;
+
+	for( round_index = 0;
+	     round_index < 80;
+	     round_index++ )
+	{
+		if( round_index < 20 )
+		{
+			temporary = d ^ ( b & ( c ^ d ) );
+		}
+		else if( ( round_index >= 40 )
+		      && ( round_index < 60 ) )
+		{
+			temporary = ( b & c ) | ( d & ( b | c ) );
+		}
+		else
+		{
+			temporary = b ^ c ^ d;
+		}
+		temporary += sha1_context_rotate_left( a, 5 ) + e + schedule[ round_index * stride ];
+
+		e = d;
+		d = c;
+		c = sha1_context_rotate_left( b, 30 );
+		b = a;
+		a = temporary;
+	}
+	hash_values[ 0 ] += a;
+	hash_values[ 1 ] += b;
+	hash_values[ 2 ] += c;
+	hash_values[ 3 ] += d;
+	hash_values[ 4 ] += e;
+}
+
+/* Calculates the SHA-1 of 64 byte blocks of data using the AVX2 instructions of the CPU
+ * The message schedule of 8 consecutive blocks is calculated at once, with one block
+ * per 32-bit lane, after which the rounds of the blocks are calculated in order
+ * The size must be a multitude of 64
+ */
+SHA1_CONTEXT_AVX2_TARGET_ATTRIBUTE
+static void sha1_context_transform_avx2(
+             uint32_t *hash_values,
+             const uint8_t *data,
+             size_t size )
+{
+	uint32_t block_message_words[ 16 ];
+	uint32_t schedule[ 80 * 8 ];
+
+	__m256i block_words[ 8 ];
+	__m256i byte_order_mask;
+	__m256i message_words[ 16 ];
+	__m256i pairs[ 8 ];
+	__m256i quads[ 8 ];
+
+	uint32_t message_word = 0;
+	int block_index       = 0;
+	int word_index        = 0;
+
+	byte_order_mask = _mm256_set_epi64x(
+	                   0x0c0d0e0f08090a0bULL,
+	                   0x0405060700010203ULL,
+	                   0x0c0d0e0f08090a0bULL,
+	                   0x0405060700010203ULL );
+
+	while( size >= 8 * 64 )
+	{
+		/* Transpose the message words so that each lane contains the words of one block
+		 */
+		for( word_index = 0;
+		     word_index < 16;
+		     word_index += 8 )
+		{
+			for( block_index = 0;
+			     block_index < 8;
+			     block_index++ )
+			{
+				block_words[ block_index ] = _mm256_shuffle_epi8(
+				                              _mm256_loadu_si256(
+				                               (const __m256i *) &( data[ ( block_index * 64 ) + ( word_index * 4 ) ] ) ),
+				                              byte_order_mask );
+			}
+			for( block_index = 0;
+			     block_index < 8;
+			     block_index += 2 )
+			{
+				pairs[ block_index ]     = _mm256_unpacklo_epi32( block_words[ block_index ], block_words[ block_index + 1 ] );
+				pairs[ block_index + 1 ] = _mm256_unpackhi_epi32( block_words[ block_index ], block_words[ block_index + 1 ] );
+			}
+			for( block_index = 0;
+			     block_index < 8;
+			     block_index += 4 )
+			{
+				quads[ block_index ]     = _mm256_unpacklo_epi64( pairs[ block_index ], pairs[ block_index + 2 ] );
+				quads[ block_index + 1 ] = _mm256_unpackhi_epi64( pairs[ block_index ], pairs[ block_index + 2 ] );
+				quads[ block_index + 2 ] = _mm256_unpacklo_epi64( pairs[ block_index + 1 ], pairs[ block_index + 3 ] );
+				quads[ block_index + 3 ] = _mm256_unpackhi_epi64( pairs[ block_index + 1 ], pairs[ block_index + 3 ] );
+			}
+			for( block_index = 0;
+			     block_index < 4;
+			     block_index++ )
+			{
+				message_words[ word_index + block_index ]     = _mm256_permute2x128_si256( quads[ block_index ], quads[ block_index + 4 ], 0x20 );
+				message_words[ word_index + block_index + 4 ] = _mm256_permute2x128_si256( quads[ block_index ], quads[ block_index + 4 ], 0x31 );
+			}
+		}
+		for( word_index = 0;
+		     word_index < 80;
+		     word_index++ )
+		{
+			if( word_index >= 16 )
+			{
+				message_words[ word_index & 15 ] = _mm256_xor_si256(
+				                                    _mm256_xor_si256(
+				                                     message_words[ ( word_index - 3 ) & 15 ],
+				                                     message_words[ ( word_index - 8 ) & 15 ] ),
+				                                    _mm256_xor_si256(
+				                                     message_words[ ( word_index - 14 ) & 15 ],
+				                                     message_words[ word_index & 15 ] ) );
+
+				message_words[ word_index & 15 ] = sha1_context_avx2_rotate_left(
+				                                    message_words[ word_index & 15 ],
+				                                    1 );
+			}
+			_mm256_storeu_si256(
+			 (__m256i *) &( schedule[ word_index * 8 ] ),
+			 _mm256_add_epi32(
+			  message_words[ word_index & 15 ],
+			  _mm256_set1_epi32(
+			   (int) sha1_context_round_constants[ word_index / 20 ] ) ) );
+		}
+		for( block_index = 0;
+		     block_index < 8;
+		     block_index++ )
+		{
+			sha1_context_transform_rounds(
+			 hash_values,
+			 &( schedule[ block_index ] ),
+			 8 );
+		}
+		data += 8 * 64;
+		size -= 8 * 64;
+	}
+	/* The remaining blocks are calculated one at a time
+	 */
+	while( size >= 64 )
+	{
+		for( word_index = 0;
+		     word_index < 80;
+		     word_index++ )
+		{
+			if( word_index < 16 )
+			{
+				byte_stream_copy_to_uint32_big_endian(
+				 &( data[ word_index * 4 ] ),
+				 message_word );
+			}
+			else
+			{
+				message_word = block_message_words[ ( word_index - 3 ) & 15 ]
+				             ^ block_message_words[ ( word_index - 8 ) & 15 ]
+				             ^ block_message_words[ ( word_index - 14 ) & 15 ]
+				             ^ block_message_words[ word_index & 15 ];
+
+				message_word = sha1_context_rotate_left( message_word, 1 );
+			}
+			block_message_words[ word_index & 15 ] = message_word;
+
+			schedule[ word_index ] = message_word + sha1_context_round_constants[ word_index / 20 ];
+		}
+		sha1_context_transform_rounds(
+		 hash_values,
+		 schedule,
+		 1 );
+
+		data += 64;
+		size -= 64;
+	}
+}
+
+#elif defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+
+static void sha1_context_transform(
+             uint32_t *hash_values,
+             const uint8_t *data,
+             size_t size )
+{
+	uint32x4_t message_words[ 4 ];
+
+	uint32x4_t abcd;
+	uint32x4_t abcd_saved;
+	uint32x4_t temporary;
+	uint32_t e0       = 0;
+	uint32_t e0_saved = 0;
+	uint32_t e1       = 0;
+	int group_index   = 0;
+
+	abcd = vld1q_u32(
+	        &( hash_values[ 0 ] ) );
+
+	e0 = hash_values[ 4 ];
+
+	while( size >= 64 )
+	{
+		abcd_saved = abcd;
+		e0_saved   = e0;
+
+		for( group_index = 0;
+		     group_index < 4;
+		     group_index++ )
+		{
+			message_words[ group_index ] = vreinterpretq_u32_u8(
+			                                vrev32q_u8(
+			                                 vld1q_u8(
+			                                  &( data[ group_index * 16 ] ) ) ) );
+		}
+		for( group_index = 0;
+		     group_index < 20;
+		     group_index++ )
+		{
+			temporary = vaddq_u32(
+			             message_words[ group_index & 3 ],
+			             vdupq_n_u32(
+			              sha1_context_round_constants[ group_index / 5 ] ) );
+
+			/* E of the next rounds is derived from A of these rounds
+			 */
+			e1 = vsha1h_u32(
+			      vgetq_lane_u32(
+			       abcd,
+			       0 ) );
+
+			switch( group_index / 5 )
+			{
+				case 0:
+					abcd = vsha1cq_u32( abcd, e0, temporary );
+					break;
+
+				case 2:
+					abcd = vsha1mq_u32( abcd, e0, temporary );
+					break;
+
+				default:
+					abcd = vsha1pq_u32( abcd, e0, temporary );
+					break;
+			}
+			e0 = e1;
+
+			if( group_index < 16 )
+			{
+				message_words[ group_index & 3 ] = vsha1su1q_u32(
+				                                    vsha1su0q_u32(
+				                                     message_words[ group_index & 3 ],
+				                                     message_words[ ( group_index + 1 ) & 3 ],
+				                                     message_words[ ( group_index + 2 ) & 3 ] ),
+				                                    message_words[ ( group_index + 3 ) & 3 ] );
+			}
+		}
+		e0  += e0_saved;
+		abcd = vaddq_u32( abcd, abcd_saved );
+
+		data += 64;
+		size -= 64;
+	}
+	vst1q_u32(
+	 &( hash_values[ 0 ] ),
+	 abcd );
+
+	hash_values[ 4 ] = e0;
+}
+
+#endif /* defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) */
+
+/* Calculates the SHA-1 of 64 byte blocks of data using the instructions
+ * the hardware flags of the context refer to
+ * The size must be a multitude of 64
+ */
+static void sha1_context_transform_blocks(
+             sha1_context_t *context,
+             const uint8_t *data,
+             size_t size )
+{
+	if( ( context->hardware_flags & DIGEST_HASH_HARDWARE_FLAG_SHA1 ) != 0 )
+	{
+		sha1_context_transform(
+		 context->hash_values,
+		 data,
+		 size );
+	}
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+	else if( ( context->hardware_flags & DIGEST_HASH_HARDWARE_FLAG_AVX2 ) != 0 )
+	{
+		sha1_context_transform_avx2(
+		 context->hash_values,
+		 data,
+		 size );
+	}
+#endif
+}
+
+#endif /* defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS ) */
+
+/* Creates a SHA-1 context
+ * Make sure the value context is referencing, is set to NULL
+ * The SHA or AVX2 instructions of the CPU are only used if use_hardware is set
+ * and the CPU supports them, where the SHA instructions are preferred
+ * Returns 1 if successful or -1 on error
+ */
+int sha1_context_initialize(
+     sha1_context_t **context,
+     uint8_t use_hardware,
+     libcerror_error_t **error )
+{
+	static char *function  = "sha1_context_initialize";
+	uint8_t hardware_flags = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( use_hardware != 0 )
+	{
+		if( digest_hash_get_hardware_flags(
+		     &hardware_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve hardware flags.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*context = memory_allocate_structure(
+	            sha1_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( sha1_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+	if( ( hardware_flags & ( DIGEST_HASH_HARDWARE_FLAG_SHA1 | DIGEST_HASH_HARDWARE_FLAG_AVX2 ) ) != 0 )
+#else
+	if( ( hardware_flags & DIGEST_HASH_HARDWARE_FLAG_SHA1 ) != 0 )
+#endif
+	{
+		if( memory_copy(
+		     ( *context )->hash_values,
+		     sha1_context_initial_hash_values,
+		     sizeof( uint32_t ) * 5 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy initial hash values.",
+			 function );
+
+			goto on_error;
+		}
+		( *context )->use_hardware   = 1;
+		( *context )->hardware_flags = hardware_flags;
+	}
+#endif
+	if( ( *context )->use_hardware == 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( ( *context )->libhmac_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create libhmac SHA-1 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a SHA-1 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha1_context_free(
+     sha1_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "sha1_context_free";
+	int result            = 1;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		if( ( *context )->libhmac_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *context )->libhmac_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free libhmac SHA-1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( memory_set(
+		     *context,
+		     0,
+		     sizeof( sha1_context_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear context.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( result );
+}
+
+/* Updates the SHA-1 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha1_context_update(
+     sha1_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha1_context_update";
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->use_hardware == 0 )
+	{
+		if( libhmac_sha1_update(
+		     context->libhmac_context,
+		     buffer,
+		     size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update libhmac SHA-1 context.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	if( context->block_offset > 0 )
+	{
+		read_size = SHA1_CONTEXT_BLOCK_SIZE - context->block_offset;
+
+		if( read_size > size )
+		{
+			read_size = size;
+		}
+		if( memory_copy(
+		     &( context->block[ context->block_offset ] ),
+		     buffer,
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_offset += read_size;
+		buffer_offset         += read_size;
+
+		if( context->block_offset == SHA1_CONTEXT_BLOCK_SIZE )
+		{
+			sha1_context_transform_blocks(
+			 context,
+			 context->block,
+			 SHA1_CONTEXT_BLOCK_SIZE );
+
+			context->block_offset = 0;
+		}
+	}
+	/* The blocks are hashed directly from the buffer
+	 */
+	read_size = ( size - buffer_offset ) & ~( (size_t) SHA1_CONTEXT_BLOCK_SIZE - 1 );
+
+	if( read_size > 0 )
+	{
+		sha1_context_transform_blocks(
+		 context,
+		 &( buffer[ buffer_offset ] ),
+		 read_size );
+
+		buffer_offset += read_size;
+	}
+	if( buffer_offset < size )
+	{
+		read_size = size - buffer_offset;
+
+		if( memory_copy(
+		     context->block,
+		     &( buffer[ buffer_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_offset = read_size;
+	}
+	context->number_of_bytes += size;
+#endif
+	return( 1 );
+}
+
+/* Finalizes the SHA-1 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha1_context_finalize(
+     sha1_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "sha1_context_finalize";
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	uint64_t number_of_bits = 0;
+	int hash_value_index    = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_size < 20 )
+	 || ( hash_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->use_hardware == 0 )
+	{
+		if( libhmac_sha1_finalize(
+		     context->libhmac_context,
+		     hash,
+		     hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize libhmac SHA-1 context.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	number_of_bits = context->number_of_bytes * 8;
+
+	/* Add the padding, which is a 1-bit followed by 0-bits and the size in bits
+	 */
+	context->block[ context->block_offset++ ] = 0x80;
+
+	if( context->block_offset > ( SHA1_CONTEXT_BLOCK_SIZE - 8 ) )
+	{
+		if( memory_set(
+		     &( context->block[ context->block_offset ] ),
+		     0,
+		     SHA1_CONTEXT_BLOCK_SIZE - context->block_offset ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block.",
+			 function );
+
+			return( -1 );
+		}
+		sha1_context_transform_blocks(
+		 context,
+		 context->block,
+		 SHA1_CONTEXT_BLOCK_SIZE );
+
+		context->block_offset = 0;
+	}
+	if( memory_set(
+	     &( context->block[ context->block_offset ] ),
+	     0,
+	     SHA1_CONTEXT_BLOCK_SIZE - 8 - context->block_offset ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( context->block[ SHA1_CONTEXT_BLOCK_SIZE - 8 ] ),
+	 number_of_bits );
+
+	sha1_context_transform_blocks(
+	 context,
+	 context->block,
+	 SHA1_CONTEXT_BLOCK_SIZE );
+
+	context->block_offset = 0;
+
+	for( hash_value_index = 0;
+	     hash_value_index < 5;
+	     hash_value_index++ )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( hash[ hash_value_index * 4 ] ),
+		 context->hash_values[ hash_value_index ] );
+	}
+#endif
+	return( 1 );
+}
+
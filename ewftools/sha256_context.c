@@ -0,0 +1,985 @@
+/*
+ * SHA-256 context functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libhmac.h"
+#include "sha256_context.h"
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+#include <immintrin.h>
+
+#elif defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+#include <arm_neon.h>
+
+#endif
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) && !defined( _MSC_VER )
+#define SHA256_CONTEXT_TARGET_ATTRIBUTE		__attribute__((target("sha,sse4.1,ssse3")))
+#define SHA256_CONTEXT_AVX2_TARGET_ATTRIBUTE	__attribute__((target("avx2")))
+#else
+#define SHA256_CONTEXT_TARGET_ATTRIBUTE
+#define SHA256_CONTEXT_AVX2_TARGET_ATTRIBUTE
+#endif
+
+/* The SHA-256 initial hash values
+ */
+static const uint32_t sha256_context_initial_hash_values[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+	0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+/* The SHA-256 round constants
+ */
+static const uint32_t sha256_context_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* Calculates the SHA-256 of 64 byte blocks of data using the SHA instructions of the CPU
+ * The size must be a multitude of 64
+ */
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+
+SHA256_CONTEXT_TARGET_ATTRIBUTE
+static void sha256_context_transform(
+             uint32_t *hash_values,
+             const uint8_t *data,
+             size_t size )
+{
+	__m128i byte_order_mask;
+	__m128i cdgh_saved;
+	__m128i abef_saved;
+	__m128i message;
+	__m128i message_words[ 4 ];
+	__m128i state0;
+	__m128i state1;
+	__m128i temporary;
+
+	int group_index = 0;
+
+	byte_order_mask = _mm_set_epi64x(
+	                   0x0c0d0e0f08090a0bULL,
+	                   0x0405060700010203ULL );
+
+	/* The SHA instructions use the state in the order: ABEF and CDGH
+	 */
+	temporary = _mm_loadu_si128(
+	             (const __m128i *) &( hash_values[ 0 ] ) );
+
+	state1 = _mm_loadu_si128(
+	          (const __m128i *) &( hash_values[ 4 ] ) );
+
+	temporary = _mm_shuffle_epi32( temporary, 0xb1 );
+	state1    = _mm_shuffle_epi32( state1, 0x1b );
+	state0    = _mm_alignr_epi8( temporary, state1, 8 );
+	state1    = _mm_blend_epi16( state1, temporary, 0xf0 );
+
+	while( size >= 64 )
+	{
+		abef_saved = state0;
+		cdgh_saved = state1;
+
+		for( group_index = 0;
+		     group_index < 16;
+		     group_index++ )
+		{
+			if( group_index < 4 )
+			{
+				message = _mm_loadu_si128(
+				           (const __m128i *) &( data[ group_index * 16 ] ) );
+
+				message_words[ group_index ] = _mm_shuffle_epi8(
+				                                message,
+				                                byte_order_mask );
+			}
+			message = _mm_add_epi32(
+			           message_words[ group_index & 3 ],
+			           _mm_loadu_si128(
+			            (const __m128i *) &( sha256_context_round_constants[ group_index * 4 ] ) ) );
+
+			state1 = _mm_sha256rnds2_epu32( state1, state0, message );
+
+			/* Complete the message words of the next group
+			 */
+			if( ( group_index >= 3 )
+			 && ( group_index <= 14 ) )
+			{
+				temporary = _mm_alignr_epi8(
+				             message_words[ group_index & 3 ],
+				             message_words[ ( group_index - 1 ) & 3 ],
+				             4 );
+
+				message_words[ ( group_index + 1 ) & 3 ] = _mm_add_epi32(
+				                                            message_words[ ( group_index + 1 ) & 3 ],
+				                                            temporary );
+
+				message_words[ ( group_index + 1 ) & 3 ] = _mm_sha256msg2_epu32(
+				                                            message_words[ ( group_index + 1 ) & 3 ],
+				                                            message_words[ group_index & 3 ] );
+			}
+			message = _mm_shuffle_epi32( message, 0x0e );
+			state0  = _mm_sha256rnds2_epu32( state0, state1, message );
+
+			if( ( group_index >= 1 )
+			 && ( group_index <= 12 ) )
+			{
+				message_words[ ( group_index - 1 ) & 3 ] = _mm_sha256msg1_epu32(
+				                                            message_words[ ( group_index - 1 ) & 3 ],
+				                                            message_words[ group_index & 3 ] );
+			}
+		}
+		state0 = _mm_add_epi32( state0, abef_saved );
+		state1 = _mm_add_epi32( state1, cdgh_saved );
+
+		data += 64;
+		size -= 64;
+	}
+	temporary = _mm_shuffle_epi32( state0, 0x1b );
+	state1    = _mm_shuffle_epi32( state1, 0xb1 );
+	state0    = _mm_blend_epi16( temporary, state1, 0xf0 );
+	state1    = _mm_alignr_epi8( state1, temporary, 8 );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 state0 );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 4 ] ),
+	 state1 );
+}
+
+#define sha256_context_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+#define sha256_context_sigma0( value ) \
+	( sha256_context_rotate_right( value, 7 ) ^ sha256_context_rotate_right( value, 18 ) ^ ( ( value ) >> 3 ) )
+
+#define sha256_context_sigma1( value ) \
+	( sha256_context_rotate_right( value, 17 ) ^ sha256_context_rotate_right( value, 19 ) ^ ( ( value ) >> 10 ) )
+
+#define sha256_context_avx2_rotate_right( value, number_of_bits ) \
+	_mm256_or_si256( \
+	 _mm256_srli_epi32( value, number_of_bits ), \
+	 _mm256_slli_epi32( value, 32 - ( number_of_bits ) ) )
+
+/* Calculates the SHA-256 rounds of a single 64 byte block
+ * The schedule contains the message words with the round constants added,
+ * where consecutive words are stride words apart
+ */
+static void sha256_context_transform_rounds(
+             uint32_t *hash_values,
+             const uint32_t *schedule,
+             size_t stride )
+{
+	uint32_t a          = hash_values[ 0 ];
+	uint32_t b          = hash_values[ 1 ];
+	uint32_t c          = hash_values[ 2 ];
+	uint32_t d          = hash_values[ 3 ];
+	uint32_t e          = hash_values[ 4 ];
+	uint32_t f          = hash_values[ 5 ];
+	uint32_t g          = hash_values[ 6 ];
+	uint32_t h          = hash_values[ 7 ];
+	uint32_t temporary1 = 0;
+	uint32_t temporary2 = 0;
+	int round_index     = 0;
+
+	for( round_index = 0;
+	     round_index < 64;
+	     round_index++ )
+	{
+		temporary1 = h
+		           + ( sha256_context_rotate_right( e, 6 ) ^ sha256_context_rotate_right( e, 11 ) ^ sha256_context_rotate_right( e, 25 ) )
+		           + ( g ^ ( e & ( f ^ g ) ) )
+		           + schedule[ round_index * stride ];
+
+		temporary2 = ( sha256_context_rotate_right( a, 2 ) ^ sha256_context_rotate_right( a, 13 ) ^ sha256_context_rotate_right( a, 22 ) )
+		           + ( ( a & b ) | ( c & ( a | b ) ) );
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + temporary1;
+		d = c;
+		c = b;
+		b = a;
+		a = temporary1 + temporary2;
+	}
+	hash_values[ 0 ] += a;
+	hash_values[ 1 ] += b;
+	hash_values[ 2 ] += c;
+	hash_values[ 3 ] += d;
+	hash_values[ 4 ] += e;
+	hash_values[ 5 ] += f;
+	hash_values[ 6 ] += g;
+	hash_values[ 7 ] += h;
+}
+
+/* Calculates the SHA-256 of 64 byte blocks of data using the AVX2 instructions of the CPU
+ * The message schedule of 8 consecutive blocks is calculated at once, with one block
+ * per 32-bit lane, after which the rounds of the blocks are calculated in order
+ * The size must be a multitude of 64
+ */
+SHA256_CONTEXT_AVX2_TARGET_ATTRIBUTE
+static void sha256_context_transform_avx2(
+             uint32_t *hash_values,
+             const uint8_t *data,
+             size_t size )
+{
+	uint32_t block_message_words[ 16 ];
+	uint32_t schedule[ 64 * 8 ];
+
+	__m256i block_words[ 8 ];
+	__m256i byte_order_mask;
+	__m256i message_words[ 16 ];
+	__m256i pairs[ 8 ];
+	__m256i quads[ 8 ];
+	__m256i sigma0;
+	__m256i sigma1;
+
+	uint32_t message_word = 0;
+	int block_index       = 0;
+	int word_index        = 0;
+
+	byte_order_mask = _mm256_set_epi64x(
+	                   0x0c0d0e0f08090a0bULL,
+	                   0x0405060700010203ULL,
+	                   0x0c0d0e0f08090a0bULL,
+	                   0x0405060700010203ULL );
+
+	while( size >= 8 * 64 )
+	{
+		/* Transpose the message words so that each lane contains the words of one block
+		 */
+		for( word_index = 0;
+		     word_index < 16;
+		     word_index += 8 )
+		{
+			for( block_index = 0;
+			     block_index < 8;
+			     block_index++ )
+			{
+				block_words[ block_index ] = _mm256_shuffle_epi8(
+				                              _mm256_loadu_si256(
+				                               (const __m256i *) &( data[ ( block_index * 64 ) + ( word_index * 4 ) ] ) ),
+				                              byte_order_mask );
+			}
+			for( block_index = 0;
+			     block_index < 8;
+			     block_index += 2 )
+			{
+				pairs[ block_index ]     = _mm256_unpacklo_epi32( block_words[ block_index ], block_words[ block_index + 1 ] );
+				pairs[ block_index + 1 ] = _mm256_unpackhi_epi32( block_words[ block_index ], block_words[ block_index + 1 ] );
+			}
+			for( block_index = 0;
+			     block_index < 8;
+			     block_index += 4 )
+			{
+				quads[ block_index ]     = _mm256_unpacklo_epi64( pairs[ block_index ], pairs[ block_index + 2 ] );
+				quads[ block_index + 1 ] = _mm256_unpackhi_epi64( pairs[ block_index ], pairs[ block_index + 2 ] );
+				quads[ block_index + 2 ] = _mm256_unpacklo_epi64( pairs[ block_index + 1 ], pairs[ block_index + 3 ] );
+				quads[ block_index + 3 ] = _mm256_unpackhi_epi64( pairs[ block_index + 1 ], pairs[ block_index + 3 ] );
+			}
+			for( block_index = 0;
+			     block_index < 4;
+			     block_index++ )
+			{
+				message_words[ word_index + block_index ]     = _mm256_permute2x128_si256( quads[ block_index ], quads[ block_index + 4 ], 0x20 );
+				message_words[ word_index + block_index + 4 ] = _mm256_permute2x128_si256( quads[ block_index ], quads[ block_index + 4 ], 0x31 );
+			}
+		}
+		for( word_index = 0;
+		     word_index < 64;
+		     word_index++ )
+		{
+			if( word_index >= 16 )
+			{
+				sigma0 = message_words[ ( word_index - 15 ) & 15 ];
+				sigma0 = _mm256_xor_si256(
+				          _mm256_xor_si256(
+				           sha256_context_avx2_rotate_right( sigma0, 7 ),
+				           sha256_context_avx2_rotate_right( sigma0, 18 ) ),
+				          _mm256_srli_epi32( sigma0, 3 ) );
+
+				sigma1 = message_words[ ( word_index - 2 ) & 15 ];
+				sigma1 = _mm256_xor_si256(
+				          _mm256_xor_si256(
+				           sha256_context_avx2_rotate_right( sigma1, 17 ),
+				           sha256_context_avx2_rotate_right( sigma1, 19 ) ),
+				          _mm256_srli_epi32( sigma1, 10 ) );
+
+				message_words[ word_index & 15 ] = _mm256_add_epi32(
+				                                    _mm256_add_epi32(
+				                                     message_words[ word_index & 15 ],
+				                                     sigma0 ),
+				                                    _mm256_add_epi32(
+				                                     message_words[ ( word_index - 7 ) & 15 ],
+				                                     sigma1 ) );
+			}
+			_mm256_storeu_si256(
+			 (__m256i *) &( schedule[ word_index * 8 ] ),
+			 _mm256_add_epi32(
+			  message_words[ word_index & 15 ],
+			  _mm256_set1_epi32(
+			   (int) sha256_context_round_constants[ word_index ] ) ) );
+		}
+		for( block_index = 0;
+		     block_index < 8;
+		     block_index++ )
+		{
+			sha256_context_transform_rounds(
+			 hash_values,
+			 &( schedule[ block_index ] ),
+			 8 );
+		}
+		data += 8 * 64;
+		size -= 8 * 64;
+	}
+	/* The remaining blocks are calculated one at a time
+	 */
+	while( size >= 64 )
+	{
+		for( word_index = 0;
+		     word_index < 64;
+		     word_index++ )
+		{
+			if( word_index < 16 )
+			{
+				byte_stream_copy_to_uint32_big_endian(
+				 &( data[ word_index * 4 ] ),
+				 message_word );
+			}
+			else
+			{
+				message_word = block_message_words[ word_index & 15 ]
+				             + sha256_context_sigma0( block_message_words[ ( word_index - 15 ) & 15 ] )
+				             + block_message_words[ ( word_index - 7 ) & 15 ]
+				             + sha256_context_sigma1( block_message_words[ ( word_index - 2 ) & 15 ] );
+			}
+			block_message_words[ word_index & 15 ] = message_word;
+
+			schedule[ word_index ] = message_word + sha256_context_round_constants[ word_index ];
+		}
+		sha256_context_transform_rounds(
+		 hash_values,
+		 schedule,
+		 1 );
+
+		data += 64;
+		size -= 64;
+	}
+}
+
+#elif defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+
+static void sha256_context_transform(
+             uint32_t *hash_values,
+             const uint8_t *data,
+             size_t size )
+{
+	uint32x4_t message_words[ 4 ];
+
+	uint32x4_t abcd_saved;
+	uint32x4_t efgh_saved;
+	uint32x4_t state0;
+	uint32x4_t state1;
+	uint32x4_t temporary;
+	uint32x4_t temporary_state;
+	int group_index = 0;
+
+	state0 = vld1q_u32(
+	          &( hash_values[ 0 ] ) );
+
+	state1 = vld1q_u32(
+	          &( hash_values[ 4 ] ) );
+
+	while( size >= 64 )
+	{
+		abcd_saved = state0;
+		efgh_saved = state1;
+
+		for( group_index = 0;
+		     group_index < 4;
+		     group_index++ )
+		{
+			message_words[ group_index ] = vreinterpretq_u32_u8(
+			                                vrev32q_u8(
+			                                 vld1q_u8(
+			                                  &( data[ group_index * 16 ] ) ) ) );
+		}
+		for( group_index = 0;
+		     group_index < 16;
+		     group_index++ )
+		{
+			temporary = vaddq_u32(
+			             message_words[ group_index & 3 ],
+			             vld1q_u32(
+			              &( sha256_context_round_constants[ group_index * 4 ] ) ) );
+
+			if( group_index < 12 )
+			{
+				message_words[ group_index & 3 ] = vsha256su0q_u32(
+				                                    message_words[ group_index & 3 ],
+				                                    message_words[ ( group_index + 1 ) & 3 ] );
+			}
+			temporary_state = state0;
+
+			state0 = vsha256hq_u32( state0, state1, temporary );
+			state1 = vsha256h2q_u32( state1, temporary_state, temporary );
+
+			if( group_index < 12 )
+			{
+				message_words[ group_index & 3 ] = vsha256su1q_u32(
+				                                    message_words[ group_index & 3 ],
+				                                    message_words[ ( group_index + 2 ) & 3 ],
+				                                    message_words[ ( group_index + 3 ) & 3 ] );
+			}
+		}
+		state0 = vaddq_u32( state0, abcd_saved );
+		state1 = vaddq_u32( state1, efgh_saved );
+
+		data += 64;
+		size -= 64;
+	}
+	vst1q_u32(
+	 &( hash_values[ 0 ] ),
+	 state0 );
+
+	vst1q_u32(
+	 &( hash_values[ 4 ] ),
+	 state1 );
+}
+
+#endif /* defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) */
+
+/* Calculates the SHA-256 of 64 byte blocks of data using the instructions
+ * the hardware flags of the context refer to
+ * The size must be a multitude of 64
+ */
+static void sha256_context_transform_blocks(
+             sha256_context_t *context,
+             const uint8_t *data,
+             size_t size )
+{
+	if( ( context->hardware_flags & DIGEST_HASH_HARDWARE_FLAG_SHA256 ) != 0 )
+	{
+		sha256_context_transform(
+		 context->hash_values,
+		 data,
+		 size );
+	}
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+	else if( ( context->hardware_flags & DIGEST_HASH_HARDWARE_FLAG_AVX2 ) != 0 )
+	{
+		sha256_context_transform_avx2(
+		 context->hash_values,
+		 data,
+		 size );
+	}
+#endif
+}
+
+#endif /* defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS ) */
+
+/* Creates a SHA-256 context
+ * Make sure the value context is referencing, is set to NULL
+ * The SHA or AVX2 instructions of the CPU are only used if use_hardware is set
+ * and the CPU supports them, where the SHA instructions are preferred
+ * Returns 1 if successful or -1 on error
+ */
+int sha256_context_initialize(
+     sha256_context_t **context,
+     uint8_t use_hardware,
+     libcerror_error_t **error )
+{
+	static char *function  = "sha256_context_initialize";
+	uint8_t hardware_flags = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( use_hardware != 0 )
+	{
+		if( digest_hash_get_hardware_flags(
+		     &hardware_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve hardware flags.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*context = memory_allocate_structure(
+	            sha256_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( sha256_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS )
+	if( ( hardware_flags & ( DIGEST_HASH_HARDWARE_FLAG_SHA256 | DIGEST_HASH_HARDWARE_FLAG_AVX2 ) ) != 0 )
+#else
+	if( ( hardware_flags & DIGEST_HASH_HARDWARE_FLAG_SHA256 ) != 0 )
+#endif
+	{
+		if( memory_copy(
+		     ( *context )->hash_values,
+		     sha256_context_initial_hash_values,
+		     sizeof( uint32_t ) * 8 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy initial hash values.",
+			 function );
+
+			goto on_error;
+		}
+		( *context )->use_hardware   = 1;
+		( *context )->hardware_flags = hardware_flags;
+	}
+#endif
+	if( ( *context )->use_hardware == 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( ( *context )->libhmac_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create libhmac SHA-256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a SHA-256 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha256_context_free(
+     sha256_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "sha256_context_free";
+	int result            = 1;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		if( ( *context )->libhmac_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *context )->libhmac_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free libhmac SHA-256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( memory_set(
+		     *context,
+		     0,
+		     sizeof( sha256_context_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear context.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( result );
+}
+
+/* Updates the SHA-256 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha256_context_update(
+     sha256_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha256_context_update";
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->use_hardware == 0 )
+	{
+		if( libhmac_sha256_update(
+		     context->libhmac_context,
+		     buffer,
+		     size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update libhmac SHA-256 context.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	if( context->block_offset > 0 )
+	{
+		read_size = SHA256_CONTEXT_BLOCK_SIZE - context->block_offset;
+
+		if( read_size > size )
+		{
+			read_size = size;
+		}
+		if( memory_copy(
+		     &( context->block[ context->block_offset ] ),
+		     buffer,
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_offset += read_size;
+		buffer_offset         += read_size;
+
+		if( context->block_offset == SHA256_CONTEXT_BLOCK_SIZE )
+		{
+			sha256_context_transform_blocks(
+			 context,
+			 context->block,
+			 SHA256_CONTEXT_BLOCK_SIZE );
+
+			context->block_offset = 0;
+		}
+	}
+	/* The blocks are hashed directly from the buffer
+	 */
+	read_size = ( size - buffer_offset ) & ~( (size_t) SHA256_CONTEXT_BLOCK_SIZE - 1 );
+
+	if( read_size > 0 )
+	{
+		sha256_context_transform_blocks(
+		 context,
+		 &( buffer[ buffer_offset ] ),
+		 read_size );
+
+		buffer_offset += read_size;
+	}
+	if( buffer_offset < size )
+	{
+		read_size = size - buffer_offset;
+
+		if( memory_copy(
+		     context->block,
+		     &( buffer[ buffer_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_offset = read_size;
+	}
+	context->number_of_bytes += size;
+#endif
+	return( 1 );
+}
+
+/* Finalizes the SHA-256 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha256_context_finalize(
+     sha256_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "sha256_context_finalize";
+
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	uint64_t number_of_bits = 0;
+	int hash_value_index    = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_size < 32 )
+	 || ( hash_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->use_hardware == 0 )
+	{
+		if( libhmac_sha256_finalize(
+		     context->libhmac_context,
+		     hash,
+		     hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize libhmac SHA-256 context.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if defined( HAVE_DIGEST_HASH_X86_SHA_INSTRUCTIONS ) || defined( HAVE_DIGEST_HASH_ARM_SHA_INSTRUCTIONS )
+	number_of_bits = context->number_of_bytes * 8;
+
+	/* Add the padding, which is a 1-bit followed by 0-bits and the size in bits
+	 */
+	context->block[ context->block_offset++ ] = 0x80;
+
+	if( context->block_offset > ( SHA256_CONTEXT_BLOCK_SIZE - 8 ) )
+	{
+		if( memory_set(
+		     &( context->block[ context->block_offset ] ),
+		     0,
+		     SHA256_CONTEXT_BLOCK_SIZE - context->block_offset ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block.",
+			 function );
+
+			return( -1 );
+		}
+		sha256_context_transform_blocks(
+		 context,
+		 context->block,
+		 SHA256_CONTEXT_BLOCK_SIZE );
+
+		context->block_offset = 0;
+	}
+	if( memory_set(
+	     &( context->block[ context->block_offset ] ),
+	     0,
+	     SHA256_CONTEXT_BLOCK_SIZE - 8 - context->block_offset ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( context->block[ SHA256_CONTEXT_BLOCK_SIZE - 8 ] ),
+	 number_of_bits );
+
+	sha256_context_transform_blocks(
+	 context,
+	 context->block,
+	 SHA256_CONTEXT_BLOCK_SIZE );
+
+	context->block_offset = 0;
+
+	for( hash_value_index = 0;
+	     hash_value_index < 8;
+	     hash_value_index++ )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( hash[ hash_value_index * 4 ] ),
+		 context->hash_values[ hash_value_index ] );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,100 @@
+/*
+ * SHA-256 context functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SHA256_CONTEXT_H )
+#define _SHA256_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define SHA256_CONTEXT_BLOCK_SIZE	64
+
+typedef struct sha256_context sha256_context_t;
+
+/* The SHA-256 context uses the SHA-256 instructions of the CPU when
+ * available, the AVX2 instructions to calculate the message schedule
+ * when the SHA-256 instructions are not available and libhmac otherwise
+ */
+struct sha256_context
+{
+	/* The libhmac SHA-256 context, used when the CPU does not support the SHA-256 or AVX2 instructions
+	 */
+	libhmac_sha256_context_t *libhmac_context;
+
+	/* The hash values
+	 */
+	uint32_t hash_values[ 8 ];
+
+	/* The total number of bytes hashed
+	 */
+	uint64_t number_of_bytes;
+
+	/* The block of data that is not yet hashed
+	 */
+	uint8_t block[ SHA256_CONTEXT_BLOCK_SIZE ];
+
+	/* The block offset
+	 */
+	size_t block_offset;
+
+	/* Value to indicate the instructions of the CPU are used
+	 */
+	uint8_t use_hardware;
+
+	/* The hardware flags, which determine the instructions that are used
+	 */
+	uint8_t hardware_flags;
+};
+
+int sha256_context_initialize(
+     sha256_context_t **context,
+     uint8_t use_hardware,
+     libcerror_error_t **error );
+
+int sha256_context_free(
+     sha256_context_t **context,
+     libcerror_error_t **error );
+
+int sha256_context_update(
+     sha256_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int sha256_context_finalize(
+     sha256_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SHA256_CONTEXT_H ) */
+
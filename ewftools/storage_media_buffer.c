@@ -156,6 +156,21 @@ int storage_media_buffer_initialize(
 
 		( *buffer )->raw_buffer_size = size;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *buffer )->reference_count_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reference count mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	if( ( mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 	 && ( handle != NULL ) )
 	{
@@ -181,6 +196,14 @@ int storage_media_buffer_initialize(
 on_error:
 	if( *buffer != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *buffer )->reference_count_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *buffer )->reference_count_mutex ),
+			 NULL );
+		}
+#endif
 		if( ( *buffer )->data_chunk != NULL )
 		{
 			libewf_data_chunk_free(
@@ -244,6 +267,24 @@ int storage_media_buffer_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *buffer )->reference_count_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *buffer )->reference_count_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reference count mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 *buffer );
 
@@ -252,6 +293,143 @@ int storage_media_buffer_free(
 	return( result );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Adds a reference to a storage media buffer
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_add_reference(
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_add_reference";
+	int result            = 1;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer->reference_count_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference count mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer->reference_count == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer - reference count value exceeds maximum.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		buffer->reference_count += 1;
+	}
+	if( libcthreads_mutex_release(
+	     buffer->reference_count_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference count mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Removes a reference from a storage media buffer
+ * The reference count is set to the number of remaining references
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_remove_reference(
+     storage_media_buffer_t *buffer,
+     int *reference_count,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_remove_reference";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( reference_count == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference count.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer->reference_count_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference count mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer->reference_count > 0 )
+	{
+		buffer->reference_count -= 1;
+	}
+	*reference_count = buffer->reference_count;
+
+	if( libcthreads_mutex_release(
+	     buffer->reference_count_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference count mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Retrieves the reference to the actual data and its size
  * Returns 1 if successful or -1 on error
  */
@@ -427,10 +605,97 @@ ssize_t storage_media_buffer_read_from_handle(
 		storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
 	}
 	storage_media_buffer->requested_size = read_size;
+	storage_media_buffer->is_sparse      = 0;
 
 	return( read_count );
 }
 
+/* Reads a sparse storage media buffer from the input handle
+ * The buffer is filled with zero bytes and the input handle is moved past the data
+ * without reading it
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t storage_media_buffer_read_sparse_from_handle(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_read_sparse_from_handle";
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid storage media buffer - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_seek_offset(
+	     handle,
+	     (off64_t) read_size,
+	     SEEK_CUR,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek past sparse data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     storage_media_buffer->raw_buffer,
+	     0,
+	     read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear raw buffer.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->raw_buffer_data_size = read_size;
+	storage_media_buffer->requested_size       = read_size;
+	storage_media_buffer->is_sparse            = 1;
+
+	return( (ssize_t) read_size );
+}
+
 /* Processes a storage media buffer after read
  * Returns the resulting buffer size or -1 on error
  */
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 
 #if defined( __cplusplus )
@@ -50,6 +51,10 @@ struct storage_media_buffer
 	 */
 	off64_t storage_media_offset;
 
+	/* The sequence number, which is the order in which the buffer was read
+	 */
+	uint64_t sequence_number;
+
 	/* The raw buffer
 	 */
 	uint8_t *raw_buffer;
@@ -77,6 +82,29 @@ struct storage_media_buffer
 	/* Value to indicate the data is corrupted
 	 */
 	uint8_t is_corrupted;
+
+	/* Value to indicate the data is sparse, the buffer is filled with zero bytes
+	 * instead of the data being read
+	 */
+	uint8_t is_sparse;
+
+	/* The SHA-256 of the data, used as block hash of the tree hash
+	 */
+	uint8_t block_hash[ 32 ];
+
+	/* Value to indicate the block hash was calculated
+	 */
+	uint8_t has_block_hash;
+
+	/* The number of references to the buffer
+	 */
+	int reference_count;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The reference count mutex
+	 */
+	libcthreads_mutex_t *reference_count_mutex;
+#endif
 };
 
 int storage_media_buffer_initialize(
@@ -90,6 +118,19 @@ int storage_media_buffer_free(
      storage_media_buffer_t **buffer,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int storage_media_buffer_add_reference(
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_remove_reference(
+     storage_media_buffer_t *buffer,
+     int *reference_count,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int storage_media_buffer_get_data(
      storage_media_buffer_t *buffer,
      uint8_t **data,
@@ -111,6 +152,12 @@ ssize_t storage_media_buffer_read_from_handle(
          size_t read_size,
          libcerror_error_t **error );
 
+ssize_t storage_media_buffer_read_sparse_from_handle(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t read_size,
+         libcerror_error_t **error );
+
 ssize_t storage_media_buffer_read_process(
          storage_media_buffer_t *storage_media_buffer,
          libcerror_error_t **error );
@@ -215,10 +215,17 @@ int storage_media_buffer_queue_grab_buffer(
 
 		return( -1 );
 	}
+	/* A grabbed buffer starts with a single reference
+	 */
+	if( *buffer != NULL )
+	{
+		( *buffer )->reference_count = 1;
+	}
 	return( 1 );
 }
 
 /* Releases a storage media buffer onto the queue
+ * The buffer is only pushed back onto the queue when its last reference is released
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_release_buffer(
@@ -227,7 +234,26 @@ int storage_media_buffer_queue_release_buffer(
      libcerror_error_t **error )
 {
 	static char *function = "storage_media_buffer_queue_release_buffer";
+	int reference_count   = 0;
 
+	if( storage_media_buffer_remove_reference(
+	     buffer,
+	     &reference_count,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to remove reference from storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( reference_count > 0 )
+	{
+		return( 1 );
+	}
 	if( libcthreads_queue_push(
 	     queue,
 	     (intptr_t *) buffer,
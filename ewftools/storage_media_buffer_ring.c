@@ -0,0 +1,378 @@
+/*
+ * Storage media buffer ring
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
+
+/* Creates a storage media buffer ring
+ * Make sure the value ring is referencing, is set to NULL
+ * The number of buffers should be at least the number of buffers that can be in use at the same time
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_initialize(
+     storage_media_buffer_ring_t **ring,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_initialize";
+	size_t buffers_size   = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of buffers value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	buffers_size = sizeof( storage_media_buffer_t * ) * (size_t) number_of_buffers;
+
+	if( buffers_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of buffers value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*ring = memory_allocate_structure(
+	         storage_media_buffer_ring_t );
+
+	if( *ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *ring,
+	     0,
+	     sizeof( storage_media_buffer_ring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ring.",
+		 function );
+
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+
+		return( -1 );
+	}
+	( *ring )->buffers = (storage_media_buffer_t **) memory_allocate(
+	                                                  buffers_size );
+
+	if( ( *ring )->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *ring )->buffers,
+	     0,
+	     buffers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffers.",
+		 function );
+
+		goto on_error;
+	}
+	( *ring )->number_of_buffers = number_of_buffers;
+
+	return( 1 );
+
+on_error:
+	if( *ring != NULL )
+	{
+		if( ( *ring )->buffers != NULL )
+		{
+			memory_free(
+			 ( *ring )->buffers );
+		}
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a storage media buffer ring
+ * The buffers in the ring are not freed, use storage_media_buffer_ring_remove_buffer_by_index to empty the ring
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_free(
+     storage_media_buffer_ring_t **ring,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_free";
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ring != NULL )
+	{
+		memory_free(
+		 ( *ring )->buffers );
+
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+	}
+	return( 1 );
+}
+
+/* Inserts a storage media buffer into the ring
+ * The buffer is stored at the index of its sequence number modulo the number of buffers
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_insert_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_insert_buffer";
+	int buffer_index      = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer->sequence_number < ring->next_sequence_number )
+	 || ( ( buffer->sequence_number - ring->next_sequence_number ) >= (uint64_t) ring->number_of_buffers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer - sequence number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_index = (int) ( buffer->sequence_number % (uint64_t) ring->number_of_buffers );
+
+	if( ring->buffers[ buffer_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ring - buffer: %d value already set.",
+		 function,
+		 buffer_index );
+
+		return( -1 );
+	}
+	ring->buffers[ buffer_index ] = buffer;
+
+	ring->number_of_used_buffers += 1;
+
+	return( 1 );
+}
+
+/* Removes the next storage media buffer in sequence from the ring
+ * Returns 1 if successful, 0 if the next buffer is not available or -1 on error
+ */
+int storage_media_buffer_ring_remove_next_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_remove_next_buffer";
+	int buffer_index      = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_index = (int) ( ring->next_sequence_number % (uint64_t) ring->number_of_buffers );
+
+	if( ring->buffers[ buffer_index ] == NULL )
+	{
+		return( 0 );
+	}
+	*buffer = ring->buffers[ buffer_index ];
+
+	ring->buffers[ buffer_index ] = NULL;
+
+	ring->number_of_used_buffers -= 1;
+	ring->next_sequence_number   += 1;
+
+	return( 1 );
+}
+
+/* Removes a specific storage media buffer from the ring
+ * This function is intended to empty the ring, the next sequence number is not changed
+ * Returns 1 if successful, 0 if no buffer was stored at the index or -1 on error
+ */
+int storage_media_buffer_ring_remove_buffer_by_index(
+     storage_media_buffer_ring_t *ring,
+     int buffer_index,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_remove_buffer_by_index";
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_index < 0 )
+	 || ( buffer_index >= ring->number_of_buffers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->buffers[ buffer_index ] == NULL )
+	{
+		return( 0 );
+	}
+	*buffer = ring->buffers[ buffer_index ];
+
+	ring->buffers[ buffer_index ] = NULL;
+
+	ring->number_of_used_buffers -= 1;
+
+	return( 1 );
+}
+
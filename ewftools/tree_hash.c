@@ -0,0 +1,645 @@
+/*
+ * Tree hash functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "sha256_context.h"
+#include "tree_hash.h"
+
+/* Creates a tree hash
+ * Make sure the value tree_hash is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int tree_hash_initialize(
+     tree_hash_t **tree_hash,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "tree_hash_initialize";
+
+	if( tree_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( *tree_hash != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid tree hash value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*tree_hash = memory_allocate_structure(
+	              tree_hash_t );
+
+	if( *tree_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create tree hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *tree_hash,
+	     0,
+	     sizeof( tree_hash_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear tree hash.",
+		 function );
+
+		goto on_error;
+	}
+	if( sha256_context_initialize(
+	     &( ( *tree_hash )->root_context ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create root SHA-256 context.",
+		 function );
+
+		goto on_error;
+	}
+	( *tree_hash )->block_size = block_size;
+
+	return( 1 );
+
+on_error:
+	if( *tree_hash != NULL )
+	{
+		memory_free(
+		 *tree_hash );
+
+		*tree_hash = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a tree hash
+ * Returns 1 if successful or -1 on error
+ */
+int tree_hash_free(
+     tree_hash_t **tree_hash,
+     libcerror_error_t **error )
+{
+	static char *function = "tree_hash_free";
+	int result            = 1;
+
+	if( tree_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( *tree_hash != NULL )
+	{
+		if( ( *tree_hash )->block_context != NULL )
+		{
+			if( sha256_context_free(
+			     &( ( *tree_hash )->block_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free block SHA-256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *tree_hash )->root_context != NULL )
+		{
+			if( sha256_context_free(
+			     &( ( *tree_hash )->root_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free root SHA-256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *tree_hash );
+
+		*tree_hash = NULL;
+	}
+	return( result );
+}
+
+/* Calculates the hash of a single block
+ * This function does not depend on a tree hash and can be called from multiple threads
+ * Returns 1 if successful or -1 on error
+ */
+int tree_hash_calculate_block_hash(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *block_hash,
+     size_t block_hash_size,
+     libcerror_error_t **error )
+{
+	sha256_context_t *sha256_context = NULL;
+	static char *function            = "tree_hash_calculate_block_hash";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_hash_size < TREE_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid block hash size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_context_initialize(
+	     &sha256_context,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create SHA-256 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( sha256_context_update(
+	     sha256_context,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update SHA-256 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( sha256_context_finalize(
+	     sha256_context,
+	     block_hash,
+	     block_hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finalize SHA-256 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( sha256_context_free(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free SHA-256 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &sha256_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Updates the tree hash with the hash of the next block
+ * The block hash must be calculated using tree_hash_calculate_block_hash
+ * Returns 1 if successful or -1 on error
+ */
+int tree_hash_update_block_hash(
+     tree_hash_t *tree_hash,
+     const uint8_t *block_hash,
+     size_t block_hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "tree_hash_update_block_hash";
+
+	if( tree_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( tree_hash->block_offset != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid tree hash - block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_hash_size != TREE_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported block hash size.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_context_update(
+	     tree_hash->root_context,
+	     block_hash,
+	     block_hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update root SHA-256 context.",
+		 function );
+
+		return( -1 );
+	}
+	tree_hash->number_of_blocks += 1;
+
+	return( 1 );
+}
+
+/* Finalizes the current block and updates the root with its hash
+ * Returns 1 if successful or -1 on error
+ */
+static int tree_hash_finalize_block(
+            tree_hash_t *tree_hash,
+            libcerror_error_t **error )
+{
+	uint8_t block_hash[ TREE_HASH_SIZE ];
+
+	static char *function = "tree_hash_finalize_block";
+
+	if( sha256_context_finalize(
+	     tree_hash->block_context,
+	     block_hash,
+	     TREE_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finalize block SHA-256 context.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_context_free(
+	     &( tree_hash->block_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free block SHA-256 context.",
+		 function );
+
+		return( -1 );
+	}
+	tree_hash->block_offset = 0;
+
+	if( tree_hash_update_block_hash(
+	     tree_hash,
+	     block_hash,
+	     TREE_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update tree hash with block hash.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Updates the tree hash with data that does not need to be aligned with the blocks
+ * Returns 1 if successful or -1 on error
+ */
+int tree_hash_update(
+     tree_hash_t *tree_hash,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "tree_hash_update";
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+
+	if( tree_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( tree_hash->block_context == NULL )
+		{
+			if( sha256_context_initialize(
+			     &( tree_hash->block_context ),
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create block SHA-256 context.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		read_size = tree_hash->block_size - tree_hash->block_offset;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		if( sha256_context_update(
+		     tree_hash->block_context,
+		     &( buffer[ buffer_offset ] ),
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update block SHA-256 context.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset           += read_size;
+		tree_hash->block_offset += read_size;
+
+		if( tree_hash->block_offset >= tree_hash->block_size )
+		{
+			if( tree_hash_finalize_block(
+			     tree_hash,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to finalize block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Finalizes the tree hash
+ * Returns 1 if successful or -1 on error
+ */
+int tree_hash_finalize(
+     tree_hash_t *tree_hash,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "tree_hash_finalize";
+
+	if( tree_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tree hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_size < TREE_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid hash size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* The last block can be smaller than the block size
+	 */
+	if( tree_hash->block_offset > 0 )
+	{
+		if( tree_hash_finalize_block(
+		     tree_hash,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize last block.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( sha256_context_finalize(
+	     tree_hash->root_context,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finalize root SHA-256 context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,105 @@
+/*
+ * Tree hash functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _TREE_HASH_H )
+#define _TREE_HASH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "sha256_context.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define TREE_HASH_SIZE	32
+
+typedef struct tree_hash tree_hash_t;
+
+/* The tree hash is the SHA-256 of the concatenated SHA-256 hashes
+ * of each block of the data. Since the block hashes are independent
+ * of each other they can be calculated in parallel.
+ */
+struct tree_hash
+{
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The root SHA-256 context
+	 */
+	sha256_context_t *root_context;
+
+	/* The block SHA-256 context, used when the data is not provided per block
+	 */
+	sha256_context_t *block_context;
+
+	/* The block offset
+	 */
+	size_t block_offset;
+
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+};
+
+int tree_hash_initialize(
+     tree_hash_t **tree_hash,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int tree_hash_free(
+     tree_hash_t **tree_hash,
+     libcerror_error_t **error );
+
+int tree_hash_calculate_block_hash(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *block_hash,
+     size_t block_hash_size,
+     libcerror_error_t **error );
+
+int tree_hash_update_block_hash(
+     tree_hash_t *tree_hash,
+     const uint8_t *block_hash,
+     size_t block_hash_size,
+     libcerror_error_t **error );
+
+int tree_hash_update(
+     tree_hash_t *tree_hash,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int tree_hash_finalize(
+     tree_hash_t *tree_hash,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _TREE_HASH_H ) */
+
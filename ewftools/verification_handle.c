@@ -43,12 +43,14 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
 #include "verification_handle.h"
 
 #define VERIFICATION_HANDLE_VALUE_SIZE				64
 #define VERIFICATION_HANDLE_VALUE_IDENTIFIER_SIZE		32
 #define VERIFICATION_HANDLE_NOTIFY_STREAM			stdout
 #define VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE	64 * 1024 * 1024
+#define VERIFICATION_HANDLE_ASYNC_IO_QUEUE_DEPTH		16
 
 /* Creates a verification handle
  * Make sure the value verification_handle is referencing, is set to NULL
@@ -129,6 +131,24 @@ int verification_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The asynchronous IO is only used by the read-ahead of the input handle
+	 */
+	if( libewf_handle_set_async_io_queue_depth(
+	     ( *verification_handle )->input_handle,
+	     VERIFICATION_HANDLE_ASYNC_IO_QUEUE_DEPTH,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set asynchronous IO queue depth.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 #ifdef TODO
 	/* TODO: have application determine limit value and set to value - 4 */
 	if( libewf_handle_set_maximum_number_of_open_handles(
@@ -188,6 +208,20 @@ int verification_handle_initialize(
 
 		goto on_error;
 	}
+	( *verification_handle )->stored_sha256_tree_hash_string = system_string_allocate(
+								    65 );
+
+	if( ( *verification_handle )->stored_sha256_tree_hash_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stored SHA256 tree digest hash string.",
+		 function );
+
+		goto on_error;
+	}
 	( *verification_handle )->input_format             = VERIFICATION_HANDLE_INPUT_FORMAT_RAW;
 	( *verification_handle )->use_data_chunk_functions = use_data_chunk_functions;
 	( *verification_handle )->header_codepage          = LIBEWF_CODEPAGE_ASCII;
@@ -202,6 +236,16 @@ int verification_handle_initialize(
 on_error:
 	if( *verification_handle != NULL )
 	{
+		if( ( *verification_handle )->stored_sha256_tree_hash_string != NULL )
+		{
+			memory_free(
+			 ( *verification_handle )->stored_sha256_tree_hash_string );
+		}
+		if( ( *verification_handle )->stored_sha256_hash_string != NULL )
+		{
+			memory_free(
+			 ( *verification_handle )->stored_sha256_hash_string );
+		}
 		if( ( *verification_handle )->stored_sha1_hash_string != NULL )
 		{
 			memory_free(
@@ -296,7 +340,7 @@ int verification_handle_free(
 		}
 		if( ( *verification_handle )->sha1_context != NULL )
 		{
-			if( libhmac_sha1_free(
+			if( sha1_context_free(
 			     &( ( *verification_handle )->sha1_context ),
 			     error ) != 1 )
 			{
@@ -322,7 +366,7 @@ int verification_handle_free(
 		}
 		if( ( *verification_handle )->sha256_context != NULL )
 		{
-			if( libhmac_sha256_free(
+			if( sha256_context_free(
 			     &( ( *verification_handle )->sha256_context ),
 			     error ) != 1 )
 			{
@@ -346,6 +390,32 @@ int verification_handle_free(
 			memory_free(
 			 ( *verification_handle )->stored_sha256_hash_string );
 		}
+		if( ( *verification_handle )->sha256_tree_hash != NULL )
+		{
+			if( tree_hash_free(
+			     &( ( *verification_handle )->sha256_tree_hash ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 tree hash.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *verification_handle )->calculated_sha256_tree_hash_string != NULL )
+		{
+			memory_free(
+			 ( *verification_handle )->calculated_sha256_tree_hash_string );
+		}
+		if( ( *verification_handle )->stored_sha256_tree_hash_string != NULL )
+		{
+			memory_free(
+			 ( *verification_handle )->stored_sha256_tree_hash_string );
+		}
 		memory_free(
 		 *verification_handle );
 
@@ -690,10 +760,13 @@ int verification_handle_initialize_integrity_hash(
 		verification_handle->calculate_md5    = verification_handle->stored_md5_hash_available;
 		verification_handle->calculate_sha1   = verification_handle->stored_sha1_hash_available;
 		verification_handle->calculate_sha256 = verification_handle->stored_sha256_hash_available;
+
+		verification_handle->calculate_sha256_tree = (uint8_t) verification_handle->stored_sha256_tree_hash_available;
 	}
 	if( ( verification_handle->calculate_md5 == 0 )
 	 && ( verification_handle->calculate_sha1 == 0 )
-	 && ( verification_handle->calculate_sha256 == 0 ) )
+	 && ( verification_handle->calculate_sha256 == 0 )
+	 && ( verification_handle->calculate_sha256_tree == 0 ) )
 	{
 		verification_handle->calculate_md5 = 1;
 	}
@@ -716,8 +789,9 @@ int verification_handle_initialize_integrity_hash(
 	}
 	if( verification_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_initialize(
+		if( sha1_context_initialize(
 		     &( verification_handle->sha1_context ),
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -733,8 +807,9 @@ int verification_handle_initialize_integrity_hash(
 	}
 	if( verification_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_initialize(
+		if( sha256_context_initialize(
 		     &( verification_handle->sha256_context ),
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -748,12 +823,37 @@ int verification_handle_initialize_integrity_hash(
 		}
 		verification_handle->sha256_context_initialized = 1;
 	}
+	if( verification_handle->calculate_sha256_tree != 0 )
+	{
+		/* The blocks of the tree hash are the chunks of the image
+		 */
+		if( tree_hash_initialize(
+		     &( verification_handle->sha256_tree_hash ),
+		     (size_t) verification_handle->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 tree hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
+	if( verification_handle->sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &( verification_handle->sha256_context ),
+		 NULL );
+	}
 	if( verification_handle->sha1_context != NULL )
 	{
-		libhmac_sha1_free(
+		sha1_context_free(
 		 &( verification_handle->sha1_context ),
 		 NULL );
 	}
@@ -831,7 +931,7 @@ int verification_handle_update_integrity_hash(
 	}
 	if( verification_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_update(
+		if( sha1_context_update(
 		     verification_handle->sha1_context,
 		     buffer,
 		     buffer_size,
@@ -849,7 +949,7 @@ int verification_handle_update_integrity_hash(
 	}
 	if( verification_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_update(
+		if( sha256_context_update(
 		     verification_handle->sha256_context,
 		     buffer,
 		     buffer_size,
@@ -868,6 +968,66 @@ int verification_handle_update_integrity_hash(
 	return( 1 );
 }
 
+/* Updates the SHA256 tree hash
+ * The block hash of the storage media buffer is used when it was calculated by the process threads
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_update_tree_hash(
+     verification_handle_t *verification_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_update_tree_hash";
+	int result            = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->sha256_tree_hash == NULL )
+	{
+		return( 1 );
+	}
+	if( ( storage_media_buffer != NULL )
+	 && ( storage_media_buffer->has_block_hash != 0 ) )
+	{
+		result = tree_hash_update_block_hash(
+		          verification_handle->sha256_tree_hash,
+		          storage_media_buffer->block_hash,
+		          TREE_HASH_SIZE,
+		          error );
+	}
+	else
+	{
+		result = tree_hash_update(
+		          verification_handle->sha256_tree_hash,
+		          buffer,
+		          buffer_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update SHA256 tree hash.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Finalizes the integrity hash(es)
  * Returns 1 if successful or -1 on error
  */
@@ -878,6 +1038,7 @@ int verification_handle_finalize_integrity_hash(
 	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
 	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
 	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+	uint8_t calculated_sha256_tree_hash[ TREE_HASH_SIZE ];
 
 	static char *function = "verification_handle_finalize_integrity_hash";
 
@@ -925,6 +1086,17 @@ int verification_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+	if( verification_handle->calculated_sha256_tree_hash_string != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - calculated SHA256 tree digest hash string value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( verification_handle->calculate_md5 != 0 )
 	{
 		verification_handle->calculated_md5_hash_string = system_string_allocate(
@@ -1002,7 +1174,7 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_sha1_finalize(
+		if( sha1_context_finalize(
 		     verification_handle->sha1_context,
 		     calculated_sha1_hash,
 		     LIBHMAC_SHA1_HASH_SIZE,
@@ -1017,7 +1189,7 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_sha1_free(
+		if( sha1_context_free(
 		     &( verification_handle->sha1_context ),
 		     error ) != 1 )
 		{
@@ -1063,7 +1235,7 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_sha256_finalize(
+		if( sha256_context_finalize(
 		     verification_handle->sha256_context,
 		     calculated_sha256_hash,
 		     LIBHMAC_SHA256_HASH_SIZE,
@@ -1078,7 +1250,7 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_sha256_free(
+		if( sha256_context_free(
 		     &( verification_handle->sha256_context ),
 		     error ) != 1 )
 		{
@@ -1108,9 +1280,77 @@ int verification_handle_finalize_integrity_hash(
 			goto on_error;
 		}
 	}
+	if( verification_handle->calculate_sha256_tree != 0 )
+	{
+		verification_handle->calculated_sha256_tree_hash_string = system_string_allocate(
+		                                                           65 );
+
+		if( verification_handle->calculated_sha256_tree_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create calculated SHA256 tree digest hash string.",
+			 function );
+
+			goto on_error;
+		}
+		if( tree_hash_finalize(
+		     verification_handle->sha256_tree_hash,
+		     calculated_sha256_tree_hash,
+		     TREE_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 tree hash.",
+			 function );
+
+			goto on_error;
+		}
+		if( tree_hash_free(
+		     &( verification_handle->sha256_tree_hash ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 tree hash.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_tree_hash,
+		     TREE_HASH_SIZE,
+		     verification_handle->calculated_sha256_tree_hash_string,
+		     65,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 tree hash string.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
+	if( verification_handle->calculated_sha256_tree_hash_string != NULL )
+	{
+		memory_free(
+		 verification_handle->calculated_sha256_tree_hash_string );
+
+		verification_handle->calculated_sha256_tree_hash_string = NULL;
+	}
 	if( verification_handle->calculated_sha256_hash_string != NULL )
 	{
 		memory_free(
@@ -1146,7 +1386,9 @@ int verification_handle_process_storage_media_buffer_callback(
      verification_handle_t *verification_handle )
 {
         libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
         static char *function    = "verification_handle_process_storage_media_buffer_callback";
+	size_t data_size         = 0;
 	ssize_t process_count    = 0;
 
 	if( storage_media_buffer == NULL )
@@ -1185,6 +1427,50 @@ int verification_handle_process_storage_media_buffer_callback(
 
 		storage_media_buffer->is_corrupted = 1;
 	}
+	storage_media_buffer->has_block_hash = 0;
+
+	/* The block hash can only be calculated here if the storage media buffer contains
+	 * exactly one block of the tree hash, otherwise the data is hashed by the output thread
+	 */
+	if( ( verification_handle->sha256_tree_hash != NULL )
+	 && ( storage_media_buffer->is_corrupted == 0 )
+	 && ( ( storage_media_buffer->storage_media_offset % verification_handle->chunk_size ) == 0 )
+	 && ( ( storage_media_buffer->processed_size == (size_t) verification_handle->chunk_size )
+	  || ( ( (size64_t) storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size ) == verification_handle->media_size ) ) )
+	{
+		if( storage_media_buffer_get_data(
+		     storage_media_buffer,
+		     &data,
+		     &data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine storage media buffer data.",
+			 function );
+
+			goto on_error;
+		}
+		if( tree_hash_calculate_block_hash(
+		     data,
+		     storage_media_buffer->processed_size,
+		     storage_media_buffer->block_hash,
+		     TREE_HASH_SIZE,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate block hash.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer->has_block_hash = 1;
+	}
 	if( libcthreads_thread_pool_push(
 	     verification_handle->output_thread_pool,
 	     (intptr_t *) storage_media_buffer,
@@ -1252,13 +1538,11 @@ int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-	uint8_t *data                         = NULL;
-        static char *function                 = "verification_handle_process_storage_media_buffer_callback";
-	size_t data_size                      = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+        static char *function    = "verification_handle_process_storage_media_buffer_callback";
+	size_t data_size         = 0;
+	int result               = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1286,72 +1570,43 @@ int verification_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     verification_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_ring_insert_buffer(
+	     verification_handle->output_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output ring.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		goto on_error;
-	}
-	while( element != NULL )
+	/* Handle the storage media buffers that are next in sequence
+	 */
+	while( verification_handle->abort == 0 )
 	{
-		if( verification_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			storage_media_buffer = NULL;
+		result = storage_media_buffer_ring_remove_next_buffer(
+		          verification_handle->output_ring,
+		          &storage_media_buffer,
+		          &error );
 
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove next storage media buffer from output ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
+		else if( result == 0 )
 		{
 			break;
 		}
@@ -1368,8 +1623,6 @@ int verification_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine if storage media buffer is corrupted.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		else if( result != 0 )
@@ -1389,8 +1642,6 @@ int verification_handle_output_storage_media_buffer_callback(
 				 "%s: unable to append read error.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -1407,12 +1658,11 @@ int verification_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( verification_handle_update_integrity_hash(
+		if( verification_handle_update_tree_hash(
 		     verification_handle,
+		     storage_media_buffer,
 		     data,
 		     storage_media_buffer->processed_size,
 		     &error ) != 1 )
@@ -1421,64 +1671,46 @@ int verification_handle_output_storage_media_buffer_callback(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
+			 "%s: unable to update tree hash.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		if( verification_handle->digest_hash_threads != NULL )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
+			if( digest_hash_threads_push_buffer(
+			     verification_handle->digest_hash_threads,
+			     storage_media_buffer,
+			     data,
+			     storage_media_buffer->processed_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto digest hash threads.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
+		else if( verification_handle_update_integrity_hash(
+		          verification_handle,
+		          data,
+		          storage_media_buffer->processed_size,
+		          &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash(es).",
 			 function );
 
 			goto on_error;
 		}
-		element = next_element;
+		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
 		if( storage_media_buffer_queue_release_buffer(
 		     verification_handle->storage_media_buffer_queue,
@@ -1555,17 +1787,17 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output ring
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_empty_output_list(
+int verification_handle_empty_output_ring(
      verification_handle_t *verification_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "verification_handle_empty_output_list";
+        static char *function                        = "verification_handle_empty_output_ring";
+	int buffer_index                             = 0;
+	int result                                   = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1578,46 +1810,42 @@ int verification_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( verification_handle->output_ring == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing output ring.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	for( buffer_index = 0;
+	     buffer_index < verification_handle->output_ring->number_of_buffers;
+	     buffer_index++ )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
+		result = storage_media_buffer_ring_remove_buffer_by_index(
+		          verification_handle->output_ring,
+		          buffer_index,
+		          &storage_media_buffer,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer: %d from output ring.",
+			 function,
+			 buffer_index );
 
 			return( -1 );
 		}
-		if( storage_media_buffer == NULL )
+		else if( result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
+			continue;
 		}
 		if( storage_media_buffer_queue_release_buffer(
 		     verification_handle->storage_media_buffer_queue,
@@ -1634,52 +1862,6 @@ int verification_handle_empty_output_list(
 			return( -1 );
 		}
 		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			return( -1 );
-		}
-		element = next_element;
 	}
 	return( 1 );
 }
@@ -1710,11 +1892,18 @@ int verification_handle_verify_input(
 	int is_corrupted                             = 0;
 	int maximum_number_of_queued_items           = 0;
 	int md5_hash_compare                         = 0;
+	int number_of_read_ahead_chunks              = 0;
+	int number_of_read_ahead_threads             = 0;
 	int result                                   = 0;
 	int sha1_hash_compare                        = 0;
 	int sha256_hash_compare                      = 0;
+	int sha256_tree_hash_compare                 = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	uint64_t sequence_number                     = 0;
+#endif
+
 	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
@@ -1806,6 +1995,42 @@ int verification_handle_verify_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( verification_handle->number_of_threads != 0 )
 	{
+		/* In buffered mode the input chunks are unpacked by the input handle on the reading thread,
+		 * hence the input handle reads ahead and unpacks the next chunks on the same number of threads
+		 */
+		if( storage_media_buffer_mode == STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+		{
+			if( libewf_handle_get_read_ahead_values(
+			     verification_handle->input_handle,
+			     &number_of_read_ahead_chunks,
+			     &number_of_read_ahead_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve read-ahead values.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_handle_set_read_ahead_values(
+			     verification_handle->input_handle,
+			     number_of_read_ahead_chunks,
+			     verification_handle->number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set read-ahead values.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		maximum_number_of_queued_items = 1 + (int) ( VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
 
 		if( libcthreads_thread_pool_create(
@@ -1844,15 +2069,16 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( verification_handle->output_list ),
+		if( storage_media_buffer_ring_initialize(
+		     &( verification_handle->output_ring ),
+		     maximum_number_of_queued_items,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output ring.",
 			 function );
 
 			goto on_error;
@@ -1906,6 +2132,34 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_handle->number_of_threads != 0 )
+	 && ( ( verification_handle->calculate_md5 != 0 )
+	  || ( verification_handle->calculate_sha1 != 0 )
+	  || ( verification_handle->calculate_sha256 != 0 ) ) )
+	{
+		if( digest_hash_threads_initialize(
+		     &( verification_handle->digest_hash_threads ),
+		     verification_handle->md5_context,
+		     verification_handle->sha1_context,
+		     verification_handle->sha256_context,
+		     NULL,
+		     verification_handle->storage_media_buffer_queue,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	if( process_status_initialize(
 	     &( verification_handle->process_status ),
 	     _SYSTEM_STRING( "Verify" ),
@@ -2037,6 +2291,12 @@ int verification_handle_verify_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
+			/* The sequence number is used to write the buffers in order after processing
+			 */
+			storage_media_buffer->sequence_number = sequence_number;
+
+			sequence_number += 1;
+
 			if( libcthreads_thread_pool_push(
 			     verification_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -2142,6 +2402,22 @@ int verification_handle_verify_input(
 
 				goto on_error;
 			}
+			if( verification_handle_update_tree_hash(
+			     verification_handle,
+			     storage_media_buffer,
+			     data,
+			     storage_media_buffer->processed_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to update tree hash.",
+				 function );
+
+				goto on_error;
+			}
 			verification_handle->last_offset_hashed += (off64_t) process_count;
 
 			if( process_status_update(
@@ -2210,9 +2486,9 @@ int verification_handle_verify_input(
 			goto on_error;
 		}
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_ring != NULL )
 	{
-		if( verification_handle_empty_output_list(
+		if( verification_handle_empty_output_ring(
 		     verification_handle,
 		     error ) != 1 )
 		{
@@ -2220,21 +2496,49 @@ int verification_handle_verify_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( verification_handle->output_list ),
-		     NULL,
+		if( storage_media_buffer_ring_free(
+		     &( verification_handle->output_ring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output ring.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->digest_hash_threads != NULL )
+	{
+		if( digest_hash_threads_join(
+		     verification_handle->digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_hash_threads_free(
+		     &( verification_handle->digest_hash_threads ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free digest hash threads.",
 			 function );
 
 			goto on_error;
@@ -2454,13 +2758,22 @@ int verification_handle_verify_input(
 		                       verification_handle->calculated_sha256_hash_string,
 		                       65 );
 	}
+	if( ( verification_handle->calculate_sha256_tree != 0 )
+	 && ( verification_handle->stored_sha256_tree_hash_available != 0 ) )
+	{
+		sha256_tree_hash_compare = system_string_compare(
+		                            verification_handle->stored_sha256_tree_hash_string,
+		                            verification_handle->calculated_sha256_tree_hash_string,
+		                            65 );
+	}
 	/* Note that a set of EWF files can be verified without an integrity hash
 	 */
 	if( ( is_corrupted == 0 )
 	 && ( number_of_checksum_errors == 0 )
 	 && ( md5_hash_compare == 0 )
 	 && ( sha1_hash_compare == 0 )
-	 && ( sha256_hash_compare == 0 ) )
+	 && ( sha256_hash_compare == 0 )
+	 && ( sha256_tree_hash_compare == 0 ) )
 	{
 		return( 1 );
 	}
@@ -2498,14 +2811,19 @@ on_error:
 		 &( verification_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_ring != NULL )
 	{
-		verification_handle_empty_output_list(
+		verification_handle_empty_output_ring(
 		 verification_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( verification_handle->output_list ),
-		 NULL,
+		storage_media_buffer_ring_free(
+		 &( verification_handle->output_ring ),
+		 NULL );
+	}
+	if( verification_handle->digest_hash_threads != NULL )
+	{
+		digest_hash_threads_free(
+		 &( verification_handle->digest_hash_threads ),
 		 NULL );
 	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
@@ -3020,6 +3338,22 @@ int verification_handle_verify_file_entry(
 
 					goto on_error;
 				}
+				if( verification_handle_update_tree_hash(
+				     verification_handle,
+				     NULL,
+				     file_entry_data,
+				     read_count,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to update tree hash.",
+					 function );
+
+					goto on_error;
+				}
 			}
 			memory_free(
 			 file_entry_data );
@@ -3352,6 +3686,17 @@ int verification_handle_get_integrity_hash_from_input(
 
 		return( -1 );
 	}
+	if( verification_handle->stored_sha256_tree_hash_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing stored SHA256 tree hash string.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( USE_LIBEWF_GET_MD5_HASH )
 	result = libewf_handle_get_md5_hash(
 		  verification_handle->input_handle,
@@ -3480,6 +3825,36 @@ int verification_handle_get_integrity_hash_from_input(
 	}
 	verification_handle->stored_sha256_hash_available = result;
 
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_get_utf16_hash_value(
+		  verification_handle->input_handle,
+		  (uint8_t *) "SHA256-TREE",
+		  11,
+		  (uint16_t *) verification_handle->stored_sha256_tree_hash_string,
+		  65,
+		  error );
+#else
+	result = libewf_handle_get_utf8_hash_value(
+		  verification_handle->input_handle,
+		  (uint8_t *) "SHA256-TREE",
+		  11,
+		  (uint8_t *) verification_handle->stored_sha256_tree_hash_string,
+		  65,
+		  error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine stored SHA256 tree hash string.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->stored_sha256_tree_hash_available = result;
+
 	return( 1 );
 }
 
@@ -3546,6 +3921,8 @@ int verification_handle_get_integrity_hash_from_file_entry(
 
 	verification_handle->stored_sha256_hash_available = 0;
 
+	verification_handle->stored_sha256_tree_hash_available = 0;
+
 	return( 1 );
 }
 
@@ -3795,6 +4172,7 @@ int verification_handle_set_digest_types(
 	uint8_t calculate_md5                            = 0;
 	uint8_t calculate_sha1                           = 0;
 	uint8_t calculate_sha256                         = 0;
+	uint8_t calculate_sha256_tree                    = 0;
 	int number_of_segments                           = 0;
 	int result                                       = 0;
 	int segment_index                                = 0;
@@ -4020,6 +4398,23 @@ int verification_handle_set_digest_types(
 				calculate_sha256 = 1;
 			}
 		}
+		else if( string_segment_size == 12 )
+		{
+			if( system_string_compare(
+			     string_segment,
+			     _SYSTEM_STRING( "sha256-tree" ),
+			     11 ) == 0 )
+			{
+				calculate_sha256_tree = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "SHA256-TREE" ),
+			          11 ) == 0 )
+			{
+				calculate_sha256_tree = 1;
+			}
+		}
 	}
 	if( ( calculate_md5 != 0 )
 	 && ( verification_handle->calculate_md5 == 0 ) )
@@ -4036,6 +4431,11 @@ int verification_handle_set_digest_types(
 	{
 		verification_handle->calculate_sha256 = 1;
 	}
+	if( ( calculate_sha256_tree != 0 )
+	 && ( verification_handle->calculate_sha256_tree == 0 ) )
+	{
+		verification_handle->calculate_sha256_tree = 1;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libcsplit_wide_split_string_free(
 	     &string_elements,
@@ -4268,6 +4668,26 @@ int verification_handle_hash_values_fprint(
 		 "SHA256 hash calculated over data:\t%" PRIs_SYSTEM "\n",
 		 verification_handle->calculated_sha256_hash_string );
 	}
+	if( verification_handle->calculate_sha256_tree != 0 )
+	{
+		if( verification_handle->stored_sha256_tree_hash_available == 0 )
+		{
+			fprintf(
+			 stream,
+			 "SHA256 tree hash stored in file:\tN/A\n" );
+		}
+		else
+		{
+			fprintf(
+			 stream,
+			 "SHA256 tree hash stored in file:\t%" PRIs_SYSTEM "\n",
+			 verification_handle->stored_sha256_tree_hash_string );
+		}
+		fprintf(
+		 stream,
+		 "SHA256 tree hash calculated over data:\t%" PRIs_SYSTEM "\n",
+		 verification_handle->calculated_sha256_tree_hash_string );
+	}
 	return( 1 );
 }
 
@@ -4420,6 +4840,19 @@ int verification_handle_additional_hash_values_fprint(
 				}
 			}
 		}
+		if( verification_handle->calculate_sha256_tree != 0 )
+		{
+			if( hash_value_identifier_size == 12 )
+			{
+				if( narrow_string_compare(
+				     hash_value_identifier,
+				     "SHA256-TREE",
+				     11 ) == 0 )
+				{
+					continue;
+				}
+			}
+		}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 		if( libewf_handle_get_utf16_hash_value(
 		     verification_handle->input_handle,
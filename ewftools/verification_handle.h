@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_threads.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -33,7 +34,11 @@
 #include "ewftools_libhmac.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
+#include "tree_hash.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -91,7 +96,7 @@ struct verification_handle
 
 	/* The SHA1 digest context
 	 */
-	libhmac_sha1_context_t *sha1_context;
+	sha1_context_t *sha1_context;
 
 	/* Value to indicate the SHA1 digest context was initialized
 	 */
@@ -115,7 +120,7 @@ struct verification_handle
 
 	/* The SHA256 digest context
 	 */
-	libhmac_sha256_context_t *sha256_context;
+	sha256_context_t *sha256_context;
 
 	/* Value to indicate the SHA256 digest context was initialized
 	 */
@@ -133,6 +138,26 @@ struct verification_handle
 	 */
 	system_character_t *stored_sha256_hash_string;
 
+	/* Value to indicate if the SHA256 tree digest hash should be calculated
+	 */
+	uint8_t calculate_sha256_tree;
+
+	/* The SHA256 tree hash
+	 */
+	tree_hash_t *sha256_tree_hash;
+
+	/* The calculated SHA256 tree digest hash string
+	 */
+	system_character_t *calculated_sha256_tree_hash_string;
+
+	/* Value to indicate a stored SHA256 tree digest hash is available
+	 */
+	int stored_sha256_tree_hash_available;
+
+	/* The stored SHA256 tree digest hash string
+	 */
+	system_character_t *stored_sha256_tree_hash_string;
+
 	/* Value to indicate if the data chunk functions instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_data_chunk_functions;
@@ -155,14 +180,18 @@ struct verification_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output ring
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_ring_t *output_ring;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash threads
+	 */
+	digest_hash_threads_t *digest_hash_threads;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
@@ -255,7 +284,7 @@ int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
 
-int verification_handle_empty_output_list(
+int verification_handle_empty_output_ring(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
 
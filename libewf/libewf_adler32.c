@@ -0,0 +1,985 @@
+/*
+ * Adler-32 functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_adler32.h"
+#include "libewf_libcerror.h"
+
+#if defined( LIBEWF_ADLER32_HAVE_SSE2 ) || defined( LIBEWF_ADLER32_HAVE_AVX2 )
+#include <immintrin.h>
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 ) && defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+#include <arm_neon.h>
+#endif
+
+/* The Adler-32 modulus
+ */
+#define LIBEWF_ADLER32_MODULUS		65521
+
+/* The maximum number of bytes that can be processed before the sums
+ * must be reduced, to prevent 32-bit overflow
+ */
+#define LIBEWF_ADLER32_MAXIMUM_BLOCK_SIZE	5552
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 ) && defined( __GNUC__ )
+#define LIBEWF_ADLER32_TARGET_AVX2	__attribute__((target("avx2")))
+#else
+#define LIBEWF_ADLER32_TARGET_AVX2
+#endif
+
+/* The Adler-32 calculate function, determined on first use
+ */
+static libewf_adler32_calculate_function_t libewf_adler32_calculate_function = NULL;
+
+/* Calculates the little-endian Adler-32 of a buffer
+ * It uses the initial value to calculate a new Adler-32
+ * This is the reference implementation used when no vectorized implementation is available
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_adler32_calculate_scalar(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_adler32_calculate_scalar";
+	size_t data_offset    = 0;
+	uint32_t lower_word   = 0;
+	uint32_t upper_word   = 0;
+	uint32_t value_32bit  = 0;
+	int block_index       = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( data_size >= 0x15b0 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 16 = 347
+		 */
+		for( block_index = 0;
+		     block_index < 347;
+		     block_index++ )
+		{
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+		}
+		/* Optimized equivalent of:
+		 * lower_word %= 0xfff1
+		 */
+		value_32bit = lower_word >> 16;
+		lower_word &= 0x0000ffffUL;
+		lower_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( lower_word > 65521 )
+		{
+			value_32bit = lower_word >> 16;
+			lower_word &= 0x0000ffffUL;
+			lower_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( lower_word >= 65521 )
+		{
+			lower_word -= 65521;
+		}
+		/* Optimized equivalent of:
+		 * upper_word %= 0xfff1
+		 */
+		value_32bit = upper_word >> 16;
+		upper_word &= 0x0000ffffUL;
+		upper_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( upper_word > 65521 )
+		{
+			value_32bit = upper_word >> 16;
+			upper_word &= 0x0000ffffUL;
+			upper_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( upper_word >= 65521 )
+		{
+			upper_word -= 65521;
+		}
+		data_size -= 0x15b0;
+	}
+	if( data_size > 0 )
+	{
+		while( data_size > 16 )
+		{
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			data_size -= 16;
+		}
+		while( data_size > 0 )
+		{
+			lower_word += data[ data_offset++ ];
+			upper_word += lower_word;
+
+			data_size--;
+		}
+		/* Optimized equivalent of:
+		 * lower_word %= 0xfff1
+		 */
+		value_32bit = lower_word >> 16;
+		lower_word &= 0x0000ffffUL;
+		lower_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( lower_word > 65521 )
+		{
+			value_32bit = lower_word >> 16;
+			lower_word &= 0x0000ffffUL;
+			lower_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( lower_word >= 65521 )
+		{
+			lower_word -= 65521;
+		}
+		/* Optimized equivalent of:
+		 * upper_word %= 0xfff1
+		 */
+		value_32bit = upper_word >> 16;
+		upper_word &= 0x0000ffffUL;
+		upper_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( upper_word > 65521 )
+		{
+			value_32bit = upper_word >> 16;
+			upper_word &= 0x0000ffffUL;
+			upper_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( upper_word >= 65521 )
+		{
+			upper_word -= 65521;
+		}
+	}
+	*checksum_value = ( upper_word << 16 ) | lower_word;
+
+	return( 1 );
+}
+
+#if defined( LIBEWF_ADLER32_HAVE_SSE2 )
+
+/* Calculates the little-endian Adler-32 of a buffer using SSE2
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_adler32_calculate_sse2(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m128i block_data          = _mm_setzero_si128();
+	__m128i lower_sums          = _mm_setzero_si128();
+	__m128i prefix_sums         = _mm_setzero_si128();
+	__m128i upper_sums          = _mm_setzero_si128();
+	__m128i zero_vector         = _mm_setzero_si128();
+	__m128i high_weights        = _mm_setr_epi16( 16, 15, 14, 13, 12, 11, 10, 9 );
+	__m128i low_weights         = _mm_setr_epi16( 8, 7, 6, 5, 4, 3, 2, 1 );
+	static char *function       = "libewf_adler32_calculate_sse2";
+	size_t block_size           = 0;
+	size_t number_of_blocks     = 0;
+	uint32_t lower_word         = 0;
+	uint32_t upper_word         = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( data_size >= 16 )
+	{
+		block_size = data_size;
+
+		if( block_size > LIBEWF_ADLER32_MAXIMUM_BLOCK_SIZE )
+		{
+			block_size = LIBEWF_ADLER32_MAXIMUM_BLOCK_SIZE;
+		}
+		block_size &= ~( (size_t) 15 );
+		data_size  -= block_size;
+
+		/* Every byte in the block adds the lower word to the upper word
+		 */
+		upper_word += lower_word * (uint32_t) block_size;
+
+		lower_sums  = _mm_setzero_si128();
+		prefix_sums = _mm_setzero_si128();
+		upper_sums  = _mm_setzero_si128();
+
+		for( number_of_blocks = block_size / 16;
+		     number_of_blocks > 0;
+		     number_of_blocks-- )
+		{
+			/* The sum of the bytes of the preceding 16-byte blocks contributes
+			 * 16 times to the upper word
+			 */
+			prefix_sums = _mm_add_epi32(
+			               prefix_sums,
+			               lower_sums );
+
+			block_data = _mm_loadu_si128(
+			              (const __m128i *) data );
+
+			lower_sums = _mm_add_epi32(
+			              lower_sums,
+			              _mm_sad_epu8(
+			               block_data,
+			               zero_vector ) );
+
+			upper_sums = _mm_add_epi32(
+			              upper_sums,
+			              _mm_madd_epi16(
+			               _mm_unpacklo_epi8(
+			                block_data,
+			                zero_vector ),
+			               high_weights ) );
+
+			upper_sums = _mm_add_epi32(
+			              upper_sums,
+			              _mm_madd_epi16(
+			               _mm_unpackhi_epi8(
+			                block_data,
+			                zero_vector ),
+			               low_weights ) );
+
+			data += 16;
+		}
+		upper_sums = _mm_add_epi32(
+		              upper_sums,
+		              _mm_slli_epi32(
+		               prefix_sums,
+		               4 ) );
+
+		/* Add the 32-bit lanes horizontally
+		 */
+		lower_sums = _mm_add_epi32(
+		              lower_sums,
+		              _mm_shuffle_epi32(
+		               lower_sums,
+		               _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_sums = _mm_add_epi32(
+		              lower_sums,
+		              _mm_shuffle_epi32(
+		               lower_sums,
+		               _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		upper_sums = _mm_add_epi32(
+		              upper_sums,
+		              _mm_shuffle_epi32(
+		               upper_sums,
+		               _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		upper_sums = _mm_add_epi32(
+		              upper_sums,
+		              _mm_shuffle_epi32(
+		               upper_sums,
+		               _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32(
+		                          lower_sums );
+
+		upper_word += (uint32_t) _mm_cvtsi128_si32(
+		                          upper_sums );
+
+		lower_word %= LIBEWF_ADLER32_MODULUS;
+		upper_word %= LIBEWF_ADLER32_MODULUS;
+	}
+	/* Calculate the Adler-32 of the remaining data
+	 */
+	return( libewf_adler32_calculate_scalar(
+	         checksum_value,
+	         data,
+	         data_size,
+	         ( upper_word << 16 ) | lower_word,
+	         error ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_SSE2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+/* Determines if the CPU and operating system support AVX2
+ * Returns 1 if supported or 0 if not
+ */
+int libewf_adler32_cpu_supports_avx2(
+     void )
+{
+#if defined( _MSC_VER )
+	int cpu_information[ 4 ];
+
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	if( cpu_information[ 0 ] < 7 )
+	{
+		return( 0 );
+	}
+	__cpuid(
+	 cpu_information,
+	 1 );
+
+	/* Check if the operating system saves the YMM registers (OSXSAVE and AVX)
+	 */
+	if( ( ( cpu_information[ 2 ] & 0x18000000UL ) != 0x18000000UL )
+	 || ( ( _xgetbv( 0 ) & 0x06 ) != 0x06 ) )
+	{
+		return( 0 );
+	}
+	__cpuidex(
+	 cpu_information,
+	 7,
+	 0 );
+
+	if( ( cpu_information[ 1 ] & 0x00000020UL ) == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "avx2" ) == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#endif
+}
+
+/* Calculates the little-endian Adler-32 of a buffer using AVX2
+ * It uses the initial value to calculate a new Adler-32
+ * The CPU must support AVX2, see libewf_adler32_cpu_supports_avx2
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_ADLER32_TARGET_AVX2
+int libewf_adler32_calculate_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m256i block_data          = _mm256_setzero_si256();
+	__m256i lower_sums          = _mm256_setzero_si256();
+	__m256i prefix_sums         = _mm256_setzero_si256();
+	__m256i upper_sums          = _mm256_setzero_si256();
+	__m256i zero_vector         = _mm256_setzero_si256();
+	__m256i one_vector          = _mm256_set1_epi16( 1 );
+	__m256i weights             = _mm256_setr_epi8(
+	                               32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	                               16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	__m128i sums                = _mm_setzero_si128();
+	static char *function       = "libewf_adler32_calculate_avx2";
+	size_t block_size           = 0;
+	size_t number_of_blocks     = 0;
+	uint32_t lower_word         = 0;
+	uint32_t upper_word         = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( data_size >= 32 )
+	{
+		block_size = data_size;
+
+		if( block_size > LIBEWF_ADLER32_MAXIMUM_BLOCK_SIZE )
+		{
+			block_size = LIBEWF_ADLER32_MAXIMUM_BLOCK_SIZE;
+		}
+		block_size &= ~( (size_t) 31 );
+		data_size  -= block_size;
+
+		/* Every byte in the block adds the lower word to the upper word
+		 */
+		upper_word += lower_word * (uint32_t) block_size;
+
+		lower_sums  = _mm256_setzero_si256();
+		prefix_sums = _mm256_setzero_si256();
+		upper_sums  = _mm256_setzero_si256();
+
+		for( number_of_blocks = block_size / 32;
+		     number_of_blocks > 0;
+		     number_of_blocks-- )
+		{
+			/* The sum of the bytes of the preceding 32-byte blocks contributes
+			 * 32 times to the upper word
+			 */
+			prefix_sums = _mm256_add_epi32(
+			               prefix_sums,
+			               lower_sums );
+
+			block_data = _mm256_loadu_si256(
+			              (const __m256i *) data );
+
+			lower_sums = _mm256_add_epi32(
+			              lower_sums,
+			              _mm256_sad_epu8(
+			               block_data,
+			               zero_vector ) );
+
+			upper_sums = _mm256_add_epi32(
+			              upper_sums,
+			              _mm256_madd_epi16(
+			               _mm256_maddubs_epi16(
+			                block_data,
+			                weights ),
+			               one_vector ) );
+
+			data += 32;
+		}
+		upper_sums = _mm256_add_epi32(
+		              upper_sums,
+		              _mm256_slli_epi32(
+		               prefix_sums,
+		               5 ) );
+
+		/* Add the 32-bit lanes horizontally
+		 */
+		sums = _mm_add_epi32(
+		        _mm256_castsi256_si128(
+		         lower_sums ),
+		        _mm256_extracti128_si256(
+		         lower_sums,
+		         1 ) );
+
+		sums = _mm_add_epi32(
+		        sums,
+		        _mm_shuffle_epi32(
+		         sums,
+		         _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		sums = _mm_add_epi32(
+		        sums,
+		        _mm_shuffle_epi32(
+		         sums,
+		         _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32(
+		                          sums );
+
+		sums = _mm_add_epi32(
+		        _mm256_castsi256_si128(
+		         upper_sums ),
+		        _mm256_extracti128_si256(
+		         upper_sums,
+		         1 ) );
+
+		sums = _mm_add_epi32(
+		        sums,
+		        _mm_shuffle_epi32(
+		         sums,
+		         _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		sums = _mm_add_epi32(
+		        sums,
+		        _mm_shuffle_epi32(
+		         sums,
+		         _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		upper_word += (uint32_t) _mm_cvtsi128_si32(
+		                          sums );
+
+		lower_word %= LIBEWF_ADLER32_MODULUS;
+		upper_word %= LIBEWF_ADLER32_MODULUS;
+	}
+	/* Calculate the Adler-32 of the remaining data
+	 */
+	return( libewf_adler32_calculate_scalar(
+	         checksum_value,
+	         data,
+	         data_size,
+	         ( upper_word << 16 ) | lower_word,
+	         error ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+/* Calculates the little-endian Adler-32 of a buffer using NEON
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_adler32_calculate_neon(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	static const uint16_t weights[ 32 ] = {
+		32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+		16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+
+	uint8x16_t first_block_data  = vdupq_n_u8( 0 );
+	uint8x16_t second_block_data = vdupq_n_u8( 0 );
+	uint16x8_t column_sums1      = vdupq_n_u16( 0 );
+	uint16x8_t column_sums2      = vdupq_n_u16( 0 );
+	uint16x8_t column_sums3      = vdupq_n_u16( 0 );
+	uint16x8_t column_sums4      = vdupq_n_u16( 0 );
+	uint32x4_t lower_sums        = vdupq_n_u32( 0 );
+	uint32x4_t prefix_sums       = vdupq_n_u32( 0 );
+	uint32x4_t upper_sums        = vdupq_n_u32( 0 );
+	static char *function        = "libewf_adler32_calculate_neon";
+	size_t block_size            = 0;
+	size_t number_of_blocks      = 0;
+	uint32_t lower_word          = 0;
+	uint32_t upper_word          = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( data_size >= 32 )
+	{
+		block_size = data_size;
+
+		if( block_size > LIBEWF_ADLER32_MAXIMUM_BLOCK_SIZE )
+		{
+			block_size = LIBEWF_ADLER32_MAXIMUM_BLOCK_SIZE;
+		}
+		block_size &= ~( (size_t) 31 );
+		data_size  -= block_size;
+
+		/* Every byte in the block adds the lower word to the upper word
+		 */
+		upper_word += lower_word * (uint32_t) block_size;
+
+		column_sums1 = vdupq_n_u16( 0 );
+		column_sums2 = vdupq_n_u16( 0 );
+		column_sums3 = vdupq_n_u16( 0 );
+		column_sums4 = vdupq_n_u16( 0 );
+		lower_sums   = vdupq_n_u32( 0 );
+		prefix_sums  = vdupq_n_u32( 0 );
+
+		for( number_of_blocks = block_size / 32;
+		     number_of_blocks > 0;
+		     number_of_blocks-- )
+		{
+			/* The sum of the bytes of the preceding 32-byte blocks contributes
+			 * 32 times to the upper word
+			 */
+			prefix_sums = vaddq_u32(
+			               prefix_sums,
+			               lower_sums );
+
+			first_block_data  = vld1q_u8( data );
+			second_block_data = vld1q_u8( &( data[ 16 ] ) );
+
+			lower_sums = vpadalq_u16(
+			              lower_sums,
+			              vpadalq_u8(
+			               vpaddlq_u8(
+			                first_block_data ),
+			               second_block_data ) );
+
+			/* The per byte position sums are weighted after the block is processed
+			 */
+			column_sums1 = vaddw_u8(
+			                column_sums1,
+			                vget_low_u8(
+			                 first_block_data ) );
+
+			column_sums2 = vaddw_u8(
+			                column_sums2,
+			                vget_high_u8(
+			                 first_block_data ) );
+
+			column_sums3 = vaddw_u8(
+			                column_sums3,
+			                vget_low_u8(
+			                 second_block_data ) );
+
+			column_sums4 = vaddw_u8(
+			                column_sums4,
+			                vget_high_u8(
+			                 second_block_data ) );
+
+			data += 32;
+		}
+		upper_sums = vshlq_n_u32(
+		              prefix_sums,
+		              5 );
+
+		upper_sums = vmlal_u16(
+		              upper_sums,
+		              vget_low_u16(
+		               column_sums1 ),
+		              vld1_u16( &( weights[ 0 ] ) ) );
+
+		upper_sums = vmlal_u16(
+		              upper_sums,
+		              vget_high_u16(
+		               column_sums1 ),
+		              vld1_u16( &( weights[ 4 ] ) ) );
+
+		upper_sums = vmlal_u16(
+		              upper_sums,
+		              vget_low_u16(
+		               column_sums2 ),
+		              vld1_u16( &( weights[ 8 ] ) ) );
+
+		upper_sums = vmlal_u16(
+		              upper_sums,
+		              vget_high_u16(
+		               column_sums2 ),
+		              vld1_u16( &( weights[ 12 ] ) ) );
+
+		upper_sums = vmlal_u16(
+		              upper_sums,
+		              vget_low_u16(
+		               column_sums3 ),
+		              vld1_u16( &( weights[ 16 ] ) ) );
+
+		upper_sums = vmlal_u16(
+		              upper_sums,
+		              vget_high_u16(
+		               column_sums3 ),
+		              vld1_u16( &( weights[ 20 ] ) ) );
+
+		upper_sums = vmlal_u16(
+		              upper_sums,
+		              vget_low_u16(
+		               column_sums4 ),
+		              vld1_u16( &( weights[ 24 ] ) ) );
+
+		upper_sums = vmlal_u16(
+		              upper_sums,
+		              vget_high_u16(
+		               column_sums4 ),
+		              vld1_u16( &( weights[ 28 ] ) ) );
+
+		lower_word += vaddvq_u32(
+		               lower_sums );
+
+		upper_word += vaddvq_u32(
+		               upper_sums );
+
+		lower_word %= LIBEWF_ADLER32_MODULUS;
+		upper_word %= LIBEWF_ADLER32_MODULUS;
+	}
+	/* Calculate the Adler-32 of the remaining data
+	 */
+	return( libewf_adler32_calculate_scalar(
+	         checksum_value,
+	         data,
+	         data_size,
+	         ( upper_word << 16 ) | lower_word,
+	         error ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+/* Retrieves the fastest Adler-32 calculate function supported by the CPU
+ * The function is determined on first use, concurrent callers determine the same function
+ * Returns the calculate function
+ */
+libewf_adler32_calculate_function_t libewf_adler32_get_calculate_function(
+                                     void )
+{
+	libewf_adler32_calculate_function_t calculate_function = libewf_adler32_calculate_function;
+
+	if( calculate_function == NULL )
+	{
+		calculate_function = &libewf_adler32_calculate_scalar;
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+		calculate_function = &libewf_adler32_calculate_neon;
+#endif
+#if defined( LIBEWF_ADLER32_HAVE_SSE2 )
+		calculate_function = &libewf_adler32_calculate_sse2;
+#endif
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+		if( libewf_adler32_cpu_supports_avx2() != 0 )
+		{
+			calculate_function = &libewf_adler32_calculate_avx2;
+		}
+#endif
+		libewf_adler32_calculate_function = calculate_function;
+	}
+	return( calculate_function );
+}
+
+/* Calculates the little-endian Adler-32 of a buffer
+ * It uses the initial value to calculate a new Adler-32
+ * It uses the fastest implementation supported by the CPU
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_adler32_calculate(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	libewf_adler32_calculate_function_t calculate_function = NULL;
+	static char *function                                  = "libewf_adler32_calculate";
+
+	calculate_function = libewf_adler32_get_calculate_function();
+
+	if( calculate_function(
+	     checksum_value,
+	     data,
+	     data_size,
+	     initial_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate Adler-32.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,122 @@
+/*
+ * Adler-32 functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ADLER32_H )
+#define _LIBEWF_ADLER32_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The vectorized Adler-32 implementations that can be built with the compiler
+ */
+#if !defined( LIBEWF_ADLER32_DISABLE_SIMD )
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#define LIBEWF_ADLER32_HAVE_SSE2
+#endif
+
+#if ( defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( ( __GNUC__ >= 5 ) || defined( __clang__ ) ) ) \
+ || ( defined( _MSC_VER ) && ( _MSC_VER >= 1900 ) && defined( _M_X64 ) )
+#define LIBEWF_ADLER32_HAVE_AVX2
+#endif
+
+#if ( defined( __aarch64__ ) && defined( __ARM_NEON ) ) || defined( _M_ARM64 )
+#define LIBEWF_ADLER32_HAVE_NEON
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_SSE2 ) || defined( LIBEWF_ADLER32_HAVE_AVX2 ) || defined( LIBEWF_ADLER32_HAVE_NEON )
+#define LIBEWF_ADLER32_HAVE_SIMD
+#endif
+
+#endif /* !defined( LIBEWF_ADLER32_DISABLE_SIMD ) */
+
+typedef int (*libewf_adler32_calculate_function_t)(
+               uint32_t *checksum_value,
+               const uint8_t *data,
+               size_t data_size,
+               uint32_t initial_value,
+               libcerror_error_t **error );
+
+int libewf_adler32_calculate_scalar(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#if defined( LIBEWF_ADLER32_HAVE_SSE2 )
+
+int libewf_adler32_calculate_sse2(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_SSE2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+int libewf_adler32_cpu_supports_avx2(
+     void );
+
+int libewf_adler32_calculate_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+int libewf_adler32_calculate_neon(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+libewf_adler32_calculate_function_t libewf_adler32_get_calculate_function(
+                                     void );
+
+int libewf_adler32_calculate(
+     uint32_t *checksum_value,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ADLER32_H ) */
+
@@ -0,0 +1,818 @@
+/*
+ * Asynchronous IO functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_async_io.h"
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+
+#include <errno.h>
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#endif /* defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT ) */
+
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+
+/* Creates asynchronous IO
+ * Make sure the value async_io is referencing, is set to NULL
+ * Returns 1 if successful, 0 if asynchronous IO is not supported or -1 on error
+ */
+int libewf_async_io_initialize(
+     libewf_async_io_t **async_io,
+     int number_of_files,
+     int queue_depth,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_async_io_initialize";
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	size_t file_descriptors_size = 0;
+	int file_index               = 0;
+#endif
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_io != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous IO value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_files <= 0 )
+	 || ( (size_t) number_of_files > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( int ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of files value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth <= 0 )
+	 || ( queue_depth > LIBEWF_ASYNC_IO_MAXIMUM_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	*async_io = memory_allocate_structure(
+	             libewf_async_io_t );
+
+	if( *async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create asynchronous IO.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *async_io,
+	     0,
+	     sizeof( libewf_async_io_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear asynchronous IO.",
+		 function );
+
+		memory_free(
+		 *async_io );
+
+		*async_io = NULL;
+
+		return( -1 );
+	}
+	file_descriptors_size = sizeof( int ) * (size_t) number_of_files;
+
+	( *async_io )->file_descriptors = (int *) memory_allocate(
+	                                           file_descriptors_size );
+
+	if( ( *async_io )->file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	for( file_index = 0;
+	     file_index < number_of_files;
+	     file_index++ )
+	{
+		( *async_io )->file_descriptors[ file_index ] = -1;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *async_io )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	/* The io_uring setup fails if the kernel does not support io_uring
+	 * or if it has been disabled, in which case synchronous IO is used
+	 */
+	if( io_uring_queue_init(
+	     (unsigned int) queue_depth,
+	     &( ( *async_io )->ring ),
+	     0 ) != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to initialize io_uring, asynchronous IO is not used.\n",
+			 function );
+		}
+#endif
+		libcthreads_mutex_free(
+		 &( ( *async_io )->mutex ),
+		 NULL );
+
+		memory_free(
+		 ( *async_io )->file_descriptors );
+
+		memory_free(
+		 *async_io );
+
+		*async_io = NULL;
+
+		return( 0 );
+	}
+	( *async_io )->queue_depth     = queue_depth;
+	( *async_io )->number_of_files = number_of_files;
+
+	return( 1 );
+
+on_error:
+	if( *async_io != NULL )
+	{
+		if( ( *async_io )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *async_io )->mutex ),
+			 NULL );
+		}
+		if( ( *async_io )->file_descriptors != NULL )
+		{
+			memory_free(
+			 ( *async_io )->file_descriptors );
+		}
+		memory_free(
+		 *async_io );
+
+		*async_io = NULL;
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT ) */
+}
+
+/* Frees asynchronous IO
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_io_free(
+     libewf_async_io_t **async_io,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_io_free";
+	int result            = 1;
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	int file_index        = 0;
+#endif
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_io != NULL )
+	{
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+		io_uring_queue_exit(
+		 &( ( *async_io )->ring ) );
+
+		for( file_index = 0;
+		     file_index < ( *async_io )->number_of_files;
+		     file_index++ )
+		{
+			if( ( *async_io )->file_descriptors[ file_index ] != -1 )
+			{
+				if( close(
+				     ( *async_io )->file_descriptors[ file_index ] ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+					 "%s: unable to close file: %d.",
+					 function,
+					 file_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *async_io )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif /* defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT ) */
+
+		if( ( *async_io )->file_descriptors != NULL )
+		{
+			memory_free(
+			 ( *async_io )->file_descriptors );
+		}
+		memory_free(
+		 *async_io );
+
+		*async_io = NULL;
+	}
+	return( result );
+}
+
+/* Opens a file read-only for asynchronous reads
+ * Returns 1 if successful, 0 if the file could not be opened or -1 on error
+ */
+int libewf_async_io_open_file(
+     libewf_async_io_t *async_io,
+     int file_index,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_io_open_file";
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_io->file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid asynchronous IO - missing file descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_index < 0 )
+	 || ( file_index >= async_io->number_of_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_io->file_descriptors[ file_index ] != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file: %d value already set.",
+		 function,
+		 file_index );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	async_io->file_descriptors[ file_index ] = open(
+	                                            filename,
+	                                            O_RDONLY );
+
+	if( async_io->file_descriptors[ file_index ] == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+
+/* Cancels the reads in flight and waits for their completions
+ * The queued submission queue entries that were not submitted are replaced by no-operations
+ * This function is not multi-thread safe, the mutex must be grabbed by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_io_cancel_reads(
+     libewf_async_io_t *async_io,
+     struct io_uring_sqe **queued_submission_queue_entries,
+     int number_of_queued_reads,
+     int number_of_reads_in_flight,
+     libcerror_error_t **error )
+{
+	libewf_async_io_request_t *request          = NULL;
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	static char *function                       = "libewf_async_io_cancel_reads";
+	int entry_index                             = 0;
+	int result                                  = 1;
+	int submit_result                           = 0;
+	int wait_result                             = 0;
+
+#if defined( IORING_ASYNC_CANCEL_ANY )
+	struct io_uring_sqe *submission_queue_entry = NULL;
+#endif
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_queued_reads > 0 )
+	 && ( queued_submission_queue_entries == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queued submission queue entries.",
+		 function );
+
+		return( -1 );
+	}
+	/* The queued reads that were not submitted are not allowed to reach the kernel
+	 * after the buffers were handed back, hence they are turned into no-operations
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_queued_reads;
+	     entry_index++ )
+	{
+		io_uring_prep_nop(
+		 queued_submission_queue_entries[ entry_index ] );
+
+		io_uring_sqe_set_data(
+		 queued_submission_queue_entries[ entry_index ],
+		 NULL );
+	}
+#if defined( IORING_ASYNC_CANCEL_ANY )
+	if( number_of_reads_in_flight > 0 )
+	{
+		submission_queue_entry = io_uring_get_sqe(
+		                          &( async_io->ring ) );
+
+		/* If no submission queue entry is available the reads in flight
+		 * are not cancelled but their completion is still waited for
+		 */
+		if( submission_queue_entry != NULL )
+		{
+			io_uring_prep_cancel(
+			 submission_queue_entry,
+			 NULL,
+			 IORING_ASYNC_CANCEL_ANY );
+
+			io_uring_sqe_set_data(
+			 submission_queue_entry,
+			 NULL );
+
+			number_of_queued_reads++;
+		}
+	}
+#endif /* defined( IORING_ASYNC_CANCEL_ANY ) */
+
+	while( number_of_queued_reads > 0 )
+	{
+		submit_result = io_uring_submit(
+		                 &( async_io->ring ) );
+
+		if( submit_result == -EINTR )
+		{
+			continue;
+		}
+		if( submit_result <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to submit cancel request.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		number_of_queued_reads    -= submit_result;
+		number_of_reads_in_flight += submit_result;
+	}
+	while( number_of_reads_in_flight > 0 )
+	{
+		do
+		{
+			wait_result = io_uring_wait_cqe(
+			               &( async_io->ring ),
+			               &completion_queue_entry );
+		}
+		while( wait_result == -EINTR );
+
+		if( wait_result < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to wait for read completion.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_reads_in_flight--;
+
+		request = (libewf_async_io_request_t *) io_uring_cqe_get_data(
+		                                         completion_queue_entry );
+
+		if( request != NULL )
+		{
+			if( completion_queue_entry->res < 0 )
+			{
+				request->read_count = -1;
+			}
+			else
+			{
+				request->read_count = (ssize_t) completion_queue_entry->res;
+			}
+		}
+		io_uring_cqe_seen(
+		 &( async_io->ring ),
+		 completion_queue_entry );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT ) */
+
+/* Reads the buffers of the requests
+ * At most queue depth reads are kept in flight, the number of bytes read
+ * is set in each request and requests of files that are not opened are not processed
+ * On error the reads in flight are cancelled and completed before the buffers are handed back
+ * This function is multi-thread safe
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_io_read_buffers(
+     libewf_async_io_t *async_io,
+     libewf_async_io_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+	static char *function                       = "libewf_async_io_read_buffers";
+	int request_index                           = 0;
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	struct io_uring_sqe *submission_queue_entries[ LIBEWF_ASYNC_IO_MAXIMUM_QUEUE_DEPTH ];
+
+	libewf_async_io_request_t *request          = NULL;
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	struct io_uring_sqe *submission_queue_entry = NULL;
+	int file_descriptor                         = 0;
+	int number_of_queued_reads                  = 0;
+	int number_of_reads_in_flight               = 0;
+	int number_of_submissions                   = 0;
+	int result                                  = 1;
+	int submit_result                           = 0;
+	int wait_result                             = 0;
+#endif
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_requests < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of requests value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		requests[ request_index ].read_count = 0;
+	}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     async_io->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	request_index = 0;
+
+	while( ( result == 1 )
+	    && ( request_index < number_of_requests ) )
+	{
+		number_of_submissions = 0;
+
+		while( ( number_of_submissions < async_io->queue_depth )
+		    && ( request_index < number_of_requests ) )
+		{
+			request = &( requests[ request_index++ ] );
+
+			if( ( request->file_index < 0 )
+			 || ( request->file_index >= async_io->number_of_files )
+			 || ( request->buffer == NULL )
+			 || ( request->buffer_size == 0 )
+			 || ( request->buffer_size > (size_t) UINT32_MAX )
+			 || ( request->offset < 0 ) )
+			{
+				continue;
+			}
+			file_descriptor = async_io->file_descriptors[ request->file_index ];
+
+			if( file_descriptor == -1 )
+			{
+				continue;
+			}
+			submission_queue_entry = io_uring_get_sqe(
+			                          &( async_io->ring ) );
+
+			if( submission_queue_entry == NULL )
+			{
+				request_index--;
+
+				if( number_of_submissions == 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve submission queue entry.",
+					 function );
+
+					result = -1;
+				}
+				break;
+			}
+			io_uring_prep_read(
+			 submission_queue_entry,
+			 file_descriptor,
+			 (void *) request->buffer,
+			 (unsigned int) request->buffer_size,
+			 (uint64_t) request->offset );
+
+			io_uring_sqe_set_data(
+			 submission_queue_entry,
+			 (void *) request );
+
+			submission_queue_entries[ number_of_submissions++ ] = submission_queue_entry;
+		}
+		/* The submission queue entries are submitted in order hence the entries
+		 * that remain queued are at the end of the submission queue entries
+		 */
+		number_of_queued_reads = number_of_submissions;
+
+		while( number_of_queued_reads > 0 )
+		{
+			submit_result = io_uring_submit(
+			                 &( async_io->ring ) );
+
+			if( submit_result == -EINTR )
+			{
+				continue;
+			}
+			if( submit_result <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to submit read requests.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			number_of_queued_reads    -= submit_result;
+			number_of_reads_in_flight += submit_result;
+		}
+		/* All submitted reads are completed before the buffers are handed back
+		 */
+		while( ( result == 1 )
+		    && ( number_of_reads_in_flight > 0 ) )
+		{
+			do
+			{
+				wait_result = io_uring_wait_cqe(
+				               &( async_io->ring ),
+				               &completion_queue_entry );
+			}
+			while( wait_result == -EINTR );
+
+			if( wait_result < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to wait for read completion.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			number_of_reads_in_flight--;
+
+			request = (libewf_async_io_request_t *) io_uring_cqe_get_data(
+			                                         completion_queue_entry );
+
+			if( request != NULL )
+			{
+				if( completion_queue_entry->res < 0 )
+				{
+					request->read_count = -1;
+				}
+				else
+				{
+					request->read_count = (ssize_t) completion_queue_entry->res;
+				}
+			}
+			io_uring_cqe_seen(
+			 &( async_io->ring ),
+			 completion_queue_entry );
+		}
+	}
+	if( ( result != 1 )
+	 && ( ( number_of_queued_reads > 0 )
+	  ||  ( number_of_reads_in_flight > 0 ) ) )
+	{
+		if( libewf_async_io_cancel_reads(
+		     async_io,
+		     &( submission_queue_entries[ number_of_submissions - number_of_queued_reads ] ),
+		     number_of_queued_reads,
+		     number_of_reads_in_flight,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to cancel reads in flight.",
+			 function );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     async_io->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+#else
+	return( 1 );
+#endif /* defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT ) */
+}
+
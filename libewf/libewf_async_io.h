@@ -0,0 +1,142 @@
+/*
+ * Asynchronous IO functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ASYNC_IO_H )
+#define _LIBEWF_ASYNC_IO_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( HAVE_LIBURING ) && defined( HAVE_LIBURING_H ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && !defined( WINAPI )
+#define HAVE_LIBEWF_ASYNC_IO_SUPPORT
+#endif
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+#include <liburing.h>
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum queue depth
+ */
+#define LIBEWF_ASYNC_IO_MAXIMUM_QUEUE_DEPTH	256
+
+typedef struct libewf_async_io_request libewf_async_io_request_t;
+
+/* A read request
+ */
+struct libewf_async_io_request
+{
+	/* The file index
+	 */
+	int file_index;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The number of bytes read, 0 if the request was not processed or -1 if the read failed
+	 */
+	ssize_t read_count;
+};
+
+typedef struct libewf_async_io libewf_async_io_t;
+
+/* The asynchronous IO keeps multiple reads of the (segment) files in flight
+ * using a Linux io_uring submission and completion queue
+ */
+struct libewf_async_io
+{
+	/* The queue depth, the maximum number of reads in flight
+	 */
+	int queue_depth;
+
+	/* The number of files
+	 */
+	int number_of_files;
+
+	/* The file descriptors, -1 if a file is not opened
+	 */
+	int *file_descriptors;
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	/* The io_uring
+	 */
+	struct io_uring ring;
+
+	/* The mutex, the io_uring is used by one thread at a time
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_async_io_initialize(
+     libewf_async_io_t **async_io,
+     int number_of_files,
+     int queue_depth,
+     libcerror_error_t **error );
+
+int libewf_async_io_free(
+     libewf_async_io_t **async_io,
+     libcerror_error_t **error );
+
+int libewf_async_io_open_file(
+     libewf_async_io_t *async_io,
+     int file_index,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+
+int libewf_async_io_cancel_reads(
+     libewf_async_io_t *async_io,
+     struct io_uring_sqe **queued_submission_queue_entries,
+     int number_of_queued_reads,
+     int number_of_reads_in_flight,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT ) */
+
+int libewf_async_io_read_buffers(
+     libewf_async_io_t *async_io,
+     libewf_async_io_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ASYNC_IO_H ) */
+
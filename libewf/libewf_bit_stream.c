@@ -19,6 +19,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <memory.h>
 #include <types.h>
@@ -185,6 +186,52 @@ int libewf_bit_stream_free(
 	return( 1 );
 }
 
+/* Fills the bit buffer with as many bytes from the byte stream as fit
+ * At least 56 bits are buffered unless the end of the byte stream was reached
+ * The bit stream is not checked, this function is intended to be called from
+ * decoding loops that already validated it
+ */
+void libewf_bit_stream_fill_bit_buffer(
+     libewf_bit_stream_t *bit_stream )
+{
+	uint64_t value_64bit  = 0;
+	size_t read_size      = 0;
+
+	if( ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	 && ( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 ) )
+	{
+		/* Read 8 bytes at once and keep the whole bytes that fit in the bit buffer
+		 */
+		byte_stream_copy_to_uint64_little_endian(
+		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+		 value_64bit );
+
+		read_size = (size_t) ( ( 63 - bit_stream->bit_buffer_size ) >> 3 );
+
+		bit_stream->bit_buffer         |= value_64bit << bit_stream->bit_buffer_size;
+		bit_stream->bit_buffer_size    += (uint8_t) ( read_size * 8 );
+		bit_stream->bit_buffer         &= ( (uint64_t) 1 << bit_stream->bit_buffer_size ) - 1;
+		bit_stream->byte_stream_offset += read_size;
+
+		return;
+	}
+	while( ( bit_stream->bit_buffer_size <= 56 )
+	    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+	{
+		if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+		{
+			bit_stream->bit_buffer |= (uint64_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
+		}
+		else
+		{
+			bit_stream->bit_buffer <<= 8;
+			bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
+		}
+		bit_stream->bit_buffer_size    += 8;
+		bit_stream->byte_stream_offset += 1;
+	}
+}
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -194,11 +241,8 @@ int libewf_bit_stream_get_value(
      uint32_t *value_32bit,
      libcerror_error_t **error )
 {
-	static char *function            = "libewf_bit_stream_get_value";
-	uint32_t read_value_32bit        = 0;
-	uint32_t safe_value_32bit        = 0;
-	uint8_t read_number_of_bits      = 0;
-	uint8_t remaining_number_of_bits = 0;
+	static char *function = "libewf_bit_stream_get_value";
+	uint64_t value_64bit  = 0;
 
 	if( bit_stream == NULL )
 	{
@@ -233,80 +277,51 @@ int libewf_bit_stream_get_value(
 
 		return( -1 );
 	}
-	remaining_number_of_bits = number_of_bits;
-
-	while( remaining_number_of_bits > 0 )
+	/* Since the bit buffer is 64-bit and at most 32 bits are requested
+	 * all the bits can be buffered before they are retrieved
+	 */
+	while( bit_stream->bit_buffer_size < number_of_bits )
 	{
-		while( ( remaining_number_of_bits > bit_stream->bit_buffer_size )
-		    && ( bit_stream->bit_buffer_size <= 24 ) )
+		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
 		{
-			if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid byte stream offset value out of bounds.",
-				 function );
-
-				return( -1 );
-			}
-			if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
-			{
-				bit_stream->bit_buffer |= (uint32_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
-			}
-			else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
-			{
-				bit_stream->bit_buffer <<= 8;
-				bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
-			}
-			bit_stream->bit_buffer_size    += 8;
-			bit_stream->byte_stream_offset += 1;
-		}
-		if( remaining_number_of_bits < bit_stream->bit_buffer_size )
-		{
-			read_number_of_bits = remaining_number_of_bits;
-		}
-		else
-		{
-			read_number_of_bits = bit_stream->bit_buffer_size;
-		}
-		read_value_32bit = bit_stream->bit_buffer;
-
-		if( remaining_number_of_bits < number_of_bits )
-		{
-			safe_value_32bit <<= remaining_number_of_bits;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid byte stream offset value out of bounds.",
+			 function );
+
+			return( -1 );
 		}
 		if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
 		{
-			if( read_number_of_bits < 32 )
-			{
-				/* On VS 2008 32-bit "~( 0xfffffffUL << 32 )" does not behave as expected
-				 */
-				read_value_32bit &= ~( 0xffffffffUL << read_number_of_bits );
-
-				bit_stream->bit_buffer >>= read_number_of_bits;
-			}
-			bit_stream->bit_buffer_size -= read_number_of_bits;
+			bit_stream->bit_buffer |= (uint64_t) bit_stream->byte_stream[ bit_stream->byte_stream_offset ] << bit_stream->bit_buffer_size;
 		}
 		else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
 		{
-			bit_stream->bit_buffer_size -= read_number_of_bits;
-			read_value_32bit           >>= bit_stream->bit_buffer_size;
-
-			if( bit_stream->bit_buffer_size > 0 )
-			{
-				bit_stream->bit_buffer &= 0xffffffffUL >> ( 32 - bit_stream->bit_buffer_size );
-			}
+			bit_stream->bit_buffer <<= 8;
+			bit_stream->bit_buffer  |= bit_stream->byte_stream[ bit_stream->byte_stream_offset ];
 		}
-		if( bit_stream->bit_buffer_size == 0 )
-		{
-			bit_stream->bit_buffer = 0;
-		}
-		safe_value_32bit         |= read_value_32bit;
-		remaining_number_of_bits -= read_number_of_bits;
+		bit_stream->bit_buffer_size    += 8;
+		bit_stream->byte_stream_offset += 1;
+	}
+	value_64bit = bit_stream->bit_buffer;
+
+	if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT )
+	{
+		value_64bit &= ( (uint64_t) 1 << number_of_bits ) - 1;
+
+		bit_stream->bit_buffer >>= number_of_bits;
 	}
-	*value_32bit = safe_value_32bit;
+	else if( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_FRONT_TO_BACK )
+	{
+		value_64bit >>= bit_stream->bit_buffer_size - number_of_bits;
+
+		bit_stream->bit_buffer &= ( (uint64_t) 1 << ( bit_stream->bit_buffer_size - number_of_bits ) ) - 1;
+	}
+	bit_stream->bit_buffer_size -= number_of_bits;
+
+	*value_32bit = (uint32_t) value_64bit;
 
 	return( 1 );
 }
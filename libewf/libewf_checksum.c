@@ -31,7 +31,7 @@
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) && !defined( LIBEWF_ADLER32_HAVE_SIMD )
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
@@ -88,5 +88,5 @@ int libewf_checksum_calculate_adler32(
 	return( 1 );
 }
 
-#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) && !defined( LIBEWF_ADLER32_HAVE_SIMD ) */
 
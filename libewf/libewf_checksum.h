@@ -25,14 +25,14 @@
 #include <common.h>
 #include <types.h>
 
-#include "libewf_deflate.h"
+#include "libewf_adler32.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
-#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) && !defined( LIBEWF_ADLER32_HAVE_SIMD )
 
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
@@ -43,9 +43,9 @@ int libewf_checksum_calculate_adler32(
 
 #else
 #define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
+	libewf_adler32_calculate( checksum_value, buffer, size, initial_value, error )
 
-#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) && !defined( LIBEWF_ADLER32_HAVE_SIMD ) */
 
 #if defined( __cplusplus )
 }
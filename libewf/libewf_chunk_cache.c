@@ -0,0 +1,1699 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a chunk cache entry
+ * Make sure the value chunk_cache_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_entry_initialize(
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_entry_initialize";
+
+	if( chunk_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_cache_entry = memory_allocate_structure(
+	                      libewf_chunk_cache_entry_t );
+
+	if( *chunk_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache_entry,
+	     0,
+	     sizeof( libewf_chunk_cache_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache entry.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_cache_entry )->chunk_index = chunk_index;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache_entry != NULL )
+	{
+		memory_free(
+		 *chunk_cache_entry );
+
+		*chunk_cache_entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache entry and its chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_entry_free(
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_entry_free";
+	int result            = 1;
+
+	if( chunk_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache_entry != NULL )
+	{
+		if( ( *chunk_cache_entry )->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( ( *chunk_cache_entry )->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *chunk_cache_entry );
+
+		*chunk_cache_entry = NULL;
+	}
+	return( result );
+}
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_initialize";
+	size_t buckets_size   = 0;
+	int number_of_buckets = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_get_number_of_buckets(
+	     maximum_cache_size,
+	     &number_of_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of buckets.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libewf_chunk_cache_entry_t * ) * number_of_buckets;
+
+	( *chunk_cache )->buckets = (libewf_chunk_cache_entry_t **) memory_allocate(
+	                                                             buckets_size );
+
+	if( ( *chunk_cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *chunk_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *chunk_cache )->number_of_buckets             = number_of_buckets;
+	( *chunk_cache )->maximum_cache_size            = maximum_cache_size;
+	( *chunk_cache )->maximum_number_of_out_entries = number_of_buckets / 2;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		if( ( *chunk_cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->buckets );
+		}
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * All referenced entries should be released before calling this function
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_free";
+	int result            = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		if( libewf_chunk_cache_empty(
+		     *chunk_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk cache.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *chunk_cache )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 ( *chunk_cache )->buckets );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Empties a chunk cache
+ * Entries that are still referenced are freed when they are released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	static char *function                         = "libewf_chunk_cache_empty";
+	uint8_t queue_type                            = 0;
+	int result                                    = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN;
+	     queue_type <= LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT;
+	     queue_type++ )
+	{
+		while( chunk_cache->queues[ queue_type ].first_entry != NULL )
+		{
+			chunk_cache_entry = chunk_cache->queues[ queue_type ].first_entry;
+
+			if( libewf_chunk_cache_detach_entry(
+			     chunk_cache,
+			     chunk_cache_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to detach chunk cache entry.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			if( chunk_cache_entry->number_of_references == 0 )
+			{
+				if( libewf_chunk_cache_entry_free(
+				     &chunk_cache_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk cache entry.",
+					 function );
+
+					result = -1;
+				}
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determines the number of hash buckets for a specific maximum cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_number_of_buckets(
+     size64_t maximum_cache_size,
+     int *number_of_buckets,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_number_of_buckets";
+	size64_t safe_number  = 0;
+
+	if( number_of_buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of buckets.",
+		 function );
+
+		return( -1 );
+	}
+	safe_number = maximum_cache_size / LIBEWF_CHUNK_CACHE_SIZE_PER_BUCKET;
+
+	if( safe_number < LIBEWF_CHUNK_CACHE_MINIMUM_NUMBER_OF_BUCKETS )
+	{
+		safe_number = LIBEWF_CHUNK_CACHE_MINIMUM_NUMBER_OF_BUCKETS;
+	}
+	else if( safe_number > LIBEWF_CHUNK_CACHE_MAXIMUM_NUMBER_OF_BUCKETS )
+	{
+		safe_number = LIBEWF_CHUNK_CACHE_MAXIMUM_NUMBER_OF_BUCKETS;
+	}
+	*number_of_buckets = (int) safe_number;
+
+	return( 1 );
+}
+
+/* Resizes the hash buckets and rehashes the entries
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_resize_buckets(
+     libewf_chunk_cache_t *chunk_cache,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t **buckets          = NULL;
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	static char *function                         = "libewf_chunk_cache_resize_buckets";
+	size_t buckets_size                           = 0;
+	uint8_t queue_type                            = 0;
+	int bucket_index                              = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buckets < LIBEWF_CHUNK_CACHE_MINIMUM_NUMBER_OF_BUCKETS )
+	 || ( number_of_buckets > LIBEWF_CHUNK_CACHE_MAXIMUM_NUMBER_OF_BUCKETS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buckets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libewf_chunk_cache_entry_t * ) * number_of_buckets;
+
+	buckets = (libewf_chunk_cache_entry_t **) memory_allocate(
+	                                           buckets_size );
+
+	if( buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		memory_free(
+		 buckets );
+
+		return( -1 );
+	}
+	for( queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN;
+	     queue_type <= LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT;
+	     queue_type++ )
+	{
+		chunk_cache_entry = chunk_cache->queues[ queue_type ].first_entry;
+
+		while( chunk_cache_entry != NULL )
+		{
+			bucket_index = (int) ( chunk_cache_entry->chunk_index % (uint64_t) number_of_buckets );
+
+			chunk_cache_entry->next_bucket_entry = buckets[ bucket_index ];
+			buckets[ bucket_index ]              = chunk_cache_entry;
+
+			chunk_cache_entry = chunk_cache_entry->next_entry;
+		}
+	}
+	memory_free(
+	 chunk_cache->buckets );
+
+	chunk_cache->buckets           = buckets;
+	chunk_cache->number_of_buckets = number_of_buckets;
+
+	return( 1 );
+}
+
+/* Retrieves the maximum cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_maximum_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_maximum_cache_size";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_cache_size = chunk_cache->maximum_cache_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum cache size
+ * Entries are evicted if the cache size exceeds the new maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_maximum_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_set_maximum_cache_size";
+	int number_of_buckets = 0;
+	int result            = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_get_number_of_buckets(
+	     maximum_cache_size,
+	     &number_of_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of buckets.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( number_of_buckets != chunk_cache->number_of_buckets )
+	{
+		if( libewf_chunk_cache_resize_buckets(
+		     chunk_cache,
+		     number_of_buckets,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize buckets.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		chunk_cache->maximum_cache_size            = maximum_cache_size;
+		chunk_cache->maximum_number_of_out_entries = number_of_buckets / 2;
+
+		if( libewf_chunk_cache_evict_entries(
+		     chunk_cache,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict entries.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of cache hits and misses
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_statistics";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_hits   = chunk_cache->number_of_hits;
+	*number_of_misses = chunk_cache->number_of_misses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Attaches an entry to the front of a queue and its hash bucket
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_attach_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *chunk_cache_entry,
+     uint8_t queue_type,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_queue_t *queue = NULL;
+	static char *function             = "libewf_chunk_cache_attach_entry";
+	int bucket_index                  = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_entry->queue_type != LIBEWF_CHUNK_CACHE_QUEUE_TYPE_NONE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache entry - already attached.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_type != LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN )
+	 && ( queue_type != LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN )
+	 && ( queue_type != LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported queue type.",
+		 function );
+
+		return( -1 );
+	}
+	queue        = &( chunk_cache->queues[ queue_type ] );
+	bucket_index = (int) ( chunk_cache_entry->chunk_index % (uint64_t) chunk_cache->number_of_buckets );
+
+	chunk_cache_entry->previous_entry    = NULL;
+	chunk_cache_entry->next_entry        = queue->first_entry;
+	chunk_cache_entry->next_bucket_entry = chunk_cache->buckets[ bucket_index ];
+	chunk_cache_entry->queue_type        = queue_type;
+
+	if( queue->first_entry != NULL )
+	{
+		queue->first_entry->previous_entry = chunk_cache_entry;
+	}
+	else
+	{
+		queue->last_entry = chunk_cache_entry;
+	}
+	queue->first_entry                   = chunk_cache_entry;
+	chunk_cache->buckets[ bucket_index ] = chunk_cache_entry;
+
+	queue->number_of_entries += 1;
+	queue->size              += chunk_cache_entry->data_size;
+
+	if( queue_type != LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT )
+	{
+		chunk_cache->cache_size += chunk_cache_entry->data_size;
+	}
+	return( 1 );
+}
+
+/* Detaches an entry from its queue and hash bucket
+ * The entry is not freed
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_detach_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *chunk_cache_entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *bucket_entry = NULL;
+	libewf_chunk_cache_queue_t *queue        = NULL;
+	static char *function                    = "libewf_chunk_cache_detach_entry";
+	int bucket_index                         = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_entry->queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_NONE )
+	{
+		return( 1 );
+	}
+	if( chunk_cache_entry->queue_type > LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk cache entry queue type.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = (int) ( chunk_cache_entry->chunk_index % (uint64_t) chunk_cache->number_of_buckets );
+
+	bucket_entry = chunk_cache->buckets[ bucket_index ];
+
+	if( bucket_entry == chunk_cache_entry )
+	{
+		chunk_cache->buckets[ bucket_index ] = chunk_cache_entry->next_bucket_entry;
+	}
+	else
+	{
+		while( bucket_entry != NULL )
+		{
+			if( bucket_entry->next_bucket_entry == chunk_cache_entry )
+			{
+				bucket_entry->next_bucket_entry = chunk_cache_entry->next_bucket_entry;
+
+				break;
+			}
+			bucket_entry = bucket_entry->next_bucket_entry;
+		}
+		if( bucket_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk cache entry: %" PRIu64 " in bucket: %d.",
+			 function,
+			 chunk_cache_entry->chunk_index,
+			 bucket_index );
+
+			return( -1 );
+		}
+	}
+	queue = &( chunk_cache->queues[ chunk_cache_entry->queue_type ] );
+
+	if( chunk_cache_entry->previous_entry != NULL )
+	{
+		chunk_cache_entry->previous_entry->next_entry = chunk_cache_entry->next_entry;
+	}
+	else
+	{
+		queue->first_entry = chunk_cache_entry->next_entry;
+	}
+	if( chunk_cache_entry->next_entry != NULL )
+	{
+		chunk_cache_entry->next_entry->previous_entry = chunk_cache_entry->previous_entry;
+	}
+	else
+	{
+		queue->last_entry = chunk_cache_entry->previous_entry;
+	}
+	queue->number_of_entries -= 1;
+	queue->size              -= chunk_cache_entry->data_size;
+
+	if( chunk_cache_entry->queue_type != LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT )
+	{
+		chunk_cache->cache_size -= chunk_cache_entry->data_size;
+	}
+	chunk_cache_entry->previous_entry    = NULL;
+	chunk_cache_entry->next_entry        = NULL;
+	chunk_cache_entry->next_bucket_entry = NULL;
+	chunk_cache_entry->queue_type        = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_NONE;
+
+	return( 1 );
+}
+
+/* Evicts entries until the required size fits in the cache
+ * Entries are evicted from the in queue while it uses more than a quarter of
+ * the maximum cache size, otherwise from the main queue. Entries evicted from
+ * the in queue are remembered in the out queue without their chunk data.
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_evict_entries(
+     libewf_chunk_cache_t *chunk_cache,
+     size_t required_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *evicted_entry = NULL;
+	libewf_chunk_cache_queue_t *in_queue      = NULL;
+	libewf_chunk_cache_queue_t *main_queue    = NULL;
+	libewf_chunk_cache_queue_t *out_queue     = NULL;
+	static char *function                     = "libewf_chunk_cache_evict_entries";
+	uint8_t queue_type                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	in_queue   = &( chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN ] );
+	main_queue = &( chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN ] );
+	out_queue  = &( chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT ] );
+
+	while( ( chunk_cache->cache_size + required_size ) > chunk_cache->maximum_cache_size )
+	{
+		if( ( in_queue->number_of_entries > 0 )
+		 && ( ( in_queue->size > ( chunk_cache->maximum_cache_size / 4 ) )
+		  ||  ( main_queue->number_of_entries == 0 ) ) )
+		{
+			evicted_entry = in_queue->last_entry;
+		}
+		else if( main_queue->number_of_entries > 0 )
+		{
+			evicted_entry = main_queue->last_entry;
+		}
+		else
+		{
+			break;
+		}
+		queue_type = evicted_entry->queue_type;
+
+		if( libewf_chunk_cache_detach_entry(
+		     chunk_cache,
+		     evicted_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to detach chunk cache entry.",
+			 function );
+
+			return( -1 );
+		}
+		/* Entries that are still referenced are freed on release
+		 */
+		if( evicted_entry->number_of_references != 0 )
+		{
+			continue;
+		}
+		if( queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN )
+		{
+			if( libewf_chunk_cache_entry_free(
+			     &evicted_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk cache entry.",
+				 function );
+
+				return( -1 );
+			}
+			continue;
+		}
+		if( evicted_entry->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( evicted_entry->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				libewf_chunk_cache_entry_free(
+				 &evicted_entry,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		evicted_entry->data_size = 0;
+
+		if( libewf_chunk_cache_attach_entry(
+		     chunk_cache,
+		     evicted_entry,
+		     LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to attach chunk cache entry to out queue.",
+			 function );
+
+			libewf_chunk_cache_entry_free(
+			 &evicted_entry,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	while( out_queue->number_of_entries > chunk_cache->maximum_number_of_out_entries )
+	{
+		evicted_entry = out_queue->last_entry;
+
+		if( libewf_chunk_cache_detach_entry(
+		     chunk_cache,
+		     evicted_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to detach chunk cache entry.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_chunk_cache_entry_free(
+		     &evicted_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves an entry for a specific chunk index
+ * The entry is referenced and must be released with libewf_chunk_cache_release_entry
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libewf_chunk_cache_get_entry_by_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *safe_chunk_cache_entry = NULL;
+	static char *function                              = "libewf_chunk_cache_get_entry_by_index";
+	int bucket_index                                   = 0;
+	int result                                         = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	bucket_index = (int) ( chunk_index % (uint64_t) chunk_cache->number_of_buckets );
+
+	safe_chunk_cache_entry = chunk_cache->buckets[ bucket_index ];
+
+	while( safe_chunk_cache_entry != NULL )
+	{
+		if( safe_chunk_cache_entry->chunk_index == chunk_index )
+		{
+			break;
+		}
+		safe_chunk_cache_entry = safe_chunk_cache_entry->next_bucket_entry;
+	}
+	if( ( safe_chunk_cache_entry == NULL )
+	 || ( safe_chunk_cache_entry->queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT ) )
+	{
+		chunk_cache->number_of_misses += 1;
+	}
+	else
+	{
+		result = 1;
+
+		/* Move an entry in the main queue to the front, entries in the in queue
+		 * keep their position
+		 */
+		if( ( safe_chunk_cache_entry->queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN )
+		 && ( safe_chunk_cache_entry->previous_entry != NULL ) )
+		{
+			if( libewf_chunk_cache_detach_entry(
+			     chunk_cache,
+			     safe_chunk_cache_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to detach chunk cache entry.",
+				 function );
+
+				result = -1;
+			}
+			else if( libewf_chunk_cache_attach_entry(
+			          chunk_cache,
+			          safe_chunk_cache_entry,
+			          LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to attach chunk cache entry.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			safe_chunk_cache_entry->number_of_references += 1;
+
+			chunk_cache->number_of_hits += 1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		if( result == 1 )
+		{
+			libewf_chunk_cache_release_entry(
+			 chunk_cache,
+			 &safe_chunk_cache_entry,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*chunk_cache_entry = safe_chunk_cache_entry;
+	}
+	return( result );
+}
+
+/* Inserts (unpacked) chunk data for a specific chunk index
+ * The cache takes over management of the chunk data and sets it to NULL
+ * If another thread inserted the same chunk index first the chunk data is freed
+ * and the existing entry is returned
+ * Chunk data of a chunk index that was recently evicted from the in queue is
+ * stored in the main queue, otherwise in the in queue
+ * The entry is referenced and must be released with libewf_chunk_cache_release_entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_insert_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *safe_chunk_cache_entry = NULL;
+	static char *function                              = "libewf_chunk_cache_insert_entry";
+	size_t data_size                                   = 0;
+	uint8_t queue_type                                 = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN;
+	int bucket_index                                   = 0;
+	int result                                         = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data == NULL )
+	 || ( *chunk_data == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = ( *chunk_data )->allocated_data_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	bucket_index = (int) ( chunk_index % (uint64_t) chunk_cache->number_of_buckets );
+
+	safe_chunk_cache_entry = chunk_cache->buckets[ bucket_index ];
+
+	while( safe_chunk_cache_entry != NULL )
+	{
+		if( safe_chunk_cache_entry->chunk_index == chunk_index )
+		{
+			break;
+		}
+		safe_chunk_cache_entry = safe_chunk_cache_entry->next_bucket_entry;
+	}
+	if( ( safe_chunk_cache_entry != NULL )
+	 && ( safe_chunk_cache_entry->queue_type != LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT ) )
+	{
+		if( libewf_chunk_data_free(
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	else
+	{
+		if( safe_chunk_cache_entry != NULL )
+		{
+			/* The chunk was recently evicted from the in queue
+			 */
+			if( libewf_chunk_cache_detach_entry(
+			     chunk_cache,
+			     safe_chunk_cache_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to detach chunk cache entry from out queue.",
+				 function );
+
+				safe_chunk_cache_entry = NULL;
+
+				result = -1;
+			}
+			queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN;
+		}
+		if( result == 1 )
+		{
+			if( libewf_chunk_cache_evict_entries(
+			     chunk_cache,
+			     data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to evict entries.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( result == 1 )
+		 && ( safe_chunk_cache_entry == NULL ) )
+		{
+			if( libewf_chunk_cache_entry_initialize(
+			     &safe_chunk_cache_entry,
+			     chunk_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk cache entry.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			safe_chunk_cache_entry->chunk_data = *chunk_data;
+			safe_chunk_cache_entry->data_size  = data_size;
+
+			if( libewf_chunk_cache_attach_entry(
+			     chunk_cache,
+			     safe_chunk_cache_entry,
+			     queue_type,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to attach chunk cache entry.",
+				 function );
+
+				safe_chunk_cache_entry->chunk_data = NULL;
+
+				result = -1;
+			}
+			else
+			{
+				*chunk_data = NULL;
+			}
+		}
+		if( ( result != 1 )
+		 && ( safe_chunk_cache_entry != NULL ) )
+		{
+			libewf_chunk_cache_entry_free(
+			 &safe_chunk_cache_entry,
+			 NULL );
+		}
+	}
+	if( result == 1 )
+	{
+		safe_chunk_cache_entry->number_of_references += 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		if( result == 1 )
+		{
+			libewf_chunk_cache_release_entry(
+			 chunk_cache,
+			 &safe_chunk_cache_entry,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*chunk_cache_entry = safe_chunk_cache_entry;
+	}
+	return( result );
+}
+
+/* Releases a referenced entry
+ * Frees the entry if it is no longer referenced and was evicted from the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_release_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *safe_chunk_cache_entry = NULL;
+	static char *function                              = "libewf_chunk_cache_release_entry";
+	int result                                         = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache_entry == NULL )
+	{
+		return( 1 );
+	}
+	safe_chunk_cache_entry = *chunk_cache_entry;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( safe_chunk_cache_entry->number_of_references > 0 )
+	{
+		safe_chunk_cache_entry->number_of_references -= 1;
+	}
+	if( ( safe_chunk_cache_entry->number_of_references == 0 )
+	 && ( safe_chunk_cache_entry->queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_NONE ) )
+	{
+		if( libewf_chunk_cache_entry_free(
+		     &safe_chunk_cache_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache entry.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*chunk_cache_entry = NULL;
+
+	return( result );
+}
+
@@ -0,0 +1,257 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The chunk cache queue types
+ */
+enum LIBEWF_CHUNK_CACHE_QUEUE_TYPES
+{
+	LIBEWF_CHUNK_CACHE_QUEUE_TYPE_NONE	= 0,
+
+	/* Entries that were inserted once, evicted in first in first out order
+	 */
+	LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN	= 1,
+
+	/* Entries that were inserted again after having been evicted from the in queue,
+	 * evicted in least recently used order
+	 */
+	LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN	= 2,
+
+	/* Entries without chunk data that were recently evicted from the in queue
+	 */
+	LIBEWF_CHUNK_CACHE_QUEUE_TYPE_OUT	= 3
+};
+
+/* The minimum and maximum number of hash buckets
+ */
+#define LIBEWF_CHUNK_CACHE_MINIMUM_NUMBER_OF_BUCKETS	64
+#define LIBEWF_CHUNK_CACHE_MAXIMUM_NUMBER_OF_BUCKETS	1048576
+
+/* The cache size per hash bucket
+ */
+#define LIBEWF_CHUNK_CACHE_SIZE_PER_BUCKET		16384
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The (unpacked) chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data accounted to the cache size
+	 */
+	size_t data_size;
+
+	/* The number of references
+	 */
+	int number_of_references;
+
+	/* The queue type of the queue the entry is stored in
+	 * LIBEWF_CHUNK_CACHE_QUEUE_TYPE_NONE if the entry is not stored in the cache
+	 */
+	uint8_t queue_type;
+
+	/* The previous entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *previous_entry;
+
+	/* The next entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *next_entry;
+
+	/* The next entry in the same hash bucket
+	 */
+	libewf_chunk_cache_entry_t *next_bucket_entry;
+};
+
+typedef struct libewf_chunk_cache_queue libewf_chunk_cache_queue_t;
+
+struct libewf_chunk_cache_queue
+{
+	/* The first (most recently inserted or used) entry
+	 */
+	libewf_chunk_cache_entry_t *first_entry;
+
+	/* The last (least recently inserted or used) entry
+	 */
+	libewf_chunk_cache_entry_t *last_entry;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The size of the chunk data of the entries
+	 */
+	size64_t size;
+};
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+/* The chunk cache uses the 2Q replacement policy, chunks that are read once,
+ * such as by a sequential scan, do not push frequently used chunks out of the cache
+ */
+struct libewf_chunk_cache
+{
+	/* The hash buckets
+	 */
+	libewf_chunk_cache_entry_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	int number_of_buckets;
+
+	/* The queues, indexed by queue type
+	 */
+	libewf_chunk_cache_queue_t queues[ 4 ];
+
+	/* The size of the chunk data stored in the cache
+	 */
+	size64_t cache_size;
+
+	/* The maximum size of the chunk data stored in the cache
+	 */
+	size64_t maximum_cache_size;
+
+	/* The maximum number of entries in the out queue
+	 */
+	int maximum_number_of_out_entries;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libewf_chunk_cache_entry_initialize(
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_entry_free(
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_number_of_buckets(
+     size64_t maximum_cache_size,
+     int *number_of_buckets,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_resize_buckets(
+     libewf_chunk_cache_t *chunk_cache,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_maximum_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_maximum_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_attach_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *chunk_cache_entry,
+     uint8_t queue_type,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_detach_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *chunk_cache_entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_evict_entries(
+     libewf_chunk_cache_t *chunk_cache,
+     size_t required_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_entry_by_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_insert_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_release_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
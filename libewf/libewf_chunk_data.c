@@ -26,8 +26,11 @@
 
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
-#include "libewf_compression.h"
+#include "libewf_chunk_data_pool.h"
+#include "libewf_compression_context.h"
+#include "libewf_compression_controller.h"
 #include "libewf_definitions.h"
+#include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
@@ -53,8 +56,43 @@ int libewf_chunk_data_initialize(
      uint8_t clear_data,
      libcerror_error_t **error )
 {
-	static char *function      = "libewf_chunk_data_initialize";
-	size_t allocated_data_size = 0;
+	static char *function = "libewf_chunk_data_initialize";
+
+	if( libewf_chunk_data_initialize_from_pool(
+	     chunk_data,
+	     NULL,
+	     chunk_size,
+	     clear_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates chunk data from a chunk data pool
+ * The chunk data and its data are allocated from the chunk data pool if provided
+ * and returned to the pool when the chunk data is freed, hence the chunk data pool
+ * must outlive the chunk data
+ * Make sure the value chunk_data is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_initialize_from_pool(
+     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size32_t chunk_size,
+     uint8_t clear_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_chunk_data_initialize_from_pool";
 
 	if( chunk_data == NULL )
 	{
@@ -90,22 +128,42 @@ int libewf_chunk_data_initialize(
 
 		return( -1 );
 	}
-	*chunk_data = memory_allocate_structure(
-	               libewf_chunk_data_t );
+	if( chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_grab_structure(
+		     chunk_data_pool,
+		     (intptr_t **) &safe_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab chunk data from pool.",
+			 function );
 
-	if( *chunk_data == NULL )
+			return( -1 );
+		}
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create chunk data.",
-		 function );
+		safe_chunk_data = memory_allocate_structure(
+		                   libewf_chunk_data_t );
 
-		goto on_error;
+		if( safe_chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk data.",
+			 function );
+
+			return( -1 );
+		}
 	}
 	if( memory_set(
-	     *chunk_data,
+	     safe_chunk_data,
 	     0,
 	     sizeof( libewf_chunk_data_t ) ) == NULL )
 	{
@@ -116,29 +174,19 @@ int libewf_chunk_data_initialize(
 		 "%s: unable to clear chunk data.",
 		 function );
 
-		memory_free(
-		 *chunk_data );
-
-		*chunk_data = NULL;
-
-		return( -1 );
+		goto on_error;
 	}
-	/* Reserve 4 bytes for the chunk checksum
-	 */
-	allocated_data_size = (size_t) chunk_size + 4;
+	safe_chunk_data->chunk_size      = chunk_size;
+	safe_chunk_data->chunk_data_pool = chunk_data_pool;
 
-	/* The allocated data size should be rounded to the next 16-byte increment
+	/* Reserve 4 bytes for the chunk checksum
 	 */
-	if( ( allocated_data_size % 16 ) != 0 )
-	{
-		allocated_data_size += 16;
-	}
-	allocated_data_size = ( allocated_data_size / 16 ) * 16;
-
-	( *chunk_data )->data = (uint8_t *) memory_allocate(
-					     sizeof( uint8_t ) * allocated_data_size );
-
-	if( ( *chunk_data )->data == NULL )
+	if( libewf_chunk_data_allocate_buffer(
+	     safe_chunk_data,
+	     (size_t) chunk_size + 4,
+	     &( safe_chunk_data->data ),
+	     &( safe_chunk_data->allocated_data_size ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -149,12 +197,14 @@ int libewf_chunk_data_initialize(
 
 		goto on_error;
 	}
+	safe_chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+
 	if( clear_data != 0 )
 	{
 		if( memory_set(
-		     ( *chunk_data )->data,
+		     safe_chunk_data->data,
 		     0,
-		     sizeof( uint8_t ) * allocated_data_size ) == NULL )
+		     sizeof( uint8_t ) * safe_chunk_data->allocated_data_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
@@ -166,36 +216,31 @@ int libewf_chunk_data_initialize(
 			goto on_error;
 		}
 	}
-	( *chunk_data )->chunk_size          = chunk_size;
-	( *chunk_data )->allocated_data_size = allocated_data_size;
-	( *chunk_data )->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+	*chunk_data = safe_chunk_data;
 
 	return( 1 );
 
 on_error:
-	if( *chunk_data != NULL )
+	if( safe_chunk_data != NULL )
 	{
-		if( ( *chunk_data )->data != NULL )
-		{
-			memory_free(
-			 ( *chunk_data )->data );
-		}
-		memory_free(
-		 *chunk_data );
-
-		*chunk_data = NULL;
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
 	}
 	return( -1 );
 }
 
 /* Frees chunk data
+ * Chunk data from a chunk data pool is returned to the pool
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_data_free";
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	static char *function                     = "libewf_chunk_data_free";
+	int result                                = 1;
 
 	if( chunk_data == NULL )
 	{
@@ -210,24 +255,238 @@ int libewf_chunk_data_free(
 	}
 	if( *chunk_data != NULL )
 	{
+		chunk_data_pool = ( *chunk_data )->chunk_data_pool;
+
 		if( ( ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			if( ( *chunk_data )->data != NULL )
+			if( libewf_chunk_data_free_buffer(
+			     *chunk_data,
+			     &( ( *chunk_data )->data ),
+			     ( *chunk_data )->allocated_data_size,
+			     error ) != 1 )
 			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libewf_chunk_data_free_buffer(
+		     *chunk_data,
+		     &( ( *chunk_data )->compressed_data ),
+		     ( *chunk_data )->allocated_compressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compressed data.",
+			 function );
+
+			result = -1;
+		}
+		if( chunk_data_pool != NULL )
+		{
+			if( libewf_chunk_data_pool_release_structure(
+			     chunk_data_pool,
+			     (intptr_t **) chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk data to pool.",
+				 function );
+
 				memory_free(
-				 ( *chunk_data )->data );
+				 *chunk_data );
+
+				result = -1;
 			}
 		}
-		if( ( *chunk_data )->compressed_data != NULL )
+		else
 		{
 			memory_free(
-			 ( *chunk_data )->compressed_data );
+			 *chunk_data );
 		}
-		memory_free(
-		 *chunk_data );
-
 		*chunk_data = NULL;
 	}
+	return( result );
+}
+
+/* Allocates a buffer for the data or compressed data of the chunk data
+ * The buffer is allocated from the chunk data pool if the chunk data has one
+ * The buffer size is set to the allocated size, which is the requested size rounded to the next 16-byte increment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_allocate_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_grab_buffer(
+		     chunk_data->chunk_data_pool,
+		     size,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab buffer from pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* The allocated size should be rounded to the next 16-byte increment
+	 */
+	if( ( size % 16 ) != 0 )
+	{
+		size += 16;
+	}
+	size = ( size / 16 ) * 16;
+
+	*buffer = (uint8_t *) memory_allocate(
+	                       sizeof( uint8_t ) * size );
+
+	if( *buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer_size = size;
+
+	return( 1 );
+}
+
+/* Frees a buffer allocated by libewf_chunk_data_allocate_buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_free_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	if( chunk_data->chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_release_buffer(
+		     chunk_data->chunk_data_pool,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release buffer to pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	memory_free(
+	 *buffer );
+
+	*buffer = NULL;
+
 	return( 1 );
 }
 
@@ -522,6 +781,33 @@ int libewf_chunk_data_pack_determine_pack_flags(
 			safe_pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION | LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
 		}
 	}
+	/* Forced compression, such as for EWF-S01, cannot be skipped
+	 */
+	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA ) != 0 )
+	 && ( io_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
+	 && ( ( safe_pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 ) )
+	{
+		result = libewf_chunk_data_check_for_incompressible_data(
+			  chunk_data->data,
+			  chunk_data->data_size,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk data is incompressible.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			safe_pack_flags |= LIBEWF_PACK_FLAG_SKIP_COMPRESSION;
+		}
+	}
 	*pack_flags = safe_pack_flags;
 
 	return( 1 );
@@ -585,6 +871,7 @@ int libewf_chunk_data_pack_with_64_bit_pattern_fill(
 
 		goto on_error;
 	}
+	chunk_data->allocated_compressed_data_size = chunk_data->compressed_data_size;
 	if( memory_copy(
 	     chunk_data->compressed_data,
 	     chunk_data->data,
@@ -606,12 +893,14 @@ int libewf_chunk_data_pack_with_64_bit_pattern_fill(
 on_error:
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
-
-		chunk_data->compressed_data = NULL;
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 &( chunk_data->compressed_data ),
+		 chunk_data->allocated_compressed_data_size,
+		 NULL );
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
+	chunk_data->allocated_compressed_data_size = 0;
 
 	return( -1 );
 }
@@ -692,6 +981,8 @@ int libewf_chunk_data_pack_with_empty_block_compression(
 
 		goto on_error;
 	}
+	chunk_data->allocated_compressed_data_size = chunk_data->compressed_data_size;
+
 	if( memory_copy(
 	     chunk_data->compressed_data,
 	     compressed_zero_byte_empty_block,
@@ -717,12 +1008,14 @@ int libewf_chunk_data_pack_with_empty_block_compression(
 on_error:
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
-
-		chunk_data->compressed_data = NULL;
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 &( chunk_data->compressed_data ),
+		 chunk_data->allocated_compressed_data_size,
+		 NULL );
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
+	chunk_data->allocated_compressed_data_size = 0;
 
 	return( -1 );
 }
@@ -735,10 +1028,14 @@ int libewf_chunk_data_pack_with_compression(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function            = "libewf_chunk_data_pack_with_compression";
-	size_t safe_compressed_data_size = 0;
-	int8_t compression_level         = 0;
-	int result                       = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_chunk_data_pack_with_compression";
+	size_t safe_compressed_data_size                  = 0;
+	int64_t compression_start_time                    = 0;
+	int8_t compression_level                          = 0;
+	int deflate_level                                 = 0;
+	int result                                        = 0;
+	uint8_t use_adaptive_compression_level            = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -785,8 +1082,6 @@ int libewf_chunk_data_pack_with_compression(
 
 		return( -1 );
 	}
-/* TODO add a light weight entropy test to assess if compression makes sense */
-
 	chunk_data->compressed_data_size = chunk_data->chunk_size;
 
 	/* EWF-S01 allows to have compressed chunks larger than the chunk size, a factor 2 should suffice
@@ -795,10 +1090,14 @@ int libewf_chunk_data_pack_with_compression(
 	{
 		chunk_data->compressed_data_size *= 2;
 	}
-	chunk_data->compressed_data = (uint8_t *) memory_allocate(
-	                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
-
-	if( chunk_data->compressed_data == NULL )
+	/* Reserve 4 bytes, as for the data, so that the buffer can be reused for the data of another chunk
+	 */
+	if( libewf_chunk_data_allocate_buffer(
+	     chunk_data,
+	     chunk_data->compressed_data_size + 4,
+	     &( chunk_data->compressed_data ),
+	     &( chunk_data->allocated_compressed_data_size ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -820,15 +1119,86 @@ int libewf_chunk_data_pack_with_compression(
 	{
 		compression_level = LIBEWF_COMPRESSION_LEVEL_DEFAULT;
 	}
-	result = libewf_compress_data(
-		  chunk_data->compressed_data,
-		  &safe_compressed_data_size,
-		  io_handle->compression_method,
-		  compression_level,
-		  chunk_data->data,
-		  chunk_data->data_size,
-		  error );
+	/* The adaptive deflate compression level replaces the compression level
+	 * of the chunks that are compressed because of the compression level
+	 */
+	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION_LEVEL ) != 0 )
+	 && ( io_handle->compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( io_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE ) )
+	{
+		use_adaptive_compression_level = 1;
+	}
+	if( libewf_io_handle_grab_compression_context(
+	     io_handle,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab compression context.",
+		 function );
 
+		goto on_error;
+	}
+	if( use_adaptive_compression_level != 0 )
+	{
+		if( libewf_compression_controller_start_compression(
+		     io_handle->compression_controller,
+		     &deflate_level,
+		     &compression_start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to start compression.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_compression_context_compress_data_with_deflate_level(
+			  compression_context,
+			  chunk_data->compressed_data,
+			  &safe_compressed_data_size,
+			  deflate_level,
+			  chunk_data->data,
+			  chunk_data->data_size,
+			  error );
+
+		if( result != -1 )
+		{
+			if( libewf_compression_controller_stop_compression(
+			     io_handle->compression_controller,
+			     deflate_level,
+			     compression_start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to stop compression.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	else
+	{
+		result = libewf_compression_context_compress_data(
+			  compression_context,
+			  chunk_data->compressed_data,
+			  &safe_compressed_data_size,
+			  io_handle->compression_method,
+			  compression_level,
+			  chunk_data->data,
+			  chunk_data->data_size,
+			  error );
+	}
 	if( result == -1 )
 	{
 		libcerror_error_set(
@@ -840,7 +1210,21 @@ int libewf_chunk_data_pack_with_compression(
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	if( libewf_io_handle_release_compression_context(
+	     io_handle,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 0 )
 	{
 		if( ( safe_compressed_data_size < 4 )
 		 || ( safe_compressed_data_size > chunk_data->compressed_data_size ) )
@@ -886,14 +1270,23 @@ int libewf_chunk_data_pack_with_compression(
 	return( result );
 
 on_error:
+	if( compression_context != NULL )
+	{
+		libewf_io_handle_release_compression_context(
+		 io_handle,
+		 &compression_context,
+		 NULL );
+	}
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
-
-		chunk_data->compressed_data = NULL;
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 &( chunk_data->compressed_data ),
+		 chunk_data->allocated_compressed_data_size,
+		 NULL );
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
+	chunk_data->allocated_compressed_data_size = 0;
 
 	return( -1 );
 }
@@ -1008,6 +1401,12 @@ int libewf_chunk_data_pack(
 				goto on_error;
 			}
 		}
+		else if( ( pack_flags & LIBEWF_PACK_FLAG_SKIP_COMPRESSION ) != 0 )
+		{
+			/* The chunk data is incompressible and is stored uncompressed
+			 */
+			chunk_data->chunk_io_flags |= LIBEWF_CHUNK_IO_FLAG_IS_INCOMPRESSIBLE;
+		}
 		else
 		{
 			result = libewf_chunk_data_pack_with_compression(
@@ -1053,15 +1452,30 @@ int libewf_chunk_data_pack(
 	{
 		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			memory_free(
-			 chunk_data->data );
+			if( libewf_chunk_data_free_buffer(
+			     chunk_data,
+			     &( chunk_data->data ),
+			     chunk_data->allocated_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		chunk_data->data      = chunk_data->compressed_data;
-		chunk_data->data_size = chunk_data->compressed_data_size;
-		chunk_data->flags     = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->data_size           = chunk_data->compressed_data_size;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
+		chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
 	}
 	else if( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 )
 	{
@@ -1091,7 +1505,7 @@ int libewf_chunk_data_pack(
 		}
 		else
 		{
-			chunk_data->chunk_io_flags = LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET;
+			chunk_data->chunk_io_flags |= LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET;
 		}
 		chunk_data->range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
 	}
@@ -1137,12 +1551,14 @@ int libewf_chunk_data_pack(
 on_error:
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
-
-		chunk_data->compressed_data = NULL;
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 &( chunk_data->compressed_data ),
+		 chunk_data->allocated_compressed_data_size,
+		 NULL );
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
+	chunk_data->allocated_compressed_data_size = 0;
 
 	return( -1 );
 }
@@ -1156,9 +1572,12 @@ int libewf_chunk_data_unpack(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function        = "libewf_chunk_data_unpack";
-	size_t remaining_chunk_size  = 0;
-	uint32_t calculated_checksum = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_chunk_data_unpack";
+	size_t remaining_chunk_size                       = 0;
+	uint32_t calculated_checksum                      = 0;
+	uint8_t compressed_data_is_mapped                 = 0;
+	int result                                        = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1222,25 +1641,30 @@ int libewf_chunk_data_unpack(
 
 			return( -1 );
 		}
+		/* Data that is not managed references a file mapping
+		 */
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) == 0 )
+		{
+			compressed_data_is_mapped = 1;
+		}
 		chunk_data->compressed_data      = chunk_data->data;
 		chunk_data->compressed_data_size = chunk_data->data_size;
 
-		/* Reserve 4 bytes for the checksum
-		 */
-		chunk_data->allocated_data_size = (size_t) ( chunk_data->chunk_size + 4 );
-
-		/* The allocated data size should be rounded to the next 16-byte increment
-		 */
-		if( ( chunk_data->allocated_data_size % 16 ) != 0 )
+		if( compressed_data_is_mapped == 0 )
 		{
-			chunk_data->allocated_data_size += 16;
+			chunk_data->allocated_compressed_data_size = chunk_data->allocated_data_size;
 		}
-		chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
-
-		chunk_data->data = (uint8_t *) memory_allocate(
-		                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
+		chunk_data->data                = NULL;
+		chunk_data->allocated_data_size = 0;
 
-		if( chunk_data->data == NULL )
+		/* Reserve 4 bytes for the checksum
+		 */
+		if( libewf_chunk_data_allocate_buffer(
+		     chunk_data,
+		     (size_t) chunk_data->chunk_size + 4,
+		     &( chunk_data->data ),
+		     &( chunk_data->allocated_data_size ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1251,6 +1675,8 @@ int libewf_chunk_data_unpack(
 
 			goto on_error;
 		}
+		chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+
 		if( memory_set(
 		     chunk_data->data,
 		     0,
@@ -1327,13 +1753,44 @@ int libewf_chunk_data_unpack(
 		}
 		else
 		{
-			if( libewf_decompress_data(
-			     chunk_data->compressed_data,
-			     chunk_data->compressed_data_size,
-			     io_handle->compression_method,
-			     chunk_data->data,
-			     &( chunk_data->data_size ),
+			if( libewf_io_handle_grab_compression_context(
+			     io_handle,
+			     &compression_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab compression context.",
+				 function );
+
+				goto on_error;
+			}
+			result = libewf_compression_context_decompress_data(
+			          compression_context,
+			          chunk_data->compressed_data,
+			          chunk_data->compressed_data_size,
+			          io_handle->compression_method,
+			          chunk_data->data,
+			          &( chunk_data->data_size ),
+			          error );
+
+			if( libewf_io_handle_release_compression_context(
+			     io_handle,
+			     &compression_context,
 			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release compression context.",
+				 function );
+
+				goto on_error;
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1360,6 +1817,14 @@ int libewf_chunk_data_unpack(
 				chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 			}
 		}
+		/* The compressed data in a file mapping is not owned by the chunk data
+		 */
+		if( compressed_data_is_mapped != 0 )
+		{
+			chunk_data->compressed_data                = NULL;
+			chunk_data->compressed_data_size           = 0;
+			chunk_data->allocated_compressed_data_size = 0;
+		}
 	}
 	else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
 	{
@@ -1431,6 +1896,33 @@ int libewf_chunk_data_unpack(
 	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
 	 && ( io_handle->zero_on_error != 0 ) )
 	{
+		/* Data in a file mapping is read-only hence it is zeroed in a managed buffer
+		 */
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) == 0 )
+		{
+			chunk_data->data                = NULL;
+			chunk_data->allocated_data_size = 0;
+
+			/* Reserve 4 bytes for the checksum
+			 */
+			if( libewf_chunk_data_allocate_buffer(
+			     chunk_data,
+			     (size_t) chunk_data->chunk_size + 4,
+			     &( chunk_data->data ),
+			     &( chunk_data->allocated_data_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create data.",
+				 function );
+
+				goto on_error;
+			}
+			chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		}
 		if( memory_set(
 		     chunk_data->data,
 		     0,
@@ -1455,14 +1947,23 @@ on_error:
 	{
 		if( chunk_data->data != NULL )
 		{
-			memory_free(
-			 chunk_data->data );
+			libewf_chunk_data_free_buffer(
+			 chunk_data,
+			 &( chunk_data->data ),
+			 chunk_data->allocated_data_size,
+			 NULL );
 		}
-		chunk_data->data      = chunk_data->compressed_data;
-		chunk_data->data_size = chunk_data->compressed_data_size;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->data_size           = chunk_data->compressed_data_size;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+		if( compressed_data_is_mapped != 0 )
+		{
+			chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA );
+		}
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
 	}
 	return( -1 );
 }
@@ -1635,6 +2136,138 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 	return( 1 );
 }
 
+/* Checks if a buffer containing the chunk data is incompressible
+ * The byte values of samples spread over the chunk data are counted, when the byte values
+ * are nearly uniformly distributed the data, like encrypted or already compressed data,
+ * has a high entropy and deflate compression will not make it smaller
+ * The differences between successive byte values are counted as well, so that structured
+ * data that uses all byte values, like a sequence of incrementing values, is not considered
+ * incompressible
+ * Returns 1 if the data is incompressible, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_incompressible_data(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint16_t byte_value_counts[ 256 ];
+	uint16_t difference_counts[ 256 ];
+
+	static char *function                     = "libewf_chunk_data_check_for_incompressible_data";
+	size_t data_offset                        = 0;
+	size_t number_of_sampled_bytes            = 0;
+	size_t sample_offset                      = 0;
+	size_t sample_stride                      = 0;
+	uint32_t sum_of_squared_counts            = 0;
+	uint32_t sum_of_squared_difference_counts = 0;
+	uint32_t threshold                        = 0;
+	uint16_t byte_value                       = 0;
+	uint8_t difference                        = 0;
+	uint8_t previous_byte_value               = 0;
+	int sample_index                          = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_sampled_bytes = LIBEWF_INCOMPRESSIBLE_DATA_NUMBER_OF_SAMPLES * LIBEWF_INCOMPRESSIBLE_DATA_SAMPLE_SIZE;
+
+	/* Too few bytes to reliably determine the distribution of the byte values
+	 */
+	if( data_size < number_of_sampled_bytes )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     byte_value_counts,
+	     0,
+	     sizeof( uint16_t ) * 256 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear byte value counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     difference_counts,
+	     0,
+	     sizeof( uint16_t ) * 256 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear difference counts.",
+		 function );
+
+		return( -1 );
+	}
+	sample_stride = ( data_size - LIBEWF_INCOMPRESSIBLE_DATA_SAMPLE_SIZE ) / ( LIBEWF_INCOMPRESSIBLE_DATA_NUMBER_OF_SAMPLES - 1 );
+
+	for( sample_index = 0;
+	     sample_index < LIBEWF_INCOMPRESSIBLE_DATA_NUMBER_OF_SAMPLES;
+	     sample_index++ )
+	{
+		data_offset         = sample_offset;
+		previous_byte_value = data[ data_offset ];
+
+		while( data_offset < ( sample_offset + LIBEWF_INCOMPRESSIBLE_DATA_SAMPLE_SIZE ) )
+		{
+			byte_value = data[ data_offset++ ];
+			difference = (uint8_t) ( byte_value - previous_byte_value );
+
+			byte_value_counts[ byte_value ] += 1;
+			difference_counts[ difference ] += 1;
+
+			previous_byte_value = (uint8_t) byte_value;
+		}
+		sample_offset += sample_stride;
+	}
+	for( byte_value = 0;
+	     byte_value < 256;
+	     byte_value++ )
+	{
+		sum_of_squared_counts            += (uint32_t) byte_value_counts[ byte_value ] * byte_value_counts[ byte_value ];
+		sum_of_squared_difference_counts += (uint32_t) difference_counts[ byte_value ] * difference_counts[ byte_value ];
+	}
+	/* For uniformly distributed byte values the sum of the squared counts is expected
+	 * to be close to: ( number of sampled bytes ^ 2 / 256 ) + number of sampled bytes
+	 * Data that compresses has less distinct or more unevenly distributed byte values
+	 * and hence a considerably larger sum of the squared counts
+	 */
+	threshold = (uint32_t) ( ( number_of_sampled_bytes * number_of_sampled_bytes ) / 256 )
+	          + (uint32_t) ( 2 * number_of_sampled_bytes );
+
+	if( ( sum_of_squared_counts > threshold )
+	 || ( sum_of_squared_difference_counts > threshold ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Writes a chunk
  * Returns 1 if successful or -1 on error
  */
@@ -1999,6 +2632,149 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 	return( read_count );
 }
 
+/* Creates chunk data that references the packed chunk data in a file mapping
+ * The data is not copied and remains owned by the file mapping until the chunk data is unpacked
+ * Make sure the value chunk_data is referencing, is set to NULL
+ * Returns 1 if successful, 0 if the chunk data is not mapped or -1 on error
+ */
+int libewf_chunk_data_initialize_from_file_mapping(
+     libewf_chunk_data_t **chunk_data,
+     size32_t chunk_size,
+     libewf_file_mapping_t *file_mapping,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_chunk_data_initialize_from_file_mapping";
+	uint8_t *mapped_data     = NULL;
+	size_t maximum_data_size = 0;
+	int result               = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The packed chunk data is bound by the same size as the data allocated by libewf_chunk_data_initialize
+	 */
+	maximum_data_size = (size_t) chunk_size + 4;
+
+	if( ( maximum_data_size % 16 ) != 0 )
+	{
+		maximum_data_size += 16;
+	}
+	maximum_data_size = ( maximum_data_size / 16 ) * 16;
+
+	if( ( chunk_data_size == (size64_t) 0 )
+	 || ( chunk_data_size > (size64_t) maximum_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_file_mapping_get_data_at_offset(
+	          file_mapping,
+	          chunk_data_offset,
+	          chunk_data_size,
+	          &mapped_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapped data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 chunk_data_offset,
+		 chunk_data_offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	*chunk_data = memory_allocate_structure(
+	               libewf_chunk_data_t );
+
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *chunk_data,
+	     0,
+	     sizeof( libewf_chunk_data_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data.",
+		 function );
+
+		memory_free(
+		 *chunk_data );
+
+		*chunk_data = NULL;
+
+		return( -1 );
+	}
+	( *chunk_data )->chunk_size = chunk_size;
+	( *chunk_data )->data       = mapped_data;
+	( *chunk_data )->data_size  = (size_t) chunk_data_size;
+	( *chunk_data )->flags      = LIBEWF_CHUNK_DATA_ITEM_FLAG_NON_MANAGED_DATA;
+
+	( *chunk_data )->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+	                             & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	return( 1 );
+}
+
 /* Reads chunk data
  * Callback function for the chunks list
  * Returns 1 if successful or -1 on error
@@ -2054,8 +2830,9 @@ int libewf_chunk_data_read_element_data(
 
 		return( -1 );
 	}
-	if( libewf_chunk_data_initialize(
+	if( libewf_chunk_data_initialize_from_pool(
 	     &chunk_data,
+	     io_handle->chunk_data_pool,
 	     io_handle->chunk_size,
 	     0,
 	     error ) != 1 )
@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data_pool.h"
+#include "libewf_file_mapping.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -70,6 +72,10 @@ struct libewf_chunk_data
 	 */
 	size_t compressed_data_size;
 
+	/* The allocated compressed data size
+	 */
+	size_t allocated_compressed_data_size;
+
 	/* The padding size
 	 */
 	size_t padding_size;
@@ -97,6 +103,11 @@ struct libewf_chunk_data
 	/* The range end offset
 	 */
 	off64_t range_end_offset;
+
+	/* The chunk data pool the data and the chunk data are allocated from,
+	 * not owned by the chunk data
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
 };
 
 int libewf_chunk_data_initialize(
@@ -105,10 +116,30 @@ int libewf_chunk_data_initialize(
      uint8_t clear_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_initialize_from_pool(
+     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size32_t chunk_size,
+     uint8_t clear_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
 ssize_t libewf_chunk_data_read_buffer(
          libewf_chunk_data_t *chunk_data,
          uint8_t *buffer,
@@ -166,6 +197,11 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error );
 
+int libewf_chunk_data_check_for_incompressible_data(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 ssize_t libewf_chunk_data_write(
          libewf_chunk_data_t *chunk_data,
          libbfio_pool_t *file_io_pool,
@@ -192,6 +228,15 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error );
 
+int libewf_chunk_data_initialize_from_file_mapping(
+     libewf_chunk_data_t **chunk_data,
+     size32_t chunk_size,
+     libewf_file_mapping_t *file_mapping,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
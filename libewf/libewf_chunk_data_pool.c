@@ -0,0 +1,863 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data_pool.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a chunk data pool
+ * Make sure the value chunk_data_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     size_t structure_size,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_initialize";
+	size_t entries_size   = 0;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( structure_size == 0 )
+	 || ( structure_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid structure size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( (size_t) maximum_number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint8_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_data_pool = memory_allocate_structure(
+	                    libewf_chunk_data_pool_t );
+
+	if( *chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_data_pool,
+	     0,
+	     sizeof( libewf_chunk_data_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data pool.",
+		 function );
+
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+
+		return( -1 );
+	}
+	entries_size = sizeof( uint8_t * ) * (size_t) maximum_number_of_entries;
+
+	( *chunk_data_pool )->buffers = (uint8_t **) memory_allocate(
+	                                              entries_size );
+
+	if( ( *chunk_data_pool )->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	entries_size = sizeof( intptr_t * ) * (size_t) maximum_number_of_entries;
+
+	( *chunk_data_pool )->structures = (intptr_t **) memory_allocate(
+	                                                  entries_size );
+
+	if( ( *chunk_data_pool )->structures == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create structures.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *chunk_data_pool )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *chunk_data_pool )->structure_size            = structure_size;
+	( *chunk_data_pool )->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_data_pool != NULL )
+	{
+		if( ( *chunk_data_pool )->structures != NULL )
+		{
+			memory_free(
+			 ( *chunk_data_pool )->structures );
+		}
+		if( ( *chunk_data_pool )->buffers != NULL )
+		{
+			memory_free(
+			 ( *chunk_data_pool )->buffers );
+		}
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk data pool
+ * The buffers and structures that are in use are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data_pool != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *chunk_data_pool )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( entry_index = 0;
+		     entry_index < ( *chunk_data_pool )->number_of_buffers;
+		     entry_index++ )
+		{
+			memory_free(
+			 ( *chunk_data_pool )->buffers[ entry_index ] );
+		}
+		for( entry_index = 0;
+		     entry_index < ( *chunk_data_pool )->number_of_structures;
+		     entry_index++ )
+		{
+			memory_free(
+			 ( *chunk_data_pool )->structures[ entry_index ] );
+		}
+		memory_free(
+		 ( *chunk_data_pool )->structures );
+
+		memory_free(
+		 ( *chunk_data_pool )->buffers );
+
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+	}
+	return( result );
+}
+
+/* Empties the buffers of a chunk data pool
+ * The buffers that are not in use are freed and the pool buffer size is reset
+ * The buffers that are in use are freed when released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_empty_buffers(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_empty_buffers";
+	int entry_index       = 0;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < chunk_data_pool->number_of_buffers;
+	     entry_index++ )
+	{
+		memory_free(
+		 chunk_data_pool->buffers[ entry_index ] );
+
+		chunk_data_pool->buffers[ entry_index ] = NULL;
+	}
+	chunk_data_pool->number_of_buffers = 0;
+	chunk_data_pool->buffer_size       = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Grabs a buffer of the requested size rounded to the next 16-byte increment
+ * The pool buffer size is set by the first buffer that is grabbed
+ * A previously released buffer is reused if available otherwise a new one is allocated
+ * Buffers of a different size than the pool buffer size are allocated outside the pool
+ * and freed on release, this prevents that a single smaller or larger allocation ties up
+ * or flushes the buffers of the pool buffer size
+ * The buffer must be released with libewf_chunk_data_pool_release_buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_grab_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size_t size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t *safe_buffer    = NULL;
+	static char *function   = "libewf_chunk_data_pool_grab_buffer";
+	size_t safe_buffer_size = 0;
+	int entry_index         = 0;
+	int result              = 1;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The buffer size should be rounded to the next 16-byte increment
+	 */
+	if( ( size % 16 ) != 0 )
+	{
+		size += 16;
+	}
+	size = ( size / 16 ) * 16;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_data_pool->buffer_size == 0 )
+	{
+		chunk_data_pool->buffer_size = size;
+	}
+	safe_buffer_size = size;
+
+	if( ( size == chunk_data_pool->buffer_size )
+	 && ( chunk_data_pool->number_of_buffers > 0 ) )
+	{
+		chunk_data_pool->number_of_buffers -= 1;
+
+		entry_index = chunk_data_pool->number_of_buffers;
+
+		safe_buffer = chunk_data_pool->buffers[ entry_index ];
+
+		chunk_data_pool->buffers[ entry_index ] = NULL;
+
+		chunk_data_pool->number_of_reuses += 1;
+	}
+	else
+	{
+		chunk_data_pool->number_of_allocations += 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( ( result == 1 )
+	 && ( safe_buffer == NULL ) )
+	{
+		safe_buffer = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * safe_buffer_size );
+
+		if( safe_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		if( safe_buffer != NULL )
+		{
+			memory_free(
+			 safe_buffer );
+		}
+		return( -1 );
+	}
+	*buffer      = safe_buffer;
+	*buffer_size = safe_buffer_size;
+
+	return( 1 );
+}
+
+/* Releases a buffer
+ * The buffer is retained for reuse if the pool is not full otherwise it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_release_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_release_buffer";
+	int is_retained       = 0;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Buffers that were allocated outside the pool, or before the pool was emptied,
+	 * have a different size and are not retained
+	 */
+	if( ( buffer_size == chunk_data_pool->buffer_size )
+	 && ( chunk_data_pool->number_of_buffers < chunk_data_pool->maximum_number_of_entries ) )
+	{
+		chunk_data_pool->buffers[ chunk_data_pool->number_of_buffers ] = *buffer;
+
+		chunk_data_pool->number_of_buffers += 1;
+
+		is_retained = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( is_retained == 0 )
+	{
+		memory_free(
+		 *buffer );
+	}
+	*buffer = NULL;
+
+	return( 1 );
+}
+
+/* Grabs a structure
+ * A previously released structure is reused if available otherwise a new one is allocated
+ * The structure is not cleared and must be released with libewf_chunk_data_pool_release_structure
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_grab_structure(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     intptr_t **structure,
+     libcerror_error_t **error )
+{
+	intptr_t *safe_structure = NULL;
+	static char *function    = "libewf_chunk_data_pool_grab_structure";
+	int entry_index          = 0;
+	int result               = 1;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( structure == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid structure.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_data_pool->number_of_structures > 0 )
+	{
+		chunk_data_pool->number_of_structures -= 1;
+
+		entry_index = chunk_data_pool->number_of_structures;
+
+		safe_structure = chunk_data_pool->structures[ entry_index ];
+
+		chunk_data_pool->structures[ entry_index ] = NULL;
+
+		chunk_data_pool->number_of_reuses += 1;
+	}
+	else
+	{
+		chunk_data_pool->number_of_allocations += 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( ( result == 1 )
+	 && ( safe_structure == NULL ) )
+	{
+		safe_structure = (intptr_t *) memory_allocate(
+		                               chunk_data_pool->structure_size );
+
+		if( safe_structure == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create structure.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		if( safe_structure != NULL )
+		{
+			memory_free(
+			 safe_structure );
+		}
+		return( -1 );
+	}
+	*structure = safe_structure;
+
+	return( 1 );
+}
+
+/* Releases a structure
+ * The structure is retained for reuse if the pool is not full otherwise it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_release_structure(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     intptr_t **structure,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_release_structure";
+	int is_retained       = 0;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( structure == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid structure.",
+		 function );
+
+		return( -1 );
+	}
+	if( *structure == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_data_pool->number_of_structures < chunk_data_pool->maximum_number_of_entries )
+	{
+		chunk_data_pool->structures[ chunk_data_pool->number_of_structures ] = *structure;
+
+		chunk_data_pool->number_of_structures += 1;
+
+		is_retained = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( is_retained == 0 )
+	{
+		memory_free(
+		 *structure );
+	}
+	*structure = NULL;
+
+	return( 1 );
+}
+
+/* Retrieves the number of allocated and reused buffers and structures
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_get_statistics(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_get_statistics";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_allocations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of allocations.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reuses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reuses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_allocations = chunk_data_pool->number_of_allocations;
+	*number_of_reuses      = chunk_data_pool->number_of_reuses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_data_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
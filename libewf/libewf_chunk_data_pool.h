@@ -0,0 +1,134 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_DATA_POOL_H )
+#define _LIBEWF_CHUNK_DATA_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_data_pool libewf_chunk_data_pool_t;
+
+/* The chunk data pool retains the buffers and structures of chunk data
+ * that are no longer in use, so that they can be reused for the next chunk
+ * instead of being allocated again
+ */
+struct libewf_chunk_data_pool
+{
+	/* The size of the buffers, which is set by the first buffer that is grabbed
+	 */
+	size_t buffer_size;
+
+	/* The buffers that are currently not in use
+	 */
+	uint8_t **buffers;
+
+	/* The number of buffers that are currently not in use
+	 */
+	int number_of_buffers;
+
+	/* The size of the structures
+	 */
+	size_t structure_size;
+
+	/* The structures that are currently not in use
+	 */
+	intptr_t **structures;
+
+	/* The number of structures that are currently not in use
+	 */
+	int number_of_structures;
+
+	/* The maximum number of buffers and structures that are retained
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of buffers and structures that were allocated
+	 */
+	uint64_t number_of_allocations;
+
+	/* The number of buffers and structures that were reused
+	 */
+	uint64_t number_of_reuses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     size_t structure_size,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_empty_buffers(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_grab_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size_t size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_release_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_grab_structure(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     intptr_t **structure,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_release_structure(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     intptr_t **structure,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_get_statistics(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_DATA_POOL_H ) */
+
@@ -0,0 +1,723 @@
+/*
+ * Chunk location table functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_location_table.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* The range flags that can be stored in a packed chunk location
+ */
+static const uint32_t libewf_chunk_location_table_range_flags[ 8 ] = {
+	LIBEWF_RANGE_FLAG_IS_SPARSE,
+	LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	LIBEWF_RANGE_FLAG_USES_PATTERN_FILL,
+	LIBEWF_RANGE_FLAG_IS_PACKED,
+	LIBEWF_RANGE_FLAG_IS_TAINTED,
+	LIBEWF_RANGE_FLAG_IS_CORRUPTED,
+	LIBEWF_RANGE_FLAG_IS_ENCRYPTED };
+
+/* Creates a chunk location table
+ * Make sure the value chunk_location_table is referencing, is set to NULL
+ * The maximum size includes the size of the block index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_location_table_initialize(
+     libewf_chunk_location_table_t **chunk_location_table,
+     uint64_t number_of_chunks,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_chunk_location_table_initialize";
+	size_t blocks_size        = 0;
+	size_t blocks_status_size = 0;
+	uint64_t number_of_blocks = 0;
+
+	if( chunk_location_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk location table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_location_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk location table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of chunks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = number_of_chunks / LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE;
+
+	if( ( number_of_chunks % LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	if( number_of_blocks > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_chunk_location_block_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of chunks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	blocks_size        = sizeof( libewf_chunk_location_block_t * ) * (size_t) number_of_blocks;
+	blocks_status_size = sizeof( uint8_t ) * (size_t) number_of_blocks;
+
+	if( maximum_size < (size64_t) ( blocks_size + blocks_status_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_location_table = memory_allocate_structure(
+	                         libewf_chunk_location_table_t );
+
+	if( *chunk_location_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk location table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_location_table,
+	     0,
+	     sizeof( libewf_chunk_location_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk location table.",
+		 function );
+
+		memory_free(
+		 *chunk_location_table );
+
+		*chunk_location_table = NULL;
+
+		return( -1 );
+	}
+	( *chunk_location_table )->blocks = (libewf_chunk_location_block_t **) memory_allocate(
+	                                                                        blocks_size );
+
+	if( ( *chunk_location_table )->blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_location_table )->blocks,
+	     0,
+	     blocks_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear blocks.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_location_table )->blocks_status = (uint8_t *) memory_allocate(
+	                                                        blocks_status_size );
+
+	if( ( *chunk_location_table )->blocks_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks status.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_location_table )->blocks_status,
+	     LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_UNSET,
+	     blocks_status_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear blocks status.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_location_table )->number_of_chunks = number_of_chunks;
+	( *chunk_location_table )->number_of_blocks = number_of_blocks;
+	( *chunk_location_table )->maximum_size     = maximum_size;
+	( *chunk_location_table )->size             = (size64_t) ( blocks_size + blocks_status_size );
+
+	return( 1 );
+
+on_error:
+	if( *chunk_location_table != NULL )
+	{
+		if( ( *chunk_location_table )->blocks_status != NULL )
+		{
+			memory_free(
+			 ( *chunk_location_table )->blocks_status );
+		}
+		if( ( *chunk_location_table )->blocks != NULL )
+		{
+			memory_free(
+			 ( *chunk_location_table )->blocks );
+		}
+		memory_free(
+		 *chunk_location_table );
+
+		*chunk_location_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk location table
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_location_table_free(
+     libewf_chunk_location_table_t **chunk_location_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_location_table_free";
+	uint64_t block_index  = 0;
+
+	if( chunk_location_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk location table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_location_table != NULL )
+	{
+		for( block_index = 0;
+		     block_index < ( *chunk_location_table )->number_of_blocks;
+		     block_index++ )
+		{
+			if( ( *chunk_location_table )->blocks[ block_index ] != NULL )
+			{
+				memory_free(
+				 ( *chunk_location_table )->blocks[ block_index ] );
+			}
+		}
+		memory_free(
+		 ( *chunk_location_table )->blocks_status );
+
+		memory_free(
+		 ( *chunk_location_table )->blocks );
+
+		memory_free(
+		 *chunk_location_table );
+
+		*chunk_location_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the status of the block that contains a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_location_table_get_block_status(
+     libewf_chunk_location_table_t *chunk_location_table,
+     uint64_t chunk_index,
+     uint8_t *block_status,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_location_table_get_block_status";
+
+	if( chunk_location_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk location table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= chunk_location_table->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block status.",
+		 function );
+
+		return( -1 );
+	}
+	*block_status = chunk_location_table->blocks_status[ chunk_index / LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+
+	return( 1 );
+}
+
+/* Sets the chunk locations of the block that contains a specific chunk
+ * The locations must be provided for every chunk in the block
+ * If the locations cannot be packed or the maximum size would be exceeded
+ * the block is marked as not indexed
+ * Returns 1 if successful, 0 if the block is not indexed or -1 on error
+ */
+int libewf_chunk_location_table_set_block(
+     libewf_chunk_location_table_t *chunk_location_table,
+     uint64_t chunk_index,
+     const int *file_io_pool_entries,
+     const off64_t *data_offsets,
+     const size64_t *data_sizes,
+     const uint32_t *range_flags,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	libewf_chunk_location_block_t *block = NULL;
+	static char *function                = "libewf_chunk_location_table_set_block";
+	uint64_t block_index                 = 0;
+	uint64_t expected_number_of_entries  = 0;
+	uint64_t packed_location             = 0;
+	uint64_t relative_data_offset        = 0;
+	uint32_t remaining_range_flags       = 0;
+	uint8_t packed_range_flags           = 0;
+	int entry_index                      = 0;
+	int flag_index                       = 0;
+	int relative_file_io_pool_entry      = 0;
+
+	if( chunk_location_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk location table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= chunk_location_table->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	block_index = chunk_index / LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE;
+
+	expected_number_of_entries = chunk_location_table->number_of_chunks - ( block_index * LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE );
+
+	if( expected_number_of_entries > LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE )
+	{
+		expected_number_of_entries = LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE;
+	}
+	if( (uint64_t) number_of_entries != expected_number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_location_table->blocks_status[ block_index ] != LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_UNSET )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk location table - block: %" PRIu64 " already set.",
+		 function,
+		 block_index );
+
+		return( -1 );
+	}
+	if( ( chunk_location_table->size + sizeof( libewf_chunk_location_block_t ) ) > chunk_location_table->maximum_size )
+	{
+		chunk_location_table->blocks_status[ block_index ] = LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_NOT_INDEXED;
+
+		return( 0 );
+	}
+	block = memory_allocate_structure(
+	         libewf_chunk_location_block_t );
+
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block.",
+		 function );
+
+		return( -1 );
+	}
+	block->base_file_io_pool_entry = file_io_pool_entries[ 0 ];
+	block->base_data_offset        = data_offsets[ 0 ];
+
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		relative_file_io_pool_entry = file_io_pool_entries[ entry_index ] - block->base_file_io_pool_entry;
+
+		if( ( relative_file_io_pool_entry < 0 )
+		 || ( relative_file_io_pool_entry > 0x0f ) )
+		{
+			break;
+		}
+		if( data_offsets[ entry_index ] < 0 )
+		{
+			break;
+		}
+		if( relative_file_io_pool_entry == 0 )
+		{
+			if( data_offsets[ entry_index ] < block->base_data_offset )
+			{
+				break;
+			}
+			relative_data_offset = (uint64_t) ( data_offsets[ entry_index ] - block->base_data_offset );
+		}
+		else
+		{
+			relative_data_offset = (uint64_t) data_offsets[ entry_index ];
+		}
+		if( relative_data_offset > 0x0fffffffUL )
+		{
+			break;
+		}
+		if( data_sizes[ entry_index ] > 0x00ffffffUL )
+		{
+			break;
+		}
+		remaining_range_flags = range_flags[ entry_index ];
+		packed_range_flags    = 0;
+
+		for( flag_index = 0;
+		     flag_index < 8;
+		     flag_index++ )
+		{
+			if( ( remaining_range_flags & libewf_chunk_location_table_range_flags[ flag_index ] ) != 0 )
+			{
+				packed_range_flags    |= (uint8_t) ( 1 << flag_index );
+				remaining_range_flags &= ~( libewf_chunk_location_table_range_flags[ flag_index ] );
+			}
+		}
+		if( remaining_range_flags != 0 )
+		{
+			break;
+		}
+		packed_location  = (uint64_t) packed_range_flags << 56;
+		packed_location |= (uint64_t) data_sizes[ entry_index ] << 32;
+		packed_location |= (uint64_t) relative_file_io_pool_entry << 28;
+		packed_location |= relative_data_offset;
+
+		block->locations[ entry_index ] = packed_location;
+	}
+	if( entry_index < number_of_entries )
+	{
+		memory_free(
+		 block );
+
+		chunk_location_table->blocks_status[ block_index ] = LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_NOT_INDEXED;
+
+		return( 0 );
+	}
+	chunk_location_table->blocks[ block_index ]        = block;
+	chunk_location_table->blocks_status[ block_index ] = LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_SET;
+	chunk_location_table->size                        += sizeof( libewf_chunk_location_block_t );
+
+	return( 1 );
+}
+
+/* Marks the block that contains a specific chunk as not indexed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_location_table_set_block_not_indexed(
+     libewf_chunk_location_table_t *chunk_location_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_location_table_set_block_not_indexed";
+	uint64_t block_index  = 0;
+
+	if( chunk_location_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk location table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= chunk_location_table->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	block_index = chunk_index / LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE;
+
+	if( chunk_location_table->blocks[ block_index ] != NULL )
+	{
+		memory_free(
+		 chunk_location_table->blocks[ block_index ] );
+
+		chunk_location_table->blocks[ block_index ] = NULL;
+		chunk_location_table->size                 -= sizeof( libewf_chunk_location_block_t );
+	}
+	chunk_location_table->blocks_status[ block_index ] = LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_NOT_INDEXED;
+
+	return( 1 );
+}
+
+/* Retrieves the location of a specific chunk
+ * Returns 1 if successful, 0 if the block that contains the chunk is not set or -1 on error
+ */
+int libewf_chunk_location_table_get_chunk_location(
+     libewf_chunk_location_table_t *chunk_location_table,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *data_offset,
+     size64_t *data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_location_block_t *block = NULL;
+	static char *function                = "libewf_chunk_location_table_get_chunk_location";
+	uint64_t packed_location             = 0;
+	uint32_t safe_range_flags            = 0;
+	uint8_t packed_range_flags           = 0;
+	int flag_index                       = 0;
+	int relative_file_io_pool_entry      = 0;
+
+	if( chunk_location_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk location table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= chunk_location_table->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	block = chunk_location_table->blocks[ chunk_index / LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+
+	if( block == NULL )
+	{
+		return( 0 );
+	}
+	packed_location = block->locations[ chunk_index % LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+
+	packed_range_flags          = (uint8_t) ( packed_location >> 56 );
+	relative_file_io_pool_entry = (int) ( ( packed_location >> 28 ) & 0x0f );
+
+	for( flag_index = 0;
+	     flag_index < 8;
+	     flag_index++ )
+	{
+		if( ( packed_range_flags & ( 1 << flag_index ) ) != 0 )
+		{
+			safe_range_flags |= libewf_chunk_location_table_range_flags[ flag_index ];
+		}
+	}
+	*file_io_pool_entry = block->base_file_io_pool_entry + relative_file_io_pool_entry;
+	*data_offset        = (off64_t) ( packed_location & 0x0fffffffUL );
+	*data_size          = (size64_t) ( ( packed_location >> 32 ) & 0x00ffffffUL );
+	*range_flags        = safe_range_flags;
+
+	if( relative_file_io_pool_entry == 0 )
+	{
+		*data_offset += block->base_data_offset;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,142 @@
+/*
+ * Chunk location table functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_LOCATION_TABLE_H )
+#define _LIBEWF_CHUNK_LOCATION_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of chunk locations per block
+ */
+#define LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE			64
+
+enum LIBEWF_CHUNK_LOCATION_BLOCK_STATUS
+{
+	LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_UNSET		= 0,
+	LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_SET			= 1,
+	LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_NOT_INDEXED		= 2
+};
+
+typedef struct libewf_chunk_location_block libewf_chunk_location_block_t;
+
+/* A chunk location is packed in 64-bit as:
+ * bits  0 - 27: data offset, relative to the base data offset if stored in the base file IO pool entry
+ * bits 28 - 31: file IO pool entry, relative to the base file IO pool entry
+ * bits 32 - 55: data size
+ * bits 56 - 63: range flags
+ */
+struct libewf_chunk_location_block
+{
+	/* The base data offset
+	 */
+	off64_t base_data_offset;
+
+	/* The base file IO pool entry
+	 */
+	int base_file_io_pool_entry;
+
+	/* The packed chunk locations
+	 */
+	uint64_t locations[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+};
+
+typedef struct libewf_chunk_location_table libewf_chunk_location_table_t;
+
+struct libewf_chunk_location_table
+{
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+
+	/* The blocks
+	 */
+	libewf_chunk_location_block_t **blocks;
+
+	/* The status of the blocks
+	 */
+	uint8_t *blocks_status;
+
+	/* The maximum size
+	 */
+	size64_t maximum_size;
+
+	/* The (allocated) size
+	 */
+	size64_t size;
+};
+
+int libewf_chunk_location_table_initialize(
+     libewf_chunk_location_table_t **chunk_location_table,
+     uint64_t number_of_chunks,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_location_table_free(
+     libewf_chunk_location_table_t **chunk_location_table,
+     libcerror_error_t **error );
+
+int libewf_chunk_location_table_get_block_status(
+     libewf_chunk_location_table_t *chunk_location_table,
+     uint64_t chunk_index,
+     uint8_t *block_status,
+     libcerror_error_t **error );
+
+int libewf_chunk_location_table_set_block(
+     libewf_chunk_location_table_t *chunk_location_table,
+     uint64_t chunk_index,
+     const int *file_io_pool_entries,
+     const off64_t *data_offsets,
+     const size64_t *data_sizes,
+     const uint32_t *range_flags,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_location_table_set_block_not_indexed(
+     libewf_chunk_location_table_t *chunk_location_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_location_table_get_chunk_location(
+     libewf_chunk_location_table_t *chunk_location_table,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *data_offset,
+     size64_t *data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_LOCATION_TABLE_H ) */
+
@@ -24,13 +24,17 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_location_table.h"
 #include "libewf_chunk_table.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_segment_file.h"
@@ -126,16 +130,16 @@ int libewf_chunk_table_initialize(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *chunk_table )->chunk_data_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+	if( libewf_chunk_cache_initialize(
+	     &( ( *chunk_table )->chunk_cache ),
+	     LIBEWF_DEFAULT_MAXIMUM_CACHE_SIZE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk data cache.",
+		 "%s: unable to create chunk cache.",
 		 function );
 
 		goto on_error;
@@ -154,6 +158,35 @@ int libewf_chunk_table_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( ( *chunk_table )->chunk_views ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk views array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *chunk_table )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *chunk_table )->io_handle = io_handle;
 
 	return( 1 );
@@ -161,10 +194,30 @@ int libewf_chunk_table_initialize(
 on_error:
 	if( *chunk_table != NULL )
 	{
-		if( ( *chunk_table )->chunk_data_cache != NULL )
+		if( ( *chunk_table )->chunk_views != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *chunk_table )->chunk_views ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *chunk_table )->single_chunk_data_cache != NULL )
 		{
 			libfcache_cache_free(
-			 &( ( *chunk_table )->chunk_data_cache ),
+			 &( ( *chunk_table )->single_chunk_data_cache ),
+			 NULL );
+		}
+		if( ( *chunk_table )->chunk_cache != NULL )
+		{
+			libewf_chunk_cache_free(
+			 &( ( *chunk_table )->chunk_cache ),
+			 NULL );
+		}
+		if( ( *chunk_table )->checksum_errors != NULL )
+		{
+			libcdata_range_list_free(
+			 &( ( *chunk_table )->checksum_errors ),
+			 NULL,
 			 NULL );
 		}
 		memory_free(
@@ -182,8 +235,11 @@ int libewf_chunk_table_free(
      libewf_chunk_table_t **chunk_table,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_table_free";
-	int result            = 1;
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	static char *function                         = "libewf_chunk_table_free";
+	int chunk_view_index                          = 0;
+	int number_of_chunk_views                     = 0;
+	int result                                    = 1;
 
 	if( chunk_table == NULL )
 	{
@@ -198,6 +254,74 @@ int libewf_chunk_table_free(
 	}
 	if( *chunk_table != NULL )
 	{
+		/* Release the chunk data of chunk views that were not released
+		 */
+		if( libcdata_array_get_number_of_entries(
+		     ( *chunk_table )->chunk_views,
+		     &number_of_chunk_views,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunk views.",
+			 function );
+
+			result = -1;
+		}
+		for( chunk_view_index = 0;
+		     chunk_view_index < number_of_chunk_views;
+		     chunk_view_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     ( *chunk_table )->chunk_views,
+			     chunk_view_index,
+			     (intptr_t **) &chunk_cache_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk view: %d.",
+				 function,
+				 chunk_view_index );
+
+				result = -1;
+
+				continue;
+			}
+			if( libewf_chunk_cache_release_entry(
+			     ( *chunk_table )->chunk_cache,
+			     &chunk_cache_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk view: %d.",
+				 function,
+				 chunk_view_index );
+
+				result = -1;
+			}
+		}
+		if( libcdata_array_free(
+		     &( ( *chunk_table )->chunk_views ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk views array.",
+			 function );
+
+			result = -1;
+		}
 		if( libcdata_range_list_free(
 		     &( ( *chunk_table )->checksum_errors ),
 		     NULL,
@@ -212,15 +336,31 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
-		if( libfcache_cache_free(
-		     &( ( *chunk_table )->chunk_data_cache ),
+		if( ( *chunk_table )->chunk_location_table != NULL )
+		{
+			if( libewf_chunk_location_table_free(
+			     &( ( *chunk_table )->chunk_location_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk location table.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libewf_chunk_cache_free(
+		     &( ( *chunk_table )->chunk_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data cache.",
+			 "%s: unable to free chunk cache.",
 			 function );
 
 			result = -1;
@@ -238,6 +378,40 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
+		/* The file mappings are freed after the chunk cache since cached chunk data can reference them
+		 */
+		if( ( *chunk_table )->file_mappings != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *chunk_table )->file_mappings ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_file_mapping_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file mappings array.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *chunk_table )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *chunk_table );
 
@@ -320,8 +494,15 @@ int libewf_chunk_table_clone(
 	( *destination_chunk_table )->current_chunk_group     = NULL;
 	( *destination_chunk_table )->current_chunk_data      = NULL;
 	( *destination_chunk_table )->checksum_errors         = NULL;
-	( *destination_chunk_table )->chunk_data_cache        = NULL;
+	( *destination_chunk_table )->chunk_cache             = NULL;
 	( *destination_chunk_table )->single_chunk_data_cache = NULL;
+	( *destination_chunk_table )->chunk_views             = NULL;
+	( *destination_chunk_table )->chunk_location_table    = NULL;
+	( *destination_chunk_table )->file_mappings           = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *destination_chunk_table )->read_write_lock         = NULL;
+#endif
 
 	if( libcdata_range_list_clone(
 	     &( ( *destination_chunk_table )->checksum_errors ),
@@ -339,16 +520,16 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
-	if( libfcache_cache_clone(
-	     &( ( *destination_chunk_table )->chunk_data_cache ),
-	     source_chunk_table->chunk_data_cache,
+	if( libewf_chunk_cache_initialize(
+	     &( ( *destination_chunk_table )->chunk_cache ),
+	     source_chunk_table->chunk_cache->maximum_cache_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination chunk data cache.",
+		 "%s: unable to create destination chunk cache.",
 		 function );
 
 		goto on_error;
@@ -367,15 +548,83 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( ( *destination_chunk_table )->chunk_views ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunk views array.",
+		 function );
+
+		goto on_error;
+	}
+	/* The chunk locations of the destination are set on demand
+	 */
+	if( source_chunk_table->chunk_location_table != NULL )
+	{
+		if( libewf_chunk_location_table_initialize(
+		     &( ( *destination_chunk_table )->chunk_location_table ),
+		     source_chunk_table->chunk_location_table->number_of_chunks,
+		     source_chunk_table->chunk_location_table->maximum_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination chunk location table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *destination_chunk_table )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize destination read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *destination_chunk_table != NULL )
 	{
-		if( ( *destination_chunk_table )->chunk_data_cache != NULL )
+		if( ( *destination_chunk_table )->chunk_location_table != NULL )
+		{
+			libewf_chunk_location_table_free(
+			 &( ( *destination_chunk_table )->chunk_location_table ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->chunk_views != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *destination_chunk_table )->chunk_views ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->single_chunk_data_cache != NULL )
 		{
 			libfcache_cache_free(
-			 &( ( *destination_chunk_table )->chunk_data_cache ),
+			 &( ( *destination_chunk_table )->single_chunk_data_cache ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->chunk_cache != NULL )
+		{
+			libewf_chunk_cache_free(
+			 &( ( *destination_chunk_table )->chunk_cache ),
 			 NULL );
 		}
 		if( ( *destination_chunk_table )->checksum_errors != NULL )
@@ -393,16 +642,18 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the number of checksum errors
- * Returns 1 if successful or -1 on error
+/* Initializes the chunk location table
+ * The chunk location table is only used if its block index fits in the maximum size
+ * Returns 1 if successful, 0 if the maximum size is too small or -1 on error
  */
-int libewf_chunk_table_get_number_of_checksum_errors(
+int libewf_chunk_table_initialize_chunk_location_table(
      libewf_chunk_table_t *chunk_table,
-     uint32_t *number_of_errors,
+     uint64_t number_of_chunks,
+     size64_t maximum_size,
      libcerror_error_t **error )
 {
-	static char *function  = "libewf_chunk_table_get_number_of_checksum_errors";
-	int number_of_elements = 0;
+	static char *function     = "libewf_chunk_table_initialize_chunk_location_table";
+	uint64_t number_of_blocks = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -415,48 +666,64 @@ int libewf_chunk_table_get_number_of_checksum_errors(
 
 		return( -1 );
 	}
-	if( number_of_errors == NULL )
+	if( chunk_table->chunk_location_table != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid number of errors.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk table - chunk location table value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcdata_range_list_get_number_of_elements(
-	     chunk_table->checksum_errors,
-	     &number_of_elements,
+	if( number_of_chunks == 0 )
+	{
+		return( 0 );
+	}
+	number_of_blocks = number_of_chunks / LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE;
+
+	if( ( number_of_chunks % LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	if( ( number_of_blocks > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_chunk_location_block_t * ) ) )
+	 || ( maximum_size < ( number_of_blocks * ( sizeof( libewf_chunk_location_block_t * ) + sizeof( uint8_t ) ) ) ) )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_location_table_initialize(
+	     &( chunk_table->chunk_location_table ),
+	     number_of_chunks,
+	     maximum_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from range list.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk location table.",
 		 function );
 
 		return( -1 );
 	}
-	*number_of_errors = (uint32_t) number_of_elements;
-
 	return( 1 );
 }
 
-/* Retrieves a checksum error
+/* Sets the file mapping of a segment file
+ * The chunk table takes over management of the file mapping
+ * This function is not multi-thread safe, the file mappings are only set when the handle is opened
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_get_checksum_error(
+int libewf_chunk_table_set_file_mapping(
      libewf_chunk_table_t *chunk_table,
-     uint32_t error_index,
-     uint64_t *start_sector,
-     uint64_t *number_of_sectors,
+     int file_io_pool_entry,
+     libewf_file_mapping_t *file_mapping,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_table_get_checksum_error";
-	intptr_t *value       = NULL;
+	libewf_file_mapping_t *existing_file_mapping = NULL;
+	static char *function                        = "libewf_chunk_table_set_file_mapping";
+	int number_of_file_mappings                  = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -469,93 +736,2028 @@ int libewf_chunk_table_get_checksum_error(
 
 		return( -1 );
 	}
-	if( libcdata_range_list_get_range_by_index(
-	     chunk_table->checksum_errors,
-	     (int) error_index,
-	     start_sector,
-	     number_of_sectors,
-	     &value,
-	     error ) != 1 )
+	if( file_io_pool_entry < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve checksum error: %" PRIu32 " from range list.",
-		 function,
-		 error_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Appends a checksum error
- * Returns 1 if successful or -1 on error
- */
-int libewf_chunk_table_append_checksum_error(
-     libewf_chunk_table_t *chunk_table,
-     uint64_t start_sector,
-     uint64_t number_of_sectors,
-     libcerror_error_t **error )
-{
-	static char *function = "libewf_chunk_table_append_checksum_error";
-	int result            = 0;
-
-	if( chunk_table == NULL )
+	if( file_mapping == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk table.",
+		 "%s: invalid file mapping.",
 		 function );
 
 		return( -1 );
 	}
-	result = libcdata_range_list_insert_range(
-	          chunk_table->checksum_errors,
-	          start_sector,
-	          number_of_sectors,
-	          NULL,
-	          NULL,
-	          NULL,
-	          error );
+	if( chunk_table->file_mappings == NULL )
+	{
+		if( libcdata_array_initialize(
+		     &( chunk_table->file_mappings ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file mappings array.",
+			 function );
 
-	if( result == -1 )
+			return( -1 );
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     chunk_table->file_mappings,
+	     &number_of_file_mappings,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert checksum error in range list.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file mappings.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
+	if( file_io_pool_entry >= number_of_file_mappings )
+	{
+		if( libcdata_array_resize(
+		     chunk_table->file_mappings,
+		     file_io_pool_entry + 1,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_file_mapping_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize file mappings array.",
+			 function );
 
-/* Retrieves the chunk group in a segment file at a specific offset
- * Returns 1 if successful, 0 if not or -1 on error
- */
-int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
-     libewf_chunk_table_t *chunk_table,
-     libbfio_pool_t *file_io_pool,
-     libewf_segment_table_t *segment_table,
-     off64_t offset,
-     uint32_t *segment_number,
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libcdata_array_get_entry_by_index(
+		     chunk_table->file_mappings,
+		     file_io_pool_entry,
+		     (intptr_t **) &existing_file_mapping,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file mapping: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		if( existing_file_mapping != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid chunk table - file mapping: %d value already set.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+	}
+	if( libcdata_array_set_entry_by_index(
+	     chunk_table->file_mappings,
+	     file_io_pool_entry,
+	     (intptr_t *) file_mapping,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file mapping: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file mapping of a segment file
+ * Returns 1 if successful, 0 if the segment file is not mapped or -1 on error
+ */
+int libewf_chunk_table_get_file_mapping(
+     libewf_chunk_table_t *chunk_table,
+     int file_io_pool_entry,
+     libewf_file_mapping_t **file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_table_get_file_mapping";
+	int number_of_file_mappings = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	*file_mapping = NULL;
+
+	if( ( chunk_table->file_mappings == NULL )
+	 || ( file_io_pool_entry < 0 ) )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     chunk_table->file_mappings,
+	     &number_of_file_mappings,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file mappings.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry >= number_of_file_mappings )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     chunk_table->file_mappings,
+	     file_io_pool_entry,
+	     (intptr_t **) file_mapping,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file mapping: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( *file_mapping == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of checksum errors
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_number_of_checksum_errors(
+     libewf_chunk_table_t *chunk_table,
+     uint32_t *number_of_errors,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_table_get_number_of_checksum_errors";
+	int number_of_elements = 0;
+	int result             = 1;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_errors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of errors.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_range_list_get_number_of_elements(
+	     chunk_table->checksum_errors,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from range list.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*number_of_errors = (uint32_t) number_of_elements;
+	}
+	return( result );
+}
+
+/* Retrieves a checksum error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     uint32_t error_index,
+     uint64_t *start_sector,
+     uint64_t *number_of_sectors,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_get_checksum_error";
+	intptr_t *value       = NULL;
+	int result            = 1;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_range_list_get_range_by_index(
+	     chunk_table->checksum_errors,
+	     (int) error_index,
+	     start_sector,
+	     number_of_sectors,
+	     &value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve checksum error: %" PRIu32 " from range list.",
+		 function,
+		 error_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Appends a checksum error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_append_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_append_checksum_error";
+	int result            = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libcdata_range_list_insert_range(
+	          chunk_table->checksum_errors,
+	          start_sector,
+	          number_of_sectors,
+	          NULL,
+	          NULL,
+	          NULL,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert checksum error in range list.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk group in a segment file at a specific offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     uint32_t *segment_number,
      int *chunk_groups_list_index,
      off64_t *chunk_group_data_offset,
      libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file  = NULL;
-	static char *function                = "libewf_chunk_table_get_segment_file_chunk_group_by_offset";
-	off64_t safe_chunk_group_data_offset = 0;
-	off64_t segment_file_data_offset     = 0;
-	uint32_t safe_segment_number         = 0;
-	int result                           = 0;
+	libewf_segment_file_t *segment_file  = NULL;
+	static char *function                = "libewf_chunk_table_get_segment_file_chunk_group_by_offset";
+	off64_t safe_chunk_group_data_offset = 0;
+	off64_t segment_file_data_offset     = 0;
+	uint32_t safe_segment_number         = 0;
+	int result                           = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment number.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_groups_list_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk groups list index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk groups.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_table->current_chunk_group != NULL )
+	 && ( chunk_table->current_chunk_group->range_end_offset > 0 ) )
+	{
+		if( ( offset >= chunk_table->current_chunk_group->range_start_offset )
+		 && ( offset < chunk_table->current_chunk_group->range_end_offset ) )
+		{
+			safe_chunk_group_data_offset = offset - chunk_table->current_chunk_group->range_start_offset;
+
+			result = 1;
+		}
+	}
+	if( result == 0 )
+	{
+		result = libewf_segment_table_get_segment_file_at_offset(
+		          segment_table,
+		          offset,
+		          file_io_pool,
+		          &safe_segment_number,
+		          &segment_file_data_offset,
+		          &segment_file,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+/* TODO handle missing segment file */
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: missing segment file for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else
+		{
+			result = libewf_segment_file_get_chunk_group_by_offset(
+				  segment_file,
+				  file_io_pool,
+				  segment_file_data_offset,
+				  &( chunk_table->current_chunk_group_index ),
+				  &safe_chunk_group_data_offset,
+				  &( chunk_table->current_chunk_group ),
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk group from segment file: %" PRIu32 " for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 safe_segment_number,
+				 offset,
+				 offset );
+
+				return( -1 );
+			}
+		}
+	}
+	if( result != 0 )
+	{
+		*segment_number          = safe_segment_number;
+		*chunk_groups_list_index = chunk_table->current_chunk_group_index;
+		*chunk_group_data_offset = safe_chunk_group_data_offset;
+		*chunk_group             = chunk_table->current_chunk_group;
+	}
+	return( result );
+}
+
+/* Sets the chunk locations of the block in the chunk location table that contains a specific chunk
+ * The chunk locations are retrieved from the chunk groups of the segment files
+ * If a chunk location cannot be retrieved the block is marked as not indexed
+ * Returns 1 if successful, 0 if the block is not indexed or -1 on error
+ */
+int libewf_chunk_table_set_chunk_location_block(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	int file_io_pool_entries[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	off64_t data_offsets[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	size64_t data_sizes[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	uint32_t range_flags[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+
+	libewf_chunk_group_t *chunk_group = NULL;
+	static char *function             = "libewf_chunk_table_set_chunk_location_block";
+	off64_t chunk_group_data_offset   = 0;
+	off64_t offset                    = 0;
+	off64_t range_start_offset        = 0;
+	size64_t range_size               = 0;
+	uint64_t first_chunk_index        = 0;
+	uint32_t segment_number           = 0;
+	int chunk_groups_list_index       = 0;
+	int chunks_list_index             = 0;
+	int entry_index                   = 0;
+	int number_of_entries             = 0;
+	int result                        = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk table - invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->chunk_location_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk table - missing chunk location table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= chunk_table->chunk_location_table->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	first_chunk_index = chunk_index - ( chunk_index % LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE );
+
+	if( ( chunk_table->chunk_location_table->number_of_chunks - first_chunk_index ) < LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE )
+	{
+		number_of_entries = (int) ( chunk_table->chunk_location_table->number_of_chunks - first_chunk_index );
+	}
+	else
+	{
+		number_of_entries = LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE;
+	}
+	result = 1;
+
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		offset = (off64_t) ( ( first_chunk_index + entry_index ) * chunk_table->io_handle->chunk_size );
+
+		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+			  chunk_table,
+			  file_io_pool,
+			  segment_table,
+			  offset,
+			  &segment_number,
+			  &chunk_groups_list_index,
+			  &chunk_group_data_offset,
+			  &chunk_group,
+			  error );
+
+		if( ( result != 1 )
+		 || ( chunk_group == NULL ) )
+		{
+			result = 0;
+
+			break;
+		}
+		chunks_list_index = (int) ( chunk_group_data_offset / chunk_table->io_handle->chunk_size );
+
+		if( libfdata_list_get_element_by_index(
+		     chunk_group->chunks_list,
+		     chunks_list_index,
+		     &( file_io_pool_entries[ entry_index ] ),
+		     &( data_offsets[ entry_index ] ),
+		     &( data_sizes[ entry_index ] ),
+		     &( range_flags[ entry_index ] ),
+		     error ) != 1 )
+		{
+			result = 0;
+
+			break;
+		}
+		if( libfdata_list_get_element_mapped_range(
+		     chunk_group->chunks_list,
+		     chunks_list_index,
+		     &range_start_offset,
+		     &range_size,
+		     error ) != 1 )
+		{
+			result = 0;
+
+			break;
+		}
+		/* The chunk location table assumes every chunk maps chunk size bytes of the media data
+		 */
+		if( ( ( chunk_group->range_start_offset + range_start_offset ) != offset )
+		 || ( range_size != (size64_t) chunk_table->io_handle->chunk_size ) )
+		{
+			result = 0;
+
+			break;
+		}
+	}
+	if( result == 0 )
+	{
+		/* The chunk is retrieved from the chunk groups instead
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		if( libewf_chunk_location_table_set_block_not_indexed(
+		     chunk_table->chunk_location_table,
+		     first_chunk_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk location block: %" PRIu64 " not indexed.",
+			 function,
+			 first_chunk_index / LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	result = libewf_chunk_location_table_set_block(
+	          chunk_table->chunk_location_table,
+	          first_chunk_index,
+	          file_io_pool_entries,
+	          data_offsets,
+	          data_sizes,
+	          range_flags,
+	          number_of_entries,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk location block: %" PRIu64 ".",
+		 function,
+		 first_chunk_index / LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the location of a chunk from the chunk location table
+ * The block that contains the chunk is set on demand
+ * Returns 1 if successful, 0 if the chunk is not indexed or -1 on error
+ */
+int libewf_chunk_table_get_chunk_location_by_index(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *segment_file_data_offset,
+     size64_t *segment_file_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_get_chunk_location_by_index";
+	uint8_t block_status  = 0;
+	int result            = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->chunk_location_table == NULL )
+	{
+		return( 0 );
+	}
+	if( chunk_index >= chunk_table->chunk_location_table->number_of_chunks )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_location_table_get_block_status(
+	     chunk_table->chunk_location_table,
+	     chunk_index,
+	     &block_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve status of chunk location block of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( block_status == LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_NOT_INDEXED )
+	{
+		return( 0 );
+	}
+	if( block_status == LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_UNSET )
+	{
+		result = libewf_chunk_table_set_chunk_location_block(
+		          chunk_table,
+		          file_io_pool,
+		          segment_table,
+		          chunk_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk location block of chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	result = libewf_chunk_location_table_get_chunk_location(
+	          chunk_table->chunk_location_table,
+	          chunk_index,
+	          file_io_pool_entry,
+	          segment_file_data_offset,
+	          segment_file_data_size,
+	          range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve location of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the chunk data of a chunk at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_data_cache,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     off64_t *chunk_data_offset,
+     libewf_chunk_data_t **chunk_data,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group = NULL;
+	static char *function             = "libewf_chunk_table_get_segment_file_chunk_data_by_offset";
+	off64_t chunk_group_data_offset   = 0;
+	off64_t safe_chunk_data_offset    = 0;
+	uint64_t chunk_index              = 0;
+	uint32_t segment_number           = 0;
+	int chunk_groups_list_index       = 0;
+	int chunks_list_index             = 0;
+	int result                        = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_table->current_chunk_data != NULL )
+	 && ( chunk_table->current_chunk_data->range_end_offset > 0 ) )
+	{
+		if( ( offset >= chunk_table->current_chunk_data->range_start_offset )
+		 && ( offset < chunk_table->current_chunk_data->range_end_offset ) )
+		{
+			safe_chunk_data_offset = offset - chunk_table->current_chunk_data->range_start_offset;
+
+			result = 1;
+		}
+	}
+	if( result == 0 )
+	{
+		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+			  chunk_table,
+			  file_io_pool,
+			  segment_table,
+			  offset,
+			  &segment_number,
+			  &chunk_groups_list_index,
+			  &chunk_group_data_offset,
+			  &chunk_group,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file chunk group for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( result != 0 )
+		{
+			if( chunk_group == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk group: %d.",
+				 function,
+				 chunk_groups_list_index );
+
+				return( -1 );
+			}
+			chunk_index            = (uint64_t) offset / media_values->chunk_size;
+			chunks_list_index      = (int) ( chunk_group_data_offset / media_values->chunk_size );
+			safe_chunk_data_offset = chunk_group_data_offset - ( (off64_t) chunks_list_index * media_values->chunk_size );
+
+			if( libfdata_list_get_element_value_by_index(
+			     chunk_group->chunks_list,
+			     (intptr_t *) file_io_pool,
+			     (libfdata_cache_t *) chunk_data_cache,
+			     chunks_list_index,
+			     (intptr_t **) &( chunk_table->current_chunk_data ),
+			     read_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 " for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 chunk_index,
+				 chunk_groups_list_index,
+				 segment_number,
+				 offset,
+				 offset );
+
+				return( -1 );
+			}
+			if( chunk_table->current_chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk data: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			chunk_table->current_chunk_data->chunk_index = chunk_index;
+
+			if( libfdata_list_get_element_mapped_range(
+			     chunk_group->chunks_list,
+			     chunks_list_index,
+			     &( chunk_table->current_chunk_data->range_start_offset ),
+			     (size64_t *) &( chunk_table->current_chunk_data->range_end_offset ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve list element: %d mapped range for chunk group: %d in segment file: %" PRIu32 ".",
+				 function,
+				 chunks_list_index,
+				 chunk_groups_list_index,
+				 segment_number );
+
+				return( -1 );
+			}
+			chunk_table->current_chunk_data->range_start_offset += chunk_table->current_chunk_group->range_start_offset;
+			chunk_table->current_chunk_data->range_end_offset   += chunk_table->current_chunk_data->range_start_offset;
+
+			if( (size64_t) chunk_table->current_chunk_data->range_end_offset > media_values->media_size )
+			{
+				chunk_table->current_chunk_data->range_end_offset = (off64_t) media_values->media_size;
+			}
+		}
+	}
+	if( result != 0 )
+	{
+		*chunk_data_offset = safe_chunk_data_offset;
+		*chunk_data        = chunk_table->current_chunk_data;
+	}
+	return( result );
+}
+
+/* Empties the (unpacked) chunk data cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_empty_cache(
+     libewf_chunk_table_t *chunk_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_empty_cache";
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_empty(
+	     chunk_table->chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the location of the chunk at a specific offset
+ * This function is multi-thread safe as long as the segment files are not modified
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_location_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *segment_file_data_offset,
+     size64_t *segment_file_data_size,
+     uint32_t *range_flags,
+     off64_t *range_start_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group = NULL;
+	static char *function             = "libewf_chunk_table_get_chunk_location_by_offset";
+	off64_t chunk_group_data_offset   = 0;
+	uint64_t chunk_index              = 0;
+	uint32_t segment_number           = 0;
+	int chunk_groups_list_index       = 0;
+	int chunks_list_index             = 0;
+	int result                        = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_start_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range start offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index = (uint64_t) offset / media_values->chunk_size;
+
+	/* The chunk groups are cached per segment file hence the lookup is serialized
+	 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_table_get_chunk_location_by_index(
+	          chunk_table,
+	          file_io_pool,
+	          segment_table,
+	          chunk_index,
+	          file_io_pool_entry,
+	          segment_file_data_offset,
+	          segment_file_data_size,
+	          range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve location of chunk: %" PRIu64 " from chunk location table.",
+		 function,
+		 chunk_index );
+	}
+	else if( result != 0 )
+	{
+		*range_start_offset = (off64_t) ( chunk_index * media_values->chunk_size );
+		*range_size         = (size64_t) media_values->chunk_size;
+	}
+	else
+	{
+		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+			  chunk_table,
+			  file_io_pool,
+			  segment_table,
+			  offset,
+			  &segment_number,
+			  &chunk_groups_list_index,
+			  &chunk_group_data_offset,
+			  &chunk_group,
+			  error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file chunk group for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			result = -1;
+		}
+		else if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			result = -1;
+		}
+		if( result == 1 )
+		{
+			chunks_list_index = (int) ( chunk_group_data_offset / media_values->chunk_size );
+
+			if( libfdata_list_get_element_by_index(
+			     chunk_group->chunks_list,
+			     chunks_list_index,
+			     file_io_pool_entry,
+			     segment_file_data_offset,
+			     segment_file_data_size,
+			     range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve list element: %d from chunk group: %d in segment file: %" PRIu32 ".",
+				 function,
+				 chunks_list_index,
+				 chunk_groups_list_index,
+				 segment_number );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( libfdata_list_get_element_mapped_range(
+			     chunk_group->chunks_list,
+			     chunks_list_index,
+			     range_start_offset,
+			     range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve list element: %d mapped range for chunk group: %d in segment file: %" PRIu32 ".",
+				 function,
+				 chunks_list_index,
+				 chunk_groups_list_index,
+				 segment_number );
+
+				result = -1;
+			}
+			*range_start_offset += chunk_group->range_start_offset;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Unpacks chunk data and inserts it in the chunk cache
+ * Adds a checksum error if the data is corrupted
+ * On success the chunk cache takes over the chunk data and chunk_data is set to NULL
+ * The chunk cache entry must be released with libewf_chunk_table_release_chunk_data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_insert_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     uint64_t chunk_index,
+     off64_t range_start_offset,
+     size64_t range_size,
+     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_table_insert_chunk_data";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	( *chunk_data )->chunk_index        = chunk_index;
+	( *chunk_data )->range_start_offset = range_start_offset;
+	( *chunk_data )->range_end_offset   = range_start_offset + (off64_t) range_size;
+
+	if( (size64_t) ( *chunk_data )->range_end_offset > media_values->media_size )
+	{
+		( *chunk_data )->range_end_offset = (off64_t) media_values->media_size;
+	}
+	if( libewf_chunk_data_unpack(
+	     *chunk_data,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		/* Add checksum error
+		 */
+		start_sector      = ( *chunk_data )->range_start_offset / media_values->bytes_per_sector;
+		number_of_sectors = media_values->sectors_per_chunk;
+
+		if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+		{
+			number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+		}
+		if( libewf_chunk_table_append_checksum_error(
+		     chunk_table,
+		     start_sector,
+		     number_of_sectors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append checksum error.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_chunk_cache_insert_entry(
+	     chunk_table->chunk_cache,
+	     chunk_index,
+	     chunk_data,
+	     chunk_cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to insert chunk: %" PRIu64 " in cache.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads and unpacks a range of chunks into the chunk cache using asynchronous IO
+ * The packed chunk data of all chunks is read before the chunks are unpacked
+ * Chunks that are cached, sparse or in a mapped segment file are skipped
+ * and chunks that could not be read asynchronously are read from the file IO pool
+ * This function is multi-thread safe as long as the segment files are not modified
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_read_chunks_with_async_io(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libewf_async_io_t *async_io,
+     uint64_t first_chunk_index,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_async_io_request_t *requests           = NULL;
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	libewf_chunk_data_t **chunk_data_array        = NULL;
+	libewf_file_mapping_t *file_mapping           = NULL;
+	static char *function                         = "libewf_chunk_table_read_chunks_with_async_io";
+	off64_t range_start_offset                    = 0;
+	off64_t segment_file_data_offset              = 0;
+	size64_t range_size                           = 0;
+	size64_t segment_file_data_size               = 0;
+	ssize_t read_count                            = 0;
+	uint64_t chunk_index                          = 0;
+	uint32_t range_flags                          = 0;
+	int chunk_offset                              = 0;
+	int file_io_pool_entry                        = 0;
+	int number_of_requests                        = 0;
+	int request_index                             = 0;
+	int result                                    = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks <= 0 )
+	 || ( (size_t) number_of_chunks > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_async_io_request_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_chunk_index + (uint64_t) number_of_chunks ) > (uint64_t) ( INT64_MAX / media_values->chunk_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	requests = (libewf_async_io_request_t *) memory_allocate(
+	                                          sizeof( libewf_async_io_request_t ) * (size_t) number_of_chunks );
+
+	if( requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_data_array = (libewf_chunk_data_t **) memory_allocate(
+	                                             sizeof( libewf_chunk_data_t * ) * (size_t) number_of_chunks );
+
+	if( chunk_data_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data array.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     chunk_data_array,
+	     0,
+	     sizeof( libewf_chunk_data_t * ) * (size_t) number_of_chunks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data array.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_offset = 0;
+	     chunk_offset < number_of_chunks;
+	     chunk_offset++ )
+	{
+		chunk_index = first_chunk_index + (uint64_t) chunk_offset;
+
+		result = libewf_chunk_cache_get_entry_by_index(
+		          chunk_table->chunk_cache,
+		          chunk_index,
+		          &chunk_cache_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libewf_chunk_cache_release_entry(
+			     chunk_table->chunk_cache,
+			     &chunk_cache_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk: %" PRIu64 " cache entry.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( libewf_chunk_table_get_chunk_location_by_offset(
+		     chunk_table,
+		     file_io_pool,
+		     media_values,
+		     segment_table,
+		     (off64_t) ( chunk_index * media_values->chunk_size ),
+		     &file_io_pool_entry,
+		     &segment_file_data_offset,
+		     &segment_file_data_size,
+		     &range_flags,
+		     &range_start_offset,
+		     &range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve location of chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* Sparse chunks are not supported and mapped chunks are not read
+		 */
+		if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			continue;
+		}
+		result = libewf_chunk_table_get_file_mapping(
+		          chunk_table,
+		          file_io_pool_entry,
+		          &file_mapping,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file mapping of file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			continue;
+		}
+		if( libewf_chunk_data_initialize_from_pool(
+		     &( chunk_data_array[ number_of_requests ] ),
+		     io_handle->chunk_data_pool,
+		     io_handle->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( segment_file_data_size == 0 )
+		 || ( segment_file_data_size > (size64_t) chunk_data_array[ number_of_requests ]->allocated_data_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk: %" PRIu64 " data size value out of bounds.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		chunk_data_array[ number_of_requests ]->chunk_index        = chunk_index;
+		chunk_data_array[ number_of_requests ]->range_start_offset = range_start_offset;
+		chunk_data_array[ number_of_requests ]->range_end_offset   = range_start_offset + (off64_t) range_size;
+		chunk_data_array[ number_of_requests ]->range_flags        = range_flags;
+
+		requests[ number_of_requests ].file_index  = file_io_pool_entry;
+		requests[ number_of_requests ].offset      = segment_file_data_offset;
+		requests[ number_of_requests ].buffer      = chunk_data_array[ number_of_requests ]->data;
+		requests[ number_of_requests ].buffer_size = (size_t) segment_file_data_size;
+		requests[ number_of_requests ].read_count  = 0;
+
+		number_of_requests++;
+	}
+	if( number_of_requests > 0 )
+	{
+		if( libewf_async_io_read_buffers(
+		     async_io,
+		     requests,
+		     number_of_requests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunks: %" PRIu64 " - %" PRIu64 ".",
+			 function,
+			 first_chunk_index,
+			 first_chunk_index + (uint64_t) number_of_chunks - 1 );
+
+			goto on_error;
+		}
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		chunk_index = chunk_data_array[ request_index ]->chunk_index;
+		read_count  = requests[ request_index ].read_count;
+
+		if( read_count == (ssize_t) requests[ request_index ].buffer_size )
+		{
+			chunk_data_array[ request_index ]->data_size   = (size_t) read_count;
+			chunk_data_array[ request_index ]->range_flags = ( chunk_data_array[ request_index ]->range_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+			                                               & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+		}
+		else
+		{
+			/* Fall back to a synchronous read if the chunk was not or only partially read
+			 */
+			read_count = libewf_chunk_data_read_from_file_io_pool(
+			              chunk_data_array[ request_index ],
+			              file_io_pool,
+			              requests[ request_index ].file_index,
+			              requests[ request_index ].offset,
+			              (size64_t) requests[ request_index ].buffer_size,
+			              chunk_data_array[ request_index ]->range_flags,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		range_start_offset = chunk_data_array[ request_index ]->range_start_offset;
+		range_size         = (size64_t) ( chunk_data_array[ request_index ]->range_end_offset - range_start_offset );
+
+		if( libewf_chunk_table_insert_chunk_data(
+		     chunk_table,
+		     io_handle,
+		     media_values,
+		     chunk_index,
+		     range_start_offset,
+		     range_size,
+		     &( chunk_data_array[ request_index ] ),
+		     &chunk_cache_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to insert chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( libewf_chunk_cache_release_entry(
+		     chunk_table->chunk_cache,
+		     &chunk_cache_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk: %" PRIu64 " cache entry.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 chunk_data_array );
+
+	memory_free(
+	 requests );
+
+	return( 1 );
+
+on_error:
+	if( chunk_data_array != NULL )
+	{
+		for( request_index = 0;
+		     request_index < number_of_chunks;
+		     request_index++ )
+		{
+			if( chunk_data_array[ request_index ] != NULL )
+			{
+				libewf_chunk_data_free(
+				 &( chunk_data_array[ request_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 chunk_data_array );
+	}
+	if( requests != NULL )
+	{
+		memory_free(
+		 requests );
+	}
+	return( -1 );
+}
+
+/* Grabs the (unpacked) chunk data of a chunk at a specific offset
+ * On a cache miss the chunk is read and unpacked by the calling thread, outside
+ * of the chunk table lock, and afterwards inserted in the chunk cache
+ * Adds a checksum error if the data is corrupted
+ * The chunk cache entry must be released with libewf_chunk_table_release_chunk_data
+ * This function is multi-thread safe as long as the segment files are not modified
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_grab_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     off64_t *chunk_data_offset,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *safe_chunk_cache_entry = NULL;
+	libewf_chunk_data_t *chunk_data                    = NULL;
+	libewf_file_mapping_t *file_mapping                = NULL;
+	static char *function                              = "libewf_chunk_table_grab_chunk_data_by_offset";
+	off64_t range_start_offset                         = 0;
+	off64_t segment_file_data_offset                   = 0;
+	size64_t range_size                                = 0;
+	size64_t segment_file_data_size                    = 0;
+	ssize_t read_count                                 = 0;
+	uint64_t chunk_index                               = 0;
+	uint32_t range_flags                               = 0;
+	int file_io_pool_entry                             = 0;
+	int result                                         = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -568,161 +2770,290 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 
 		return( -1 );
 	}
-	if( segment_number == NULL )
+	if( io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment number.",
+		 "%s: invalid IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_groups_list_index == NULL )
+	if( io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk groups list index.",
+		 "%s: invalid media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_group_data_offset == NULL )
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk group data offset.",
+		 "%s: invalid chunk data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_group == NULL )
+	if( chunk_cache_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk groups.",
+		 "%s: invalid chunk cache entry.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( chunk_table->current_chunk_group != NULL )
-	 && ( chunk_table->current_chunk_group->range_end_offset > 0 ) )
+	chunk_index = (uint64_t) offset / media_values->chunk_size;
+
+	result = libewf_chunk_cache_get_entry_by_index(
+	          chunk_table->chunk_cache,
+	          chunk_index,
+	          &safe_chunk_cache_entry,
+	          error );
+
+	if( result == -1 )
 	{
-		if( ( offset >= chunk_table->current_chunk_group->range_start_offset )
-		 && ( offset < chunk_table->current_chunk_group->range_end_offset ) )
-		{
-			safe_chunk_group_data_offset = offset - chunk_table->current_chunk_group->range_start_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " from cache.",
+		 function,
+		 chunk_index );
 
-			result = 1;
-		}
+		goto on_error;
 	}
-	if( result == 0 )
+	else if( result == 0 )
 	{
-		result = libewf_segment_table_get_segment_file_at_offset(
+		result = libewf_chunk_table_get_chunk_location_by_offset(
+		          chunk_table,
+		          file_io_pool,
+		          media_values,
 		          segment_table,
 		          offset,
-		          file_io_pool,
-		          &safe_segment_number,
+		          &file_io_pool_entry,
 		          &segment_file_data_offset,
-		          &segment_file,
+		          &segment_file_data_size,
+		          &range_flags,
+		          &range_start_offset,
+		          &range_size,
 		          error );
 
-		if( result == -1 )
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 "%s: unable to retrieve location of chunk: %" PRIu64 ".",
 			 function,
-			 offset,
-			 offset );
+			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		else if( result == 0 )
+		if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk: %" PRIu64 " range flags.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* The file mappings are only set when the handle is opened hence no lock is needed
+		 */
+		result = libewf_chunk_table_get_file_mapping(
+		          chunk_table,
+		          file_io_pool_entry,
+		          &file_mapping,
+		          error );
+
+		if( result == 1 )
+		{
+			/* The packed chunk data is referenced in the file mapping instead of read
+			 */
+			result = libewf_chunk_data_initialize_from_file_mapping(
+			          &chunk_data,
+			          io_handle->chunk_size,
+			          file_mapping,
+			          segment_file_data_offset,
+			          segment_file_data_size,
+			          range_flags,
+			          error );
+		}
+		if( result == -1 )
 		{
-/* TODO handle missing segment file */
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: missing segment file for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data from file mapping.",
 			 function,
-			 offset,
-			 offset );
+			 chunk_index );
 
-			return( -1 );
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			/* The unpacked data of the file mapped chunk data is allocated from the pool
+			 */
+			chunk_data->chunk_data_pool = io_handle->chunk_data_pool;
 		}
 		else
 		{
-			result = libewf_segment_file_get_chunk_group_by_offset(
-				  segment_file,
-				  file_io_pool,
-				  segment_file_data_offset,
-				  &( chunk_table->current_chunk_group_index ),
-				  &safe_chunk_group_data_offset,
-				  &( chunk_table->current_chunk_group ),
-				  error );
-
-			if( result == -1 )
+			/* The chunk data is read into and unpacked in a buffer owned by the calling thread
+			 */
+			if( libewf_chunk_data_initialize_from_pool(
+			     &chunk_data,
+			     io_handle->chunk_data_pool,
+			     io_handle->chunk_size,
+			     0,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve chunk group from segment file: %" PRIu32 " for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk data.",
+				 function );
+
+				goto on_error;
+			}
+			read_count = libewf_chunk_data_read_from_file_io_pool(
+				      chunk_data,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      segment_file_data_offset,
+				      segment_file_data_size,
+				      range_flags,
+				      error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
 				 function,
-				 safe_segment_number,
-				 offset,
-				 offset );
+				 chunk_index );
 
-				return( -1 );
+				goto on_error;
 			}
 		}
+		if( libewf_chunk_table_insert_chunk_data(
+		     chunk_table,
+		     io_handle,
+		     media_values,
+		     chunk_index,
+		     range_start_offset,
+		     range_size,
+		     &chunk_data,
+		     &safe_chunk_cache_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to insert chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
 	}
-	if( result != 0 )
+	if( ( safe_chunk_cache_entry == NULL )
+	 || ( safe_chunk_cache_entry->chunk_data == NULL ) )
 	{
-		*segment_number          = safe_segment_number;
-		*chunk_groups_list_index = chunk_table->current_chunk_group_index;
-		*chunk_group_data_offset = safe_chunk_group_data_offset;
-		*chunk_group             = chunk_table->current_chunk_group;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
 	}
-	return( result );
+	*chunk_data_offset = offset - safe_chunk_cache_entry->chunk_data->range_start_offset;
+	*chunk_cache_entry = safe_chunk_cache_entry;
+
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( safe_chunk_cache_entry != NULL )
+	{
+		libewf_chunk_cache_release_entry(
+		 chunk_table->chunk_cache,
+		 &safe_chunk_cache_entry,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the chunk data of a chunk at a specific offset
+/* Releases chunk data grabbed with libewf_chunk_table_grab_chunk_data_by_offset
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
+int libewf_chunk_table_release_chunk_data(
      libewf_chunk_table_t *chunk_table,
-     libewf_io_handle_t *io_handle,
-     libbfio_pool_t *file_io_pool,
-     libfcache_cache_t *chunk_data_cache,
-     libewf_media_values_t *media_values,
-     libewf_segment_table_t *segment_table,
-     off64_t offset,
-     off64_t *chunk_data_offset,
-     libewf_chunk_data_t **chunk_data,
-     uint8_t read_flags,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
      libcerror_error_t **error )
 {
-	libewf_chunk_group_t *chunk_group = NULL;
-	static char *function             = "libewf_chunk_table_get_segment_file_chunk_data_by_offset";
-	off64_t chunk_group_data_offset   = 0;
-	off64_t safe_chunk_data_offset    = 0;
-	uint64_t chunk_index              = 0;
-	uint32_t segment_number           = 0;
-	int chunk_groups_list_index       = 0;
-	int chunks_list_index             = 0;
-	int result                        = 0;
+	static char *function = "libewf_chunk_table_release_chunk_data";
 
 	if( chunk_table == NULL )
 	{
@@ -735,17 +3066,53 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
+	if( libewf_chunk_cache_release_entry(
+	     chunk_table->chunk_cache,
+	     chunk_cache_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk cache entry.",
 		 function );
 
 		return( -1 );
 	}
+	return( 1 );
+}
+
+/* Determines if the chunk at a specific index is empty, i.e. only contains zero bytes
+ * The chunk is determined from the chunk location and flags, only chunks stored
+ * with pattern fill or as a small compressed (empty-block) stream are unpacked
+ * Uncompressed chunks are considered to contain data
+ * This function is multi-thread safe as long as the segment files are not modified
+ * Returns 1 if empty, 0 if not or -1 on error
+ */
+int libewf_chunk_table_chunk_is_empty(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	libewf_chunk_data_t *chunk_data               = NULL;
+	static char *function                         = "libewf_chunk_table_chunk_is_empty";
+	off64_t chunk_data_offset                     = 0;
+	off64_t offset                                = 0;
+	off64_t range_start_offset                    = 0;
+	off64_t segment_file_data_offset              = 0;
+	size64_t maximum_empty_block_data_size        = 0;
+	size64_t range_size                           = 0;
+	size64_t segment_file_data_size               = 0;
+	uint32_t range_flags                          = 0;
+	int file_io_pool_entry                        = 0;
+	int result                                    = 0;
+
 	if( media_values == NULL )
 	{
 		libcerror_error_set(
@@ -762,184 +3129,164 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid media values - chunk size value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data_offset == NULL )
+	if( chunk_index > (uint64_t) ( INT64_MAX / media_values->chunk_size ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data offset.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data == NULL )
+	offset = (off64_t) ( chunk_index * media_values->chunk_size );
+
+	if( libewf_chunk_table_get_chunk_location_by_offset(
+	     chunk_table,
+	     file_io_pool,
+	     media_values,
+	     segment_table,
+	     offset,
+	     &file_io_pool_entry,
+	     &segment_file_data_offset,
+	     &segment_file_data_size,
+	     &range_flags,
+	     &range_start_offset,
+	     &range_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve location of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
-	if( ( chunk_table->current_chunk_data != NULL )
-	 && ( chunk_table->current_chunk_data->range_end_offset > 0 ) )
+	if( ( range_flags & ( LIBEWF_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_IS_CORRUPTED ) ) != 0 )
 	{
-		if( ( offset >= chunk_table->current_chunk_data->range_start_offset )
-		 && ( offset < chunk_table->current_chunk_data->range_end_offset ) )
-		{
-			safe_chunk_data_offset = offset - chunk_table->current_chunk_data->range_start_offset;
-
-			result = 1;
-		}
+		return( 0 );
 	}
-	if( result == 0 )
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
 	{
-		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
-			  chunk_table,
-			  file_io_pool,
-			  segment_table,
-			  offset,
-			  &segment_number,
-			  &chunk_groups_list_index,
-			  &chunk_group_data_offset,
-			  &chunk_group,
-			  error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file chunk group for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 offset,
-			 offset );
-
-			return( -1 );
-		}
-		if( result != 0 )
-		{
-			if( chunk_group == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing chunk group: %d.",
-				 function,
-				 chunk_groups_list_index );
-
-				return( -1 );
-			}
-			chunk_index            = (uint64_t) offset / media_values->chunk_size;
-			chunks_list_index      = (int) ( chunk_group_data_offset / media_values->chunk_size );
-			safe_chunk_data_offset = chunk_group_data_offset - ( (off64_t) chunks_list_index * media_values->chunk_size );
-
-			if( libfdata_list_get_element_value_by_index(
-			     chunk_group->chunks_list,
-			     (intptr_t *) file_io_pool,
-			     (libfdata_cache_t *) chunk_data_cache,
-			     chunks_list_index,
-			     (intptr_t **) &( chunk_table->current_chunk_data ),
-			     read_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 " for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 chunk_index,
-				 chunk_groups_list_index,
-				 segment_number,
-				 offset,
-				 offset );
+		return( 0 );
+	}
+	/* A deflate stream of zero bytes is roughly a thousandth of the chunk size
+	 */
+	maximum_empty_block_data_size = ( media_values->chunk_size / 512 ) + 64;
 
-				return( -1 );
-			}
-			if( chunk_table->current_chunk_data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing chunk data: %" PRIu64 ".",
-				 function,
-				 chunk_index );
+	if( ( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+	 && ( segment_file_data_size > maximum_empty_block_data_size ) )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_table_grab_chunk_data_by_offset(
+	     chunk_table,
+	     io_handle,
+	     file_io_pool,
+	     media_values,
+	     segment_table,
+	     offset,
+	     &chunk_data_offset,
+	     &chunk_cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
 
-				return( -1 );
-			}
-			chunk_table->current_chunk_data->chunk_index = chunk_index;
+		goto on_error;
+	}
+	chunk_data = chunk_cache_entry->chunk_data;
 
-			if( libfdata_list_get_element_mapped_range(
-			     chunk_group->chunks_list,
-			     chunks_list_index,
-			     &( chunk_table->current_chunk_data->range_start_offset ),
-			     (size64_t *) &( chunk_table->current_chunk_data->range_end_offset ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve list element: %d mapped range for chunk group: %d in segment file: %" PRIu32 ".",
-				 function,
-				 chunks_list_index,
-				 chunk_groups_list_index,
-				 segment_number );
+	if( ( chunk_data != NULL )
+	 && ( chunk_data->data != NULL )
+	 && ( chunk_data->data_size > 0 )
+	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 )
+	 && ( chunk_data->data[ 0 ] == 0 ) )
+	{
+		result = libewf_chunk_data_check_for_empty_block(
+		          chunk_data->data,
+		          chunk_data->data_size,
+		          error );
 
-				return( -1 );
-			}
-			chunk_table->current_chunk_data->range_start_offset += chunk_table->current_chunk_group->range_start_offset;
-			chunk_table->current_chunk_data->range_end_offset   += chunk_table->current_chunk_data->range_start_offset;
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if chunk: %" PRIu64 " data is an empty block.",
+			 function,
+			 chunk_index );
 
-			if( (size64_t) chunk_table->current_chunk_data->range_end_offset > media_values->media_size )
-			{
-				chunk_table->current_chunk_data->range_end_offset = (off64_t) media_values->media_size;
-			}
+			goto on_error;
 		}
 	}
-	if( result != 0 )
+	if( libewf_chunk_table_release_chunk_data(
+	     chunk_table,
+	     &chunk_cache_entry,
+	     error ) != 1 )
 	{
-		*chunk_data_offset = safe_chunk_data_offset;
-		*chunk_data        = chunk_table->current_chunk_data;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
 	}
 	return( result );
+
+on_error:
+	if( chunk_cache_entry != NULL )
+	{
+		libewf_chunk_table_release_chunk_data(
+		 chunk_table,
+		 &chunk_cache_entry,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
+/* Grabs a view of the chunk data at a specific offset
+ * The chunk data remains referenced, and its data valid, until the view is released
+ * with libewf_chunk_table_release_chunk_view or the chunk table is freed
+ * This function is multi-thread safe as long as the segment files are not modified
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_get_chunk_data_by_offset(
+int libewf_chunk_table_grab_chunk_view_by_offset(
      libewf_chunk_table_t *chunk_table,
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
      off64_t offset,
-     off64_t *chunk_data_offset,
-     libewf_chunk_data_t **chunk_data,
+     const uint8_t **data,
+     size_t *data_size,
      libcerror_error_t **error )
 {
-	libewf_chunk_data_t *safe_chunk_data = NULL;
-	static char *function                = "libewf_chunk_table_get_chunk_data_by_offset";
-	off64_t safe_chunk_data_offset       = 0;
-	uint64_t chunk_index                 = 0;
-	uint64_t number_of_sectors           = 0;
-	uint64_t start_sector                = 0;
-	int result                           = 0;
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	libewf_chunk_data_t *chunk_data               = NULL;
+	static char *function                         = "libewf_chunk_table_grab_chunk_view_by_offset";
+	off64_t chunk_data_offset                     = 0;
+	int entry_index                               = 0;
+	int result                                    = 1;
 
 	if( chunk_table == NULL )
 	{
@@ -952,141 +3299,336 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_values == NULL )
+	if( data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media values.",
+		 "%s: invalid data size.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_values->chunk_size == 0 )
+	if( libewf_chunk_table_grab_chunk_data_by_offset(
+	     chunk_table,
+	     io_handle,
+	     file_io_pool,
+	     media_values,
+	     segment_table,
+	     offset,
+	     &chunk_data_offset,
+	     &chunk_cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+	chunk_data = chunk_cache_entry->chunk_data;
+
+	if( ( chunk_data_offset < 0 )
+	 || ( (size64_t) chunk_data_offset >= (size64_t) chunk_data->data_size ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid media values - chunk size value out of bounds.",
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_data->chunk_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libcdata_array_append_entry(
+	     chunk_table->chunk_views,
+	     &entry_index,
+	     (intptr_t *) chunk_cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append chunk: %" PRIu64 " to chunk views array.",
+		 function,
+		 chunk_data->chunk_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+		/* The chunk cache entry is referenced by the chunk views array
+		 */
 		return( -1 );
 	}
-	if( chunk_data_offset == NULL )
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	*data      = &( ( chunk_data->data )[ chunk_data_offset ] );
+	*data_size = chunk_data->data_size - (size_t) chunk_data_offset;
+
+	return( 1 );
+
+on_error:
+	if( chunk_cache_entry != NULL )
+	{
+		libewf_chunk_table_release_chunk_data(
+		 chunk_table,
+		 &chunk_cache_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a view of chunk data grabbed with libewf_chunk_table_grab_chunk_view_by_offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_release_chunk_view(
+     libewf_chunk_table_t *chunk_table,
+     const uint8_t *data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	libewf_chunk_cache_entry_t *last_entry        = NULL;
+	libewf_chunk_data_t *chunk_data               = NULL;
+	static char *function                         = "libewf_chunk_table_release_chunk_view";
+	int entry_index                               = 0;
+	int number_of_entries                         = 0;
+	int result                                    = 0;
+
+	if( chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data offset.",
+		 "%s: invalid chunk table.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data == NULL )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-	result = libewf_chunk_table_get_segment_file_chunk_data_by_offset(
-		  chunk_table,
-		  io_handle,
-		  file_io_pool,
-	          chunk_table->chunk_data_cache,
-		  media_values,
-		  segment_table,
-		  offset,
-		  &safe_chunk_data_offset,
-		  &safe_chunk_data,
-		  0,
-		  error );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-	if( result == -1 )
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     chunk_table->chunk_views,
+	     &number_of_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 offset,
-		 offset );
+		 "%s: unable to retrieve number of chunk views.",
+		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	else if( result != 0 )
+	/* Search the most recently grabbed views first
+	 */
+	entry_index = number_of_entries - 1;
+
+	while( ( result == 0 )
+	    && ( entry_index >= 0 ) )
 	{
-		if( libewf_chunk_data_unpack(
-		     safe_chunk_data,
-		     io_handle,
+		if( libcdata_array_get_entry_by_index(
+		     chunk_table->chunk_views,
+		     entry_index,
+		     (intptr_t **) &chunk_cache_entry,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk view: %d.",
 			 function,
-			 chunk_index );
+			 entry_index );
 
-			return( -1 );
+			result = -1;
 		}
-		if( ( safe_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		else if( chunk_cache_entry != NULL )
 		{
-			/* Add checksum error
-			 */
-			start_sector      = safe_chunk_data->range_start_offset / media_values->bytes_per_sector;
-			number_of_sectors = media_values->sectors_per_chunk;
+			chunk_data = chunk_cache_entry->chunk_data;
 
-			if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+			if( ( chunk_data != NULL )
+			 && ( data >= chunk_data->data )
+			 && ( data < &( ( chunk_data->data )[ chunk_data->data_size ] ) ) )
 			{
-				number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+				result = 1;
 			}
-			if( libcdata_range_list_insert_range(
-			     chunk_table->checksum_errors,
-			     start_sector,
-			     number_of_sectors,
-			     NULL,
-			     NULL,
-			     NULL,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to insert checksum error in range list.",
-				 function );
+		}
+		if( result == 0 )
+		{
+			entry_index--;
+		}
+	}
+	if( result == 1 )
+	{
+		/* Replace the view by the last view to keep the array compact
+		 */
+		if( libcdata_array_get_entry_by_index(
+		     chunk_table->chunk_views,
+		     number_of_entries - 1,
+		     (intptr_t **) &last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk view: %d.",
+			 function,
+			 number_of_entries - 1 );
 
-				return( -1 );
-			}
+			result = -1;
+		}
+		else if( libcdata_array_set_entry_by_index(
+		          chunk_table->chunk_views,
+		          entry_index,
+		          (intptr_t *) last_entry,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk view: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+		else if( libcdata_array_resize(
+		          chunk_table->chunk_views,
+		          number_of_entries - 1,
+		          NULL,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize chunk views array.",
+			 function );
+
+			result = -1;
 		}
 	}
-	if( result != 0 )
+	else if( result == 0 )
 	{
-		*chunk_data_offset = safe_chunk_data_offset;
-		*chunk_data        = safe_chunk_data;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data value out of bounds - no such chunk view.",
+		 function );
+
+		result = -1;
 	}
-	return( result );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_chunk_cache_release_entry(
+	     chunk_table->chunk_cache,
+	     &chunk_cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
 /* Retrieves the chunk data of a chunk at a specific offset
@@ -1117,11 +3659,29 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
 
 		return( -1 );
 	}
+	/* The chunk groups and the current chunk data are shared with the read-ahead
+	 * threads hence the lookup is serialized
+	 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	result = libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 		  chunk_table,
 		  io_handle,
 		  file_io_pool,
-	          chunk_table->single_chunk_data_cache,
+		  chunk_table->single_chunk_data_cache,
 		  media_values,
 		  segment_table,
 		  offset,
@@ -1140,8 +3700,6 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
 		 function,
 		 offset,
 		 offset );
-
-		return( -1 );
 	}
 	else if( result != 0 )
 	{
@@ -1157,9 +3715,24 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
 			 "%s: unable to clear single chunk data cache entry: 0.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     chunk_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( result );
 }
 
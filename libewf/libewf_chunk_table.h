@@ -25,10 +25,16 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_async_io.h"
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_location_table.h"
+#include "libewf_file_mapping.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_segment_file.h"
@@ -74,13 +80,31 @@ struct libewf_chunk_table
 	 */
 	libfcache_cache_t *chunk_groups_cache;
 
-	/* The chunk data cache
+	/* The (unpacked) chunk data cache
 	 */
-	libfcache_cache_t *chunk_data_cache;
+	libewf_chunk_cache_t *chunk_cache;
 
 	/* The single chunk data cache
 	 */
 	libfcache_cache_t *single_chunk_data_cache;
+
+	/* The chunk cache entries referenced by chunk views
+	 */
+	libcdata_array_t *chunk_views;
+
+	/* The chunk location table
+	 */
+	libewf_chunk_location_table_t *chunk_location_table;
+
+	/* The file mappings of the segment files, by file IO pool entry
+	 */
+	libcdata_array_t *file_mappings;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libewf_chunk_table_initialize(
@@ -97,6 +121,24 @@ int libewf_chunk_table_clone(
      libewf_chunk_table_t *source_chunk_table,
      libcerror_error_t **error );
 
+int libewf_chunk_table_initialize_chunk_location_table(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t number_of_chunks,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_set_file_mapping(
+     libewf_chunk_table_t *chunk_table,
+     int file_io_pool_entry,
+     libewf_file_mapping_t *file_mapping,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_file_mapping(
+     libewf_chunk_table_t *chunk_table,
+     int file_io_pool_entry,
+     libewf_file_mapping_t **file_mapping,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_number_of_checksum_errors(
      libewf_chunk_table_t *chunk_table,
      uint32_t *number_of_errors,
@@ -126,6 +168,24 @@ int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
      libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error );
 
+int libewf_chunk_table_set_chunk_location_block(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_location_by_index(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *segment_file_data_offset,
+     size64_t *segment_file_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      libewf_io_handle_t *io_handle,
@@ -139,7 +199,47 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
      uint8_t read_flags,
      libcerror_error_t **error );
 
-int libewf_chunk_table_get_chunk_data_by_offset(
+int libewf_chunk_table_empty_cache(
+     libewf_chunk_table_t *chunk_table,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_location_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *segment_file_data_offset,
+     size64_t *segment_file_data_size,
+     uint32_t *range_flags,
+     off64_t *range_start_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_insert_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     uint64_t chunk_index,
+     off64_t range_start_offset,
+     size64_t range_size,
+     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_read_chunks_with_async_io(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libewf_async_io_t *async_io,
+     uint64_t first_chunk_index,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_grab_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -147,7 +247,37 @@ int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
      off64_t *chunk_data_offset,
-     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_release_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     libewf_chunk_cache_entry_t **chunk_cache_entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_chunk_is_empty(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_grab_chunk_view_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_release_chunk_view(
+     libewf_chunk_table_t *chunk_table,
+     const uint8_t *data,
      libcerror_error_t **error );
 
 int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
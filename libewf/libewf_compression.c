@@ -34,6 +34,10 @@
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
 #include "libewf_deflate.h"
@@ -52,16 +56,20 @@ int libewf_compress_data(
      size_t uncompressed_data_size,
      libcerror_error_t **error )
 {
-	static char *function                   = "libewf_compress_data";
-	int result                              = 0;
+	static char *function                    = "libewf_compress_data";
+	int result                               = 0;
 
 #if defined( HAVE_BZLIB ) || defined( BZ_DLL )
-	unsigned int bzip2_compressed_data_size = 0;
-	int bzip2_compression_level             = 0;
+	unsigned int bzip2_compressed_data_size  = 0;
+	int bzip2_compression_level              = 0;
 #endif
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
-	uLongf zlib_compressed_data_size        = 0;
-	int zlib_compression_level              = 0;
+#if defined( HAVE_LIBDEFLATE )
+	struct libdeflate_compressor *compressor = NULL;
+	size_t libdeflate_compressed_data_size   = 0;
+	int libdeflate_compression_level         = 0;
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	uLongf zlib_compressed_data_size         = 0;
+	int zlib_compression_level               = 0;
 #endif
 
 	if( compressed_data == NULL )
@@ -110,7 +118,107 @@ int libewf_compress_data(
 	}
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+		/* The libdeflate compression levels are mapped onto the zlib equivalents
+		 */
+		if( compression_level == LIBEWF_COMPRESSION_LEVEL_DEFAULT )
+		{
+			libdeflate_compression_level = 6;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+		{
+			libdeflate_compression_level = 1;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_LEVEL_BEST )
+		{
+			libdeflate_compression_level = 9;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+		{
+			libdeflate_compression_level = 0;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression level.",
+			 function );
+
+			return( -1 );
+		}
+		if( *compressed_data_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid compressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		compressor = libdeflate_alloc_compressor(
+		              libdeflate_compression_level );
+
+		if( compressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressor.",
+			 function );
+
+			*compressed_data_size = 0;
+
+			return( -1 );
+		}
+		libdeflate_compressed_data_size = libdeflate_zlib_compress(
+		                                   compressor,
+		                                   uncompressed_data,
+		                                   uncompressed_data_size,
+		                                   compressed_data,
+		                                   *compressed_data_size );
+
+		if( libdeflate_compressed_data_size != 0 )
+		{
+			*compressed_data_size = libdeflate_compressed_data_size;
+
+			result = 1;
+		}
+		else
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to write compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			*compressed_data_size = libdeflate_zlib_compress_bound(
+			                         compressor,
+			                         uncompressed_data_size );
+
+			result = 0;
+		}
+		libdeflate_free_compressor(
+		 compressor );
+
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
 		if( compression_level == LIBEWF_COMPRESSION_LEVEL_DEFAULT )
 		{
 			zlib_compression_level = Z_DEFAULT_COMPRESSION;
@@ -241,7 +349,7 @@ int libewf_compress_data(
 		 function );
 
 		return( -1 );
-#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+#endif /* defined( HAVE_LIBDEFLATE ) */
 	}
 	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
 	{
@@ -384,14 +492,17 @@ int libewf_decompress_data(
      size_t *uncompressed_data_size,
      libcerror_error_t **error )
 {
-	static char *function                     = "libewf_decompress_data";
-	int result                                = 0;
+	static char *function                        = "libewf_decompress_data";
+	int result                                   = 0;
 
 #if defined( HAVE_BZLIB ) || defined( BZ_DLL )
-	unsigned int bzip2_uncompressed_data_size = 0;
+	unsigned int bzip2_uncompressed_data_size    = 0;
 #endif
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
-	uLongf zlib_uncompressed_data_size        = 0;
+#if defined( HAVE_LIBDEFLATE )
+	struct libdeflate_decompressor *decompressor = NULL;
+	size_t libdeflate_uncompressed_data_size     = 0;
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	uLongf zlib_uncompressed_data_size           = 0;
 #endif
 
 	if( compressed_data == NULL )
@@ -440,7 +551,106 @@ int libewf_decompress_data(
 	}
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+		if( compressed_data_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid compressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( *uncompressed_data_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		decompressor = libdeflate_alloc_decompressor();
+
+		if( decompressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create decompressor.",
+			 function );
+
+			*uncompressed_data_size = 0;
+
+			return( -1 );
+		}
+		result = (int) libdeflate_zlib_decompress(
+		                decompressor,
+		                compressed_data,
+		                compressed_data_size,
+		                uncompressed_data,
+		                *uncompressed_data_size,
+		                &libdeflate_uncompressed_data_size );
+
+		libdeflate_free_decompressor(
+		 decompressor );
+
+		if( result == (int) LIBDEFLATE_SUCCESS )
+		{
+			*uncompressed_data_size = libdeflate_uncompressed_data_size;
+
+			result = 1;
+		}
+		else if( result == (int) LIBDEFLATE_BAD_DATA )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to read compressed data: data error.\n",
+				 function );
+			}
+#endif
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+		else if( result == (int) LIBDEFLATE_INSUFFICIENT_SPACE )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				"%s: unable to read compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			/* Estimate that a factor 2 enlargement should suffice
+			 */
+			*uncompressed_data_size *= 2;
+
+			result = 0;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: libdeflate returned undefined error: %d.",
+			 function,
+			 result );
+
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
 #if ULONG_MAX < SSIZE_MAX
 		if( compressed_data_size > (size_t) ULONG_MAX )
 #else
@@ -561,7 +771,7 @@ int libewf_decompress_data(
 
 			return( -1 );
 		}
-#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+#endif /* defined( HAVE_LIBDEFLATE ) */
 	}
 	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
 	{
@@ -0,0 +1,896 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_compression.h"
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+/* Creates a compression context
+ * Make sure the value compression_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_initialize";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = memory_allocate_structure(
+	                        libewf_compression_context_t );
+
+	if( *compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context,
+	     0,
+	     sizeof( libewf_compression_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_free";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+#if defined( HAVE_LIBDEFLATE )
+		if( ( *compression_context )->compressor != NULL )
+		{
+			libdeflate_free_compressor(
+			 ( *compression_context )->compressor );
+		}
+		if( ( *compression_context )->decompressor != NULL )
+		{
+			libdeflate_free_decompressor(
+			 ( *compression_context )->decompressor );
+		}
+#elif defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+		if( ( *compression_context )->deflate_stream_is_initialized != 0 )
+		{
+			deflateEnd(
+			 &( ( *compression_context )->deflate_stream ) );
+		}
+		if( ( *compression_context )->inflate_stream_is_initialized != 0 )
+		{
+			inflateEnd(
+			 &( ( *compression_context )->inflate_stream ) );
+		}
+#endif
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Compresses data using the compression method
+ * The deflate compression state is retained in the compression context and reset between calls
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_compress_data(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_compress_data";
+	int result            = 0;
+
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	int deflate_level     = 0;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	if( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+#endif
+	{
+		/* bzip2 has no means to reset a stream, hence it is compressed without context
+		 */
+		result = libewf_compress_data(
+		          compressed_data,
+		          compressed_data_size,
+		          compression_method,
+		          compression_level,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress data.",
+			 function );
+		}
+		return( result );
+	}
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	/* The compression levels are mapped onto the zlib equivalents
+	 */
+	if( compression_level == LIBEWF_COMPRESSION_LEVEL_DEFAULT )
+	{
+		deflate_level = 6;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+	{
+		deflate_level = 1;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_BEST )
+	{
+		deflate_level = 9;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+	{
+		deflate_level = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_compression_context_compress_data_with_deflate_level(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          deflate_level,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+	}
+	return( result );
+#endif
+}
+
+/* Compresses data using the deflate compression method with a specific compression level
+ * The deflate level ranges from 0 (no compression) to 9 (best compression) like zlib
+ * The deflate compression state is retained in the compression context and reset between calls
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_compress_data_with_deflate_level(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int deflate_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function                  = "libewf_compression_context_compress_data_with_deflate_level";
+
+#if defined( HAVE_LIBDEFLATE )
+	size_t libdeflate_compressed_data_size = 0;
+#endif
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	int result                             = 0;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( deflate_level < 0 )
+	 || ( deflate_level > 9 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid deflate level value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == uncompressed_data )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer equals compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( *compressed_data_size > (size_t) SSIZE_MAX )
+#else
+	if( *compressed_data_size > (size_t) UINT_MAX )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( uncompressed_data_size > (size_t) SSIZE_MAX )
+#else
+	if( uncompressed_data_size > (size_t) UINT_MAX )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_LIBDEFLATE )
+	/* A compressor is bound to a compression level
+	 */
+	if( ( compression_context->compressor != NULL )
+	 && ( compression_context->compressor_level != deflate_level ) )
+	{
+		libdeflate_free_compressor(
+		 compression_context->compressor );
+
+		compression_context->compressor = NULL;
+	}
+	if( compression_context->compressor == NULL )
+	{
+		compression_context->compressor = libdeflate_alloc_compressor(
+		                                   deflate_level );
+
+		if( compression_context->compressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressor.",
+			 function );
+
+			*compressed_data_size = 0;
+
+			return( -1 );
+		}
+		compression_context->compressor_level = deflate_level;
+	}
+	libdeflate_compressed_data_size = libdeflate_zlib_compress(
+	                                   compression_context->compressor,
+	                                   uncompressed_data,
+	                                   uncompressed_data_size,
+	                                   compressed_data,
+	                                   *compressed_data_size );
+
+	if( libdeflate_compressed_data_size != 0 )
+	{
+		*compressed_data_size = libdeflate_compressed_data_size;
+
+		result = 1;
+	}
+	else
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		*compressed_data_size = libdeflate_zlib_compress_bound(
+		                         compression_context->compressor,
+		                         uncompressed_data_size );
+
+		result = 0;
+	}
+#elif defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	if( compression_context->deflate_stream_is_initialized == 0 )
+	{
+		result = deflateInit(
+		          &( compression_context->deflate_stream ),
+		          deflate_level );
+
+		if( result == Z_OK )
+		{
+			compression_context->deflate_stream_is_initialized = 1;
+			compression_context->deflate_level                 = deflate_level;
+		}
+	}
+	else
+	{
+		result = deflateReset(
+		          &( compression_context->deflate_stream ) );
+
+		/* Since the stream was reset no pending data needs to be flushed
+		 * when changing the compression level
+		 */
+		if( ( result == Z_OK )
+		 && ( compression_context->deflate_level != deflate_level ) )
+		{
+			result = deflateParams(
+			          &( compression_context->deflate_stream ),
+			          deflate_level,
+			          Z_DEFAULT_STRATEGY );
+
+			if( result == Z_OK )
+			{
+				compression_context->deflate_level = deflate_level;
+			}
+		}
+	}
+	if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to initialize deflate stream with error: %d.",
+		 function,
+		 result );
+
+		*compressed_data_size = 0;
+
+		return( -1 );
+	}
+	compression_context->deflate_stream.next_in   = (Bytef *) uncompressed_data;
+	compression_context->deflate_stream.avail_in  = (uInt) uncompressed_data_size;
+	compression_context->deflate_stream.next_out  = (Bytef *) compressed_data;
+	compression_context->deflate_stream.avail_out = (uInt) *compressed_data_size;
+
+	result = deflate(
+	          &( compression_context->deflate_stream ),
+	          Z_FINISH );
+
+	if( result == Z_STREAM_END )
+	{
+		*compressed_data_size = (size_t) compression_context->deflate_stream.total_out;
+
+		result = 1;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		*compressed_data_size = (size_t) deflateBound(
+		                                  &( compression_context->deflate_stream ),
+		                                  (uLong) uncompressed_data_size );
+
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*compressed_data_size = 0;
+
+		result = -1;
+	}
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: missing support for deflate compression.",
+	 function );
+
+	return( -1 );
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	compression_context->number_of_uses += 1;
+
+	return( result );
+#endif
+}
+
+/* Decompresses data using the compression method
+ * The inflate decompression state is retained in the compression context and reset between calls
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_decompress_data(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t compression_method,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function                    = "libewf_compression_context_decompress_data";
+	int result                               = 0;
+
+#if defined( HAVE_LIBDEFLATE )
+	size_t libdeflate_uncompressed_data_size = 0;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	if( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+#endif
+	{
+		/* bzip2 has no means to reset a stream, hence it is decompressed without context
+		 */
+		result = libewf_decompress_data(
+		          compressed_data,
+		          compressed_data_size,
+		          compression_method,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data.",
+			 function );
+		}
+		return( result );
+	}
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == compressed_data )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer equals uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+#else
+	if( compressed_data_size > (size_t) UINT_MAX )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( *uncompressed_data_size > (size_t) SSIZE_MAX )
+#else
+	if( *uncompressed_data_size > (size_t) UINT_MAX )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_LIBDEFLATE )
+	if( compression_context->decompressor == NULL )
+	{
+		compression_context->decompressor = libdeflate_alloc_decompressor();
+
+		if( compression_context->decompressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create decompressor.",
+			 function );
+
+			*uncompressed_data_size = 0;
+
+			return( -1 );
+		}
+	}
+	result = (int) libdeflate_zlib_decompress(
+	                compression_context->decompressor,
+	                compressed_data,
+	                compressed_data_size,
+	                uncompressed_data,
+	                *uncompressed_data_size,
+	                &libdeflate_uncompressed_data_size );
+
+	if( result == (int) LIBDEFLATE_SUCCESS )
+	{
+		*uncompressed_data_size = libdeflate_uncompressed_data_size;
+
+		result = 1;
+	}
+	else if( result == (int) LIBDEFLATE_BAD_DATA )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+		}
+#endif
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else if( result == (int) LIBDEFLATE_INSUFFICIENT_SPACE )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: libdeflate returned undefined error: %d.",
+		 function,
+		 result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+#elif defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	if( compression_context->inflate_stream_is_initialized == 0 )
+	{
+		result = inflateInit(
+		          &( compression_context->inflate_stream ) );
+
+		if( result == Z_OK )
+		{
+			compression_context->inflate_stream_is_initialized = 1;
+		}
+	}
+	else
+	{
+		result = inflateReset(
+		          &( compression_context->inflate_stream ) );
+	}
+	if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to initialize inflate stream with error: %d.",
+		 function,
+		 result );
+
+		*uncompressed_data_size = 0;
+
+		return( -1 );
+	}
+	compression_context->inflate_stream.next_in   = (Bytef *) compressed_data;
+	compression_context->inflate_stream.avail_in  = (uInt) compressed_data_size;
+	compression_context->inflate_stream.next_out  = (Bytef *) uncompressed_data;
+	compression_context->inflate_stream.avail_out = (uInt) *uncompressed_data_size;
+
+	result = inflate(
+	          &( compression_context->inflate_stream ),
+	          Z_FINISH );
+
+	/* Like uncompress, distinguish between a too small target buffer
+	 * and truncated compressed data
+	 */
+	if( ( ( result == Z_OK )
+	  ||  ( result == Z_BUF_ERROR ) )
+	 && ( compression_context->inflate_stream.avail_out != 0 ) )
+	{
+		result = Z_DATA_ERROR;
+	}
+	if( result == Z_STREAM_END )
+	{
+		*uncompressed_data_size = (size_t) compression_context->inflate_stream.total_out;
+
+		result = 1;
+	}
+	else if( ( result == Z_DATA_ERROR )
+	      || ( result == Z_NEED_DICT ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+		}
+#endif
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else if( result == Z_MEM_ERROR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to read compressed data: insufficient memory.",
+		 function );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+#if defined( HAVE_LIBDEFLATE ) || defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	compression_context->number_of_uses += 1;
+
+	return( result );
+#endif
+}
+
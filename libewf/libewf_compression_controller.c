@@ -0,0 +1,770 @@
+/*
+ * Compression controller functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "libewf_compression_controller.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a compression controller
+ * Make sure the value compression_controller is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_initialize(
+     libewf_compression_controller_t **compression_controller,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_initialize";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_controller != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression controller value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_controller = memory_allocate_structure(
+	                           libewf_compression_controller_t );
+
+	if( *compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression controller.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_controller,
+	     0,
+	     sizeof( libewf_compression_controller_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression controller.",
+		 function );
+
+		memory_free(
+		 *compression_controller );
+
+		*compression_controller = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *compression_controller )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *compression_controller )->deflate_level = LIBEWF_ADAPTIVE_COMPRESSION_DEFAULT_LEVEL;
+
+	return( 1 );
+
+on_error:
+	if( *compression_controller != NULL )
+	{
+		memory_free(
+		 *compression_controller );
+
+		*compression_controller = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression controller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_free(
+     libewf_compression_controller_t **compression_controller,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_free";
+	int result            = 1;
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_controller != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *compression_controller )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *compression_controller );
+
+		*compression_controller = NULL;
+	}
+	return( result );
+}
+
+/* Resets the compression controller to start at a specific deflate compression level
+ * The measurements and the number of chunks per deflate compression level are cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_reset(
+     libewf_compression_controller_t *compression_controller,
+     int deflate_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_reset";
+	int level_index       = 0;
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( deflate_level < LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LEVEL )
+	 || ( deflate_level > LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LEVEL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid deflate level value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	compression_controller->deflate_level                         = deflate_level;
+	compression_controller->has_current_time                      = 0;
+	compression_controller->window_start_time                     = 0;
+	compression_controller->window_number_of_chunks               = 0;
+	compression_controller->window_compression_time               = 0;
+	compression_controller->window_maximum_number_of_compressions = compression_controller->number_of_compressions;
+
+	for( level_index = 0;
+	     level_index < 10;
+	     level_index++ )
+	{
+		compression_controller->number_of_chunks[ level_index ] = 0;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the current time of a monotonic clock in nano seconds
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_compression_controller_get_current_time(
+     int64_t *current_time,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "libewf_compression_controller_get_current_time";
+
+	if( current_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	/* Split the conversion to prevent the multiplication from overflowing
+	 */
+	*current_time = ( ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	              + ( ( ( counter.QuadPart % frequency.QuadPart ) * 1000000000 ) / frequency.QuadPart );
+
+	return( 1 );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		return( 0 );
+	}
+	*current_time = ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec;
+
+	return( 1 );
+
+#else
+	/* The resolution of time() is too coarse to measure the compression of individual chunks
+	 */
+	*current_time = 0;
+
+	return( 0 );
+
+#endif /* defined( WINAPI ) */
+}
+
+/* Starts the compression of a chunk
+ * Retrieves the deflate compression level that should be used to compress the chunk
+ * and the time the compression started
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_start_compression(
+     libewf_compression_controller_t *compression_controller,
+     int *deflate_level,
+     int64_t *start_time,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_start_compression";
+	int64_t current_time  = 0;
+	int result            = 0;
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( deflate_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid deflate level.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid start time.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_compression_controller_get_current_time(
+	          &current_time,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( result != 0 )
+	 && ( compression_controller->has_current_time == 0 ) )
+	{
+		compression_controller->has_current_time  = 1;
+		compression_controller->window_start_time = current_time;
+	}
+	compression_controller->number_of_compressions += 1;
+
+	if( compression_controller->number_of_compressions > compression_controller->window_maximum_number_of_compressions )
+	{
+		compression_controller->window_maximum_number_of_compressions = compression_controller->number_of_compressions;
+	}
+	*deflate_level = compression_controller->deflate_level;
+	*start_time    = current_time;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Stops the compression of a chunk
+ * The deflate level and start time are the values retrieved by start compression
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_stop_compression(
+     libewf_compression_controller_t *compression_controller,
+     int deflate_level,
+     int64_t start_time,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_stop_compression";
+	int64_t current_time  = 0;
+	int result            = 0;
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( deflate_level < LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LEVEL )
+	 || ( deflate_level > LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LEVEL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid deflate level value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_compression_controller_get_current_time(
+	          &current_time,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( compression_controller->number_of_compressions > 0 )
+	{
+		compression_controller->number_of_compressions -= 1;
+	}
+	compression_controller->number_of_chunks[ deflate_level ] += 1;
+
+	/* Without a clock the deflate level is not changed
+	 */
+	if( ( result != 0 )
+	 && ( compression_controller->has_current_time != 0 ) )
+	{
+		if( current_time > start_time )
+		{
+			compression_controller->window_compression_time += current_time - start_time;
+		}
+		compression_controller->window_number_of_chunks += 1;
+
+		if( compression_controller->window_number_of_chunks >= LIBEWF_ADAPTIVE_COMPRESSION_WINDOW_SIZE )
+		{
+			if( libewf_compression_controller_update_deflate_level(
+			     compression_controller,
+			     current_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update deflate level.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 compression_controller->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Updates the deflate compression level at the end of a measurement window
+ *
+ * The load of the compressor is the time spent compressing relative to the time
+ * available to the concurrent compressions during the measurement window. When
+ * the source provides chunks faster than they can be compressed, the compressions
+ * are continuously in progress and the load is high. When the source is slower the
+ * compressions wait for the next chunk and the load is low.
+ *
+ * The caller is responsible for locking the compression controller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_update_deflate_level(
+     libewf_compression_controller_t *compression_controller,
+     int64_t current_time,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_compression_controller_update_deflate_level";
+	int64_t available_time = 0;
+	int64_t load           = 0;
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_controller->window_maximum_number_of_compressions > 0 )
+	 && ( current_time > compression_controller->window_start_time ) )
+	{
+		available_time = ( current_time - compression_controller->window_start_time )
+		               * compression_controller->window_maximum_number_of_compressions;
+
+		load = ( compression_controller->window_compression_time * 100 ) / available_time;
+
+		if( ( load >= LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LOAD )
+		 && ( compression_controller->deflate_level > LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LEVEL ) )
+		{
+			compression_controller->deflate_level -= 1;
+		}
+		else if( ( load <= LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LOAD )
+		      && ( compression_controller->deflate_level < LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LEVEL ) )
+		{
+			compression_controller->deflate_level += 1;
+		}
+	}
+	compression_controller->window_start_time                     = current_time;
+	compression_controller->window_number_of_chunks               = 0;
+	compression_controller->window_compression_time               = 0;
+	compression_controller->window_maximum_number_of_compressions = compression_controller->number_of_compressions;
+
+	return( 1 );
+}
+
+/* Retrieves the current deflate compression level
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_get_deflate_level(
+     libewf_compression_controller_t *compression_controller,
+     int *deflate_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_get_deflate_level";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( deflate_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid deflate level.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*deflate_level = compression_controller->deflate_level;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of chunks compressed with a specific deflate compression level
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_controller_get_number_of_chunks(
+     libewf_compression_controller_t *compression_controller,
+     int deflate_level,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_controller_get_number_of_chunks";
+
+	if( compression_controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( deflate_level < LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LEVEL )
+	 || ( deflate_level > LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LEVEL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid deflate level value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_chunks = compression_controller->number_of_chunks[ deflate_level ];
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     compression_controller->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,132 @@
+/*
+ * Compression controller functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CONTROLLER_H )
+#define _LIBEWF_COMPRESSION_CONTROLLER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_compression_controller libewf_compression_controller_t;
+
+/* The compression controller adapts the deflate compression level of the chunks
+ * to the rate at which the chunks are provided, so that the compression keeps pace
+ * with reading the source while compressing as much as possible
+ */
+struct libewf_compression_controller
+{
+	/* The current deflate compression level
+	 */
+	int deflate_level;
+
+	/* Value to indicate the current time is available
+	 */
+	uint8_t has_current_time;
+
+	/* The start time of the current measurement window
+	 */
+	int64_t window_start_time;
+
+	/* The number of chunks compressed in the current measurement window
+	 */
+	int window_number_of_chunks;
+
+	/* The time spent compressing in the current measurement window
+	 */
+	int64_t window_compression_time;
+
+	/* The maximum number of concurrent compressions in the current measurement window
+	 */
+	int window_maximum_number_of_compressions;
+
+	/* The number of compressions that are currently in progress
+	 */
+	int number_of_compressions;
+
+	/* The number of chunks compressed per deflate compression level
+	 */
+	uint64_t number_of_chunks[ 10 ];
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libewf_compression_controller_initialize(
+     libewf_compression_controller_t **compression_controller,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_free(
+     libewf_compression_controller_t **compression_controller,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_reset(
+     libewf_compression_controller_t *compression_controller,
+     int deflate_level,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_get_current_time(
+     int64_t *current_time,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_start_compression(
+     libewf_compression_controller_t *compression_controller,
+     int *deflate_level,
+     int64_t *start_time,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_stop_compression(
+     libewf_compression_controller_t *compression_controller,
+     int deflate_level,
+     int64_t start_time,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_update_deflate_level(
+     libewf_compression_controller_t *compression_controller,
+     int64_t current_time,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_get_deflate_level(
+     libewf_compression_controller_t *compression_controller,
+     int *deflate_level,
+     libcerror_error_t **error );
+
+int libewf_compression_controller_get_number_of_chunks(
+     libewf_compression_controller_t *compression_controller,
+     int deflate_level,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_CONTROLLER_H ) */
+
@@ -553,8 +553,9 @@ ssize_t libewf_data_chunk_write_buffer(
 			goto on_error;
 		}
 	}
-	if( libewf_chunk_data_initialize(
+	if( libewf_chunk_data_initialize_from_pool(
 	     &( internal_data_chunk->chunk_data ),
+	     internal_data_chunk->io_handle->chunk_data_pool,
 	     internal_data_chunk->io_handle->chunk_size,
 	     0,
 	     error ) != 1 )
@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_adler32.h"
 #include "libewf_bit_stream.h"
 #include "libewf_deflate.h"
 #include "libewf_huffman_tree.h"
@@ -652,239 +653,23 @@ int libewf_deflate_calculate_adler32(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_deflate_calculate_adler32";
-	size_t data_offset    = 0;
-	uint32_t lower_word   = 0;
-	uint32_t upper_word   = 0;
-	uint32_t value_32bit  = 0;
-	int block_index       = 0;
 
-	if( checksum_value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid checksum value.",
-		 function );
-
-		return( -1 );
-	}
-	if( data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
-		 function );
-
-		return( -1 );
-	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( libewf_adler32_calculate(
+	     checksum_value,
+	     data,
+	     data_size,
+	     initial_value,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate Adler-32.",
 		 function );
 
 		return( -1 );
 	}
-	lower_word = initial_value & 0xffff;
-	upper_word = ( initial_value >> 16 ) & 0xffff;
-
-	while( data_size >= 0x15b0 )
-	{
-		/* The modulo calculation is needed per 5552 (0x15b0) bytes
-		 * 5552 / 16 = 347
-		 */
-		for( block_index = 0;
-		     block_index < 347;
-		     block_index++ )
-		{
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-		}
-		/* Optimized equivalent of:
-		 * lower_word %= 0xfff1
-		 */
-		value_32bit = lower_word >> 16;
-		lower_word &= 0x0000ffffUL;
-		lower_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( lower_word > 65521 )
-		{
-			value_32bit = lower_word >> 16;
-			lower_word &= 0x0000ffffUL;
-			lower_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( lower_word >= 65521 )
-		{
-			lower_word -= 65521;
-		}
-		/* Optimized equivalent of:
-		 * upper_word %= 0xfff1
-		 */
-		value_32bit = upper_word >> 16;
-		upper_word &= 0x0000ffffUL;
-		upper_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( upper_word > 65521 )
-		{
-			value_32bit = upper_word >> 16;
-			upper_word &= 0x0000ffffUL;
-			upper_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( upper_word >= 65521 )
-		{
-			upper_word -= 65521;
-		}
-		data_size -= 0x15b0;
-	}
-	if( data_size > 0 )
-	{
-		while( data_size > 16 )
-		{
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			data_size -= 16;
-		}
-		while( data_size > 0 )
-		{
-			lower_word += data[ data_offset++ ];
-			upper_word += lower_word;
-
-			data_size--;
-		}
-		/* Optimized equivalent of:
-		 * lower_word %= 0xfff1
-		 */
-		value_32bit = lower_word >> 16;
-		lower_word &= 0x0000ffffUL;
-		lower_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( lower_word > 65521 )
-		{
-			value_32bit = lower_word >> 16;
-			lower_word &= 0x0000ffffUL;
-			lower_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( lower_word >= 65521 )
-		{
-			lower_word -= 65521;
-		}
-		/* Optimized equivalent of:
-		 * upper_word %= 0xfff1
-		 */
-		value_32bit = upper_word >> 16;
-		upper_word &= 0x0000ffffUL;
-		upper_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( upper_word > 65521 )
-		{
-			value_32bit = upper_word >> 16;
-			upper_word &= 0x0000ffffUL;
-			upper_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( upper_word >= 65521 )
-		{
-			upper_word -= 65521;
-		}
-	}
-	*checksum_value = ( upper_word << 16 ) | lower_word;
-
 	return( 1 );
 }
 
@@ -1224,6 +1009,17 @@ int libewf_deflate_read_block(
 			block_size_copy = ( block_size >> 16 ) ^ 0x0000ffffUL;
 			block_size     &= 0x0000ffffUL;
 
+			/* Return the bytes remaining in the bit stream buffer to the byte stream
+			 * and flush the bit stream buffer
+			 */
+			while( bit_stream->bit_buffer_size >= 8 )
+			{
+				bit_stream->byte_stream_offset -= 1;
+				bit_stream->bit_buffer_size    -= 8;
+			}
+			bit_stream->bit_buffer      = 0;
+			bit_stream->bit_buffer_size = 0;
+
 			if( block_size != block_size_copy )
 			{
 				libcerror_error_set(
@@ -1280,11 +1076,6 @@ int libewf_deflate_read_block(
 			bit_stream->byte_stream_offset += block_size;
 			safe_uncompressed_data_offset  += block_size;
 
-			/* Flush the bit stream buffer
-			 */
-			bit_stream->bit_buffer      = 0;
-			bit_stream->bit_buffer_size = 0;
-
 			break;
 
 		case LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED:
@@ -1536,7 +1327,10 @@ int libewf_deflate_decompress(
 
 		goto on_error;
 	}
-	while( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	/* The bit stream buffer can contain bytes that were read ahead
+	 */
+	while( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	    || ( bit_stream->bit_buffer_size >= 8 ) )
 	{
 		if( libewf_deflate_read_block_header(
 		     bit_stream,
@@ -1821,7 +1615,10 @@ int libewf_deflate_decompress_zlib(
 
 		goto on_error;
 	}
-	while( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	/* The bit stream buffer can contain bytes that were read ahead
+	 */
+	while( ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size )
+	    || ( bit_stream->bit_buffer_size >= 8 ) )
 	{
 		if( libewf_deflate_read_block_header(
 		     bit_stream,
@@ -1913,13 +1710,15 @@ int libewf_deflate_decompress_zlib(
 			break;
 		}
 	}
+	/* Return the bytes remaining in the bit stream buffer to the byte stream
+	 */
+	while( bit_stream->bit_buffer_size >= 8 )
+	{
+		bit_stream->byte_stream_offset -= 1;
+		bit_stream->bit_buffer_size    -= 8;
+	}
 	if( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 4 )
 	{
-		while( bit_stream->bit_buffer_size >= 8 )
-		{
-			bit_stream->byte_stream_offset -= 1;
-			bit_stream->bit_buffer_size    -= 8;
-		}
 		byte_stream_copy_to_uint32_big_endian(
 		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
 		 stored_checksum );
@@ -0,0 +1,360 @@
+/*
+ * File mapping functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_file_mapping.h"
+
+#if defined( HAVE_LIBEWF_FILE_MAPPING_SUPPORT )
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#include <sys/mman.h>
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#endif /* defined( HAVE_LIBEWF_FILE_MAPPING_SUPPORT ) */
+
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+/* Creates a file mapping
+ * Make sure the value file_mapping is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_mapping_initialize(
+     libewf_file_mapping_t **file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_mapping_initialize";
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_mapping != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file mapping value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*file_mapping = memory_allocate_structure(
+	                 libewf_file_mapping_t );
+
+	if( *file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file mapping.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_mapping,
+	     0,
+	     sizeof( libewf_file_mapping_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file mapping.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_mapping != NULL )
+	{
+		memory_free(
+		 *file_mapping );
+
+		*file_mapping = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file mapping
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_mapping_free(
+     libewf_file_mapping_t **file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_mapping_free";
+	int result            = 1;
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_mapping != NULL )
+	{
+#if defined( HAVE_LIBEWF_FILE_MAPPING_SUPPORT )
+		if( ( *file_mapping )->data != NULL )
+		{
+			if( munmap(
+			     (void *) ( *file_mapping )->data,
+			     ( *file_mapping )->data_size ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unmap data.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *file_mapping );
+
+		*file_mapping = NULL;
+	}
+	return( result );
+}
+
+/* Maps a file read-only into memory
+ * The file should not be truncated or modified while it is mapped
+ * Returns 1 if successful, 0 if the file could not be mapped or -1 on error
+ */
+int libewf_file_mapping_map_file(
+     libewf_file_mapping_t *file_mapping,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_mapping_map_file";
+
+#if defined( HAVE_LIBEWF_FILE_MAPPING_SUPPORT )
+	struct stat file_statistics;
+
+	void *data            = NULL;
+	int file_descriptor   = -1;
+	int result            = 0;
+#endif
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_mapping->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file mapping - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_FILE_MAPPING_SUPPORT )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     &file_statistics,
+	     0,
+	     sizeof( struct stat ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file statistics.",
+		 function );
+
+		close(
+		 file_descriptor );
+
+		return( -1 );
+	}
+	/* Only regular files that fit in the address space are mapped
+	 */
+	if( ( fstat(
+	       file_descriptor,
+	       &file_statistics ) == 0 )
+	 && ( S_ISREG( file_statistics.st_mode ) )
+	 && ( file_statistics.st_size > 0 )
+	 && ( (uint64_t) file_statistics.st_size <= (uint64_t) SSIZE_MAX ) )
+	{
+		data = mmap(
+		        NULL,
+		        (size_t) file_statistics.st_size,
+		        PROT_READ,
+		        MAP_SHARED,
+		        file_descriptor,
+		        0 );
+
+		if( data != MAP_FAILED )
+		{
+			file_mapping->data      = (uint8_t *) data;
+			file_mapping->data_size = (size_t) file_statistics.st_size;
+
+			result = 1;
+		}
+	}
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	close(
+	 file_descriptor );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( result != 0 )
+		{
+			libcnotify_printf(
+			 "%s: mapped file: %s of size: %" PRIzd ".\n",
+			 function,
+			 filename,
+			 file_mapping->data_size );
+		}
+		else
+		{
+			libcnotify_printf(
+			 "%s: unable to map file: %s.\n",
+			 function,
+			 filename );
+		}
+	}
+#endif
+	return( result );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBEWF_FILE_MAPPING_SUPPORT ) */
+}
+
+/* Retrieves a pointer to the mapped data at a specific offset
+ * Returns 1 if successful, 0 if the data is not mapped or -1 on error
+ */
+int libewf_file_mapping_get_data_at_offset(
+     libewf_file_mapping_t *file_mapping,
+     off64_t offset,
+     size64_t size,
+     uint8_t **data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_mapping_get_data_at_offset";
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_mapping->data == NULL )
+	 || ( (size64_t) offset > (size64_t) file_mapping->data_size )
+	 || ( size > ( (size64_t) file_mapping->data_size - (size64_t) offset ) ) )
+	{
+		return( 0 );
+	}
+	*data = &( file_mapping->data[ offset ] );
+
+	return( 1 );
+}
+
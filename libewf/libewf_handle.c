@@ -28,10 +28,13 @@
 #include "libewf_analytical_data.h"
 #include "libewf_case_data.h"
 #include "libewf_case_data_section.h"
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
 #include "libewf_chunk_table.h"
 #include "libewf_codepage.h"
 #include "libewf_compression.h"
+#include "libewf_compression_controller.h"
 #include "libewf_data_chunk.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
@@ -40,6 +43,7 @@
 #include "libewf_digest_section.h"
 #include "libewf_error2_section.h"
 #include "libewf_file_entry.h"
+#include "libewf_file_mapping.h"
 #include "libewf_handle.h"
 #include "libewf_hash_sections.h"
 #include "libewf_hash_values.h"
@@ -57,12 +61,14 @@
 #include "libewf_libfvalue.h"
 #include "libewf_ltree_section.h"
 #include "libewf_md5_hash_section.h"
+#include "libewf_read_request.h"
 #include "libewf_restart_data.h"
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
 #include "libewf_sector_range.h"
 #include "libewf_sector_range_list.h"
 #include "libewf_segment_file.h"
+#include "libewf_segment_file_scan.h"
 #include "libewf_session_section.h"
 #include "libewf_sha1_hash_section.h"
 #include "libewf_single_file_tree.h"
@@ -238,6 +244,9 @@ int libewf_handle_initialize(
 #endif
 	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->maximum_cache_size             = LIBEWF_DEFAULT_MAXIMUM_CACHE_SIZE;
+	internal_handle->number_of_read_ahead_chunks    = LIBEWF_DEFAULT_NUMBER_OF_READ_AHEAD_CHUNKS;
+	internal_handle->number_of_read_ahead_threads   = LIBEWF_DEFAULT_NUMBER_OF_READ_AHEAD_THREADS;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -344,6 +353,22 @@ int libewf_handle_free(
 			result = -1;
 		}
 #endif
+		if( internal_handle->index_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( internal_handle->index_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libewf_segment_table_free(
 		     &( internal_handle->segment_table ),
 		     error ) != 1 )
@@ -735,8 +760,34 @@ int libewf_handle_clone(
 		}
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
-	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
-	internal_destination_handle->date_format                    = internal_source_handle->date_format;
+	internal_destination_handle->maximum_number_of_open_handles    = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->maximum_cache_size                = internal_source_handle->maximum_cache_size;
+	internal_destination_handle->number_of_read_ahead_chunks       = internal_source_handle->number_of_read_ahead_chunks;
+	internal_destination_handle->number_of_read_ahead_threads      = internal_source_handle->number_of_read_ahead_threads;
+	internal_destination_handle->number_of_write_threads           = internal_source_handle->number_of_write_threads;
+	internal_destination_handle->maximum_chunk_location_table_size = internal_source_handle->maximum_chunk_location_table_size;
+	internal_destination_handle->use_memory_mapping                = internal_source_handle->use_memory_mapping;
+	internal_destination_handle->async_io_queue_depth              = internal_source_handle->async_io_queue_depth;
+	internal_destination_handle->date_format                       = internal_source_handle->date_format;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_destination_handle->chunk_table != NULL )
+	{
+		if( libewf_internal_handle_initialize_read_ahead(
+		     internal_destination_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize destination read-ahead.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 
 	*destination_handle = (libewf_handle_t *) internal_destination_handle;
 
@@ -866,7 +917,8 @@ int libewf_handle_signal_abort(
 
 		return( -1 );
 	}
-	internal_handle->io_handle->abort = 1;
+	internal_handle->io_handle->abort             = 1;
+	internal_handle->io_handle->abort_generation += 1;
 
 	return( 1 );
 }
@@ -1195,6 +1247,48 @@ int libewf_handle_open(
 	{
 		internal_handle->file_io_pool                    = file_io_pool;
 		internal_handle->file_io_pool_created_in_library = 1;
+
+		if( ( internal_handle->use_memory_mapping != 0 )
+		 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+		{
+			if( libewf_internal_handle_map_segment_files(
+			     internal_handle,
+			     file_io_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to map segment files.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( result == 1 )
+		 && ( internal_handle->async_io_queue_depth > 0 )
+		 && ( internal_handle->number_of_read_ahead_chunks > 0 )
+		 && ( internal_handle->number_of_read_ahead_threads > 0 )
+		 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+		{
+			if( libewf_internal_handle_open_async_io(
+			     internal_handle,
+			     file_io_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to open segment files for asynchronous IO.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -1558,6 +1652,48 @@ int libewf_handle_open_wide(
 	{
 		internal_handle->file_io_pool                    = file_io_pool;
 		internal_handle->file_io_pool_created_in_library = 1;
+
+		if( ( internal_handle->use_memory_mapping != 0 )
+		 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+		{
+			if( libewf_internal_handle_map_segment_files(
+			     internal_handle,
+			     file_io_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to map segment files.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( result == 1 )
+		 && ( internal_handle->async_io_queue_depth > 0 )
+		 && ( internal_handle->number_of_read_ahead_chunks > 0 )
+		 && ( internal_handle->number_of_read_ahead_threads > 0 )
+		 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+		{
+			if( libewf_internal_handle_open_async_io(
+			     internal_handle,
+			     file_io_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to open segment files for asynchronous IO.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2799,6 +2935,13 @@ int libewf_internal_handle_open_read_segment_files(
 	int file_io_pool_entry              = 0;
 	int last_segment_file               = 0;
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint32_t number_of_scanned_segments = 0;
+	uint32_t scanned_segment_number     = 0;
+	int maximum_number_of_open_handles  = 0;
+	int number_of_scan_threads          = 0;
+#endif
+
 	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
@@ -2857,6 +3000,23 @@ int libewf_internal_handle_open_read_segment_files(
 
 		return( -1 );
 	}
+	if( ( internal_handle->write_io_handle == NULL )
+	 && ( internal_handle->index_file_io_handle != NULL ) )
+	{
+		if( libewf_internal_handle_open_read_segment_files_index(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment files index.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	/* Make sure to read the device information section first so we
 	 * have the correct chunk size when reading Lx01 files.
 	 */
@@ -2876,6 +3036,32 @@ int libewf_internal_handle_open_read_segment_files(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Every scan thread uses its own file IO handle hence the number of scan threads
+	 * is bounded by the maximum number of open handles of the file IO pool
+	 */
+	if( libbfio_pool_get_maximum_number_of_open_handles(
+	     file_io_pool,
+	     &maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_scan_threads = LIBEWF_MAXIMUM_NUMBER_OF_SEGMENT_FILE_SCAN_THREADS;
+
+	if( ( maximum_number_of_open_handles != LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+	 && ( maximum_number_of_open_handles < number_of_scan_threads ) )
+	{
+		number_of_scan_threads = maximum_number_of_open_handles;
+	}
+#endif
 	for( segment_number = 0;
 	     segment_number < number_of_segments;
 	     segment_number++ )
@@ -2919,6 +3105,46 @@ int libewf_internal_handle_open_read_segment_files(
 				return( -1 );
 			}
 		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* The first segment file is read on its own, since the chunk size is needed
+		 * to read the sector tables. The segment files that follow are scanned concurrently
+		 * in batches that fit in the segment files cache.
+		 */
+		if( ( number_of_scan_threads > 1 )
+		 && ( segment_number > 0 )
+		 && ( segment_number >= scanned_segment_number )
+		 && ( ( number_of_segments - segment_number ) > 1 )
+		 && ( internal_handle->io_handle->chunk_size != 0 ) )
+		{
+			number_of_scanned_segments = number_of_segments - segment_number;
+
+			if( number_of_scanned_segments > LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES )
+			{
+				number_of_scanned_segments = LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES;
+			}
+			if( libewf_internal_handle_scan_segment_files(
+			     internal_handle,
+			     file_io_pool,
+			     segment_table,
+			     segment_number,
+			     number_of_scanned_segments,
+			     number_of_scan_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to scan segment files: %" PRIu32 " - %" PRIu32 ".",
+				 function,
+				 segment_number,
+				 segment_number + number_of_scanned_segments - 1 );
+
+				return( -1 );
+			}
+			scanned_segment_number = segment_number + number_of_scanned_segments;
+		}
+#endif
 		if( libewf_segment_table_get_segment_file_by_index(
 		     segment_table,
 		     segment_number,
@@ -3039,22 +3265,29 @@ int libewf_internal_handle_open_read_segment_files(
 			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
 			internal_handle->io_handle->is_encrypted = 1;
 		}
-		if( libewf_internal_handle_open_read_segment_file_section_data(
-		     internal_handle,
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     error ) != 1 )
+		/* Segment files restored from the segment files index that only contain
+		 * sector data, sector table, next and done sections have no section data to read
+		 */
+		if( ( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_READ_FROM_INDEX ) == 0 )
+		 || ( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_HAS_METADATA_SECTIONS ) != 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section data from segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
+			if( libewf_internal_handle_open_read_segment_file_section_data(
+			     internal_handle,
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section data from segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
 
-			return( -1 );
+				return( -1 );
+			}
 		}
 		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
 		{
@@ -3104,26 +3337,44 @@ int libewf_internal_handle_open_read_segment_files(
 
 		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
 	}
+	if( libewf_internal_handle_close_segment_files_index(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to close segment files index.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Reads the device information from the segment files
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Scans segment files concurrently
+ * The segment files are read with their own file IO handle and are stored
+ * in the segment table in segment order. Segment files that could not be scanned
+ * are read again when they are retrieved from the segment table.
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_read_device_information(
+int libewf_internal_handle_scan_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
      uint32_t number_of_segments,
+     int number_of_threads,
      libcerror_error_t **error )
 {
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	libewf_segment_file_t *segment_file             = NULL;
-	libfcache_cache_t *sections_cache               = NULL;
-	static char *function                           = "libewf_internal_handle_open_read_device_information";
+	libewf_segment_file_scan_t **segment_file_scans = NULL;
+	libcthreads_thread_pool_t *thread_pool          = NULL;
+	static char *function                           = "libewf_internal_handle_scan_segment_files";
 	size64_t segment_file_size                      = 0;
-	ssize_t read_count                              = 0;
-	uint32_t segment_number                         = 0;
+	uint32_t scan_index                             = 0;
 	int file_io_pool_entry                          = 0;
 
 	if( internal_handle == NULL )
@@ -3137,230 +3388,252 @@ int libewf_internal_handle_open_read_device_information(
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( number_of_segments > (uint32_t) LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
 		 "%s: invalid number of segments value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_segment_file_by_index(
-	     segment_table,
-	     segment_number,
-	     file_io_pool,
-	     &segment_file,
-	     error ) != 1 )
+	if( number_of_threads <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-		 function,
-		 segment_number );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( segment_file == NULL )
+	if( (uint32_t) number_of_threads > number_of_segments )
+	{
+		number_of_threads = (int) number_of_segments;
+	}
+	segment_file_scans = (libewf_segment_file_scan_t **) memory_allocate(
+	                                                      sizeof( libewf_segment_file_scan_t * ) * number_of_segments );
+
+	if( segment_file_scans == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing segment file: %" PRIu32 ".",
-		 function,
-		 segment_number );
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment file scans.",
+		 function );
 
 		goto on_error;
 	}
-	if( segment_file->major_version != 2 )
+	if( memory_set(
+	     segment_file_scans,
+	     0,
+	     sizeof( libewf_segment_file_scan_t * ) * number_of_segments ) == NULL )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment file scans.",
+		 function );
+
+		memory_free(
+		 segment_file_scans );
+
+		return( -1 );
 	}
-	if( segment_file->device_information_section_index == -1 )
+	for( scan_index = 0;
+	     scan_index < number_of_segments;
+	     scan_index++ )
 	{
-		/* Lx01 stores the device information in the last segment file
-		 */
-		segment_number = number_of_segments - 1;
-
-		if( libewf_segment_table_get_segment_file_by_index(
+		if( libewf_segment_table_get_segment_by_index(
 		     segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
+		     first_segment_number + scan_index,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
 			 function,
-			 segment_number );
+			 first_segment_number + scan_index );
 
 			goto on_error;
 		}
-		if( segment_file == NULL )
+		if( libewf_segment_file_scan_initialize(
+		     &( segment_file_scans[ scan_index ] ),
+		     internal_handle->io_handle,
+		     first_segment_number + scan_index + 1,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     segment_file_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file scan: %" PRIu32 ".",
 			 function,
-			 segment_number );
+			 scan_index );
 
 			goto on_error;
 		}
 	}
-	if( segment_file->device_information_section_index == -1 )
+	if( libcthreads_thread_pool_create(
+	     &thread_pool,
+	     NULL,
+	     number_of_threads,
+	     (int) number_of_segments,
+	     (int (*)(intptr_t *, void *)) &libewf_segment_file_scan_process_callback,
+	     NULL,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: unable to locate a device information section.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_segment_table_get_segment_by_index(
-	     segment_table,
-	     segment_number,
-	     &file_io_pool_entry,
-	     &segment_file_size,
-	     error ) != 1 )
+	for( scan_index = 0;
+	     scan_index < number_of_segments;
+	     scan_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-		 function,
-		 segment_number );
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) segment_file_scans[ scan_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push segment file scan: %" PRIu32 " onto thread pool queue.",
+			 function,
+			 scan_index );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	if( libfcache_cache_initialize(
-	     &sections_cache,
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	if( libcthreads_thread_pool_join(
+	     &thread_pool,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread pool.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfdata_list_get_element_value_by_index(
-	     segment_file->sections_list,
-	     (intptr_t *) file_io_pool,
-	     (libfdata_cache_t *) sections_cache,
-	     segment_file->device_information_section_index,
-	     (intptr_t **) &section_descriptor,
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve section: %d from sections list.",
-		 function,
-		 segment_file->device_information_section_index );
-
-		goto on_error;
-	}
-	if( libewf_segment_file_seek_offset(
-	     segment_file,
-	     file_io_pool,
-	     file_io_pool_entry,
-	     section_descriptor->start_offset,
-	     error ) == -1 )
+	/* Merge the scanned segment files in segment order
+	 */
+	for( scan_index = 0;
+	     scan_index < number_of_segments;
+	     scan_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to seek section: %d data offset: %" PRIu64 " (0x%08%" PRIx64 ").",
-		 function,
-		 segment_file->device_information_section_index,
-		 section_descriptor->start_offset );
-
-		goto on_error;
-	}
-	read_count = libewf_device_information_section_read_file_io_pool(
-		      section_descriptor,
-		      internal_handle->io_handle,
-		      file_io_pool,
-		      file_io_pool_entry,
-		      internal_handle->read_io_handle,
-		      internal_handle->media_values,
-		      internal_handle->header_values,
-		      error );
+		if( segment_file_scans[ scan_index ]->segment_file != NULL )
+		{
+			if( libewf_segment_table_set_segment_file_by_index(
+			     segment_table,
+			     first_segment_number + scan_index,
+			     file_io_pool,
+			     segment_file_scans[ scan_index ]->segment_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment file: %" PRIu32 " in segment table.",
+				 function,
+				 first_segment_number + scan_index );
 
-	if( read_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read device information section: %d.",
-		 function,
-		 segment_file->device_information_section_index );
+				goto on_error;
+			}
+			segment_file_scans[ scan_index ]->segment_file = NULL;
+		}
+		if( libewf_segment_file_scan_free(
+		     &( segment_file_scans[ scan_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file scan: %" PRIu32 ".",
+			 function,
+			 scan_index );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	if( libfcache_cache_free(
-	     &sections_cache,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sections cache.",
-		 function );
+	memory_free(
+	 segment_file_scans );
 
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
+	if( thread_pool != NULL )
 	{
-		libfcache_cache_free(
-		 &sections_cache,
+		libcthreads_thread_pool_join(
+		 &thread_pool,
 		 NULL );
 	}
+	if( segment_file_scans != NULL )
+	{
+		for( scan_index = 0;
+		     scan_index < number_of_segments;
+		     scan_index++ )
+		{
+			if( segment_file_scans[ scan_index ] != NULL )
+			{
+				libewf_segment_file_scan_free(
+				 &( segment_file_scans[ scan_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 segment_file_scans );
+	}
 	return( -1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads the segment files index
+ * A missing or invalid segment files index results in an empty segment files index
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_file_io_pool(
+int libewf_internal_handle_open_read_segment_files_index(
      libewf_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
-     libewf_segment_table_t *segment_table,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle    = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_file_io_pool";
-	size64_t segment_file_size          = 0;
-	ssize_t read_count                  = 0;
-	int file_io_pool_entry              = 0;
-	int number_of_file_io_handles       = 0;
+	static char *function = "libewf_internal_handle_open_read_segment_files_index";
+	int result            = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -3384,492 +3657,5595 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->file_io_pool != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->chunk_table != NULL )
+	if( internal_handle->segment_files_index != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
+		 "%s: invalid handle - segment files index value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( libewf_segment_files_index_initialize(
+	     &( internal_handle->segment_files_index ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment files index.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - single files value already set.",
-		 function );
+	result = libewf_segment_files_index_read_file_io_handle(
+	          internal_handle->segment_files_index,
+	          internal_handle->index_file_io_handle,
+	          error );
 
-		return( -1 );
-	}
-	if( file_io_pool == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files index.",
 		 function );
 
-		return( -1 );
-	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
-	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
-		 function );
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
 
-		return( -1 );
-	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		if( libewf_read_io_handle_initialize(
-		     &( internal_handle->read_io_handle ),
+		if( libewf_segment_files_index_empty(
+		     internal_handle->segment_files_index,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create read IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty segment files index.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	else if( libcnotify_verbose != 0 )
 	{
-		if( libewf_write_io_handle_initialize(
-		     &( internal_handle->write_io_handle ),
-		     internal_handle->io_handle,
-		     error ) != 1 )
+		if( result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create write IO handle.",
+			libcnotify_printf(
+			 "%s: missing or invalid segment files index.\n",
 			 function );
-
-			goto on_error;
+		}
+		else
+		{
+			libcnotify_printf(
+			 "%s: segment files index contains: %d entries.\n",
+			 function,
+			 internal_handle->segment_files_index->number_of_entries );
 		}
 	}
-	if( libewf_chunk_table_initialize(
-	     &( internal_handle->chunk_table ),
-	     internal_handle->io_handle,
-	     error ) != 1 )
+#endif
+	internal_handle->io_handle->segment_files_index = internal_handle->segment_files_index;
+
+	return( 1 );
+
+on_error:
+	if( internal_handle->segment_files_index != NULL )
+	{
+		libewf_segment_files_index_free(
+		 &( internal_handle->segment_files_index ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the segment files index if it was modified and frees it
+ * Failing to write the segment files index is not considered an error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_close_segment_files_index(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_close_segment_files_index";
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk table.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_header_values_initialize(
-	     &( internal_handle->header_values ),
+	if( internal_handle->io_handle != NULL )
+	{
+		internal_handle->io_handle->segment_files_index = NULL;
+	}
+	if( internal_handle->segment_files_index == NULL )
+	{
+		return( 1 );
+	}
+	if( internal_handle->segment_files_index->is_modified != 0 )
+	{
+		if( libewf_segment_files_index_write_file_io_handle(
+		     internal_handle->segment_files_index,
+		     internal_handle->index_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment files index.",
+			 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	if( libewf_segment_files_index_free(
+	     &( internal_handle->segment_files_index ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header values.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free segment files index.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_hash_sections_initialize(
-	     &( internal_handle->hash_sections ),
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Reads the device information from the segment files
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_device_information(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	libewf_segment_file_t *segment_file             = NULL;
+	libfcache_cache_t *sections_cache               = NULL;
+	static char *function                           = "libewf_internal_handle_open_read_device_information";
+	size64_t segment_file_size                      = 0;
+	ssize_t read_count                              = 0;
+	uint32_t segment_number                         = 0;
+	int file_io_pool_entry                          = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create hash sections.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( number_of_segments == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	if( libewf_segment_table_get_segment_file_by_index(
+	     segment_table,
+	     segment_number,
+	     file_io_pool,
+	     &segment_file,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+		 function,
+		 segment_number );
 
 		goto on_error;
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
 
 		goto on_error;
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	if( segment_file->major_version != 2 )
 	{
-		if( libbfio_pool_get_number_of_handles(
+		return( 1 );
+	}
+	if( segment_file->device_information_section_index == -1 )
+	{
+		/* Lx01 stores the device information in the last segment file
+		 */
+		segment_number = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
 		     file_io_pool,
-		     &number_of_file_io_handles,
+		     &segment_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of handles in the pool.",
-			 function );
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
 			goto on_error;
 		}
-		if( libewf_segment_file_initialize(
-		     &segment_file,
-		     internal_handle->io_handle,
-		     error ) != 1 )
+		if( segment_file == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create segment file.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
 
 			goto on_error;
 		}
-		for( file_io_pool_entry = 0;
-		     file_io_pool_entry < number_of_file_io_handles;
-		     file_io_pool_entry++ )
-		{
-			if( libbfio_pool_get_size(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve size of file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-			if( libbfio_pool_get_handle(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to retrieve file IO handle: %d from pool.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: processing file IO pool entry: %d.\n",
-				 function,
-				 file_io_pool_entry );
-			}
-#endif
-			read_count = libewf_segment_file_read_file_header_file_io_pool(
-				      segment_file,
-				      file_io_pool,
-				      file_io_pool_entry,
-				      error );
+	}
+	if( segment_file->device_information_section_index == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: unable to locate a device information section.",
+		 function );
 
-			if( read_count < 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read segment file header.",
-				 function );
+		goto on_error;
+	}
+	if( libewf_segment_table_get_segment_by_index(
+	     segment_table,
+	     segment_number,
+	     &file_io_pool_entry,
+	     &segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+		 function,
+		 segment_number );
 
-				goto on_error;
-			}
+		goto on_error;
+	}
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_element_value_by_index(
+	     segment_file->sections_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) sections_cache,
+	     segment_file->device_information_section_index,
+	     (intptr_t **) &section_descriptor,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve section: %d from sections list.",
+		 function,
+		 segment_file->device_information_section_index );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_seek_offset(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     section_descriptor->start_offset,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to seek section: %d data offset: %" PRIu64 " (0x%08%" PRIx64 ").",
+		 function,
+		 segment_file->device_information_section_index,
+		 section_descriptor->start_offset );
+
+		goto on_error;
+	}
+	read_count = libewf_device_information_section_read_file_io_pool(
+		      section_descriptor,
+		      internal_handle->io_handle,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      internal_handle->read_io_handle,
+		      internal_handle->media_values,
+		      internal_handle->header_values,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read device information section: %d.",
+		 function,
+		 segment_file->device_information_section_index );
+
+		goto on_error;
+	}
+	if( libfcache_cache_free(
+	     &sections_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the filename of a segment file in the file IO pool
+ * The file IO pool entry must be a file handle
+ * The filename is allocated and must be freed with memory_free
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_get_segment_filename(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     char **filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_internal_handle_get_segment_filename";
+	size_t filename_size             = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( *filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid filename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name_size(
+	     file_io_handle,
+	     &filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename size of file IO handle: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( ( filename_size == 0 )
+	 || ( filename_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	*filename = narrow_string_allocate(
+	             filename_size );
+
+	if( *filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name(
+	     file_io_handle,
+	     *filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename of file IO handle: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *filename != NULL )
+	{
+		memory_free(
+		 *filename );
+
+		*filename = NULL;
+	}
+	return( -1 );
+}
+
+/* Memory maps the segment files in the file IO pool
+ * The file IO pool must consist of file handles and is only mapped when reading
+ * Segment files that cannot be mapped are read using the file IO pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_map_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libewf_file_mapping_t *file_mapping = NULL;
+	char *filename                      = NULL;
+	static char *function               = "libewf_internal_handle_map_segment_files";
+	int file_io_pool_entry              = 0;
+	int number_of_file_io_handles       = 0;
+	int result                          = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_file_io_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file IO handles in pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( file_io_pool_entry = 0;
+	     file_io_pool_entry < number_of_file_io_handles;
+	     file_io_pool_entry++ )
+	{
+		if( libewf_internal_handle_get_segment_filename(
+		     internal_handle,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename of file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( libewf_file_mapping_initialize(
+		     &file_mapping,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file mapping.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_file_mapping_map_file(
+		          file_mapping,
+		          filename,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to map file: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		memory_free(
+		 filename );
+
+		filename = NULL;
+
+		if( result == 0 )
+		{
+			if( libewf_file_mapping_free(
+			     &file_mapping,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file mapping.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( libewf_chunk_table_set_file_mapping(
+		     internal_handle->chunk_table,
+		     file_io_pool_entry,
+		     file_mapping,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set file mapping: %d in chunk table.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		file_mapping = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( file_mapping != NULL )
+	{
+		libewf_file_mapping_free(
+		 &file_mapping,
+		 NULL );
+	}
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle    = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size          = 0;
+	ssize_t read_count                  = 0;
+	uint64_t number_of_chunks           = 0;
+	int file_io_pool_entry              = 0;
+	int number_of_file_io_handles       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - single files value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( libewf_read_io_handle_initialize(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( libewf_write_io_handle_initialize(
+		     &( internal_handle->write_io_handle ),
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_table_initialize(
+	     &( internal_handle->chunk_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk table.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_cache_set_maximum_cache_size(
+	     internal_handle->chunk_table->chunk_cache,
+	     internal_handle->maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum cache size in chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_header_values_initialize(
+	     &( internal_handle->header_values ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_hash_sections_initialize(
+	     &( internal_handle->hash_sections ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( libbfio_pool_get_number_of_handles(
+		     file_io_pool,
+		     &number_of_file_io_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of handles in the pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
+
+			goto on_error;
+		}
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_handles;
+		     file_io_pool_entry++ )
+		{
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: processing file IO pool entry: %d.\n",
+				 function,
+				 file_io_pool_entry );
+			}
+#endif
+			read_count = libewf_segment_file_read_file_header_file_io_pool(
+				      segment_file,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment file header.",
+				 function );
+
+				goto on_error;
+			}
 			if( segment_file->segment_number == 0 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
-				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
+				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libewf_segment_table_append_segment_by_segment_file(
+			     segment_table,
+			     segment_file,
+			     file_io_pool_entry,
+			     segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment: %" PRIu32 " to segment table.",
+				 function,
+				 segment_file->segment_number );
+
+				goto on_error;
+			}
+		}
+		if( libewf_segment_file_free(
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_internal_handle_open_read_segment_files(
+		     internal_handle,
+		     file_io_pool,
+		     segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment files.",
+			 function );
+
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+			{
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		if( internal_handle->media_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing media values.",
+			 function );
+
+			goto on_error;
+		}
+/* TODO refactor */
+		if( internal_handle->single_files == NULL )
+		{
+			if( libewf_internal_handle_get_media_values(
+			     internal_handle,
+			     &( internal_handle->media_values->media_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine media values.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( internal_handle->write_io_handle->values_initialized == 0 )
+		{
+			if( libewf_write_io_handle_initialize_values(
+			     internal_handle->write_io_handle,
+			     internal_handle->io_handle,
+			     internal_handle->media_values,
+			     segment_table,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize write IO handle values.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libewf_write_io_handle_initialize_resume(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     segment_table,
+		     internal_handle->read_io_handle,
+		     &( internal_handle->current_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle to resume.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_handle->io_handle->chunk_size   = internal_handle->media_values->chunk_size;
+	internal_handle->io_handle->access_flags = access_flags;
+	internal_handle->io_handle->abort        = 0;
+
+	/* The chunk locations do not change when reading
+	 */
+	if( ( internal_handle->maximum_chunk_location_table_size > 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	 && ( internal_handle->media_values->chunk_size > 0 ) )
+	{
+		number_of_chunks = internal_handle->media_values->media_size / internal_handle->media_values->chunk_size;
+
+		if( ( internal_handle->media_values->media_size % internal_handle->media_values->chunk_size ) != 0 )
+		{
+			number_of_chunks += 1;
+		}
+		if( libewf_chunk_table_initialize_chunk_location_table(
+		     internal_handle->chunk_table,
+		     number_of_chunks,
+		     internal_handle->maximum_chunk_location_table_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize chunk location table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_internal_handle_initialize_read_ahead(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->read_ahead != NULL )
+	{
+		libewf_read_ahead_free(
+		 &( internal_handle->read_ahead ),
+		 NULL );
+	}
+#endif
+	if( internal_handle->segment_files_index != NULL )
+	{
+		internal_handle->io_handle->segment_files_index = NULL;
+
+		libewf_segment_files_index_free(
+		 &( internal_handle->segment_files_index ),
+		 NULL );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &( internal_handle->single_files ),
+		 NULL );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libewf_hash_sections_free(
+		 &( internal_handle->hash_sections ),
+		 NULL );
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		libfvalue_table_free(
+		 &( internal_handle->header_values ),
+		 NULL );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &( internal_handle->chunk_table ),
+		 NULL );
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &( internal_handle->write_io_handle ),
+		 error );
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		libewf_read_io_handle_free(
+		 &( internal_handle->read_io_handle ),
+		 error );
+	}
+	return( -1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_file_io_pool(
+     libewf_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_open_file_io_pool";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_WRITE_SUPPORT )
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported - compiled without zlib.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          internal_handle->segment_table,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
+	}
+	else
+	{
+		internal_handle->file_io_pool = file_io_pool;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	internal_handle->file_io_pool = NULL;
+
+	return( -1 );
+}
+
+/* Closes the EWF handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_handle_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_close";
+	ssize_t write_count                       = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_ahead != NULL )
+	{
+		if( libewf_read_ahead_free(
+		     &( internal_handle->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->async_io != NULL )
+	{
+		if( libewf_async_io_free(
+		     &( internal_handle->async_io ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free asynchronous IO.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	{
+		write_count = libewf_internal_handle_write_finalize_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize write.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->write_queue != NULL )
+	{
+		if( libewf_write_queue_free(
+		     &( internal_handle->write_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( internal_handle->file_io_pool_created_in_library != 0 )
+	{
+		if( libbfio_pool_close_all(
+		     internal_handle->file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO pool handles.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_handle->file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->file_io_pool_created_in_library = 0;
+	}
+	internal_handle->file_io_pool = NULL;
+
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_media_values_clear(
+	     internal_handle->media_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear media values.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		if( libewf_read_io_handle_free(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		if( libewf_write_io_handle_free(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
+	 */
+	if( internal_handle->chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		if( libewf_chunk_table_free(
+		     &( internal_handle->chunk_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		if( libewf_hash_sections_free(
+		     &( internal_handle->hash_sections ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash sections.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->header_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &( internal_handle->single_files ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single files.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_segment_table_clear(
+	     internal_handle->segment_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear segment table.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	return( result );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads a chunk ahead into the chunk cache
+ * Callback function for the read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	static char *function                         = "libewf_internal_handle_read_ahead_chunk";
+	off64_t chunk_data_offset                     = 0;
+	off64_t offset                                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index > (uint64_t) ( INT64_MAX / internal_handle->media_values->chunk_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	offset = (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+
+	if( libewf_chunk_table_grab_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->io_handle,
+	     internal_handle->file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     offset,
+	     &chunk_data_offset,
+	     &chunk_cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_release_chunk_data(
+	     internal_handle->chunk_table,
+	     &chunk_cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads a range of chunks ahead into the chunk cache using asynchronous IO
+ * Callback function for the read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_chunks(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t first_chunk_index,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_read_ahead_chunks";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_read_chunks_with_async_io(
+	     internal_handle->chunk_table,
+	     internal_handle->io_handle,
+	     internal_handle->file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->async_io,
+	     first_chunk_index,
+	     number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks: %" PRIu64 " to %" PRIu64 ".",
+		 function,
+		 first_chunk_index,
+		 first_chunk_index + number_of_chunks - 1 );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Initializes the read-ahead
+ * The read-ahead is only used when reading, with a non-zero number of chunks and threads
+ * and when at least 2 read-ahead windows fit in the chunk data cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_initialize_read_ahead(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function              = "libewf_internal_handle_initialize_read_ahead";
+	uint64_t maximum_number_of_chunks  = 0;
+	uint64_t number_of_cached_chunks   = 0;
+	int number_of_chunks               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_ahead != NULL )
+	{
+		if( libewf_read_ahead_free(
+		     &( internal_handle->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( internal_handle->read_io_handle == NULL )
+	 || ( internal_handle->write_io_handle != NULL )
+	 || ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 )
+	 || ( internal_handle->number_of_read_ahead_chunks <= 0 )
+	 || ( internal_handle->number_of_read_ahead_threads <= 0 ) )
+	{
+		return( 1 );
+	}
+	number_of_chunks        = internal_handle->number_of_read_ahead_chunks;
+	number_of_cached_chunks = internal_handle->maximum_cache_size / ( 2 * (size64_t) internal_handle->media_values->chunk_size );
+
+	if( (uint64_t) number_of_chunks > number_of_cached_chunks )
+	{
+		number_of_chunks = (int) number_of_cached_chunks;
+	}
+	if( number_of_chunks == 0 )
+	{
+		return( 1 );
+	}
+	maximum_number_of_chunks = internal_handle->media_values->media_size / internal_handle->media_values->chunk_size;
+
+	if( ( internal_handle->media_values->media_size % internal_handle->media_values->chunk_size ) != 0 )
+	{
+		maximum_number_of_chunks += 1;
+	}
+	if( libewf_read_ahead_initialize(
+	     &( internal_handle->read_ahead ),
+	     number_of_chunks,
+	     internal_handle->number_of_read_ahead_threads,
+	     maximum_number_of_chunks,
+	     (int (*)(void *, uint64_t, libcerror_error_t **)) &libewf_internal_handle_read_ahead_chunk,
+	     (void *) internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->async_io != NULL )
+	{
+		if( libewf_read_ahead_set_read_chunks_callback(
+		     internal_handle->read_ahead,
+		     (int (*)(void *, uint64_t, int, libcerror_error_t **)) &libewf_internal_handle_read_ahead_chunks,
+		     internal_handle->async_io->queue_depth,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set read chunks callback in read-ahead.",
+			 function );
+
+			libewf_read_ahead_free(
+			 &( internal_handle->read_ahead ),
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the segment files for asynchronous IO and initializes the read-ahead to use it
+ * Falls back to synchronous reads if asynchronous IO is not supported
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_async_io(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	char *filename                = NULL;
+	static char *function         = "libewf_internal_handle_open_async_io";
+	int file_io_pool_entry        = 0;
+	int number_of_file_io_handles = 0;
+	int result                    = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->async_io != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - asynchronous IO value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_file_io_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file IO handles in pool.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_async_io_initialize(
+	          &( internal_handle->async_io ),
+	          number_of_file_io_handles,
+	          internal_handle->async_io_queue_depth,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create asynchronous IO.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( file_io_pool_entry = 0;
+	     file_io_pool_entry < number_of_file_io_handles;
+	     file_io_pool_entry++ )
+	{
+		if( libewf_internal_handle_get_segment_filename(
+		     internal_handle,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename of file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		/* Segment files that cannot be opened are read synchronously
+		 */
+		if( libewf_async_io_open_file(
+		     internal_handle->async_io,
+		     file_io_pool_entry,
+		     filename,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file: %s for asynchronous IO.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		memory_free(
+		 filename );
+
+		filename = NULL;
+	}
+	if( libewf_internal_handle_initialize_read_ahead(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	if( internal_handle->async_io != NULL )
+	{
+		libewf_async_io_free(
+		 &( internal_handle->async_io ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * The current offset is neither used nor changed
+ * This function is multi-thread safe if the read lock is acquired before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	libewf_chunk_data_t *chunk_data               = NULL;
+	static char *function                         = "libewf_internal_handle_read_buffer_at_offset_from_file_io_pool";
+	off64_t chunk_data_offset                     = 0;
+	size_t buffer_offset                          = 0;
+	size_t read_size                              = 0;
+	uint32_t abort_generation                     = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	/* Multiple threads can read at an offset concurrently hence the abort flag is not reset here,
+	 * instead an abort only applies if it was signalled after the read started
+	 */
+	abort_generation = internal_handle->io_handle->abort_generation;
+
+	if( (size64_t) ( offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->read_ahead != NULL )
+	 && ( buffer_size > 0 ) )
+	{
+		if( libewf_read_ahead_notify_read(
+		     internal_handle->read_ahead,
+		     (uint64_t) offset / internal_handle->media_values->chunk_size,
+		     (uint64_t) ( offset + buffer_size - 1 ) / internal_handle->media_values->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to notify read-ahead of read.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	while( buffer_size > 0 )
+	{
+		if( libewf_chunk_table_grab_chunk_data_by_offset(
+		     internal_handle->chunk_table,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     offset,
+		     &chunk_data_offset,
+		     &chunk_cache_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		chunk_data = chunk_cache_entry->chunk_data;
+
+		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 function,
+			 chunk_data->chunk_index );
+
+			goto on_error;
+		}
+		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+		if( read_size > buffer_size )
+		{
+			read_size = buffer_size;
+		}
+		if( read_size > 0 )
+		{
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_data->chunk_index );
+
+				goto on_error;
+			}
+		}
+		chunk_data = NULL;
+
+		if( libewf_chunk_table_release_chunk_data(
+		     internal_handle->chunk_table,
+		     &chunk_cache_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+		buffer_offset += read_size;
+		buffer_size   -= read_size;
+		offset        += (off64_t) read_size;
+
+		if( (size64_t) offset >= internal_handle->media_values->media_size )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort_generation != abort_generation )
+		{
+			break;
+		}
+		chunk_data_offset = 0;
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( chunk_cache_entry != NULL )
+	{
+		libewf_chunk_table_release_chunk_data(
+		 internal_handle->chunk_table,
+		 &chunk_cache_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_read_buffer_from_file_io_pool";
+	ssize_t read_count    = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+	              internal_handle,
+	              file_io_pool,
+	              buffer,
+	              buffer_size,
+	              internal_handle->current_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		return( -1 );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	internal_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * The current offset is not changed, multiple threads can read concurrently
+ * A signalled abort only applies to the reads that are in progress
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at specific offsets into multiple buffers using a Basic File IO (bfio) pool
+ * The requests are split per chunk and sorted by chunk index so that every chunk is read and
+ * decompressed only once, the number of bytes read per request is stored in read_counts,
+ * which is -1 if the request failed
+ * The current offset is neither used nor changed
+ * This function is multi-thread safe if the read lock is acquired before call
+ * Returns 1 if successful, 0 if one or more requests failed or -1 on error
+ */
+int libewf_internal_handle_read_buffers_at_offsets_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int number_of_buffers,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	libewf_chunk_data_t *chunk_data               = NULL;
+	libewf_read_request_t *read_request           = NULL;
+	libewf_read_request_t *read_requests          = NULL;
+	static char *function                         = "libewf_internal_handle_read_buffers_at_offsets_from_file_io_pool";
+	size64_t chunk_size                           = 0;
+	size64_t media_size                           = 0;
+	size_t buffer_offset                          = 0;
+	size_t buffer_size                            = 0;
+	size_t number_of_read_requests                = 0;
+	size_t read_size                              = 0;
+	uint64_t chunk_index                          = 0;
+	uint64_t first_chunk_index                    = 0;
+	uint64_t last_chunk_index                     = 0;
+	off64_t chunk_data_offset                     = 0;
+	off64_t offset                                = 0;
+	size_t group_end_index                        = 0;
+	size_t read_request_index                     = 0;
+	uint32_t abort_generation                     = 0;
+	int buffer_index                              = 0;
+	int result                                    = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of buffers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_size = internal_handle->media_values->chunk_size;
+	media_size = internal_handle->media_values->media_size;
+
+	/* Determine the number of bytes to read per buffer and the number of chunks the buffers span
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		buffer_size = buffer_sizes[ buffer_index ];
+		offset      = offsets[ buffer_index ];
+
+		if( buffers[ buffer_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( buffer_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid buffer: %d offset value out of bounds.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( (size64_t) offset >= media_size )
+		{
+			buffer_size = 0;
+		}
+		else if( (size64_t) ( offset + buffer_size ) >= media_size )
+		{
+			buffer_size = (size_t) ( media_size - offset );
+		}
+		read_counts[ buffer_index ] = (ssize_t) buffer_size;
+
+		if( buffer_size > 0 )
+		{
+			first_chunk_index = (uint64_t) offset / chunk_size;
+			last_chunk_index  = (uint64_t) ( offset + buffer_size - 1 ) / chunk_size;
+
+			number_of_read_requests += (size_t) ( last_chunk_index - first_chunk_index + 1 );
+		}
+	}
+	if( number_of_read_requests == 0 )
+	{
+		return( 1 );
+	}
+	if( number_of_read_requests > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_read_request_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of read requests value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	read_requests = (libewf_read_request_t *) memory_allocate(
+	                                           sizeof( libewf_read_request_t ) * number_of_read_requests );
+
+	if( read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read requests.",
+		 function );
+
+		goto on_error;
+	}
+	/* Split the buffers into per chunk read requests
+	 */
+	read_request_index = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		buffer_size   = (size_t) read_counts[ buffer_index ];
+		buffer_offset = 0;
+		offset        = offsets[ buffer_index ];
+
+		while( buffer_size > 0 )
+		{
+			read_request = &( read_requests[ read_request_index++ ] );
+
+			read_request->chunk_index       = (uint64_t) offset / chunk_size;
+			read_request->chunk_data_offset = (size_t) ( (uint64_t) offset % chunk_size );
+			read_request->data_size         = (size_t) ( chunk_size - read_request->chunk_data_offset );
+			read_request->buffer_index      = buffer_index;
+			read_request->buffer_offset     = buffer_offset;
+
+			if( read_request->data_size > buffer_size )
+			{
+				read_request->data_size = buffer_size;
+			}
+			buffer_offset += read_request->data_size;
+			buffer_size   -= read_request->data_size;
+			offset        += (off64_t) read_request->data_size;
+		}
+	}
+	if( libewf_read_requests_sort(
+	     read_requests,
+	     number_of_read_requests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to sort read requests.",
+		 function );
+
+		goto on_error;
+	}
+	/* Read every chunk once and copy its data into all the buffers that reference it
+	 * Multiple threads can read at offsets concurrently hence the abort flag is not reset here,
+	 * instead an abort only applies if it was signalled after the read started
+	 */
+	abort_generation   = internal_handle->io_handle->abort_generation;
+	read_request_index = 0;
+
+	while( read_request_index < number_of_read_requests )
+	{
+		chunk_index     = read_requests[ read_request_index ].chunk_index;
+		group_end_index = read_request_index + 1;
+
+		while( ( group_end_index < number_of_read_requests )
+		    && ( read_requests[ group_end_index ].chunk_index == chunk_index ) )
+		{
+			group_end_index++;
+		}
+		if( internal_handle->io_handle->abort_generation != abort_generation )
+		{
+			chunk_data = NULL;
+		}
+		else if( libewf_chunk_table_grab_chunk_data_by_offset(
+		          internal_handle->chunk_table,
+		          internal_handle->io_handle,
+		          file_io_pool,
+		          internal_handle->media_values,
+		          internal_handle->segment_table,
+		          (off64_t) ( chunk_index * chunk_size ),
+		          &chunk_data_offset,
+		          &chunk_cache_entry,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			while( read_request_index < group_end_index )
+			{
+				read_counts[ read_requests[ read_request_index++ ].buffer_index ] = -1;
+			}
+			result = 0;
+
+			continue;
+		}
+		else
+		{
+			chunk_data = chunk_cache_entry->chunk_data;
+		}
+		while( read_request_index < group_end_index )
+		{
+			read_request = &( read_requests[ read_request_index++ ] );
+			buffer_index = read_request->buffer_index;
+
+			if( read_counts[ buffer_index ] == -1 )
+			{
+				continue;
+			}
+			read_size = 0;
+
+			if( ( chunk_data != NULL )
+			 && ( read_request->chunk_data_offset < chunk_data->data_size ) )
+			{
+				read_size = chunk_data->data_size - read_request->chunk_data_offset;
+
+				if( read_size > read_request->data_size )
+				{
+					read_size = read_request->data_size;
+				}
+				if( memory_copy(
+				     &( ( (uint8_t *) buffers[ buffer_index ] )[ read_request->buffer_offset ] ),
+				     &( ( chunk_data->data )[ read_request->chunk_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk: %" PRIu64 " data to buffer: %d.",
+					 function,
+					 chunk_index,
+					 buffer_index );
+
+					goto on_error;
+				}
+			}
+			/* Data that could not be read truncates the request
+			 */
+			if( read_size < read_request->data_size )
+			{
+				buffer_size = read_request->buffer_offset + read_size;
+
+				if( (size_t) read_counts[ buffer_index ] > buffer_size )
+				{
+					read_counts[ buffer_index ] = (ssize_t) buffer_size;
+				}
+			}
+		}
+		chunk_data = NULL;
+
+		if( chunk_cache_entry != NULL )
+		{
+			if( libewf_chunk_table_release_chunk_data(
+			     internal_handle->chunk_table,
+			     &chunk_cache_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	memory_free(
+	 read_requests );
+
+	return( result );
+
+on_error:
+	if( chunk_cache_entry != NULL )
+	{
+		libewf_chunk_table_release_chunk_data(
+		 internal_handle->chunk_table,
+		 &chunk_cache_entry,
+		 NULL );
+	}
+	if( read_requests != NULL )
+	{
+		memory_free(
+		 read_requests );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at specific offsets into multiple buffers
+ * Every chunk touched by the buffers is read and decompressed only once
+ * The number of bytes read per buffer is stored in read_counts, which is -1 if the read failed
+ * The current offset is not changed, multiple threads can read concurrently
+ * A signalled abort only applies to the reads that are in progress
+ * Returns 1 if successful, 0 if one or more reads failed or -1 on error
+ */
+int libewf_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle,
+     int number_of_buffers,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffers_at_offsets";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_read_buffers_at_offsets_from_file_io_pool(
+	          internal_handle,
+	          internal_handle->file_io_pool,
+	          number_of_buffers,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a read-only view of the (media) data at a specific offset
+ * The view references the cached chunk data directly, which avoids copying the data
+ * and covers the data from the offset up to the end of the chunk
+ * The view must be released with libewf_handle_release_chunk_view before the handle is closed
+ * The current offset is not changed, multiple threads can retrieve views concurrently
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	const uint8_t *safe_data                  = NULL;
+	static char *function                     = "libewf_handle_get_chunk_view";
+	size_t safe_data_size                     = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		result = 0;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( result == 1 )
+	 && ( internal_handle->read_ahead != NULL ) )
+	{
+		if( libewf_read_ahead_notify_read(
+		     internal_handle->read_ahead,
+		     (uint64_t) offset / internal_handle->media_values->chunk_size,
+		     (uint64_t) offset / internal_handle->media_values->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to notify read-ahead of read.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( result == 1 )
+	{
+		if( libewf_chunk_table_grab_chunk_view_by_offset(
+		     internal_handle->chunk_table,
+		     internal_handle->io_handle,
+		     internal_handle->file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     offset,
+		     &safe_data,
+		     &safe_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk view for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		if( safe_data != NULL )
+		{
+			libewf_chunk_table_release_chunk_view(
+			 internal_handle->chunk_table,
+			 safe_data,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		/* The chunk data can contain padding beyond the end of the media data
+		 */
+		if( (size64_t) safe_data_size > ( internal_handle->media_values->media_size - (size64_t) offset ) )
+		{
+			safe_data_size = (size_t) ( internal_handle->media_values->media_size - offset );
+		}
+		*data      = safe_data;
+		*data_size = safe_data_size;
+	}
+	return( result );
+}
+
+/* Releases a view retrieved with libewf_handle_get_chunk_view
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_release_chunk_view(
+     libewf_handle_t *handle,
+     const uint8_t *data,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_release_chunk_view";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_chunk_table_release_chunk_view(
+	     internal_handle->chunk_table,
+	     data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk view.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Packs chunk data for writing
+ * Callback function for the write queue
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_pack_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_pack_chunk_data";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_pack(
+	     chunk_data,
+	     internal_handle->io_handle,
+	     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+	     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+	     internal_handle->write_io_handle->pack_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Initializes the write queue
+ * The write queue is only used when writing a new image or resuming, with a non-zero number of write threads
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_initialize_write_queue(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_initialize_write_queue";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->write_queue != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->number_of_write_threads <= 0 ) )
+	{
+		return( 1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 1 );
+	}
+	if( libewf_write_queue_initialize(
+	     &( internal_handle->write_queue ),
+	     internal_handle->number_of_write_threads,
+	     (int (*)(void *, libewf_chunk_data_t *, libcerror_error_t **)) &libewf_internal_handle_pack_chunk_data,
+	     (void *) internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create write queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the packed chunks in the write queue using a Basic File IO (bfio) pool
+ * If write all is set the function waits for all queued chunks to be packed and writes them,
+ * otherwise only the chunks at the front of the queue that have been packed are written
+ * and the function only waits for the first chunk when the queue is full
+ * The chunks are packed by the write threads but written synchronously on the calling thread,
+ * asynchronous IO is not used since the chunks and the section descriptors that follow them
+ * are written as sequential appends that depend on the current segment file offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_queued_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t write_all,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_write_queued_chunks_to_file_io_pool";
+	size_t input_data_size          = 0;
+	ssize_t total_write_count       = 0;
+	ssize_t write_count             = 0;
+	uint64_t chunk_index            = 0;
+	uint8_t wait_for_packed         = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_queue == NULL )
+	{
+		return( 0 );
+	}
+	do
+	{
+		wait_for_packed = write_all;
+
+		if( wait_for_packed == 0 )
+		{
+			result = libewf_write_queue_is_full(
+			          internal_handle->write_queue,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if write queue is full.",
+				 function );
+
+				return( -1 );
+			}
+			wait_for_packed = (uint8_t) result;
+		}
+		result = libewf_write_queue_pop(
+		          internal_handle->write_queue,
+		          wait_for_packed,
+		          &chunk_index,
+		          &chunk_data,
+		          &input_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop chunk data from write queue.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			write_count = libewf_write_io_handle_write_new_chunk(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+			               file_io_pool,
+			               internal_handle->media_values,
+			               internal_handle->segment_table,
+			               internal_handle->header_values,
+			               internal_handle->hash_values,
+			               internal_handle->hash_sections,
+			               internal_handle->sessions,
+			               internal_handle->tracks,
+			               internal_handle->acquiry_errors,
+			               chunk_index,
+			               chunk_data,
+			               input_data_size,
+			               error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write new chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				libewf_chunk_data_free(
+				 &chunk_data,
+				 NULL );
+
+				return( -1 );
+			}
+			total_write_count += write_count;
+
+			if( libewf_chunk_data_free(
+			     &chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	while( result != 0 );
+
+	return( total_write_count );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
+	size_t buffer_offset      = 0;
+	size_t input_data_size    = 0;
+	size_t write_size         = 0;
+	ssize_t write_count       = 0;
+	off64_t chunk_data_offset = 0;
+	uint64_t chunk_index      = 0;
+	uint64_t next_chunk_index = 0;
+	int write_chunk           = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int number_of_queued_chunks = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->write_queue == NULL )
+	{
+		if( libewf_internal_handle_initialize_write_queue(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	while( buffer_size > 0 )
+	{
+		/* Chunks in the write queue have not yet been written but do exist
+		 */
+		next_chunk_index = internal_handle->write_io_handle->number_of_chunks_written;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->write_queue != NULL )
+		{
+			if( libewf_write_queue_get_number_of_entries(
+			     internal_handle->write_queue,
+			     &number_of_queued_chunks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of queued chunks.",
+				 function );
+
+				return( -1 );
+			}
+			next_chunk_index += (uint64_t) number_of_queued_chunks;
+		}
+#endif
+		if( chunk_index < next_chunk_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( internal_handle->write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			if( libewf_chunk_data_initialize_from_pool(
+			     &( internal_handle->chunk_data ),
+			     internal_handle->io_handle->chunk_data_pool,
+			     internal_handle->media_values->chunk_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk offset exceeds chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+		{
+			write_chunk = 1;
+		}
+		else if( ( internal_handle->media_values->media_size != 0 )
+		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		{
+			write_chunk = 1;
+		}
+		else
+		{
+			write_chunk = 0;
+		}
+		if( write_chunk != 0 )
+		{
+			input_data_size = internal_handle->chunk_data->data_size;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( write_chunk != 0 )
+		 && ( internal_handle->write_queue != NULL ) )
+		{
+			/* Make room in the write queue by writing the chunks that have been packed
+			 */
+			if( libewf_internal_handle_write_queued_chunks_to_file_io_pool(
+			     internal_handle,
+			     file_io_pool,
+			     0,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write queued chunks.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_write_queue_push(
+			     internal_handle->write_queue,
+			     chunk_index,
+			     internal_handle->chunk_data,
+			     input_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk: %" PRIu64 " data onto write queue.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			internal_handle->chunk_data = NULL;
+
+			write_chunk = 0;
+		}
+#endif
+		if( write_chunk != 0 )
+		{
+			if( libewf_chunk_data_pack(
+			     internal_handle->chunk_data,
+			     internal_handle->io_handle,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     internal_handle->write_io_handle->pack_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to pack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			write_count = libewf_write_io_handle_write_new_chunk(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+			               file_io_pool,
+			               internal_handle->media_values,
+			               internal_handle->segment_table,
+			               internal_handle->header_values,
+			               internal_handle->hash_values,
+			               internal_handle->hash_sections,
+			               internal_handle->sessions,
+			               internal_handle->tracks,
+			               internal_handle->acquiry_errors,
+			               chunk_index,
+			               internal_handle->chunk_data,
+			               input_data_size,
+			               error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write new chunk.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_chunk_data_free(
+			     &( internal_handle->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	internal_handle->io_handle->abort = 0;
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		if( libewf_internal_handle_seek_offset(
+		     internal_handle,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Retrieves a (media) data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_data_chunk(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_chunk";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: data chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		if( libewf_data_chunk_initialize(
+		     data_chunk,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data chunk.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	size_t read_count               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
+	     internal_handle->chunk_table,
+	     internal_handle->io_handle,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->current_offset,
+	     &chunk_data_offset,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		goto on_error;
+	}
+	/* data_chunk takes over management of chunk_data
+	 */
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 chunk_data->chunk_index );
+
+		goto on_error;
+	}
+	internal_handle->current_offset = chunk_data->range_end_offset;
+
+	read_count = (ssize_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
+
+	return( read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunk";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	size_t data_size             = 0;
+	ssize_t write_count          = 0;
+	uint64_t current_chunk_index = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	data_size = internal_data_chunk->data_size;
+
+	if( internal_handle->media_values->media_size != 0 )
+	{
+		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: last data chunk size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+/* TODO remove need to calculate */
+	current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) current_chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
+		 function,
+		 current_chunk_index,
+		 data_size );
+	}
+#endif
+	if( current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 current_chunk_index );
+
+		return( -1 );
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               current_chunk_index,
+	               internal_data_chunk->chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) data_size;
+
+	return( write_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_data_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               (libewf_internal_data_chunk_t *) data_chunk,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data chunk.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	size_t input_data_size              = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	int file_io_pool_entry              = -1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	write_count = libewf_internal_handle_write_queued_chunks_to_file_io_pool(
+	               internal_handle,
+	               file_io_pool,
+	               1,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write queued chunks.",
+		 function );
 
-				goto on_error;
-			}
-			if( libewf_segment_table_append_segment_by_segment_file(
-			     segment_table,
-			     segment_file,
-			     file_io_pool_entry,
-			     segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append segment: %" PRIu32 " to segment table.",
-				 function,
-				 segment_file->segment_number );
+		return( -1 );
+	}
+	write_finalize_count += write_count;
+#endif
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
 
-				goto on_error;
-			}
+		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
 		}
-		if( libewf_segment_file_free(
-		     &segment_file,
+		input_data_size = internal_handle->chunk_data->data_size;
+
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_table,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       chunk_index,
+			       internal_handle->chunk_data,
+			       input_data_size,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment file.",
+			 "%s: unable to free chunk data.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libewf_internal_handle_open_read_segment_files(
-		     internal_handle,
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->io_handle,
 		     file_io_pool,
-		     segment_table,
+		     internal_handle->segment_table,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->media_values->set_identifier,
+		     &file_io_pool_entry,
+		     &segment_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read segment files.",
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
 			 function );
 
-			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	else if( internal_handle->write_io_handle->current_segment_file != NULL )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     internal_handle->write_io_handle->current_segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
+
+			return( -1 );
+		}
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+			               internal_handle->write_io_handle->current_segment_file,
+			               error );
+
+			if( write_count == -1 )
 			{
-				goto on_error;
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunks section end: %" PRIu32 ".",
+				 function,
+				 internal_handle->write_io_handle->current_segment_number );
+
+				return( -1 );
 			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
 #if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				if( ( error != NULL )
-				 && ( *error != NULL ) )
-				{
-					libcnotify_print_error_backtrace(
-					 *error );
-				}
-			}
-#endif
-			libcerror_error_free(
-			 error );
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file: %" PRIu32 ".\n",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
 		}
-		if( internal_handle->media_values == NULL )
+#endif
+		write_count = libewf_segment_file_write_close(
+		               internal_handle->write_io_handle->current_segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing media values.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-/* TODO refactor */
-		if( internal_handle->single_files == NULL )
-		{
-			if( libewf_internal_handle_get_media_values(
-			     internal_handle,
-			     &( internal_handle->media_values->media_size ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine media values.",
-				 function );
+		write_finalize_count += write_count;
 
-				goto on_error;
-			}
-		}
+		internal_handle->write_io_handle->current_segment_file = NULL;
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
 	{
-		if( internal_handle->write_io_handle->values_initialized == 0 )
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
 		{
-			if( libewf_write_io_handle_initialize_values(
-			     internal_handle->write_io_handle,
-			     internal_handle->io_handle,
-			     internal_handle->media_values,
-			     segment_table,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to initialize write IO handle values.",
-				 function );
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
 
-				goto on_error;
-			}
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
 		}
-		if( libewf_write_io_handle_initialize_resume(
+		if( internal_handle->write_io_handle->device_information != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
+		}
+		if( internal_handle->write_io_handle->data_section != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
+		}
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
 		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
 		     file_io_pool,
 		     internal_handle->media_values,
-		     segment_table,
-		     internal_handle->read_io_handle,
-		     &( internal_handle->current_offset ),
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle to resume.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-	internal_handle->io_handle->chunk_size   = internal_handle->media_values->chunk_size;
-	internal_handle->io_handle->access_flags = access_flags;
-
-	return( 1 );
+	internal_handle->write_io_handle->write_finalized = 1;
 
-on_error:
-	if( segment_file != NULL )
-	{
-		libewf_segment_file_free(
-		 &segment_file,
-		 NULL );
-	}
-	if( internal_handle->single_files != NULL )
-	{
-		libewf_single_files_free(
-		 &( internal_handle->single_files ),
-		 NULL );
-	}
-	if( internal_handle->hash_sections != NULL )
-	{
-		libewf_hash_sections_free(
-		 &( internal_handle->hash_sections ),
-		 NULL );
-	}
-	if( internal_handle->header_values != NULL )
-	{
-		libfvalue_table_free(
-		 &( internal_handle->header_values ),
-		 NULL );
-	}
-	if( internal_handle->chunk_table != NULL )
-	{
-		libewf_chunk_table_free(
-		 &( internal_handle->chunk_table ),
-		 NULL );
-	}
-	if( internal_handle->write_io_handle != NULL )
-	{
-		libewf_write_io_handle_free(
-		 &( internal_handle->write_io_handle ),
-		 error );
-	}
-	if( internal_handle->read_io_handle != NULL )
-	{
-		libewf_read_io_handle_free(
-		 &( internal_handle->read_io_handle ),
-		 error );
-	}
-	return( -1 );
+	return( write_finalize_count );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * Returns 1 if successful or -1 on error
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
  */
-int libewf_handle_open_file_io_pool(
-     libewf_handle_t *handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
-     libcerror_error_t **error )
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_open_file_io_pool";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
 
 	if( handle == NULL )
 	{
@@ -3884,30 +9260,17 @@ int libewf_handle_open_file_io_pool(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool != NULL )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
-		 function );
-
-		return( -1 );
-	}
-#if !defined( HAVE_WRITE_SUPPORT )
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported - compiled without zlib.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -3923,80 +9286,24 @@ int libewf_handle_open_file_io_pool(
 		return( -1 );
 	}
 #endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          internal_handle->segment_table,
-	          error );
+	write_count = libewf_internal_handle_write_finalize_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               error );
 
-	if( result != 1 )
+	if( write_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
-		 function );
-	}
-	else
-	{
-		internal_handle->file_io_pool = file_io_pool;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		result = -1;
-	}
-#endif
-	if( result != 1 )
-	{
-		goto on_error;
-	}
-	return( 1 );
-
-on_error:
-	internal_handle->file_io_pool = NULL;
-
-	return( -1 );
-}
-
-/* Closes the EWF handle
- * Returns 0 if successful or -1 on error
- */
-int libewf_handle_close(
-     libewf_handle_t *handle,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_close";
-	ssize_t write_count                       = 0;
-	int result                                = 0;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write finalize.",
 		 function );
 
-		return( -1 );
+		write_count = -1;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4004,287 +9311,182 @@ int libewf_handle_close(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
-	{
-		write_count = libewf_internal_handle_write_finalize_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               error );
+	return( write_count );
+}
 
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to finalize write.",
-			 function );
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_seek_offset";
 
-			result = -1;
-		}
-	}
-	if( internal_handle->file_io_pool_created_in_library != 0 )
+	if( internal_handle == NULL )
 	{
-		if( libbfio_pool_close_all(
-		     internal_handle->file_io_pool,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all file IO pool handles.",
-			 function );
-
-			result = -1;
-		}
-		if( libbfio_pool_free(
-		     &( internal_handle->file_io_pool ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO pool.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			result = -1;
-		}
-		internal_handle->file_io_pool_created_in_library = 0;
+		return( -1 );
 	}
-	internal_handle->file_io_pool = NULL;
-
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
-	     error ) != 1 )
+	if( internal_handle->chunk_data != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libewf_media_values_clear(
-	     internal_handle->media_values,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear media values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
-		result = -1;
-	}
-	if( internal_handle->read_io_handle != NULL )
-	{
-		if( libewf_read_io_handle_free(
-		     &( internal_handle->read_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free read IO handle.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( internal_handle->write_io_handle != NULL )
-	{
-		if( libewf_write_io_handle_free(
-		     &( internal_handle->write_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free write IO handle.",
-			 function );
-
-			result = -1;
-		}
-	}
-	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
-	 */
-	if( internal_handle->chunk_data != NULL )
-	{
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
-			 function );
-
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->chunk_table != NULL )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
-		if( libewf_chunk_table_free(
-		     &( internal_handle->chunk_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk table.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
 	{
-		if( libewf_hash_sections_free(
-		     &( internal_handle->hash_sections ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash sections.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->header_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->header_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free header values.",
-			 function );
-
-			result = -1;
-		}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
 	}
-	if( internal_handle->hash_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash values.",
-			 function );
-
-			result = -1;
-		}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
 	}
-	if( internal_handle->single_files != NULL )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		if( libewf_single_files_free(
-		     &( internal_handle->single_files ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free single files.",
-			 function );
-
-			result = -1;
-		}
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+#endif
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libewf_segment_table_clear(
-	     internal_handle->segment_table,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear segment table.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
-	     error ) != 1 )
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
 		 function );
-
-		result = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -4298,30 +9500,24 @@ int libewf_handle_close(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
 #endif
-	return( result );
+	return( offset );
 }
 
-/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	size_t buffer_offset            = 0;
-	size_t read_size                = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4332,35 +9528,92 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#endif
+	return( 1 );
+}
+
+/* Retrieves the next region of (media) data at or after a specific offset
+ * The region consists of chunks that are not empty, where empty chunks are
+ * determined from the chunk metadata, see libewf_chunk_table_chunk_is_empty
+ * This function is multi-thread safe if the read lock is acquired before call
+ * Returns 1 if successful, 0 if no more data is available or -1 on error
+ */
+int libewf_internal_handle_get_next_data_region(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     off64_t *data_offset,
+     size64_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_get_next_data_region";
+	off64_t end_offset        = 0;
+	off64_t safe_data_offset  = 0;
+	uint64_t chunk_index      = 0;
+	uint64_t number_of_chunks = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
 		 function );
 
 		return( -1 );
@@ -4387,145 +9640,152 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
 	{
 		return( 0 );
 	}
-	internal_handle->io_handle->abort = 0;
+	number_of_chunks = internal_handle->media_values->media_size / internal_handle->media_values->chunk_size;
 
-	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	if( ( internal_handle->media_values->media_size % internal_handle->media_values->chunk_size ) != 0 )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+		number_of_chunks += 1;
 	}
-	while( buffer_size > 0 )
-	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->current_offset,
-		     &chunk_data_offset,
-		     &chunk_data,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
+	chunk_index = (uint64_t) offset / internal_handle->media_values->chunk_size;
 
-			return( -1 );
-		}
-		if( chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
+	/* Skip the empty chunks
+	 */
+	while( chunk_index < number_of_chunks )
+	{
+		result = libewf_chunk_table_chunk_is_empty(
+		          internal_handle->chunk_table,
+		          internal_handle->io_handle,
+		          internal_handle->file_io_pool,
+		          internal_handle->media_values,
+		          internal_handle->segment_table,
+		          chunk_index,
+		          error );
 
-			return( -1 );
-		}
-		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if chunk: %" PRIu64 " is empty.",
 			 function,
-			 chunk_data->chunk_index );
+			 chunk_index );
 
 			return( -1 );
 		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
-
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
+		else if( result == 0 )
 		{
 			break;
 		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
+		chunk_index++;
+	}
+	if( chunk_index >= number_of_chunks )
+	{
+		return( 0 );
+	}
+	safe_data_offset = (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+
+	if( safe_data_offset < offset )
+	{
+		safe_data_offset = offset;
+	}
+	/* Determine the end of the region of chunks that contain data
+	 */
+	for( chunk_index += 1;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		result = libewf_chunk_table_chunk_is_empty(
+		          internal_handle->chunk_table,
+		          internal_handle->io_handle,
+		          internal_handle->file_io_pool,
+		          internal_handle->media_values,
+		          internal_handle->segment_table,
+		          chunk_index,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if chunk: %" PRIu64 " is empty.",
 			 function,
-			 chunk_data->chunk_index );
+			 chunk_index );
 
 			return( -1 );
 		}
-		buffer_offset += read_size;
-		buffer_size   -= read_size;
-
-		internal_handle->current_offset += (off64_t) read_size;
-
-		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
+		else if( result != 0 )
 		{
 			break;
 		}
-		chunk_data        = NULL;
-		chunk_data_offset = 0;
 	}
-	internal_handle->io_handle->abort = 0;
+	end_offset = (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
 
-	return( (ssize_t) buffer_offset );
+	if( (size64_t) end_offset > internal_handle->media_values->media_size )
+	{
+		end_offset = (off64_t) internal_handle->media_values->media_size;
+	}
+	*data_offset = safe_data_offset;
+	*data_size   = (size64_t) ( end_offset - safe_data_offset );
+
+	return( 1 );
 }
 
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Retrieves the next region of (media) data at or after a specific offset
+ * Chunks that only contain zero bytes and are stored with pattern fill or empty-block
+ * compression are not part of a data region, which allows to skip them similar to
+ * SEEK_DATA and SEEK_HOLE without reading and decompressing their data
+ * Returns 1 if successful, 0 if no more data is available or -1 on error
  */
-ssize_t libewf_handle_read_buffer(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_get_next_data_region(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *data_offset,
+     size64_t *data_size,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libewf_handle_get_next_data_region";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -4540,19 +9800,8 @@ ssize_t libewf_handle_read_buffer(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4560,32 +9809,30 @@ ssize_t libewf_handle_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
+	result = libewf_internal_handle_get_next_data_region(
+	          internal_handle,
+	          offset,
+	          data_offset,
+	          data_size,
+	          error );
 
-	if( read_count == -1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next data region.",
 		 function );
-
-		read_count = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4593,30 +9840,38 @@ ssize_t libewf_handle_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Retrieves the information of a specific chunk
+ * The information is determined from the chunk table entries without reading the chunk data
+ * This function is multi-thread safe if the read lock is acquired before call
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libewf_internal_handle_get_chunk_information(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     size32_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
+	static char *function            = "libewf_internal_handle_get_chunk_information";
+	off64_t range_start_offset       = 0;
+	off64_t segment_file_data_offset = 0;
+	size64_t range_size              = 0;
+	size64_t segment_file_data_size  = 0;
+	uint64_t number_of_chunks        = 0;
+	uint32_t range_flags             = 0;
+	uint32_t safe_chunk_flags        = 0;
+	int file_io_pool_entry           = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4627,111 +9882,161 @@ ssize_t libewf_handle_read_buffer_at_offset(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
 
-	if( internal_handle->file_io_pool == NULL )
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( chunk_data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
 		 function );
 
-		read_count = -1;
+		return( -1 );
 	}
-	if( read_count != -1 )
+	if( chunk_flags == NULL )
 	{
-		read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		              internal_handle,
-		              internal_handle->file_io_pool,
-		              buffer,
-		              buffer_size,
-		              error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk flags.",
+		 function );
 
-		if( read_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer.",
-			 function );
+		return( -1 );
+	}
+	number_of_chunks = internal_handle->media_values->media_size / internal_handle->media_values->chunk_size;
 
-			read_count = -1;
-		}
+	if( ( internal_handle->media_values->media_size % internal_handle->media_values->chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( chunk_index >= number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_location_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     (off64_t) ( chunk_index * internal_handle->media_values->chunk_size ),
+	     &file_io_pool_entry,
+	     &segment_file_data_offset,
+	     &segment_file_data_size,
+	     &range_flags,
+	     &range_start_offset,
+	     &range_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve location of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
+	if( segment_file_data_size > (size64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk: %" PRIu64 " data size value out of bounds.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		safe_chunk_flags |= LIBEWF_CHUNK_FLAG_IS_COMPRESSED;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		safe_chunk_flags |= LIBEWF_CHUNK_FLAG_HAS_CHECKSUM;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		safe_chunk_flags |= LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		safe_chunk_flags |= LIBEWF_CHUNK_FLAG_IS_CORRUPTED;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_TAINTED ) != 0 )
+	{
+		safe_chunk_flags |= LIBEWF_CHUNK_FLAG_IS_TAINTED;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		safe_chunk_flags |= LIBEWF_CHUNK_FLAG_IS_MISSING;
+	}
+	*chunk_data_size = (size32_t) segment_file_data_size;
+	*chunk_flags     = safe_chunk_flags;
+
+	return( 1 );
 }
 
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Retrieves the information of a specific chunk
+ * The information is determined from the chunk table entries without reading
+ * and unpacking the chunk data
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_get_chunk_information(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     size32_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error )
 {
-	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
-	size_t buffer_offset      = 0;
-	size_t input_data_size    = 0;
-	size_t write_size         = 0;
-	ssize_t write_count       = 0;
-	off64_t chunk_data_offset = 0;
-	uint64_t chunk_index      = 0;
-	int write_chunk           = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_information";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4742,348 +10047,322 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#endif
+	if( libewf_internal_handle_get_chunk_information(
+	     internal_handle,
+	     chunk_index,
+	     chunk_data_size,
+	     chunk_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve information of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
 
-		return( -1 );
+		result = -1;
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#endif
+	return( result );
+}
+
+/* Retrieves the information of multiple consecutive chunks
+ * The chunk data sizes and chunk flags arrays must be able to hold maximum number of entries
+ * The number of entries is set to the number of chunks for which information was retrieved
+ * The read lock is acquired once for all the chunks, which allows to iterate over all
+ * the chunks of a large image at the speed of the chunk table entries
+ * Returns 1 if successful, 0 if the first chunk index is beyond the last chunk or -1 on error
+ */
+int libewf_handle_get_chunk_information_entries(
+     libewf_handle_t *handle,
+     uint64_t first_chunk_index,
+     size32_t *chunk_data_sizes,
+     uint32_t *chunk_flags,
+     size_t maximum_number_of_entries,
+     size_t *number_of_entries,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_information_entries";
+	size_t entry_index                        = 0;
+	uint64_t number_of_chunks                 = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( chunk_data_sizes == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data sizes.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( chunk_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid chunk flags.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( maximum_number_of_entries > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 "%s: invalid maximum number of entries value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( number_of_entries == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	internal_handle->io_handle->abort = 0;
-
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
-	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-	if( chunk_index >= (uint64_t) INT_MAX )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
-
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+#endif
+	if( internal_handle->media_values->chunk_size != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
-		 function );
+		number_of_chunks = internal_handle->media_values->media_size / internal_handle->media_values->chunk_size;
 
-		return( -1 );
-	}
-	while( buffer_size > 0 )
-	{
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( ( internal_handle->media_values->media_size % internal_handle->media_values->chunk_size ) != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
+			number_of_chunks += 1;
 		}
-		if( internal_handle->write_io_handle->write_finalized != 0 )
+	}
+	if( first_chunk_index >= number_of_chunks )
+	{
+		result = 0;
+	}
+	else
+	{
+		if( (uint64_t) maximum_number_of_entries > ( number_of_chunks - first_chunk_index ) )
 		{
-			break;
+			maximum_number_of_entries = (size_t) ( number_of_chunks - first_chunk_index );
 		}
-		if( internal_handle->chunk_data == NULL )
+		for( entry_index = 0;
+		     entry_index < maximum_number_of_entries;
+		     entry_index++ )
 		{
-			if( libewf_chunk_data_initialize(
-			     &( internal_handle->chunk_data ),
-			     internal_handle->media_values->chunk_size,
-			     0,
+			if( libewf_internal_handle_get_chunk_information(
+			     internal_handle,
+			     first_chunk_index + entry_index,
+			     &( chunk_data_sizes[ entry_index ] ),
+			     &( chunk_flags[ entry_index ] ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve information of chunk: %" PRIu64 ".",
 				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( chunk_data_offset > internal_handle->media_values->chunk_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
-			 function );
-
-			return( -1 );
-		}
-		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
-
-		if( write_size > buffer_size )
-		{
-			write_size = buffer_size;
-		}
-		if( write_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     write_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to chunk data.",
-			 function );
-
-			return( -1 );
-		}
-		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+				 first_chunk_index + entry_index );
 
-		buffer_offset += write_size;
-		buffer_size   -= write_size;
+				result = -1;
 
-		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-		{
-			write_chunk = 1;
-		}
-		else if( ( internal_handle->media_values->media_size != 0 )
-		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-		{
-			write_chunk = 1;
-		}
-		else
-		{
-			write_chunk = 0;
+				break;
+			}
 		}
-		if( write_chunk != 0 )
-		{
-			input_data_size = internal_handle->chunk_data->data_size;
-
-			if( libewf_chunk_data_pack(
-			     internal_handle->chunk_data,
-			     internal_handle->io_handle,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     internal_handle->write_io_handle->pack_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-				return( -1 );
-			}
-			write_count = libewf_write_io_handle_write_new_chunk(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-			               file_io_pool,
-			               internal_handle->media_values,
-			               internal_handle->segment_table,
-			               internal_handle->header_values,
-			               internal_handle->hash_values,
-			               internal_handle->hash_sections,
-			               internal_handle->sessions,
-			               internal_handle->tracks,
-			               internal_handle->acquiry_errors,
-			               chunk_index,
-			               internal_handle->chunk_data,
-			               input_data_size,
-			               error );
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*number_of_entries = entry_index;
+	}
+	else if( result == 0 )
+	{
+		*number_of_entries = 0;
+	}
+	return( result );
+}
 
-			if( write_count <= 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new chunk.",
-				 function );
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int result                                = 1;
 
-				return( -1 );
-			}
-			if( libewf_chunk_data_free(
-			     &( internal_handle->chunk_data ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free chunk data.",
-				 function );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-				return( -1 );
-			}
-		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		internal_handle->current_offset += (off64_t) write_size;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		result = libbfio_pool_set_maximum_number_of_open_handles(
+		          internal_handle->file_io_pool,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool.",
+			 function );
 		}
 	}
-	internal_handle->io_handle->abort = 0;
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-	return( (ssize_t) buffer_offset );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Retrieves the maximum size of the (unpacked) chunk data cache
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_buffer(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_get_maximum_cache_size(
+     libewf_handle_t *handle,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_get_maximum_cache_size";
 
 	if( handle == NULL )
 	{
@@ -5098,17 +10377,78 @@ ssize_t libewf_handle_write_buffer(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( maximum_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_cache_size = internal_handle->maximum_cache_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the (unpacked) chunk data cache
+ * A size of 0 restricts the cache to the most recently read chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_cache_size(
+     libewf_handle_t *handle,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_cache_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -5124,47 +10464,45 @@ ssize_t libewf_handle_write_buffer(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	if( internal_handle->chunk_table != NULL )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
+		result = libewf_chunk_cache_set_maximum_cache_size(
+		          internal_handle->chunk_table->chunk_cache,
+		          maximum_cache_size,
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum cache size in chunk cache.",
 			 function );
-
-			write_count = -1;
 		}
 	}
-	if( write_count != -1 )
+	if( result == 1 )
 	{
-		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               buffer,
-		               buffer_size,
-		               error );
+		internal_handle->maximum_cache_size = maximum_cache_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( result == 1 )
+	 && ( internal_handle->chunk_table != NULL ) )
+	{
+		result = libewf_internal_handle_initialize_read_ahead(
+		          internal_handle,
+		          error );
 
-		if( write_count == -1 )
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read-ahead.",
 			 function );
-
-			write_count = -1;
 		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -5179,24 +10517,21 @@ ssize_t libewf_handle_write_buffer(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Retrieves the number of hits and misses of the (unpacked) chunk data cache
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_buffer_at_offset(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libewf_handle_get_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer_at_offset";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_get_cache_statistics";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -5211,19 +10546,30 @@ ssize_t libewf_handle_write_buffer_at_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( number_of_hits == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5231,72 +10577,37 @@ ssize_t libewf_handle_write_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
-
-			write_count = -1;
-		}
-	}
-	if( write_count != -1 )
+	if( internal_handle->chunk_table == NULL )
 	{
-		if( libewf_internal_handle_seek_offset(
-		     internal_handle,
-		     offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset.",
-			 function );
-
-			write_count = -1;
-		}
+		*number_of_hits   = 0;
+		*number_of_misses = 0;
 	}
-	if( write_count != -1 )
+	else
 	{
-		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               buffer,
-		               buffer_size,
-		               error );
+		result = libewf_chunk_cache_get_statistics(
+		          internal_handle->chunk_table->chunk_cache,
+		          number_of_hits,
+		          number_of_misses,
+		          error );
 
-		if( write_count == -1 )
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk cache statistics.",
 			 function );
-
-			write_count = -1;
 		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5304,25 +10615,26 @@ ssize_t libewf_handle_write_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Retrieves a (media) data chunk
+/* Retrieves the number of allocations and reuses of the chunk data pool
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_data_chunk(
+int libewf_handle_get_chunk_data_pool_statistics(
      libewf_handle_t *handle,
-     libewf_data_chunk_t **data_chunk,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_data_chunk";
+	static char *function                     = "libewf_handle_get_chunk_data_pool_statistics";
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -5338,41 +10650,41 @@ int libewf_handle_get_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_chunk == NULL )
+	if( number_of_allocations == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 "%s: invalid number of allocations.",
 		 function );
 
 		return( -1 );
 	}
-	if( *data_chunk != NULL )
+	if( number_of_reuses == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: data chunk value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reuses.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5380,52 +10692,29 @@ int libewf_handle_get_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
+	result = libewf_chunk_data_pool_get_statistics(
+	          internal_handle->io_handle->chunk_data_pool,
+	          number_of_allocations,
+	          number_of_reuses,
+	          error );
 
-			result = -1;
-		}
-	}
-	if( result != -1 )
+	if( result != 1 )
 	{
-		if( libewf_data_chunk_initialize(
-		     data_chunk,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create data chunk.",
-			 function );
-
-			result = -1;
-		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data pool statistics.",
+		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5433,7 +10722,7 @@ int libewf_handle_get_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -5442,22 +10731,19 @@ int libewf_handle_get_data_chunk(
 	return( result );
 }
 
-/* Reads a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+/* Retrieves the read-ahead values
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_get_read_ahead_values(
+     libewf_handle_t *handle,
+     int *number_of_chunks,
+     int *number_of_threads,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	size_t read_count               = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_read_ahead_values";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5468,134 +10754,207 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_chunks == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( number_of_threads == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#endif
+	*number_of_chunks  = internal_handle->number_of_read_ahead_chunks;
+	*number_of_threads = internal_handle->number_of_read_ahead_threads;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+#endif
+	return( 1 );
+}
+
+/* Sets the read-ahead values
+ * When sequential reads are detected the number of chunks that follow the last read chunk
+ * are read and unpacked into the chunk data cache by the number of threads
+ * The number of chunks is limited to half the chunk data cache
+ * A number of chunks or threads of 0 disables the read-ahead, which is the default
+ * The read-ahead requires multi-thread support and is only used when reading
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_ahead_values(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_ahead_values";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
-	     internal_handle->chunk_table,
-	     internal_handle->io_handle,
-	     file_io_pool,
-	     internal_handle->media_values,
-	     internal_handle->segment_table,
-	     internal_handle->current_offset,
-	     &chunk_data_offset,
-	     &chunk_data,
-	     error ) != 1 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_chunks < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of chunks value less than zero.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( chunk_data == NULL )
+	if( number_of_threads < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	/* data_chunk takes over management of chunk_data
-	 */
-	if( libewf_internal_data_chunk_set_chunk_data(
-	     internal_data_chunk,
-	     chunk_data,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
-		 function,
-		 chunk_data->chunk_index );
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_handle->current_offset = chunk_data->range_end_offset;
+#endif
+	internal_handle->number_of_read_ahead_chunks  = number_of_chunks;
+	internal_handle->number_of_read_ahead_threads = number_of_threads;
 
-	read_count = (ssize_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->chunk_table != NULL )
+	{
+		/* The segment files are only opened for asynchronous IO when the read-ahead is enabled
+		 */
+		if( ( internal_handle->async_io == NULL )
+		 && ( internal_handle->async_io_queue_depth > 0 )
+		 && ( number_of_chunks > 0 )
+		 && ( number_of_threads > 0 )
+		 && ( internal_handle->write_io_handle == NULL ) )
+		{
+			result = libewf_internal_handle_open_async_io(
+			          internal_handle,
+			          internal_handle->file_io_pool,
+			          error );
 
-	return( read_count );
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to open segment files for asynchronous IO.",
+				 function );
+			}
+		}
+		else
+		{
+			result = libewf_internal_handle_initialize_read_ahead(
+			          internal_handle,
+			          error );
 
-on_error:
-	if( chunk_data != NULL )
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize read-ahead.",
+				 function );
+			}
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libewf_chunk_data_free(
-		 &chunk_data,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+#endif
+	return( result );
 }
 
-/* Reads a (media) data chunk at the current offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+/* Retrieves the number of write threads
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_get_number_of_write_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_data_chunk";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libewf_handle_get_number_of_write_threads";
 
 	if( handle == NULL )
 	{
@@ -5610,19 +10969,19 @@ ssize_t libewf_handle_read_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( number_of_threads == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5630,31 +10989,16 @@ ssize_t libewf_handle_read_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              (libewf_internal_data_chunk_t *) data_chunk,
-	              error );
-
-	if( read_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data chunk.",
-		 function );
+	*number_of_threads = internal_handle->number_of_write_threads;
 
-		read_count = -1;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5662,31 +11006,32 @@ ssize_t libewf_handle_read_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 }
 
-/* Writes a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Sets the number of write threads
+ * When set the chunks written by libewf_handle_write_buffer are packed by the number of threads,
+ * at most 2 chunks per thread are queued, and written in order to the segment files
+ * A packing error can be reported by a subsequent write or the write finalize
+ * A number of threads of 0 packs the chunks in the calling thread, which is the default
+ * The write threads require multi-thread support and must be set before the first write
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_set_number_of_write_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
 {
-	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size             = 0;
-	ssize_t write_count          = 0;
-	uint64_t current_chunk_index = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_write_threads";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5697,175 +11042,84 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		return( -1 );
-	}
-	if( internal_handle->chunk_data != NULL )
+	if( number_of_threads < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: number of write threads cannot be changed.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
+	internal_handle->number_of_write_threads = number_of_threads;
 
-		return( -1 );
-	}
-	if( internal_handle->write_io_handle == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_data_chunk == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	data_size = internal_data_chunk->data_size;
-
-	if( internal_handle->media_values->media_size != 0 )
-	{
-		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: last data chunk size value out of bounds.",
-			 function );
-
-			return( -1 );
-		}
-	}
-/* TODO remove need to calculate */
-	current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) current_chunk_index * (off64_t) internal_handle->media_values->chunk_size;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
-		 function,
-		 current_chunk_index,
-		 data_size );
-	}
 #endif
-	if( current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: chunk: %" PRIu64 " already exists.",
-		 function,
-		 current_chunk_index );
-
-		return( -1 );
-	}
-	write_count = libewf_write_io_handle_write_new_chunk(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               file_io_pool,
-	               internal_handle->media_values,
-	               internal_handle->segment_table,
-	               internal_handle->header_values,
-	               internal_handle->hash_values,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->tracks,
-	               internal_handle->acquiry_errors,
-	               current_chunk_index,
-	               internal_data_chunk->chunk_data,
-	               data_size,
-	               error );
-
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle->current_offset += (off64_t) data_size;
+	return( 1 );
 
-	return( write_count );
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Writes a (media) data chunk at the current offset
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Retrieves the maximum size of the chunk location table
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_get_maximum_chunk_location_table_size(
+     libewf_handle_t *handle,
+     size64_t *maximum_size,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_data_chunk";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_get_maximum_chunk_location_table_size";
 
 	if( handle == NULL )
 	{
@@ -5880,19 +11134,19 @@ ssize_t libewf_handle_write_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( maximum_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum size.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5900,31 +11154,16 @@ ssize_t libewf_handle_write_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
-
-		return( -1 );
-	}
-#endif
-	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               (libewf_internal_data_chunk_t *) data_chunk,
-	               error );
-
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data chunk.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		write_count = -1;
+		return( -1 );
 	}
+#endif
+	*maximum_size = internal_handle->maximum_chunk_location_table_size;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5932,35 +11171,32 @@ ssize_t libewf_handle_write_data_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( 1 );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Sets the maximum size of the chunk location table
+ * The chunk location table keeps the location of the chunks resident, in about 8 bytes per chunk,
+ * so that random reads do not need to look up the chunk groups of the segment files
+ * The locations are set on demand in blocks of 64 chunks, until the maximum size is reached
+ * A maximum size of 0 disables the chunk location table, which is the default
+ * The chunk location table is only used when reading and is created when the handle is opened
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libcerror_error_t **error )
+int libewf_handle_set_maximum_chunk_location_table_size(
+     libewf_handle_t *handle,
+     size64_t maximum_size,
+     libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	int file_io_pool_entry              = -1;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_chunk_location_table_size";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5971,410 +11207,261 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#endif
+	internal_handle->maximum_chunk_location_table_size = maximum_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+#endif
+	return( 1 );
+}
 
-			return( -1 );
-		}
-	}
-	if( internal_handle->write_io_handle == NULL )
+/* Retrieves the value to indicate if the segment files are memory mapped when reading
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_use_memory_mapping(
+     libewf_handle_t *handle,
+     uint8_t *use_memory_mapping,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_use_memory_mapping";
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( use_memory_mapping == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid use memory mapping.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
-	{
-		return( 0 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		return( 0 );
-	}
-	if( internal_handle->chunk_data != NULL )
-	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		input_data_size = internal_handle->chunk_data->data_size;
-
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
-
-		if( write_count <= 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
-			 function );
-
-			return( -1 );
-		}
-		write_finalize_count += write_count;
-
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
-			 function );
+#endif
+	*use_memory_mapping = internal_handle->use_memory_mapping;
 
-			return( -1 );
-		}
-	}
-	/* Check if all media data has been written
-	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
-	{
-		return( write_finalize_count );
-	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		return( -1 );
-	}
-	if( number_of_segments == 0 )
-	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
-		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
-			 function );
-
-			return( -1 );
-		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
-			 function );
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+/* Sets the value to indicate if the segment files should be memory mapped when reading
+ * The chunk data is then decompressed from, or for uncompressed chunks referenced in, the mapping
+ * instead of being read into a buffer first
+ * Only segment files opened by filename are mapped, other segment files are read as before
+ * The segment files should not be modified while they are mapped
+ * The value takes effect when the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_use_memory_mapping(
+     libewf_handle_t *handle,
+     uint8_t use_memory_mapping,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_use_memory_mapping";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	else if( internal_handle->write_io_handle->current_segment_file != NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     internal_handle->write_io_handle->current_segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-			return( -1 );
-		}
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
-		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-			               internal_handle->write_io_handle->current_segment_file,
-			               error );
+		return( -1 );
+	}
+#endif
+	internal_handle->use_memory_mapping = use_memory_mapping;
 
-			if( write_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write chunks section end: %" PRIu32 ".",
-				 function,
-				 internal_handle->write_io_handle->current_segment_number );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-				return( -1 );
-			}
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file: %" PRIu32 ".\n",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
-		}
+		return( -1 );
+	}
 #endif
-		write_count = libewf_segment_file_write_close(
-		               internal_handle->write_io_handle->current_segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
+	return( 1 );
+}
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file: %" PRIu32 ".",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
+/* Retrieves the asynchronous IO queue depth
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_async_io_queue_depth(
+     libewf_handle_t *handle,
+     int *queue_depth,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_async_io_queue_depth";
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-		internal_handle->write_io_handle->current_segment_file = NULL;
+		return( -1 );
 	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
-	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		/* Flush the section write caches
-		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
+	if( queue_depth == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue depth.",
+		 function );
 
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
-		}
-		if( internal_handle->write_io_handle->device_information != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
-		}
-		if( internal_handle->write_io_handle->data_section != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
+		return( -1 );
+	}
+#endif
+	*queue_depth = internal_handle->async_io_queue_depth;
 
-			internal_handle->write_io_handle->data_section = NULL;
-		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
-			 function );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
-
-	return( write_finalize_count );
+#endif
+	return( 1 );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Sets the asynchronous IO queue depth, the maximum number of chunk reads kept in flight
+ * by the read-ahead, 0 represents that asynchronous IO is not used
+ * Asynchronous IO requires liburing (io_uring) support and a read-ahead,
+ * otherwise the chunks are read synchronously
+ * The value takes effect when the handle is opened or the read-ahead is enabled
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         libcerror_error_t **error )
+int libewf_handle_set_async_io_queue_depth(
+     libewf_handle_t *handle,
+     int queue_depth,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_set_async_io_queue_depth";
 
 	if( handle == NULL )
 	{
@@ -6389,13 +11476,14 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( ( queue_depth < 0 )
+	 || ( queue_depth > LIBEWF_ASYNC_IO_MAXIMUM_QUEUE_DEPTH ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -6415,22 +11503,8 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	write_count = libewf_internal_handle_write_finalize_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               error );
-
-	if( write_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write finalize.",
-		 function );
+	internal_handle->async_io_queue_depth = queue_depth;
 
-		write_count = -1;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -6446,22 +11520,25 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( 1 );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Sets the filename of the segment files index
+ * The segment files index stores the sections and chunk groups of the segment files
+ * and is used to speed up subsequent opens of the same set of segment files
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_internal_handle_seek_offset(
-         libewf_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_seek_offset";
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_index_filename";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6472,120 +11549,69 @@ off64_t libewf_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
-		 function );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		return( -1 );
-	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
-	}
-#endif
-	if( offset < 0 )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
-}
-
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
- */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
@@ -6599,24 +11625,32 @@ off64_t libewf_handle_seek_offset(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	offset = libewf_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( internal_handle->index_file_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		if( libbfio_handle_free(
+		     &( internal_handle->index_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file IO handle.",
+			 function );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+#endif
+			goto on_error;
+		}
 	}
+	internal_handle->index_file_io_handle = file_io_handle;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -6632,19 +11666,34 @@ off64_t libewf_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the current offset of the (media) data
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the filename of the segment files index
+ * The segment files index stores the sections and chunk groups of the segment files
+ * and is used to speed up subsequent opens of the same set of segment files
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_set_index_filename_wide(
      libewf_handle_t *handle,
-     off64_t *offset,
+     const wchar_t *filename,
+     size_t filename_length,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle          = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_set_index_filename_wide";
 
 	if( handle == NULL )
 	{
@@ -6659,77 +11708,68 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*offset = internal_handle->current_offset;
-
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	if( libbfio_file_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
-}
-
-/* Sets the maximum number of (concurrent) open file handles
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_set_maximum_number_of_open_handles(
-     libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
-	int result                                = 1;
-
-	if( handle == NULL )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -6742,30 +11782,32 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
-	}
-#endif
-	if( internal_handle->file_io_pool != NULL )
-	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->file_io_pool,
-		          maximum_number_of_open_handles,
-		          error );
-
-		if( result != 1 )
+		goto on_error;
+	}
+#endif
+	if( internal_handle->index_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( internal_handle->index_file_io_handle ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO pool.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file IO handle.",
 			 function );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+#endif
+			goto on_error;
 		}
 	}
-	if( result == 1 )
-	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
-	}
+	internal_handle->index_file_io_handle = file_io_handle;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -6781,9 +11823,20 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 /* Determine if the segment files are corrupted
  * Returns 1 if corrupted, 0 if not or -1 on error
  */
@@ -8168,13 +13221,13 @@ int libewf_internal_handle_get_media_values(
      size64_t *media_size,
      libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_get_media_values";
-	size64_t chunks_data_size       = 0;
-	size64_t sector_data_size       = 0;
-	size32_t chunk_size             = 0;
-	off64_t chunk_data_offset       = 0;
-	uint64_t chunk_index            = 0;
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	static char *function                         = "libewf_internal_handle_get_media_values";
+	size64_t chunks_data_size                     = 0;
+	size64_t sector_data_size                     = 0;
+	size32_t chunk_size                           = 0;
+	off64_t chunk_data_offset                     = 0;
+	uint64_t chunk_index                          = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -8220,7 +13273,9 @@ int libewf_internal_handle_get_media_values(
 		{
 			internal_handle->current_offset = ( (off64_t) internal_handle->media_values->number_of_chunks - 1 ) * chunk_size;
 
-			if( libewf_chunk_table_get_chunk_data_by_offset(
+			/* The only way to determine the size of the last compressed chunk is to unpack it
+			 */
+			if( libewf_chunk_table_grab_chunk_data_by_offset(
 			     internal_handle->chunk_table,
 			     internal_handle->io_handle,
 			     internal_handle->file_io_pool,
@@ -8228,7 +13283,7 @@ int libewf_internal_handle_get_media_values(
 			     internal_handle->segment_table,
 			     internal_handle->current_offset,
 			     &chunk_data_offset,
-			     &chunk_data,
+			     &chunk_cache_entry,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -8242,42 +13297,26 @@ int libewf_internal_handle_get_media_values(
 
 				return( -1 );
 			}
-			if( chunk_data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 internal_handle->current_offset,
-				 internal_handle->current_offset );
+			chunks_data_size = chunk_index * chunk_size;
 
-				return( -1 );
+			if( ( chunk_cache_entry->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 )
+			{
+				chunks_data_size += chunk_cache_entry->chunk_data->data_size;
 			}
-			/* The only way to determine the size of the last compressed chunk is to unpack it
-			 */
-			if( libewf_chunk_data_unpack(
-			     chunk_data,
-			     internal_handle->io_handle,
+			if( libewf_chunk_table_release_chunk_data(
+			     internal_handle->chunk_table,
+			     &chunk_cache_entry,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to unpack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk data.",
+				 function );
 
 				return( -1 );
 			}
-			chunks_data_size = chunk_index * chunk_size;
-
-			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 )
-			{
-				chunks_data_size += chunk_data->data_size;
-			}
 			if( sector_data_size != chunks_data_size )
 			{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -9945,22 +14984,218 @@ int libewf_handle_set_error_granularity(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: error granularity cannot be changed.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->media_values->error_granularity = error_granularity;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the compression method
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_compression_method(
+     libewf_handle_t *handle,
+     uint16_t *compression_method,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_compression_method";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression method.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*compression_method = internal_handle->io_handle->compression_method;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the compression method
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_compression_method(
+     libewf_handle_t *handle,
+     uint16_t compression_method,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_compression_method";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression method.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: compression values cannot be changed.",
+		 function );
+
+		goto on_error;
 	}
-#endif
-	if( ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
+	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: error granularity cannot be changed.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: compression method not supported by format.",
 		 function );
 
 		goto on_error;
 	}
-	internal_handle->media_values->error_granularity = error_granularity;
+	internal_handle->io_handle->compression_method = compression_method;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -9988,16 +15223,17 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the compression method
+/* Retrieves the compression values
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_compression_method(
+int libewf_handle_get_compression_values(
      libewf_handle_t *handle,
-     uint16_t *compression_method,
+     int8_t *compression_level,
+     uint8_t *compression_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_compression_method";
+	static char *function                     = "libewf_handle_get_compression_values";
 
 	if( handle == NULL )
 	{
@@ -10023,13 +15259,24 @@ int libewf_handle_get_compression_method(
 
 		return( -1 );
 	}
-	if( compression_method == NULL )
+	if( compression_level == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compression method.",
+		 "%s: invalid compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression flags.",
 		 function );
 
 		return( -1 );
@@ -10049,7 +15296,8 @@ int libewf_handle_get_compression_method(
 		return( -1 );
 	}
 #endif
-	*compression_method = internal_handle->io_handle->compression_method;
+	*compression_level = internal_handle->io_handle->compression_level;
+	*compression_flags = internal_handle->io_handle->compression_flags;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -10069,16 +15317,18 @@ int libewf_handle_get_compression_method(
 	return( 1 );
 }
 
-/* Sets the compression method
+/* Sets the compression values
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_compression_method(
+int libewf_handle_set_compression_values(
      libewf_handle_t *handle,
-     uint16_t compression_method,
+     int8_t compression_level,
+     uint8_t compression_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_compression_method";
+	static char *function                     = "libewf_handle_set_compression_values";
+	int deflate_level                         = 0;
 
 	if( handle == NULL )
 	{
@@ -10104,14 +15354,26 @@ int libewf_handle_set_compression_method(
 
 		return( -1 );
 	}
-	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
-	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 ) )
+	if( ( compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
+	 && ( compression_level != LIBEWF_COMPRESSION_LEVEL_FAST )
+	 && ( compression_level != LIBEWF_COMPRESSION_LEVEL_BEST ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported compression method.",
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_flags & ~( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_COMPRESS_FLAG_SKIP_INCOMPRESSIBLE_DATA | LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION_LEVEL ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression flags.",
 		 function );
 
 		return( -1 );
@@ -10143,20 +15405,44 @@ int libewf_handle_set_compression_method(
 
 		goto on_error;
 	}
-	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
-	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
-	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	if( ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+	 && ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: compression method not supported by format.",
-		 function );
+		compression_flags |= LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION;
+	}
+	if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION_LEVEL ) != 0 )
+	{
+		/* The adaptive deflate compression level starts at the equivalent of the compression level
+		 */
+		if( compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+		{
+			deflate_level = LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LEVEL;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_LEVEL_BEST )
+		{
+			deflate_level = LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LEVEL;
+		}
+		else
+		{
+			deflate_level = LIBEWF_ADAPTIVE_COMPRESSION_DEFAULT_LEVEL;
+		}
+		if( libewf_compression_controller_reset(
+		     internal_handle->io_handle->compression_controller,
+		     deflate_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset compression controller.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	internal_handle->io_handle->compression_method = compression_method;
+	internal_handle->io_handle->compression_level = compression_level;
+	internal_handle->io_handle->compression_flags = compression_flags;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -10184,17 +15470,17 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the compression values
- * Returns 1 if successful or -1 on error
+/* Retrieves the number of chunks that were stored without compression because their data was considered incompressible
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libewf_handle_get_compression_values(
+int libewf_handle_get_number_of_incompressible_chunks(
      libewf_handle_t *handle,
-     int8_t *compression_level,
-     uint8_t *compression_flags,
+     uint64_t *number_of_chunks,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_compression_values";
+	static char *function                     = "libewf_handle_get_number_of_incompressible_chunks";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -10209,35 +15495,99 @@ int libewf_handle_get_compression_values(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( compression_level == NULL )
+#endif
+	if( internal_handle->write_io_handle != NULL )
+	{
+		*number_of_chunks = internal_handle->write_io_handle->number_of_incompressible_chunks;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the current adaptive deflate compression level
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_handle_get_adaptive_deflate_level(
+     libewf_handle_t *handle,
+     int *deflate_level,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_adaptive_deflate_level";
+	int result                                = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compression level.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( compression_flags == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( deflate_level == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compression flags.",
+		 "%s: invalid deflate level.",
 		 function );
 
 		return( -1 );
@@ -10257,9 +15607,25 @@ int libewf_handle_get_compression_values(
 		return( -1 );
 	}
 #endif
-	*compression_level = internal_handle->io_handle->compression_level;
-	*compression_flags = internal_handle->io_handle->compression_flags;
+	if( ( internal_handle->io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION_LEVEL ) != 0 )
+	{
+		result = libewf_compression_controller_get_deflate_level(
+		          internal_handle->io_handle->compression_controller,
+		          deflate_level,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve deflate level.",
+			 function );
 
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -10275,20 +15641,21 @@ int libewf_handle_get_compression_values(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the compression values
- * Returns 1 if successful or -1 on error
+/* Retrieves the number of chunks that were compressed with a specific adaptive deflate compression level
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libewf_handle_set_compression_values(
+int libewf_handle_get_number_of_chunks_with_deflate_level(
      libewf_handle_t *handle,
-     int8_t compression_level,
-     uint8_t compression_flags,
+     int deflate_level,
+     uint64_t *number_of_chunks,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_compression_values";
+	static char *function                     = "libewf_handle_get_number_of_chunks_with_deflate_level";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -10314,32 +15681,31 @@ int libewf_handle_set_compression_values(
 
 		return( -1 );
 	}
-	if( ( compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
-	 && ( compression_level != LIBEWF_COMPRESSION_LEVEL_FAST )
-	 && ( compression_level != LIBEWF_COMPRESSION_LEVEL_BEST ) )
+	if( ( deflate_level < LIBEWF_ADAPTIVE_COMPRESSION_MINIMUM_LEVEL )
+	 || ( deflate_level > LIBEWF_ADAPTIVE_COMPRESSION_MAXIMUM_LEVEL ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported compression level.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid deflate level value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( compression_flags & ~( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) ) != 0 )
+	if( number_of_chunks == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported compression flags.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -10347,34 +15713,34 @@ int libewf_handle_set_compression_values(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	if( ( internal_handle->io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION_LEVEL ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: compression values cannot be changed.",
-		 function );
+		result = libewf_compression_controller_get_number_of_chunks(
+		          internal_handle->io_handle->compression_controller,
+		          deflate_level,
+		          number_of_chunks,
+		          error );
 
-		goto on_error;
-	}
-	if( ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
-	 && ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
-	{
-		compression_flags |= LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION;
-	}
-	internal_handle->io_handle->compression_level = compression_level;
-	internal_handle->io_handle->compression_flags = compression_flags;
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunks.",
+			 function );
 
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -10382,21 +15748,13 @@ int libewf_handle_set_compression_values(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	return( result );
 }
 
 /* Retrieves the size of the contained media data
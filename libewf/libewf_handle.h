@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_async_io.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
@@ -40,11 +41,14 @@
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_read_ahead.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_segment_files_index.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
+#include "libewf_write_queue.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -94,6 +98,42 @@ struct libewf_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The maximum size of the (unpacked) chunk data cache
+	 */
+	size64_t maximum_cache_size;
+
+	/* The number of chunks to read ahead on sequential access
+	 */
+	int number_of_read_ahead_chunks;
+
+	/* The number of read-ahead threads
+	 */
+	int number_of_read_ahead_threads;
+
+	/* The number of threads that pack chunks on write
+	 */
+	int number_of_write_threads;
+
+	/* The maximum size of the chunk location table
+	 */
+	size64_t maximum_chunk_location_table_size;
+
+	/* Value to indicate if the segment files should be memory mapped when reading
+	 */
+	uint8_t use_memory_mapping;
+
+	/* The asynchronous IO queue depth, 0 if asynchronous IO is not used
+	 */
+	int async_io_queue_depth;
+
+	/* The segment files index file IO handle
+	 */
+	libbfio_handle_t *index_file_io_handle;
+
+	/* The segment files index, only set while opening
+	 */
+	libewf_segment_files_index_t *segment_files_index;
+
 	/* The current (storage media) offset
 	 */
 	off64_t current_offset;
@@ -139,6 +179,18 @@ struct libewf_internal_handle
 	libewf_single_files_t *single_files;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read-ahead
+	 */
+	libewf_read_ahead_t *read_ahead;
+
+	/* The write queue
+	 */
+	libewf_write_queue_t *write_queue;
+
+	/* The asynchronous IO used by the read-ahead
+	 */
+	libewf_async_io_t *async_io;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
@@ -199,6 +251,27 @@ int libewf_internal_handle_open_read_segment_files(
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_scan_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_internal_handle_open_read_segment_files_index(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_close_segment_files_index(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 int libewf_internal_handle_open_read_device_information(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -206,6 +279,18 @@ int libewf_internal_handle_open_read_device_information(
      uint32_t number_of_segments,
      libcerror_error_t **error );
 
+int libewf_internal_handle_get_segment_filename(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     char **filename,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_map_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
 int libewf_internal_handle_open_file_io_pool(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -225,6 +310,38 @@ int libewf_handle_close(
      libewf_handle_t *handle,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_read_ahead_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_ahead_chunks(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t first_chunk_index,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_read_ahead(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_async_io(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -247,6 +364,59 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libewf_internal_handle_read_buffers_at_offsets_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int number_of_buffers,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle,
+     int number_of_buffers,
+     void **buffers,
+     size_t *buffer_sizes,
+     off64_t *offsets,
+     ssize_t *read_counts,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_release_chunk_view(
+     libewf_handle_t *handle,
+     const uint8_t *data,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_pack_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_write_queue(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_queued_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t write_all,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -328,12 +498,158 @@ int libewf_handle_get_offset(
      off64_t *offset,
      libcerror_error_t **error );
 
+int libewf_internal_handle_get_next_data_region(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     off64_t *data_offset,
+     size64_t *data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_next_data_region(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *data_offset,
+     size64_t *data_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_information(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     size32_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_information(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     size32_t *chunk_data_size,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_information_entries(
+     libewf_handle_t *handle,
+     uint64_t first_chunk_index,
+     size32_t *chunk_data_sizes,
+     uint32_t *chunk_flags,
+     size_t maximum_number_of_entries,
+     size_t *number_of_entries,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_set_maximum_number_of_open_handles(
      libewf_handle_t *handle,
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_maximum_cache_size(
+     libewf_handle_t *handle,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_cache_size(
+     libewf_handle_t *handle,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_data_pool_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_ahead_values(
+     libewf_handle_t *handle,
+     int *number_of_chunks,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead_values(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_write_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_write_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_maximum_chunk_location_table_size(
+     libewf_handle_t *handle,
+     size64_t *maximum_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_chunk_location_table_size(
+     libewf_handle_t *handle,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_use_memory_mapping(
+     libewf_handle_t *handle,
+     uint8_t *use_memory_mapping,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_use_memory_mapping(
+     libewf_handle_t *handle,
+     uint8_t use_memory_mapping,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_async_io_queue_depth(
+     libewf_handle_t *handle,
+     int *queue_depth,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_async_io_queue_depth(
+     libewf_handle_t *handle,
+     int queue_depth,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -563,6 +879,25 @@ int libewf_handle_set_compression_values(
      uint8_t compression_flags,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_incompressible_chunks(
+     libewf_handle_t *handle,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_adaptive_deflate_level(
+     libewf_handle_t *handle,
+     int *deflate_level,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_chunks_with_deflate_level(
+     libewf_handle_t *handle,
+     int deflate_level,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_media_size(
      libewf_handle_t *handle,
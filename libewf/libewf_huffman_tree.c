@@ -226,6 +226,11 @@ int libewf_huffman_tree_free(
 	}
 	if( *huffman_tree != NULL )
 	{
+		if( ( *huffman_tree )->lookup_table != NULL )
+		{
+			memory_free(
+			 ( *huffman_tree )->lookup_table );
+		}
 		if( ( *huffman_tree )->code_size_counts != NULL )
 		{
 			memory_free(
@@ -335,6 +340,8 @@ int libewf_huffman_tree_build(
 		}
 		huffman_tree->code_size_counts[ code_size ] += 1;
 	}
+	huffman_tree->lookup_table_number_of_bits = 0;
+
 	/* The tree has no codes
 	 */
 	if( huffman_tree->code_size_counts[ 0 ] == number_of_code_sizes )
@@ -437,6 +444,23 @@ int libewf_huffman_tree_build(
 	memory_free(
 	 symbol_offsets );
 
+	symbol_offsets = NULL;
+
+	if( libewf_huffman_tree_build_lookup_table(
+	     huffman_tree,
+	     code_sizes_array,
+	     number_of_code_sizes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build lookup table.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -448,6 +472,286 @@ on_error:
 	return( -1 );
 }
 
+/* Builds the lookup table of the Huffman tree
+ * The lookup table is indexed by the next bits of a byte back to front bit stream,
+ * codes larger than the number of root bits are stored in sub tables
+ * The symbols must be sorted by code size before calling this function
+ * Returns 1 on success or -1 on error
+ */
+int libewf_huffman_tree_build_lookup_table(
+     libewf_huffman_tree_t *huffman_tree,
+     const uint8_t *code_sizes_array,
+     int number_of_code_sizes,
+     libcerror_error_t **error )
+{
+	uint8_t sub_table_number_of_bits[ 1 << LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_NUMBER_OF_BITS ];
+
+	static char *function          = "libewf_huffman_tree_build_lookup_table";
+	uint32_t *lookup_table         = NULL;
+	uint32_t huffman_code          = 0;
+	uint32_t lookup_table_entry    = 0;
+	uint32_t reversed_huffman_code = 0;
+	uint16_t symbol                = 0;
+	uint8_t bit_index              = 0;
+	uint8_t code_size              = 0;
+	uint8_t last_code_size         = 0;
+	uint8_t number_of_bits         = 0;
+	uint8_t sub_table_bits         = 0;
+	int entry_index                = 0;
+	int lookup_table_size          = 0;
+	int number_of_symbols          = 0;
+	int root_table_size            = 0;
+	int sub_table_offset           = 0;
+	int symbol_index               = 0;
+
+	if( huffman_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid Huffman tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( code_sizes_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid code sizes array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_code_sizes < 0 )
+	 || ( number_of_code_sizes > (int) INT16_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of code sizes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	huffman_tree->lookup_table_number_of_bits = 0;
+
+	/* Determine the largest code size in use
+	 */
+	for( bit_index = 1;
+	     bit_index <= huffman_tree->maximum_code_size;
+	     bit_index++ )
+	{
+		if( huffman_tree->code_size_counts[ bit_index ] > 0 )
+		{
+			last_code_size = bit_index;
+		}
+		number_of_symbols += huffman_tree->code_size_counts[ bit_index ];
+	}
+	if( last_code_size == 0 )
+	{
+		return( 1 );
+	}
+	number_of_bits = last_code_size;
+
+	if( number_of_bits > LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_NUMBER_OF_BITS )
+	{
+		number_of_bits = LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_NUMBER_OF_BITS;
+	}
+	root_table_size = 1 << number_of_bits;
+
+	if( memory_set(
+	     sub_table_number_of_bits,
+	     0,
+	     sizeof( uint8_t ) * root_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sub table number of bits.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the size of the sub tables, codes that share the same root bits
+	 * are stored in the same sub table
+	 */
+	huffman_code   = 0;
+	last_code_size = 0;
+
+	for( symbol_index = 0;
+	     symbol_index < number_of_symbols;
+	     symbol_index++ )
+	{
+		symbol    = huffman_tree->symbols[ symbol_index ];
+		code_size = code_sizes_array[ symbol ];
+
+		if( symbol_index > 0 )
+		{
+			huffman_code = ( huffman_code + 1 ) << ( code_size - last_code_size );
+		}
+		last_code_size = code_size;
+
+		if( code_size <= number_of_bits )
+		{
+			continue;
+		}
+		reversed_huffman_code = 0;
+
+		for( bit_index = 0;
+		     bit_index < code_size;
+		     bit_index++ )
+		{
+			reversed_huffman_code <<= 1;
+			reversed_huffman_code  |= ( huffman_code >> bit_index ) & 0x00000001UL;
+		}
+		entry_index    = (int) ( reversed_huffman_code & ( root_table_size - 1 ) );
+		sub_table_bits = code_size - number_of_bits;
+
+		if( sub_table_bits > sub_table_number_of_bits[ entry_index ] )
+		{
+			sub_table_number_of_bits[ entry_index ] = sub_table_bits;
+		}
+	}
+	lookup_table_size = root_table_size;
+
+	for( entry_index = 0;
+	     entry_index < root_table_size;
+	     entry_index++ )
+	{
+		sub_table_bits = sub_table_number_of_bits[ entry_index ];
+
+		if( sub_table_bits == 0 )
+		{
+			continue;
+		}
+		if( ( sub_table_bits > 15 )
+		 || ( lookup_table_size > ( LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_SIZE - ( 1 << sub_table_bits ) ) ) )
+		{
+			/* The lookup table would become too large, the codes are decoded bit by bit instead
+			 */
+			return( 1 );
+		}
+		lookup_table_size += 1 << sub_table_bits;
+	}
+	if( lookup_table_size > huffman_tree->lookup_table_size )
+	{
+		lookup_table = (uint32_t *) memory_reallocate(
+		                             huffman_tree->lookup_table,
+		                             sizeof( uint32_t ) * lookup_table_size );
+
+		if( lookup_table == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize lookup table.",
+			 function );
+
+			return( -1 );
+		}
+		huffman_tree->lookup_table      = lookup_table;
+		huffman_tree->lookup_table_size = lookup_table_size;
+	}
+	/* An entry of 0 represents an invalid code
+	 */
+	if( memory_set(
+	     huffman_tree->lookup_table,
+	     0,
+	     sizeof( uint32_t ) * lookup_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	sub_table_offset = root_table_size;
+
+	for( entry_index = 0;
+	     entry_index < root_table_size;
+	     entry_index++ )
+	{
+		sub_table_bits = sub_table_number_of_bits[ entry_index ];
+
+		if( sub_table_bits == 0 )
+		{
+			continue;
+		}
+		huffman_tree->lookup_table[ entry_index ] = LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_ENTRY_FLAG_SUB_TABLE
+		                                          | ( (uint32_t) sub_table_bits << 16 )
+		                                          | (uint32_t) sub_table_offset;
+
+		sub_table_offset += 1 << sub_table_bits;
+	}
+	/* Fill the lookup table, the bit stream stores the first bit of a code in
+	 * the least significant bit hence a code is stored in every entry of which
+	 * the lower bits match the reversed code
+	 */
+	huffman_code   = 0;
+	last_code_size = 0;
+
+	for( symbol_index = 0;
+	     symbol_index < number_of_symbols;
+	     symbol_index++ )
+	{
+		symbol    = huffman_tree->symbols[ symbol_index ];
+		code_size = code_sizes_array[ symbol ];
+
+		if( symbol_index > 0 )
+		{
+			huffman_code = ( huffman_code + 1 ) << ( code_size - last_code_size );
+		}
+		last_code_size = code_size;
+
+		reversed_huffman_code = 0;
+
+		for( bit_index = 0;
+		     bit_index < code_size;
+		     bit_index++ )
+		{
+			reversed_huffman_code <<= 1;
+			reversed_huffman_code  |= ( huffman_code >> bit_index ) & 0x00000001UL;
+		}
+		lookup_table_entry = ( (uint32_t) code_size << 16 ) | (uint32_t) symbol;
+
+		if( code_size <= number_of_bits )
+		{
+			for( entry_index = (int) reversed_huffman_code;
+			     entry_index < root_table_size;
+			     entry_index += 1 << code_size )
+			{
+				huffman_tree->lookup_table[ entry_index ] = lookup_table_entry;
+			}
+		}
+		else
+		{
+			entry_index      = (int) ( reversed_huffman_code & ( root_table_size - 1 ) );
+			sub_table_bits   = sub_table_number_of_bits[ entry_index ];
+			sub_table_offset = (int) ( huffman_tree->lookup_table[ entry_index ] & 0x0000ffffUL );
+
+			for( entry_index = (int) ( reversed_huffman_code >> number_of_bits );
+			     entry_index < ( 1 << sub_table_bits );
+			     entry_index += 1 << ( code_size - number_of_bits ) )
+			{
+				huffman_tree->lookup_table[ sub_table_offset + entry_index ] = lookup_table_entry;
+			}
+		}
+	}
+	huffman_tree->lookup_table_number_of_bits = number_of_bits;
+
+	return( 1 );
+}
+
 /* Retrieves a symbol based on the Huffman code read from the bit-stream
  * Returns 1 on success or -1 on error
  */
@@ -457,15 +761,17 @@ int libewf_huffman_tree_get_symbol_from_bit_stream(
      uint16_t *symbol,
      libcerror_error_t **error )
 {
-	static char *function  = "libewf_huffman_tree_get_symbol_from_bit_stream";
-	uint32_t value_32bit   = 0;
-	uint16_t safe_symbol   = 0;
-	uint8_t bit_index      = 0;
-	int code_size_count    = 0;
-	int first_huffman_code = 0;
-	int first_index        = 0;
-	int huffman_code       = 0;
-	int result             = 0;
+	static char *function       = "libewf_huffman_tree_get_symbol_from_bit_stream";
+	uint32_t lookup_table_entry = 0;
+	uint32_t value_32bit        = 0;
+	uint16_t safe_symbol        = 0;
+	uint8_t bit_index           = 0;
+	uint8_t code_size           = 0;
+	int code_size_count         = 0;
+	int first_huffman_code      = 0;
+	int first_index             = 0;
+	int huffman_code            = 0;
+	int result                  = 0;
 
 	if( huffman_tree == NULL )
 	{
@@ -500,8 +806,46 @@ int libewf_huffman_tree_get_symbol_from_bit_stream(
 
 		return( -1 );
 	}
-/* TODO get maximum_code_size of bits into local bit buffer */
+	if( ( huffman_tree->lookup_table_number_of_bits > 0 )
+	 && ( bit_stream->storage_type == LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT ) )
+	{
+		if( bit_stream->bit_buffer_size < huffman_tree->maximum_code_size )
+		{
+			libewf_bit_stream_fill_bit_buffer(
+			 bit_stream );
+		}
+		lookup_table_entry = huffman_tree->lookup_table[ bit_stream->bit_buffer & ( ( (uint64_t) 1 << huffman_tree->lookup_table_number_of_bits ) - 1 ) ];
+
+		if( ( lookup_table_entry & LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_ENTRY_FLAG_SUB_TABLE ) != 0 )
+		{
+			code_size = (uint8_t) ( lookup_table_entry >> 16 );
+
+			lookup_table_entry = huffman_tree->lookup_table[ ( lookup_table_entry & 0x0000ffffUL ) + ( ( bit_stream->bit_buffer >> huffman_tree->lookup_table_number_of_bits ) & ( ( (uint64_t) 1 << code_size ) - 1 ) ) ];
+		}
+		code_size = (uint8_t) ( lookup_table_entry >> 16 );
+
+		if( ( code_size == 0 )
+		 || ( code_size > bit_stream->bit_buffer_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid Huffman code: 0x%08" PRIx64 ".",
+			 function,
+			 bit_stream->bit_buffer & ( ( (uint64_t) 1 << huffman_tree->maximum_code_size ) - 1 ) );
 
+			return( -1 );
+		}
+		bit_stream->bit_buffer     >>= code_size;
+		bit_stream->bit_buffer_size -= code_size;
+
+		*symbol = (uint16_t) ( lookup_table_entry & 0x0000ffffUL );
+
+		return( 1 );
+	}
+	/* Decode the canonical Huffman code bit by bit
+	 */
 	for( bit_index = 1;
 	     bit_index <= huffman_tree->maximum_code_size;
 	     bit_index++ )
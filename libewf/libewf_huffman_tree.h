@@ -32,6 +32,20 @@
 extern "C" {
 #endif
 
+/* The maximum number of bits used to index the root of the lookup table
+ */
+#define LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_NUMBER_OF_BITS	10
+
+/* The maximum number of lookup table entries, sub table offsets are stored in 16 bits
+ */
+#define LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_MAXIMUM_SIZE		65535
+
+/* The lookup table entry values
+ * a symbol entry contains the symbol in bits 0 - 15 and the code size in bits 16 - 23
+ * a sub table entry contains the offset in bits 0 - 15 and the number of bits in bits 16 - 23
+ */
+#define LIBEWF_HUFFMAN_TREE_LOOKUP_TABLE_ENTRY_FLAG_SUB_TABLE	0x80000000UL
+
 typedef struct libewf_huffman_tree libewf_huffman_tree_t;
 
 struct libewf_huffman_tree
@@ -47,6 +61,19 @@ struct libewf_huffman_tree
 	/* The code size counts array
 	 */
 	int *code_size_counts;
+
+	/* The lookup table
+	 */
+	uint32_t *lookup_table;
+
+	/* The number of allocated lookup table entries
+	 */
+	int lookup_table_size;
+
+	/* The number of bits used to index the root of the lookup table
+	 * 0 if the lookup table is not used
+	 */
+	uint8_t lookup_table_number_of_bits;
 };
 
 int libewf_huffman_tree_initialize(
@@ -65,6 +92,12 @@ int libewf_huffman_tree_build(
      int number_of_code_sizes,
      libcerror_error_t **error );
 
+int libewf_huffman_tree_build_lookup_table(
+     libewf_huffman_tree_t *huffman_tree,
+     const uint8_t *code_sizes_array,
+     int number_of_code_sizes,
+     libcerror_error_t **error );
+
 int libewf_huffman_tree_get_symbol_from_bit_stream(
      libewf_huffman_tree_t *huffman_tree,
      libewf_bit_stream_t *bit_stream,
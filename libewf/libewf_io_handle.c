@@ -23,10 +23,16 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
 #include "libewf_codepage.h"
+#include "libewf_compression_context.h"
+#include "libewf_compression_controller.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
@@ -97,11 +103,87 @@ int libewf_io_handle_initialize(
 	( *io_handle )->zero_on_error      = 1;
 	( *io_handle )->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
+	if( libcdata_array_initialize(
+	     &( ( *io_handle )->compression_contexts_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression contexts array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_pool_initialize(
+	     &( ( *io_handle )->chunk_data_pool ),
+	     sizeof( libewf_chunk_data_t ),
+	     LIBEWF_MAXIMUM_CHUNK_DATA_POOL_ENTRIES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_compression_controller_initialize(
+	     &( ( *io_handle )->compression_controller ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression controller.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *io_handle )->compression_contexts_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize compression contexts read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *io_handle != NULL )
 	{
+		if( ( *io_handle )->compression_controller != NULL )
+		{
+			libewf_compression_controller_free(
+			 &( ( *io_handle )->compression_controller ),
+			 NULL );
+		}
+		if( ( *io_handle )->chunk_data_pool != NULL )
+		{
+			libewf_chunk_data_pool_free(
+			 &( ( *io_handle )->chunk_data_pool ),
+			 NULL );
+		}
+		if( ( *io_handle )->compression_contexts_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *io_handle )->compression_contexts_array ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *io_handle );
 
@@ -146,6 +228,61 @@ int libewf_io_handle_free(
 
 			result = -1;
 		}
+		if( libcdata_array_free(
+		     &( ( *io_handle )->compression_contexts_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_compression_context_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression contexts array.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_chunk_data_pool_free(
+		     &( ( *io_handle )->chunk_data_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_compression_controller_free(
+		     &( ( *io_handle )->compression_controller ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression controller.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *io_handle )->compression_contexts_read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression contexts read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -161,7 +298,14 @@ int libewf_io_handle_clear(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_io_handle_clear";
+	libcdata_array_t *compression_contexts_array                        = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool                           = NULL;
+	libewf_compression_controller_t *compression_controller             = NULL;
+	static char *function                                               = "libewf_io_handle_clear";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_t *compression_contexts_read_write_lock = NULL;
+#endif
 
 	if( io_handle == NULL )
 	{
@@ -174,6 +318,30 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The compression contexts, the chunk data pool and the compression controller
+	 * are retained since they do not depend on the file, the buffers of the chunk
+	 * data pool are emptied since their size depends on the chunk size of the file
+	 */
+	if( libewf_chunk_data_pool_empty_buffers(
+	     io_handle->chunk_data_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to empty chunk data pool buffers.",
+		 function );
+
+		return( -1 );
+	}
+	compression_contexts_array = io_handle->compression_contexts_array;
+	chunk_data_pool            = io_handle->chunk_data_pool;
+	compression_controller     = io_handle->compression_controller;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	compression_contexts_read_write_lock = io_handle->compression_contexts_read_write_lock;
+#endif
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -197,6 +365,13 @@ int libewf_io_handle_clear(
 	io_handle->zero_on_error      = 1;
 	io_handle->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
+	io_handle->compression_contexts_array = compression_contexts_array;
+	io_handle->chunk_data_pool            = chunk_data_pool;
+	io_handle->compression_controller     = compression_controller;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	io_handle->compression_contexts_read_write_lock = compression_contexts_read_write_lock;
+#endif
 	return( 1 );
 }
 
@@ -266,13 +441,103 @@ int libewf_io_handle_clone(
 
 		goto on_error;
 	}
-	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
+	( *destination_io_handle )->zero_on_error              = source_io_handle->zero_on_error;
+	( *destination_io_handle )->segment_files_index        = NULL;
+	( *destination_io_handle )->compression_contexts_array = NULL;
+	( *destination_io_handle )->chunk_data_pool            = NULL;
+	( *destination_io_handle )->compression_controller     = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *destination_io_handle )->compression_contexts_read_write_lock = NULL;
+#endif
+
+	/* The compression contexts are not shared with the source IO handle
+	 */
+	if( libcdata_array_initialize(
+	     &( ( *destination_io_handle )->compression_contexts_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression contexts array.",
+		 function );
 
+		goto on_error;
+	}
+	/* The chunk data pool is not shared with the source IO handle
+	 */
+	if( libewf_chunk_data_pool_initialize(
+	     &( ( *destination_io_handle )->chunk_data_pool ),
+	     sizeof( libewf_chunk_data_t ),
+	     LIBEWF_MAXIMUM_CHUNK_DATA_POOL_ENTRIES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
+	/* The compression controller is not shared with the source IO handle
+	 */
+	if( libewf_compression_controller_initialize(
+	     &( ( *destination_io_handle )->compression_controller ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression controller.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *destination_io_handle )->compression_contexts_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize destination compression contexts read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *destination_io_handle != NULL )
 	{
+		if( ( *destination_io_handle )->compression_controller != NULL )
+		{
+			libewf_compression_controller_free(
+			 &( ( *destination_io_handle )->compression_controller ),
+			 NULL );
+		}
+		if( ( *destination_io_handle )->chunk_data_pool != NULL )
+		{
+			libewf_chunk_data_pool_free(
+			 &( ( *destination_io_handle )->chunk_data_pool ),
+			 NULL );
+		}
+		if( ( *destination_io_handle )->compression_contexts_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *destination_io_handle )->compression_contexts_array ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *destination_io_handle );
 
@@ -281,3 +546,246 @@ on_error:
 	return( -1 );
 }
 
+/* Grabs a compression context
+ * A previously released compression context is reused if available otherwise a new one is created
+ * The compression context must be released with libewf_io_handle_release_compression_context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_grab_compression_context(
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_handle_grab_compression_context";
+	int number_of_entries = 0;
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_handle->compression_contexts_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     io_handle->compression_contexts_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of compression contexts.",
+		 function );
+
+		result = -1;
+	}
+	else if( number_of_entries > 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     io_handle->compression_contexts_array,
+		     number_of_entries - 1,
+		     (intptr_t **) compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compression context: %d.",
+			 function,
+			 number_of_entries - 1 );
+
+			result = -1;
+		}
+		else if( libcdata_array_resize(
+		          io_handle->compression_contexts_array,
+		          number_of_entries - 1,
+		          NULL,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize compression contexts array.",
+			 function );
+
+			*compression_context = NULL;
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_handle->compression_contexts_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( *compression_context == NULL )
+	{
+		if( libewf_compression_context_initialize(
+		     compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Releases a compression context so that it can be reused
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_release_compression_context(
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_handle_release_compression_context";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_handle->compression_contexts_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_append_entry(
+	     io_handle->compression_contexts_array,
+	     &entry_index,
+	     (intptr_t *) *compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append compression context to array.",
+		 function );
+
+		libewf_compression_context_free(
+		 compression_context,
+		 NULL );
+
+		result = -1;
+	}
+	/* On success the compression context is now owned by the array
+	 */
+	*compression_context = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_handle->compression_contexts_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
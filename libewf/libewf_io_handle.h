@@ -25,7 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data_pool.h"
+#include "libewf_compression_context.h"
+#include "libewf_compression_controller.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_files_index.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -83,9 +89,38 @@ struct libewf_io_handle
 	 */
 	int header_codepage;
 
+	/* The segment files index, used to restore the sections and chunk groups
+	 * of a segment file without reading them, not owned by the IO handle
+	 */
+	libewf_segment_files_index_t *segment_files_index;
+
+	/* The compression contexts that are currently not in use
+	 */
+	libcdata_array_t *compression_contexts_array;
+
+	/* The pool of chunk data buffers and structures that are currently not in use
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
+	/* The compression controller that adapts the deflate compression level
+	 */
+	libewf_compression_controller_t *compression_controller;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The number of times abort was signalled, which the reads at an offset compare
+	 * against the value at their start so that an abort only applies to the reads
+	 * that are in progress
+	 */
+	uint32_t abort_generation;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The compression contexts read/write lock
+	 */
+	libcthreads_read_write_lock_t *compression_contexts_read_write_lock;
+#endif
 };
 
 int libewf_io_handle_initialize(
@@ -105,6 +140,16 @@ int libewf_io_handle_clone(
      libewf_io_handle_t *source_io_handle,
      libcerror_error_t **error );
 
+int libewf_io_handle_grab_compression_context(
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_io_handle_release_compression_context(
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,835 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_read_ahead.h"
+#include "libewf_unused.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a read-ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * The read chunk callback is called from the worker threads and must be multi-thread safe
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     int number_of_chunks,
+     int number_of_threads,
+     uint64_t maximum_number_of_chunks,
+     int (*read_chunk)(
+            void *arguments,
+            uint64_t chunk_index,
+            libcerror_error_t **error ),
+     void *arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_initialize";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read chunk function.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libewf_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libewf_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *read_ahead )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_ahead )->number_of_chunks         = number_of_chunks;
+	( *read_ahead )->number_of_threads        = number_of_threads;
+	( *read_ahead )->maximum_number_of_chunks = maximum_number_of_chunks;
+	( *read_ahead )->read_chunk               = read_chunk;
+	( *read_ahead )->arguments                = arguments;
+
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * Waits for the worker threads to finish
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_free";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		if( libewf_read_ahead_stop(
+		     *read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop read-ahead.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_read_write_lock_free(
+		     &( ( *read_ahead )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Sets the callback function that reads a range of chunks
+ * When set, a worker thread reads up to the maximum number of chunks per read
+ * with a single call instead of one chunk at a time
+ * The read chunks callback is called from the worker threads and must be multi-thread safe
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_set_read_chunks_callback(
+     libewf_read_ahead_t *read_ahead,
+     int (*read_chunks)(
+            void *arguments,
+            uint64_t first_chunk_index,
+            int number_of_chunks,
+            libcerror_error_t **error ),
+     int maximum_number_of_chunks_per_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_set_read_chunks_callback";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read chunks function.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_chunks_per_read <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks per read value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	read_ahead->read_chunks                       = read_chunks;
+	read_ahead->maximum_number_of_chunks_per_read = maximum_number_of_chunks_per_read;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Stops the read-ahead
+ * Pending requests are cancelled and the worker threads are joined,
+ * the thread pool is created again when sequential access is detected
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_stop(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	static char *function                  = "libewf_read_ahead_stop";
+	int result                             = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	thread_pool = read_ahead->thread_pool;
+
+	read_ahead->thread_pool                = NULL;
+	read_ahead->end_chunk_index            = read_ahead->next_chunk_index;
+	read_ahead->number_of_sequential_reads = 0;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* The worker threads grab the read/write lock hence the thread pool
+	 * is joined without holding it
+	 */
+	if( thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	read_ahead->number_of_queued_requests = 0;
+
+	return( result );
+}
+
+/* Notifies the read-ahead that the chunks in a range are being read
+ * The read-ahead window is moved past the last chunk once the number of
+ * consecutive sequential reads reaches the threshold, and a request is queued
+ * for every chunk in the window that has not been requested yet
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_notify_read(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t first_chunk_index,
+     uint64_t last_chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function          = "libewf_read_ahead_notify_read";
+	uint64_t end_chunk_index       = 0;
+	uint64_t number_of_requests    = 0;
+	int result                     = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_chunk_index > last_chunk_index )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* A read is sequential if it continues in or after the last chunk read
+	 */
+	if( ( first_chunk_index == read_ahead->last_chunk_index )
+	 || ( first_chunk_index == ( read_ahead->last_chunk_index + 1 ) ) )
+	{
+		if( read_ahead->number_of_sequential_reads < LIBEWF_READ_AHEAD_SEQUENTIAL_READS_THRESHOLD )
+		{
+			read_ahead->number_of_sequential_reads += 1;
+		}
+	}
+	else
+	{
+		/* Cancel the requests that have not been processed yet
+		 */
+		read_ahead->number_of_sequential_reads = 0;
+		read_ahead->end_chunk_index            = read_ahead->next_chunk_index;
+	}
+	read_ahead->last_chunk_index = last_chunk_index;
+
+	if( read_ahead->number_of_sequential_reads >= LIBEWF_READ_AHEAD_SEQUENTIAL_READS_THRESHOLD )
+	{
+		if( read_ahead->next_chunk_index <= last_chunk_index )
+		{
+			read_ahead->next_chunk_index = last_chunk_index + 1;
+		}
+		end_chunk_index = last_chunk_index + 1 + (uint64_t) read_ahead->number_of_chunks;
+
+		if( end_chunk_index > read_ahead->maximum_number_of_chunks )
+		{
+			end_chunk_index = read_ahead->maximum_number_of_chunks;
+		}
+		if( end_chunk_index > read_ahead->end_chunk_index )
+		{
+			read_ahead->end_chunk_index = end_chunk_index;
+		}
+		if( read_ahead->end_chunk_index > read_ahead->next_chunk_index )
+		{
+			number_of_requests = read_ahead->end_chunk_index - read_ahead->next_chunk_index;
+		}
+		/* The number of queued requests never exceeds the size of the thread pool queue
+		 * so that pushing a request does not block
+		 */
+		if( number_of_requests > (uint64_t) read_ahead->number_of_chunks )
+		{
+			number_of_requests = (uint64_t) read_ahead->number_of_chunks;
+		}
+		if( number_of_requests > (uint64_t) read_ahead->number_of_queued_requests )
+		{
+			number_of_requests -= read_ahead->number_of_queued_requests;
+		}
+		else
+		{
+			number_of_requests = 0;
+		}
+		if( ( number_of_requests > 0 )
+		 && ( read_ahead->thread_pool == NULL ) )
+		{
+			if( libcthreads_thread_pool_create(
+			     &( read_ahead->thread_pool ),
+			     NULL,
+			     read_ahead->number_of_threads,
+			     read_ahead->number_of_chunks,
+			     (int (*)(intptr_t *, void *)) &libewf_read_ahead_process_request_callback,
+			     (void *) read_ahead,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		while( ( result == 1 )
+		    && ( number_of_requests > 0 ) )
+		{
+			if( libcthreads_thread_pool_push(
+			     read_ahead->thread_pool,
+			     (intptr_t *) read_ahead,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push request onto thread pool queue.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			read_ahead->number_of_queued_requests += 1;
+
+			number_of_requests--;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the index of the next chunk to read ahead and dequeues a request
+ * Returns 1 if successful, 0 if there is no chunk to read ahead or -1 on error
+ */
+int libewf_read_ahead_get_next_chunk_index(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t *chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_get_next_chunk_index";
+	int result            = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->number_of_queued_requests > 0 )
+	{
+		read_ahead->number_of_queued_requests -= 1;
+	}
+	if( read_ahead->next_chunk_index < read_ahead->end_chunk_index )
+	{
+		*chunk_index = read_ahead->next_chunk_index;
+
+		read_ahead->next_chunk_index += 1;
+
+		result = 1;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the next range of chunks to read ahead and dequeues a request
+ * Returns 1 if successful, 0 if there is no chunk to read ahead or -1 on error
+ */
+int libewf_read_ahead_get_next_chunk_range(
+     libewf_read_ahead_t *read_ahead,
+     int maximum_number_of_chunks,
+     uint64_t *first_chunk_index,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function          = "libewf_read_ahead_get_next_chunk_range";
+	uint64_t safe_number_of_chunks = 0;
+	int result                     = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->number_of_queued_requests > 0 )
+	{
+		read_ahead->number_of_queued_requests -= 1;
+	}
+	if( read_ahead->next_chunk_index < read_ahead->end_chunk_index )
+	{
+		safe_number_of_chunks = read_ahead->end_chunk_index - read_ahead->next_chunk_index;
+
+		if( safe_number_of_chunks > (uint64_t) maximum_number_of_chunks )
+		{
+			safe_number_of_chunks = (uint64_t) maximum_number_of_chunks;
+		}
+		*first_chunk_index = read_ahead->next_chunk_index;
+		*number_of_chunks  = (int) safe_number_of_chunks;
+
+		read_ahead->next_chunk_index += safe_number_of_chunks;
+
+		result = 1;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     read_ahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Processes a read-ahead request
+ * Callback for the read-ahead thread pool
+ * Read-ahead is best effort, errors are left to be reported by the read that needs the chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_process_request_callback(
+     intptr_t *request LIBEWF_ATTRIBUTE_UNUSED,
+     libewf_read_ahead_t *read_ahead )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_read_ahead_process_request_callback";
+	uint64_t chunk_index     = 0;
+	int number_of_chunks     = 0;
+	int result               = 0;
+
+	LIBEWF_UNREFERENCED_PARAMETER( request )
+
+	/* The read chunks callback is set before the thread pool is created
+	 */
+	if( read_ahead->read_chunks != NULL )
+	{
+		result = libewf_read_ahead_get_next_chunk_range(
+		          read_ahead,
+		          read_ahead->maximum_number_of_chunks_per_read,
+		          &chunk_index,
+		          &number_of_chunks,
+		          &error );
+	}
+	else
+	{
+		result = libewf_read_ahead_get_next_chunk_index(
+		          read_ahead,
+		          &chunk_index,
+		          &error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( read_ahead->read_chunks != NULL )
+		{
+			result = read_ahead->read_chunks(
+			          read_ahead->arguments,
+			          chunk_index,
+			          number_of_chunks,
+			          &error );
+		}
+		else
+		{
+			result = read_ahead->read_chunk(
+			          read_ahead->arguments,
+			          chunk_index,
+			          &error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ahead chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,171 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_H )
+#define _LIBEWF_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The number of consecutive sequential reads after which read-ahead starts
+ */
+#define LIBEWF_READ_AHEAD_SEQUENTIAL_READS_THRESHOLD	2
+
+typedef struct libewf_read_ahead libewf_read_ahead_t;
+
+/* The read-ahead detects sequential access and has a pool of worker threads
+ * read and unpack the chunks that follow the last read chunk into the chunk cache
+ */
+struct libewf_read_ahead
+{
+	/* The number of chunks to read ahead
+	 */
+	int number_of_chunks;
+
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The number of chunks in the media
+	 */
+	uint64_t maximum_number_of_chunks;
+
+	/* The chunk index of the last chunk read
+	 */
+	uint64_t last_chunk_index;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The index of the next chunk to read ahead
+	 */
+	uint64_t next_chunk_index;
+
+	/* The end of the read-ahead window, the chunk index after the last chunk to read ahead
+	 */
+	uint64_t end_chunk_index;
+
+	/* The number of read-ahead requests queued in the thread pool
+	 */
+	int number_of_queued_requests;
+
+	/* The callback function that reads the chunk
+	 */
+	int (*read_chunk)(
+	       void *arguments,
+	       uint64_t chunk_index,
+	       libcerror_error_t **error );
+
+	/* The callback function that reads a range of chunks, or NULL if not set
+	 */
+	int (*read_chunks)(
+	       void *arguments,
+	       uint64_t first_chunk_index,
+	       int number_of_chunks,
+	       libcerror_error_t **error );
+
+	/* The maximum number of chunks read by a single call of the read chunks callback
+	 */
+	int maximum_number_of_chunks_per_read;
+
+	/* The callback function arguments
+	 */
+	void *arguments;
+
+	/* The thread pool, created when sequential access is first detected
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+};
+
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     int number_of_chunks,
+     int number_of_threads,
+     uint64_t maximum_number_of_chunks,
+     int (*read_chunk)(
+            void *arguments,
+            uint64_t chunk_index,
+            libcerror_error_t **error ),
+     void *arguments,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_set_read_chunks_callback(
+     libewf_read_ahead_t *read_ahead,
+     int (*read_chunks)(
+            void *arguments,
+            uint64_t first_chunk_index,
+            int number_of_chunks,
+            libcerror_error_t **error ),
+     int maximum_number_of_chunks_per_read,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_stop(
+     libewf_read_ahead_t *read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_notify_read(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t first_chunk_index,
+     uint64_t last_chunk_index,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_get_next_chunk_index(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t *chunk_index,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_get_next_chunk_range(
+     libewf_read_ahead_t *read_ahead,
+     int maximum_number_of_chunks,
+     uint64_t *first_chunk_index,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_process_request_callback(
+     intptr_t *request,
+     libewf_read_ahead_t *read_ahead );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_AHEAD_H ) */
+
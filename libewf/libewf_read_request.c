@@ -0,0 +1,110 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libewf_libcerror.h"
+#include "libewf_read_request.h"
+
+/* Compares two read requests
+ * Read requests are ordered by chunk index, buffer index and buffer offset
+ * Returns -1 if the first is less than the second, 0 if equal or 1 if greater
+ */
+int libewf_read_request_compare(
+     const libewf_read_request_t *first_read_request,
+     const libewf_read_request_t *second_read_request )
+{
+	if( first_read_request->chunk_index < second_read_request->chunk_index )
+	{
+		return( -1 );
+	}
+	else if( first_read_request->chunk_index > second_read_request->chunk_index )
+	{
+		return( 1 );
+	}
+	if( first_read_request->buffer_index < second_read_request->buffer_index )
+	{
+		return( -1 );
+	}
+	else if( first_read_request->buffer_index > second_read_request->buffer_index )
+	{
+		return( 1 );
+	}
+	if( first_read_request->buffer_offset < second_read_request->buffer_offset )
+	{
+		return( -1 );
+	}
+	else if( first_read_request->buffer_offset > second_read_request->buffer_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sorts read requests by chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_requests_sort(
+     libewf_read_request_t *read_requests,
+     size_t number_of_read_requests,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_requests_sort";
+
+	if( read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_requests > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_read_request_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of read requests value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_requests > 1 )
+	{
+		qsort(
+		 read_requests,
+		 number_of_read_requests,
+		 sizeof( libewf_read_request_t ),
+		 (int (*)(const void *, const void *)) &libewf_read_request_compare );
+	}
+	return( 1 );
+}
+
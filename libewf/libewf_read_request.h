@@ -0,0 +1,75 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_REQUEST_H )
+#define _LIBEWF_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_read_request libewf_read_request_t;
+
+/* A read request is the part of a buffer read that is contained in a single chunk
+ */
+struct libewf_read_request
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The offset of the data relative to the start of the chunk
+	 */
+	size_t chunk_data_offset;
+
+	/* The size of the data
+	 */
+	size_t data_size;
+
+	/* The index of the buffer
+	 */
+	int buffer_index;
+
+	/* The offset of the data relative to the start of the buffer
+	 */
+	size_t buffer_offset;
+};
+
+int libewf_read_request_compare(
+     const libewf_read_request_t *first_read_request,
+     const libewf_read_request_t *second_read_request );
+
+int libewf_read_requests_sort(
+     libewf_read_request_t *read_requests,
+     size_t number_of_read_requests,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_REQUEST_H ) */
+
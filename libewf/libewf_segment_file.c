@@ -52,6 +52,7 @@
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
 #include "libewf_segment_file.h"
+#include "libewf_segment_files_index.h"
 #include "libewf_segment_table.h"
 #include "libewf_session_section.h"
 #include "libewf_sha1_hash_section.h"
@@ -62,6 +63,7 @@
 
 #include "ewf_file_header.h"
 #include "ewf_section.h"
+#include "ewf_segment_files_index.h"
 #include "ewf_volume.h"
 
 const uint8_t ewf1_dvf_file_signature[ 8 ] = { 0x64, 0x76, 0x66, 0x09, 0x0d, 0x0a, 0xff, 0x00 };
@@ -6116,62 +6118,1166 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
+/* Retrieves the size of the segment files index entry data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_get_index_entry_data_size(
+     libewf_segment_file_t *segment_file,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_segment_file_get_index_entry_data_size";
+	int number_of_chunk_groups = 0;
+	int number_of_sections     = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of elements from sections list.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of elements from chunk groups list.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = sizeof( ewf_segment_files_index_entry_t )
+	           + ( (size_t) number_of_sections * sizeof( ewf_segment_files_index_section_t ) )
+	           + ( (size_t) number_of_chunk_groups * sizeof( ewf_segment_files_index_chunk_group_t ) );
+
+	return( 1 );
+}
+
+/* Writes the segment files index entry data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_write_index_entry_data(
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     libewf_section_descriptor_t *last_section_descriptor,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	ewf_segment_files_index_chunk_group_t *index_chunk_group = NULL;
+	ewf_segment_files_index_entry_t *index_entry             = NULL;
+	ewf_segment_files_index_section_t *index_section         = NULL;
+	static char *function                                    = "libewf_segment_file_write_index_entry_data";
+	size64_t element_size                                    = 0;
+	size64_t mapped_size                                     = 0;
+	size_t data_offset                                       = 0;
+	size_t required_data_size                                = 0;
+	off64_t element_offset                                   = 0;
+	uint32_t element_flags                                   = 0;
+	int element_file_index                                   = 0;
+	int element_index                                        = 0;
+	int number_of_chunk_groups                               = 0;
+	int number_of_sections                                   = 0;
+
+	if( libewf_segment_file_get_index_entry_data_size(
+	     segment_file,
+	     &required_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index entry data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( last_section_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid last section descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < required_data_size )
+	 || ( required_data_size > (size_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of elements from sections list.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of elements from chunk groups list.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     required_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	index_entry = (ewf_segment_files_index_entry_t *) data;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->entry_size,
+	 (uint32_t) required_data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->segment_number,
+	 segment_file->segment_number );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->segment_file_size,
+	 segment_file_size );
+
+	index_entry->type          = segment_file->type;
+	index_entry->major_version = segment_file->major_version;
+	index_entry->minor_version = segment_file->minor_version;
+	index_entry->flags         = segment_file->flags
+	                           & ( LIBEWF_SEGMENT_FILE_FLAG_IS_LAST
+	                             | LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED
+	                             | LIBEWF_SEGMENT_FILE_FLAG_HAS_METADATA_SECTIONS );
+
+	byte_stream_copy_from_uint16_little_endian(
+	 index_entry->compression_method,
+	 segment_file->compression_method );
+
+	if( memory_copy(
+	     index_entry->set_identifier,
+	     segment_file->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->current_offset,
+	 (uint64_t) segment_file->current_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->last_section_offset,
+	 (uint64_t) segment_file->last_section_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->last_section_end_offset,
+	 (uint64_t) last_section_descriptor->end_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->last_section_data_size,
+	 last_section_descriptor->data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->last_section_type,
+	 last_section_descriptor->type );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->device_information_section_index,
+	 (uint32_t) segment_file->device_information_section_index );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->storage_media_size,
+	 segment_file->storage_media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->number_of_chunks,
+	 segment_file->number_of_chunks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->previous_last_chunk_filled,
+	 (uint64_t) segment_file->previous_last_chunk_filled );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->last_chunk_filled,
+	 (uint64_t) segment_file->last_chunk_filled );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->last_chunk_compared,
+	 (uint64_t) segment_file->last_chunk_compared );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->current_chunk_group_index,
+	 (uint32_t) segment_file->current_chunk_group_index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->number_of_sections,
+	 (uint32_t) number_of_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->number_of_chunk_groups,
+	 (uint32_t) number_of_chunk_groups );
+
+	data_offset = sizeof( ewf_segment_files_index_entry_t );
+
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     element_index,
+		     &element_file_index,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from sections list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		index_section = (ewf_segment_files_index_section_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_section->offset,
+		 (uint64_t) element_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_section->size,
+		 element_size );
+
+		data_offset += sizeof( ewf_segment_files_index_section_t );
+	}
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->chunk_groups_list,
+		     element_index,
+		     &element_file_index,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunk groups list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_get_mapped_size_by_index(
+		     segment_file->chunk_groups_list,
+		     element_index,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size: %d from chunk groups list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		index_chunk_group = (ewf_segment_files_index_chunk_group_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->offset,
+		 (uint64_t) element_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->size,
+		 element_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 index_chunk_group->range_flags,
+		 element_flags );
+
+		data_offset += sizeof( ewf_segment_files_index_chunk_group_t );
+	}
+	return( 1 );
+}
+
+/* Reads the segment files index entry data
+ * The segment file values and the sections and chunk groups lists are restored from the data
+ * The data is only used if all the offsets and ranges it contains are within the segment file
+ * Returns 1 if successful, 0 if the data is not valid or -1 on error
+ */
+int libewf_segment_file_read_index_entry_data(
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     const uint8_t *data,
+     size_t data_size,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	ewf_segment_files_index_chunk_group_t *index_chunk_group = NULL;
+	ewf_segment_files_index_entry_t *index_entry             = NULL;
+	ewf_segment_files_index_section_t *index_section         = NULL;
+	static char *function                                    = "libewf_segment_file_read_index_entry_data";
+	size64_t element_size                                    = 0;
+	size64_t mapped_size                                     = 0;
+	size_t data_offset                                       = 0;
+	uint64_t value_64bit                                     = 0;
+	uint32_t element_flags                                   = 0;
+	uint32_t element_index                                   = 0;
+	uint32_t number_of_chunk_groups                          = 0;
+	uint32_t number_of_sections                              = 0;
+	uint32_t value_32bit                                     = 0;
+	int list_element_index                                   = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( ewf_segment_files_index_entry_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	index_entry = (ewf_segment_files_index_entry_t *) data;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 index_entry->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 index_entry->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	if( ( number_of_sections > (uint32_t) INT_MAX )
+	 || ( number_of_chunk_groups > (uint32_t) INT_MAX )
+	 || ( ( data_size - sizeof( ewf_segment_files_index_entry_t ) ) != ( ( (size_t) number_of_sections * sizeof( ewf_segment_files_index_section_t ) ) + ( (size_t) number_of_chunk_groups * sizeof( ewf_segment_files_index_chunk_group_t ) ) ) ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid number of sections or chunk groups value out of bounds.\n",
+			 function );
+		}
+#endif
+		return( 0 );
+	}
+	/* The index is stored outside the segment files hence the values are validated
+	 * before they are used, if any of them is out of bounds the entry is not used
+	 */
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->current_offset,
+	 value_64bit );
+
+	if( value_64bit > (uint64_t) segment_file_size )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid current offset value out of bounds.\n",
+			 function );
+		}
+#endif
+		return( 0 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->last_section_offset,
+	 value_64bit );
+
+	if( value_64bit >= (uint64_t) segment_file_size )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid last section offset value out of bounds.\n",
+			 function );
+		}
+#endif
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 index_entry->device_information_section_index,
+	 value_32bit );
+
+	if( ( value_32bit != 0xffffffffUL )
+	 && ( value_32bit >= number_of_sections ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid device information section index value out of bounds.\n",
+			 function );
+		}
+#endif
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 index_entry->current_chunk_group_index,
+	 value_32bit );
+
+	if( ( value_32bit != 0 )
+	 && ( value_32bit >= number_of_chunk_groups ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: invalid current chunk group index value out of bounds.\n",
+			 function );
+		}
+#endif
+		return( 0 );
+	}
+	data_offset = sizeof( ewf_segment_files_index_entry_t );
+
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
+	{
+		index_section = (ewf_segment_files_index_section_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_section->offset,
+		 value_64bit );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_section->size,
+		 element_size );
+
+		if( ( value_64bit > (uint64_t) segment_file_size )
+		 || ( element_size > ( (size64_t) segment_file_size - value_64bit ) ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: invalid section: %" PRIu32 " range value out of bounds.\n",
+				 function,
+				 element_index );
+			}
+#endif
+			return( 0 );
+		}
+		data_offset += sizeof( ewf_segment_files_index_section_t );
+	}
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
+	{
+		index_chunk_group = (ewf_segment_files_index_chunk_group_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->offset,
+		 value_64bit );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->size,
+		 element_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_chunk_group->range_flags,
+		 element_flags );
+
+		if( ( value_64bit > (uint64_t) segment_file_size )
+		 || ( element_size > ( (size64_t) segment_file_size - value_64bit ) )
+		 || ( ( element_flags & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED ) ) != 0 ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: invalid chunk group: %" PRIu32 " range value out of bounds.\n",
+				 function,
+				 element_index );
+			}
+#endif
+			return( 0 );
+		}
+		data_offset += sizeof( ewf_segment_files_index_chunk_group_t );
+	}
+	segment_file->flags = index_entry->flags | LIBEWF_SEGMENT_FILE_FLAG_READ_FROM_INDEX;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->current_offset,
+	 value_64bit );
+
+	segment_file->current_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->last_section_offset,
+	 value_64bit );
+
+	segment_file->last_section_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 index_entry->device_information_section_index,
+	 value_32bit );
+
+	segment_file->device_information_section_index = (int) value_32bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->storage_media_size,
+	 segment_file->storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->number_of_chunks,
+	 segment_file->number_of_chunks );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->previous_last_chunk_filled,
+	 value_64bit );
+
+	segment_file->previous_last_chunk_filled = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->last_chunk_filled,
+	 value_64bit );
+
+	segment_file->last_chunk_filled = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->last_chunk_compared,
+	 value_64bit );
+
+	segment_file->last_chunk_compared = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 index_entry->current_chunk_group_index,
+	 value_32bit );
+
+	segment_file->current_chunk_group_index = (int) value_32bit;
+
+	data_offset = sizeof( ewf_segment_files_index_entry_t );
+
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
+	{
+		index_section = (ewf_segment_files_index_section_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_section->offset,
+		 value_64bit );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_section->size,
+		 element_size );
+
+		if( libfdata_list_append_element(
+		     segment_file->sections_list,
+		     &list_element_index,
+		     file_io_pool_entry,
+		     (off64_t) value_64bit,
+		     element_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %" PRIu32 " to sections list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		data_offset += sizeof( ewf_segment_files_index_section_t );
+	}
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
+	{
+		index_chunk_group = (ewf_segment_files_index_chunk_group_t *) &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->offset,
+		 value_64bit );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->size,
+		 element_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_chunk_group->range_flags,
+		 element_flags );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     &list_element_index,
+		     file_io_pool_entry,
+		     (off64_t) value_64bit,
+		     element_size,
+		     element_flags,
+		     mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %" PRIu32 " to chunk groups list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		data_offset += sizeof( ewf_segment_files_index_chunk_group_t );
+	}
+	return( 1 );
+}
+
+/* Restores the sections and chunk groups of the segment file from the segment files index
+ * The index entry is only used if the segment file size, the file header values
+ * and the last section descriptor in the segment file match the entry
+ * Returns 1 if successful, 0 if no matching entry is available or -1 on error
+ */
+int libewf_segment_file_read_index_entry_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libewf_segment_files_index_t *segment_files_index,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	ewf_segment_files_index_entry_t *index_entry    = NULL;
+	const uint8_t *data                             = NULL;
+	static char *function                           = "libewf_segment_file_read_index_entry_file_io_pool";
+	size_t data_size                                = 0;
+	ssize_t read_count                              = 0;
+	uint64_t last_section_data_size                 = 0;
+	uint64_t last_section_end_offset                = 0;
+	uint64_t last_section_offset                    = 0;
+	uint64_t stored_segment_file_size               = 0;
+	uint32_t last_section_type                      = 0;
+	uint16_t compression_method                     = 0;
+	int result                                      = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_files_index_get_entry_data(
+	          segment_files_index,
+	          segment_file->segment_number,
+	          &data,
+	          &data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment files index entry: %" PRIu32 " data.",
+		 function,
+		 segment_file->segment_number );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( data_size < sizeof( ewf_segment_files_index_entry_t ) )
+	{
+		return( 0 );
+	}
+	index_entry = (ewf_segment_files_index_entry_t *) data;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->segment_file_size,
+	 stored_segment_file_size );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 index_entry->compression_method,
+	 compression_method );
+
+	if( ( stored_segment_file_size != (uint64_t) segment_file_size )
+	 || ( index_entry->type != segment_file->type )
+	 || ( index_entry->major_version != segment_file->major_version )
+	 || ( index_entry->minor_version != segment_file->minor_version )
+	 || ( compression_method != segment_file->compression_method )
+	 || ( memory_compare(
+	       index_entry->set_identifier,
+	       segment_file->set_identifier,
+	       16 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->last_section_offset,
+	 last_section_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->last_section_end_offset,
+	 last_section_end_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_entry->last_section_data_size,
+	 last_section_data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 index_entry->last_section_type,
+	 last_section_type );
+
+	if( ( last_section_offset == 0 )
+	 || ( last_section_offset >= (uint64_t) segment_file_size ) )
+	{
+		return( 0 );
+	}
+	/* Read the last section descriptor to detect segment files that were modified
+	 * without changing their size
+	 */
+	if( libewf_section_descriptor_initialize(
+	     &section_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_section_descriptor_read_file_io_pool(
+	              section_descriptor,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              (off64_t) last_section_offset,
+	              segment_file->major_version,
+	              error );
+
+	if( read_count == -1 )
+	{
+		/* A section descriptor that cannot be read means the index entry is stale
+		 */
+		libcerror_error_free(
+		 error );
+
+		result = 0;
+	}
+	else if( ( section_descriptor->type != last_section_type )
+	      || ( (uint64_t) section_descriptor->end_offset != last_section_end_offset )
+	      || ( (uint64_t) section_descriptor->data_size != last_section_data_size ) )
+	{
+		result = 0;
+	}
+	if( libewf_section_descriptor_free(
+	     &section_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free section descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: segment files index entry: %" PRIu32 " is stale.\n",
+			 function,
+			 segment_file->segment_number );
+		}
+#endif
+		return( 0 );
+	}
+	/* An index entry with values that are out of bounds is handled as if no entry
+	 * is available, so the segment file is scanned instead
+	 */
+	result = libewf_segment_file_read_index_entry_data(
+	          segment_file,
+	          segment_file_size,
+	          data,
+	          data_size,
+	          file_io_pool_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files index entry: %" PRIu32 " data.",
+		 function,
+		 segment_file->segment_number );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Stores the sections and chunk groups of the segment file in the segment files index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_write_index_entry_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libewf_segment_files_index_t *segment_files_index,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	uint8_t *data                                   = NULL;
+	static char *function                           = "libewf_segment_file_write_index_entry_file_io_pool";
+	size_t data_size                                = 0;
+	ssize_t read_count                              = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_section_descriptor_initialize(
+	     &section_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_section_descriptor_read_file_io_pool(
+	              section_descriptor,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              segment_file->last_section_offset,
+	              segment_file->major_version,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read last section descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_get_index_entry_data_size(
+	     segment_file,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index entry data size.",
+		 function );
+
+		goto on_error;
+	}
+	if( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index entry data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index entry data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_write_index_entry_data(
+	     segment_file,
+	     segment_file_size,
+	     section_descriptor,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index entry data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_files_index_set_entry_data(
+	     segment_files_index,
+	     segment_file->segment_number,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment files index entry: %" PRIu32 " data.",
+		 function,
+		 segment_file->segment_number );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	if( libewf_section_descriptor_free(
+	     &section_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free section descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the segment file header, section descriptors and sector tables
+ * The segment file must be initialized with the IO handle
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *segment_file_cache,
      int file_io_pool_entry,
-     off64_t segment_file_offset,
      size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
+	libewf_io_handle_t *io_handle                   = NULL;
 	libewf_section_descriptor_t *section_descriptor = NULL;
-	libewf_segment_file_t *segment_file             = NULL;
 	libfcache_cache_t *sections_cache               = NULL;
-	static char *function                           = "libewf_segment_file_read_element_data";
+	static char *function                           = "libewf_segment_file_read_file_io_pool";
 	ssize_t read_count                              = 0;
 	off64_t section_data_offset                     = 0;
+	off64_t segment_file_offset                     = 0;
 	int element_index                               = 0;
 	int last_section                                = 0;
 	int number_of_sections                          = 0;
 	int result                                      = 0;
 	int section_index                               = 0;
 
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
-
-	if( io_handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
-	     error ) != 1 )
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
+	io_handle = segment_file->io_handle;
+
 	if( segment_file_size == 0 )
 	{
 		/* segment_file_size is 0 on write correction
@@ -6257,126 +7363,114 @@ int libewf_segment_file_read_element_data(
 			goto on_error;
 		}
 	}
-	/* Read the section descriptors:
-	 * EWF version 1 read from front to back
-	 * EWF version 2 read from back to front
-	 */
-	if( segment_file->major_version == 1 )
-	{
-		segment_file_offset = (off64_t) read_count;
-	}
-	else if( segment_file->major_version == 2 )
-	{
-		segment_file_offset = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
-	}
-	last_section = 0;
-
-	if( libewf_section_descriptor_initialize(
-	     &section_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create section descriptor.",
-		 function );
-
-		goto on_error;
-	}
-	while( ( segment_file_offset > 0 )
-	    && ( (size64_t) segment_file_offset < segment_file_size ) )
+	if( ( io_handle->segment_files_index != NULL )
+	 && ( io_handle->chunk_size != 0 ) )
 	{
-		read_count = libewf_section_descriptor_read_file_io_pool(
-			      section_descriptor,
-			      file_io_pool,
-			      file_io_pool_entry,
-			      segment_file_offset,
-			      segment_file->major_version,
-			      error );
+		result = libewf_segment_file_read_index_entry_file_io_pool(
+		          segment_file,
+		          io_handle->segment_files_index,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          segment_file_size,
+		          error );
 
-		if( read_count == -1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section descriptor.",
+			 "%s: unable to read segment files index entry.",
 			 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				if( ( error != NULL )
-				 && ( *error != NULL ) )
-				{
-					libcnotify_print_error_backtrace(
-					 *error );
-				}
-			}
-#endif
-			libcerror_error_free(
-			 error );
-
-			segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
-
-			break;
+			goto on_error;
 		}
-		segment_file->current_offset = segment_file_offset + read_count;
-
+	}
+	if( result == 0 )
+	{
+		/* Read the section descriptors:
+		 * EWF version 1 read from front to back
+		 * EWF version 2 read from back to front
+		 */
 		if( segment_file->major_version == 1 )
 		{
-			if( section_descriptor->type == LIBEWF_SECTION_TYPE_NEXT )
-			{
-				last_section = 1;
-			}
-			else if( section_descriptor->type == LIBEWF_SECTION_TYPE_DONE )
-			{
-				last_section = 1;
+			segment_file_offset = (off64_t) read_count;
+		}
+		else if( segment_file->major_version == 2 )
+		{
+			segment_file_offset = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
+		}
+		last_section = 0;
 
-				segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_LAST;
-			}
-			segment_file->last_section_offset = segment_file_offset;
+		if( libewf_section_descriptor_initialize(
+		     &section_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create section descriptor.",
+			 function );
 
-			if( libfdata_list_append_element(
-			     segment_file->sections_list,
-			     &element_index,
-			     file_io_pool_entry,
-			     segment_file_offset,
-			     sizeof( ewf_section_descriptor_v1_t ),
-			     0,
-			     error ) != 1 )
+			goto on_error;
+		}
+		while( ( segment_file_offset > 0 )
+		    && ( (size64_t) segment_file_offset < segment_file_size ) )
+		{
+			read_count = libewf_section_descriptor_read_file_io_pool(
+				      section_descriptor,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      segment_file_offset,
+				      segment_file->major_version,
+				      error );
+
+			if( read_count == -1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append element to sections list.",
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section descriptor.",
 				 function );
 
-				goto on_error;
-			}
-			segment_file_offset += section_descriptor->size;
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
 
-/* TODO move into section descriptor read ? */
-			if( ( last_section != 0 )
-			 && ( section_descriptor->size == 0 ) )
-			{
-				segment_file_offset += sizeof( ewf_section_descriptor_v1_t );
-			}
-		}
-		else if( segment_file->major_version == 2 )
-		{
-			if( section_descriptor->type == LIBEWF_SECTION_TYPE_DEVICE_INFORMATION )
-			{
-				segment_file->device_information_section_index = section_index;
+				segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
+
+				break;
 			}
-			if( section_descriptor->type == LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS )
+			segment_file->current_offset = segment_file_offset + read_count;
+
+			if( ( section_descriptor->type != LIBEWF_SECTION_TYPE_SECTOR_DATA )
+			 && ( section_descriptor->type != LIBEWF_SECTION_TYPE_SECTOR_TABLE )
+			 && ( section_descriptor->type != LIBEWF_SECTION_TYPE_NEXT )
+			 && ( section_descriptor->type != LIBEWF_SECTION_TYPE_DONE ) )
 			{
-				segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED;
-/* TODO get key info ? */
+				if( ( segment_file->major_version != 1 )
+				 || ( section_descriptor->type_string_length != 6 )
+				 || ( memory_compare(
+				       (void *) section_descriptor->type_string,
+				       (void *) "table2",
+				       6 ) != 0 ) )
+				{
+					segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_HAS_METADATA_SECTIONS;
+				}
 			}
-			if( segment_file->last_section_offset == 0 )
+			if( segment_file->major_version == 1 )
 			{
 				if( section_descriptor->type == LIBEWF_SECTION_TYPE_NEXT )
 				{
@@ -6389,299 +7483,455 @@ int libewf_segment_file_read_element_data(
 					segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_LAST;
 				}
 				segment_file->last_section_offset = segment_file_offset;
-			}
-			if( libfdata_list_append_element(
-			     segment_file->sections_list,
-			     &element_index,
-			     file_io_pool_entry,
-			     segment_file_offset,
-			     sizeof( ewf_section_descriptor_v2_t ),
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append element to sections list.",
-				 function );
-
-				goto on_error;
-			}
-			segment_file_offset -= section_descriptor->size;
-		}
-		section_index++;
-
-		if( ( segment_file->major_version == 1 )
-		 && ( last_section != 0 ) )
-		{
-			break;
-		}
-	}
-	number_of_sections = section_index;
 
-	if( libewf_section_descriptor_free(
-	     &section_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free section.",
-		 function );
+				if( libfdata_list_append_element(
+				     segment_file->sections_list,
+				     &element_index,
+				     file_io_pool_entry,
+				     segment_file_offset,
+				     sizeof( ewf_section_descriptor_v1_t ),
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append element to sections list.",
+					 function );
 
-		goto on_error;
-	}
-	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) == 0 )
-	{
-		if( last_section == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing next or done section.",
-			 function );
+					goto on_error;
+				}
+				segment_file_offset += section_descriptor->size;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				if( ( error != NULL )
-				 && ( *error != NULL ) )
+/* TODO move into section descriptor read ? */
+				if( ( last_section != 0 )
+				 && ( section_descriptor->size == 0 ) )
 				{
-					libcnotify_print_error_backtrace(
-					 *error );
+					segment_file_offset += sizeof( ewf_section_descriptor_v1_t );
 				}
 			}
-#endif
-			libcerror_error_free(
-			 error );
+			else if( segment_file->major_version == 2 )
+			{
+				if( section_descriptor->type == LIBEWF_SECTION_TYPE_DEVICE_INFORMATION )
+				{
+					segment_file->device_information_section_index = section_index;
+				}
+				if( section_descriptor->type == LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS )
+				{
+					segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED;
+/* TODO get key info ? */
+				}
+				if( segment_file->last_section_offset == 0 )
+				{
+					if( section_descriptor->type == LIBEWF_SECTION_TYPE_NEXT )
+					{
+						last_section = 1;
+					}
+					else if( section_descriptor->type == LIBEWF_SECTION_TYPE_DONE )
+					{
+						last_section = 1;
 
-			segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		else if( libcnotify_verbose != 0 )
-		{
-			if( (size64_t) segment_file_offset < segment_file_size )
+						segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_LAST;
+					}
+					segment_file->last_section_offset = segment_file_offset;
+				}
+				if( libfdata_list_append_element(
+				     segment_file->sections_list,
+				     &element_index,
+				     file_io_pool_entry,
+				     segment_file_offset,
+				     sizeof( ewf_section_descriptor_v2_t ),
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append element to sections list.",
+					 function );
+
+					goto on_error;
+				}
+				segment_file_offset -= section_descriptor->size;
+			}
+			section_index++;
+
+			if( ( segment_file->major_version == 1 )
+			 && ( last_section != 0 ) )
 			{
-				libcnotify_printf(
-				 "%s: trailing data in segment file: %" PRIu16 "\n",
-				 function,
-				 segment_file->segment_number );
+				break;
 			}
 		}
-#endif
-	}
-	if( segment_file->major_version == 2 )
-	{
-		/* Reversing the list after the last append is more efficient than using prepend
-		 */
-		if( libfdata_list_reverse(
-		     segment_file->sections_list,
+		number_of_sections = section_index;
+
+		if( libewf_section_descriptor_free(
+		     &section_descriptor,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to reverse sections list.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free section.",
 			 function );
 
 			goto on_error;
 		}
-		if( segment_file->device_information_section_index != -1 )
-		{
-			segment_file->device_information_section_index = ( section_index - 1 )
-			                                               - segment_file->device_information_section_index;
-		}
-	}
-	if( io_handle->chunk_size != 0 )
-	{
-		if( libfcache_cache_initialize(
-		     &sections_cache,
-		     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
-		     error ) != 1 )
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create section descriptor cache.",
-			 function );
+			if( last_section == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing next or done section.",
+				 function );
 
-			goto on_error;
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+
+				segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			else if( libcnotify_verbose != 0 )
+			{
+				if( (size64_t) segment_file_offset < segment_file_size )
+				{
+					libcnotify_printf(
+					 "%s: trailing data in segment file: %" PRIu16 "\n",
+					 function,
+					 segment_file->segment_number );
+				}
+			}
+#endif
 		}
-		for( section_index = 0;
-		     section_index < number_of_sections;
-		     section_index++ )
+		if( segment_file->major_version == 2 )
 		{
-			if( libfdata_list_get_element_value_by_index(
+			/* Reversing the list after the last append is more efficient than using prepend
+			 */
+			if( libfdata_list_reverse(
 			     segment_file->sections_list,
-			     (intptr_t *) file_io_pool,
-			     (libfdata_cache_t *) sections_cache,
-			     section_index,
-			     (intptr_t **) &section_descriptor,
-			     0,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve section: %d from sections list.",
-				 function,
-				 section_index );
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to reverse sections list.",
+				 function );
 
 				goto on_error;
 			}
-			result = libewf_section_get_data_offset(
-			          section_descriptor,
-			          segment_file->major_version,
-			          &section_data_offset,
-			          error );
-
-			if( result == -1 )
+			if( segment_file->device_information_section_index != -1 )
+			{
+				segment_file->device_information_section_index = ( section_index - 1 )
+				                                               - segment_file->device_information_section_index;
+			}
+		}
+		if( io_handle->chunk_size != 0 )
+		{
+			if( libfcache_cache_initialize(
+			     &sections_cache,
+			     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve section: %d data offset.",
-				 function,
-				 section_index );
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create section descriptor cache.",
+				 function );
 
 				goto on_error;
 			}
-			if( section_descriptor->type == LIBEWF_SECTION_TYPE_SECTOR_TABLE )
+			for( section_index = 0;
+			     section_index < number_of_sections;
+			     section_index++ )
 			{
-				if( result == 0 )
+				if( libfdata_list_get_element_value_by_index(
+				     segment_file->sections_list,
+				     (intptr_t *) file_io_pool,
+				     (libfdata_cache_t *) sections_cache,
+				     section_index,
+				     (intptr_t **) &section_descriptor,
+				     0,
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing section: %d data offset.",
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve section: %d from sections list.",
 					 function,
 					 section_index );
 
 					goto on_error;
 				}
-				if( libewf_segment_file_seek_offset(
-				     segment_file,
-				     file_io_pool,
-				     file_io_pool_entry,
-				     section_data_offset,
-				     error ) == -1 )
+				result = libewf_section_get_data_offset(
+				          section_descriptor,
+				          segment_file->major_version,
+				          &section_data_offset,
+				          error );
+
+				if( result == -1 )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_OPEN_FAILED,
-					 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve section: %d data offset.",
 					 function,
-					 section_index,
-					 section_data_offset );
+					 section_index );
 
 					goto on_error;
 				}
-				read_count = libewf_segment_file_read_table_section(
-					      segment_file,
-					      section_descriptor,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      io_handle->chunk_size,
-					      error );
-
-				if( read_count == -1 )
+				if( section_descriptor->type == LIBEWF_SECTION_TYPE_SECTOR_TABLE )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read section: 0x%08" PRIx32 ".",
-					 function,
-					 section_descriptor->type );
+					if( result == 0 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+						 "%s: missing section: %d data offset.",
+						 function,
+						 section_index );
 
-					section_descriptor = NULL;
+						goto on_error;
+					}
+					if( libewf_segment_file_seek_offset(
+					     segment_file,
+					     file_io_pool,
+					     file_io_pool_entry,
+					     section_data_offset,
+					     error ) == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_OPEN_FAILED,
+						 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+						 function,
+						 section_index,
+						 section_data_offset );
 
-					goto on_error;
+						goto on_error;
+					}
+					read_count = libewf_segment_file_read_table_section(
+						      segment_file,
+						      section_descriptor,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      io_handle->chunk_size,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read section: 0x%08" PRIx32 ".",
+						 function,
+						 section_descriptor->type );
+
+						section_descriptor = NULL;
+
+						goto on_error;
+					}
 				}
-			}
-			else if( ( segment_file->major_version == 1 )
-			      && ( ( section_descriptor->type_string_length == 6 )
-			      && ( memory_compare(
-			            (void *) section_descriptor->type_string,
-			            (void *) "table2",
-			            6 ) == 0 ) ) )
-			{
-				if( result == 0 )
+				else if( ( segment_file->major_version == 1 )
+				      && ( ( section_descriptor->type_string_length == 6 )
+				      && ( memory_compare(
+				            (void *) section_descriptor->type_string,
+				            (void *) "table2",
+				            6 ) == 0 ) ) )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing section: %d data offset.",
-					 function,
-					 section_index );
+					if( result == 0 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+						 "%s: missing section: %d data offset.",
+						 function,
+						 section_index );
 
-					goto on_error;
+						goto on_error;
+					}
+					if( libewf_segment_file_seek_offset(
+					     segment_file,
+					     file_io_pool,
+					     file_io_pool_entry,
+					     section_data_offset,
+					     error ) == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_OPEN_FAILED,
+						 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+						 function,
+						 section_index,
+						 section_data_offset );
+
+						goto on_error;
+					}
+					read_count = libewf_segment_file_read_table2_section(
+						      segment_file,
+						      section_descriptor,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read section: %s.",
+						 function,
+						 section_descriptor->type_string );
+
+						section_descriptor = NULL;
+
+						goto on_error;
+					}
 				}
-				if( libewf_segment_file_seek_offset(
+				section_descriptor = NULL;
+			}
+			if( libfcache_cache_free(
+			     &sections_cache,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sections cache.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( io_handle->segment_files_index != NULL )
+			 && ( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) == 0 ) )
+			{
+				if( libewf_segment_file_write_index_entry_file_io_pool(
 				     segment_file,
+				     io_handle->segment_files_index,
 				     file_io_pool,
 				     file_io_pool_entry,
-				     section_data_offset,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_OPEN_FAILED,
-					 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
-					 function,
-					 section_index,
-					 section_data_offset );
-
-					goto on_error;
-				}
-				read_count = libewf_segment_file_read_table2_section(
-					      segment_file,
-					      section_descriptor,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      error );
-
-				if( read_count == -1 )
+				     segment_file_size,
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read section: %s.",
-					 function,
-					 section_descriptor->type_string );
-
-					section_descriptor = NULL;
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write segment files index entry.",
+					 function );
 
 					goto on_error;
 				}
 			}
-			section_descriptor = NULL;
 		}
-		if( libfcache_cache_free(
-		     &sections_cache,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sections cache.",
-			 function );
+	}
+	return( 1 );
 
-			goto on_error;
-		}
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset LIBEWF_ATTRIBUTE_UNUSED,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+
+	LIBEWF_UNREFERENCED_PARAMETER( segment_file_offset )
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
 	}
 	if( libfdata_list_element_set_element_value(
 	     element,
@@ -6704,18 +7954,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
-	if( section_descriptor != NULL )
-	{
-		libewf_section_descriptor_free(
-		 &section_descriptor,
-		 NULL );
-	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
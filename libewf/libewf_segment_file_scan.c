@@ -0,0 +1,490 @@
+/*
+ * Segment file scan functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_file_scan.h"
+#include "libewf_unused.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a segment file scan
+ * Make sure the value segment_file_scan is referencing, is set to NULL
+ * The file IO handle of the segment file is cloned from the file IO pool
+ * This function is not multi-thread safe with other users of the file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_scan_initialize(
+     libewf_segment_file_scan_t **segment_file_scan,
+     libewf_io_handle_t *io_handle,
+     uint32_t segment_number,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle      = NULL;
+	libbfio_handle_t *scan_file_io_handle = NULL;
+	static char *function                 = "libewf_segment_file_scan_initialize";
+	int result                            = 0;
+
+	if( segment_file_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file scan.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file_scan != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file scan value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file IO pool entry value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	*segment_file_scan = memory_allocate_structure(
+	                      libewf_segment_file_scan_t );
+
+	if( *segment_file_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment file scan.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_file_scan,
+	     0,
+	     sizeof( libewf_segment_file_scan_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment file scan.",
+		 function );
+
+		memory_free(
+		 *segment_file_scan );
+
+		*segment_file_scan = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_handle_clone(
+	     &scan_file_io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create scan file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file IO handle is opened on demand when the segment file is read
+	 */
+	result = libbfio_handle_is_open(
+	          scan_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if scan file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libbfio_handle_close(
+		     scan_file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close scan file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The file IO handle is stored at the same pool entry so that the sections
+	 * and chunk groups of the segment file reference the correct pool entry
+	 */
+	if( libbfio_pool_initialize(
+	     &( ( *segment_file_scan )->file_io_pool ),
+	     file_io_pool_entry + 1,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     ( *segment_file_scan )->file_io_pool,
+	     file_io_pool_entry,
+	     scan_file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	( *segment_file_scan )->io_handle          = io_handle;
+	( *segment_file_scan )->segment_number     = segment_number;
+	( *segment_file_scan )->file_io_pool_entry = file_io_pool_entry;
+	( *segment_file_scan )->segment_file_size  = segment_file_size;
+
+	return( 1 );
+
+on_error:
+	if( scan_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &scan_file_io_handle,
+		 NULL );
+	}
+	if( *segment_file_scan != NULL )
+	{
+		if( ( *segment_file_scan )->file_io_pool != NULL )
+		{
+			libbfio_pool_free(
+			 &( ( *segment_file_scan )->file_io_pool ),
+			 NULL );
+		}
+		memory_free(
+		 *segment_file_scan );
+
+		*segment_file_scan = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment file scan
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_scan_free(
+     libewf_segment_file_scan_t **segment_file_scan,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_scan_free";
+	int result            = 1;
+
+	if( segment_file_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file scan.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file_scan != NULL )
+	{
+		/* The io_handle reference is freed elsewhere
+		 */
+		if( ( *segment_file_scan )->file_io_pool != NULL )
+		{
+			if( libbfio_pool_free(
+			     &( ( *segment_file_scan )->file_io_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *segment_file_scan )->segment_file != NULL )
+		{
+			if( libewf_segment_file_free(
+			     &( ( *segment_file_scan )->segment_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *segment_file_scan );
+
+		*segment_file_scan = NULL;
+	}
+	return( result );
+}
+
+/* Reads the segment file
+ * The file IO handle of the segment file is closed after reading
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_scan_read(
+     libewf_segment_file_scan_t *segment_file_scan,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_scan_read";
+
+	if( segment_file_scan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file scan.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_scan->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file scan - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_scan->segment_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file scan - segment file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     segment_file_scan->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     segment_file_scan->file_io_pool,
+	     segment_file_scan->file_io_pool_entry,
+	     segment_file_scan->segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_scan->segment_number );
+
+		goto on_error;
+	}
+	/* Close the file IO handle so that the number of open handles
+	 * is bounded by the number of scan threads
+	 */
+	if( libbfio_pool_close_all(
+	     segment_file_scan->file_io_pool,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	segment_file_scan->segment_file = segment_file;
+
+	return( 1 );
+
+on_error:
+	libbfio_pool_close_all(
+	 segment_file_scan->file_io_pool,
+	 NULL );
+
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Processes a segment file scan
+ * Callback for the segment file scan thread pool
+ * Scanning is best effort, errors are left to be reported when the segment file is read again
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_scan_process_callback(
+     libewf_segment_file_scan_t *segment_file_scan,
+     void *arguments LIBEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_segment_file_scan_process_callback";
+
+	LIBEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( libewf_segment_file_scan_read(
+	     segment_file_scan,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to scan segment file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,99 @@
+/*
+ * Segment file scan functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_FILE_SCAN_H )
+#define _LIBEWF_SEGMENT_FILE_SCAN_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_segment_file.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_segment_file_scan libewf_segment_file_scan_t;
+
+/* The segment file scan reads the section descriptors and sector tables of a segment file
+ * using its own file IO handle, so that multiple segment files can be scanned concurrently
+ */
+struct libewf_segment_file_scan
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The file IO pool that only contains the file IO handle of the segment file
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The segment file, set if the scan was successful
+	 */
+	libewf_segment_file_t *segment_file;
+};
+
+int libewf_segment_file_scan_initialize(
+     libewf_segment_file_scan_t **segment_file_scan,
+     libewf_io_handle_t *io_handle,
+     uint32_t segment_number,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_scan_free(
+     libewf_segment_file_scan_t **segment_file_scan,
+     libcerror_error_t **error );
+
+int libewf_segment_file_scan_read(
+     libewf_segment_file_scan_t *segment_file_scan,
+     libcerror_error_t **error );
+
+int libewf_segment_file_scan_process_callback(
+     libewf_segment_file_scan_t *segment_file_scan,
+     void *arguments );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_FILE_SCAN_H ) */
+
@@ -0,0 +1,1514 @@
+/*
+ * Segment files index functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_files_index.h"
+
+#include "ewf_segment_files_index.h"
+
+const uint8_t ewf_segment_files_index_signature[ 8 ] = { 'E', 'W', 'F', 'I', 'D', 'X', 0x0d, 0x0a };
+
+/* Creates a segment files index entry
+ * Make sure the value segment_files_index_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_entry_initialize(
+     libewf_segment_files_index_entry_t **segment_files_index_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_files_index_entry_initialize";
+
+	if( segment_files_index_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_files_index_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment files index entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_files_index_entry = memory_allocate_structure(
+	                              libewf_segment_files_index_entry_t );
+
+	if( *segment_files_index_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment files index entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_files_index_entry,
+	     0,
+	     sizeof( libewf_segment_files_index_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment files index entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *segment_files_index_entry != NULL )
+	{
+		memory_free(
+		 *segment_files_index_entry );
+
+		*segment_files_index_entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment files index entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_entry_free(
+     libewf_segment_files_index_entry_t **segment_files_index_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_files_index_entry_free";
+
+	if( segment_files_index_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_files_index_entry != NULL )
+	{
+		if( ( *segment_files_index_entry )->data != NULL )
+		{
+			memory_free(
+			 ( *segment_files_index_entry )->data );
+		}
+		memory_free(
+		 *segment_files_index_entry );
+
+		*segment_files_index_entry = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates a segment files index
+ * Make sure the value segment_files_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_initialize(
+     libewf_segment_files_index_t **segment_files_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_files_index_initialize";
+
+	if( segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_files_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment files index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_files_index = memory_allocate_structure(
+	                        libewf_segment_files_index_t );
+
+	if( *segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment files index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_files_index,
+	     0,
+	     sizeof( libewf_segment_files_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment files index.",
+		 function );
+
+		memory_free(
+		 *segment_files_index );
+
+		*segment_files_index = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *segment_files_index )->entries_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create entries array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *segment_files_index )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *segment_files_index != NULL )
+	{
+		if( ( *segment_files_index )->entries_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *segment_files_index )->entries_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *segment_files_index );
+
+		*segment_files_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment files index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_free(
+     libewf_segment_files_index_t **segment_files_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_files_index_free";
+	int result            = 1;
+
+	if( segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_files_index != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *segment_files_index )->entries_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_files_index_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries array.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *segment_files_index )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *segment_files_index );
+
+		*segment_files_index = NULL;
+	}
+	return( result );
+}
+
+/* Empties a segment files index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_empty(
+     libewf_segment_files_index_t *segment_files_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_files_index_empty";
+
+	if( segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_empty(
+	     segment_files_index->entries_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_files_index_entry_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty entries array.",
+		 function );
+
+		return( -1 );
+	}
+	segment_files_index->number_of_entries = 0;
+	segment_files_index->is_modified       = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the entry data of a specific segment number
+ * The data remains valid until the entry of the segment number is set again
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_segment_files_index_get_entry_data(
+     libewf_segment_files_index_t *segment_files_index,
+     uint32_t segment_number,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_segment_files_index_entry_t *segment_files_index_entry = NULL;
+	static char *function                                         = "libewf_segment_files_index_get_entry_data";
+	int number_of_array_entries                                   = 0;
+	int result                                                    = 0;
+
+	if( segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_number == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     segment_files_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     segment_files_index->entries_array,
+	     &number_of_array_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		result = -1;
+	}
+	else if( (int64_t) segment_number <= (int64_t) number_of_array_entries )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     segment_files_index->entries_array,
+		     (int) ( segment_number - 1 ),
+		     (intptr_t **) &segment_files_index_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %" PRIu32 ".",
+			 function,
+			 segment_number - 1 );
+
+			result = -1;
+		}
+		else if( segment_files_index_entry != NULL )
+		{
+			*data      = segment_files_index_entry->data;
+			*data_size = segment_files_index_entry->data_size;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     segment_files_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the entry data of a specific segment number
+ * The data is copied
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_set_entry_data(
+     libewf_segment_files_index_t *segment_files_index,
+     uint32_t segment_number,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_segment_files_index_entry_t *existing_entry            = NULL;
+	libewf_segment_files_index_entry_t *segment_files_index_entry = NULL;
+	static char *function                                         = "libewf_segment_files_index_set_entry_data";
+	int number_of_array_entries                                   = 0;
+	int result                                                    = 1;
+
+	if( segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_number == 0 )
+	 || ( segment_number > (uint32_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_files_index_entry_initialize(
+	     &segment_files_index_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment files index entry.",
+		 function );
+
+		goto on_error;
+	}
+	segment_files_index_entry->data = (uint8_t *) memory_allocate(
+	                                               sizeof( uint8_t ) * data_size );
+
+	if( segment_files_index_entry->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     segment_files_index_entry->data,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy entry data.",
+		 function );
+
+		goto on_error;
+	}
+	segment_files_index_entry->segment_number = segment_number;
+	segment_files_index_entry->data_size      = data_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     segment_files_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     segment_files_index->entries_array,
+	     &number_of_array_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		result = -1;
+	}
+	else if( (int64_t) segment_number > (int64_t) number_of_array_entries )
+	{
+		if( libcdata_array_resize(
+		     segment_files_index->entries_array,
+		     (int) segment_number,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_files_index_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize entries array.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     segment_files_index->entries_array,
+		     (int) ( segment_number - 1 ),
+		     (intptr_t **) &existing_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %" PRIu32 ".",
+			 function,
+			 segment_number - 1 );
+
+			result = -1;
+		}
+		else if( libcdata_array_set_entry_by_index(
+		          segment_files_index->entries_array,
+		          (int) ( segment_number - 1 ),
+		          (intptr_t *) segment_files_index_entry,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set entry: %" PRIu32 ".",
+			 function,
+			 segment_number - 1 );
+
+			existing_entry = NULL;
+			result         = -1;
+		}
+		else
+		{
+			segment_files_index_entry = NULL;
+
+			if( existing_entry == NULL )
+			{
+				segment_files_index->number_of_entries += 1;
+			}
+			segment_files_index->is_modified = 1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     segment_files_index->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* The replaced entry is freed outside the lock
+	 */
+	if( existing_entry != NULL )
+	{
+		if( libewf_segment_files_index_entry_free(
+		     &existing_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free existing segment files index entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( existing_entry != NULL )
+	{
+		libewf_segment_files_index_entry_free(
+		 &existing_entry,
+		 NULL );
+	}
+	if( segment_files_index_entry != NULL )
+	{
+		libewf_segment_files_index_entry_free(
+		 &segment_files_index_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the segment files index
+ * Returns 1 if successful, 0 if the data does not contain a valid segment files index or -1 on error
+ */
+int libewf_segment_files_index_read_data(
+     libewf_segment_files_index_t *segment_files_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_segment_files_index_read_data";
+	size_t data_offset           = 0;
+	uint64_t entries_data_size   = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t entry_index         = 0;
+	uint32_t entry_size          = 0;
+	uint32_t format_version      = 0;
+	uint32_t number_of_entries   = 0;
+	uint32_t segment_number      = 0;
+	uint32_t stored_checksum     = 0;
+
+	if( segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( ewf_segment_files_index_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_files_index_empty(
+	     segment_files_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (ewf_segment_files_index_header_t *) data )->signature,
+	     ewf_segment_files_index_signature,
+	     8 ) != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unsupported signature.\n",
+			 function );
+		}
+#endif
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_files_index_header_t *) data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_files_index_header_t *) data )->number_of_entries,
+	 number_of_entries );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_segment_files_index_header_t *) data )->entries_data_size,
+	 entries_data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_files_index_header_t *) data )->checksum,
+	 stored_checksum );
+
+	if( format_version != LIBEWF_SEGMENT_FILES_INDEX_FORMAT_VERSION )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unsupported format version: %" PRIu32 ".\n",
+			 function,
+			 format_version );
+		}
+#endif
+		return( 0 );
+	}
+	data_offset = sizeof( ewf_segment_files_index_header_t );
+
+	if( entries_data_size != (uint64_t) ( data_size - data_offset ) )
+	{
+		return( 0 );
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     &( data[ data_offset ] ),
+	     (size_t) entries_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: mismatch in checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).\n",
+			 function,
+			 stored_checksum,
+			 calculated_checksum );
+		}
+#endif
+		return( 0 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( ( data_size - data_offset ) < sizeof( ewf_segment_files_index_entry_t ) )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_segment_files_index_entry_t *) &( data[ data_offset ] ) )->entry_size,
+		 entry_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_segment_files_index_entry_t *) &( data[ data_offset ] ) )->segment_number,
+		 segment_number );
+
+		if( ( entry_size < sizeof( ewf_segment_files_index_entry_t ) )
+		 || ( (size_t) entry_size > ( data_size - data_offset ) )
+		 || ( segment_number == 0 )
+		 || ( segment_number > (uint32_t) INT_MAX ) )
+		{
+			break;
+		}
+		if( libewf_segment_files_index_set_entry_data(
+		     segment_files_index,
+		     segment_number,
+		     &( data[ data_offset ] ),
+		     (size_t) entry_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set entry: %" PRIu32 " data.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		data_offset += entry_size;
+	}
+	if( ( entry_index != number_of_entries )
+	 || ( data_offset != data_size ) )
+	{
+		if( libewf_segment_files_index_empty(
+		     segment_files_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty segment files index.",
+			 function );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	segment_files_index->is_modified = 0;
+
+	return( 1 );
+
+on_error:
+	libewf_segment_files_index_empty(
+	 segment_files_index,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the size of the segment files index data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_get_data_size(
+     libewf_segment_files_index_t *segment_files_index,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_segment_files_index_entry_t *segment_files_index_entry = NULL;
+	static char *function                                         = "libewf_segment_files_index_get_data_size";
+	size_t safe_data_size                                         = 0;
+	int entry_index                                               = 0;
+	int number_of_array_entries                                   = 0;
+
+	if( segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_files_index->entries_array,
+	     &number_of_array_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	safe_data_size = sizeof( ewf_segment_files_index_header_t );
+
+	for( entry_index = 0;
+	     entry_index < number_of_array_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     segment_files_index->entries_array,
+		     entry_index,
+		     (intptr_t **) &segment_files_index_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( segment_files_index_entry != NULL )
+		{
+			safe_data_size += segment_files_index_entry->data_size;
+		}
+	}
+	*data_size = safe_data_size;
+
+	return( 1 );
+}
+
+/* Writes the segment files index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_write_data(
+     libewf_segment_files_index_t *segment_files_index,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_segment_files_index_entry_t *segment_files_index_entry = NULL;
+	static char *function                                         = "libewf_segment_files_index_write_data";
+	size_t data_offset                                            = 0;
+	size_t required_data_size                                     = 0;
+	uint32_t checksum                                             = 0;
+	int entry_index                                               = 0;
+	int number_of_array_entries                                   = 0;
+
+	if( libewf_segment_files_index_get_data_size(
+	     segment_files_index,
+	     &required_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < required_data_size )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_files_index->entries_array,
+	     &number_of_array_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = sizeof( ewf_segment_files_index_header_t );
+
+	for( entry_index = 0;
+	     entry_index < number_of_array_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     segment_files_index->entries_array,
+		     entry_index,
+		     (intptr_t **) &segment_files_index_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( segment_files_index_entry == NULL )
+		{
+			continue;
+		}
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     segment_files_index_entry->data,
+		     segment_files_index_entry->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy entry: %d data.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		data_offset += segment_files_index_entry->data_size;
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     &( data[ sizeof( ewf_segment_files_index_header_t ) ] ),
+	     data_offset - sizeof( ewf_segment_files_index_header_t ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( ewf_segment_files_index_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( (ewf_segment_files_index_header_t *) data )->signature,
+	     ewf_segment_files_index_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_files_index_header_t *) data )->format_version,
+	 LIBEWF_SEGMENT_FILES_INDEX_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_files_index_header_t *) data )->number_of_entries,
+	 (uint32_t) segment_files_index->number_of_entries );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_segment_files_index_header_t *) data )->entries_data_size,
+	 (uint64_t) ( data_offset - sizeof( ewf_segment_files_index_header_t ) ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_files_index_header_t *) data )->checksum,
+	 checksum );
+
+	return( 1 );
+}
+
+/* Reads the segment files index from a file
+ * Returns 1 if successful, 0 if the file does not exist or does not contain a valid segment files index or -1 on error
+ */
+int libewf_segment_files_index_read_file_io_handle(
+     libewf_segment_files_index_t *segment_files_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "libewf_segment_files_index_read_file_io_handle";
+	size64_t file_size    = 0;
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( segment_files_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment files index.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file exists.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	result = 0;
+
+	if( ( file_size >= (size64_t) sizeof( ewf_segment_files_index_header_t ) )
+	 && ( file_size <= (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		data = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * (size_t) file_size );
+
+		if( data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              data,
+		              (size_t) file_size,
+		              0,
+		              error );
+
+		if( read_count != (ssize_t) file_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: 0 (0x00000000).",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_segment_files_index_read_data(
+		          segment_files_index,
+		          data,
+		          (size_t) file_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment files index.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 data );
+
+		data = NULL;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	libbfio_handle_close(
+	 file_io_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Writes the segment files index to a file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_files_index_write_file_io_handle(
+     libewf_segment_files_index_t *segment_files_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "libewf_segment_files_index_write_file_io_handle";
+	size_t data_size      = 0;
+	ssize_t write_count   = 0;
+
+	if( libewf_segment_files_index_get_data_size(
+	     segment_files_index,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_files_index_write_data(
+	     segment_files_index,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment files index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               file_io_handle,
+	               data,
+	               data_size,
+	               0,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data at offset: 0 (0x00000000).",
+		 function );
+
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	segment_files_index->is_modified = 0;
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,153 @@
+/*
+ * Segment files index functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_FILES_INDEX_H )
+#define _LIBEWF_SEGMENT_FILES_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The segment files index format version
+ */
+#define LIBEWF_SEGMENT_FILES_INDEX_FORMAT_VERSION	1
+
+extern const uint8_t ewf_segment_files_index_signature[ 8 ];
+
+typedef struct libewf_segment_files_index_entry libewf_segment_files_index_entry_t;
+
+struct libewf_segment_files_index_entry
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The entry data
+	 */
+	uint8_t *data;
+
+	/* The entry data size
+	 */
+	size_t data_size;
+};
+
+typedef struct libewf_segment_files_index libewf_segment_files_index_t;
+
+/* The segment files index stores the sections and chunk groups of the segment files
+ * so that a set of segment files can be opened without reading all the section descriptors
+ * and tables again
+ */
+struct libewf_segment_files_index
+{
+	/* The entries array, indexed by segment number - 1
+	 */
+	libcdata_array_t *entries_array;
+
+	/* The number of entries that are set
+	 */
+	int number_of_entries;
+
+	/* Value to indicate the index was modified
+	 */
+	uint8_t is_modified;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock, guards the entries when segment files are scanned concurrently
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libewf_segment_files_index_entry_initialize(
+     libewf_segment_files_index_entry_t **segment_files_index_entry,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_entry_free(
+     libewf_segment_files_index_entry_t **segment_files_index_entry,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_initialize(
+     libewf_segment_files_index_t **segment_files_index,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_free(
+     libewf_segment_files_index_t **segment_files_index,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_empty(
+     libewf_segment_files_index_t *segment_files_index,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_get_entry_data(
+     libewf_segment_files_index_t *segment_files_index,
+     uint32_t segment_number,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_set_entry_data(
+     libewf_segment_files_index_t *segment_files_index,
+     uint32_t segment_number,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_read_data(
+     libewf_segment_files_index_t *segment_files_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_get_data_size(
+     libewf_segment_files_index_t *segment_files_index,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_write_data(
+     libewf_segment_files_index_t *segment_files_index,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_read_file_io_handle(
+     libewf_segment_files_index_t *segment_files_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_files_index_write_file_io_handle(
+     libewf_segment_files_index_t *segment_files_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_FILES_INDEX_H ) */
+
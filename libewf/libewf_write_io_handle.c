@@ -3565,6 +3565,10 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_chunk(
 	write_io_handle->number_of_chunks_written_to_section      += 1;
 	write_io_handle->number_of_chunks_written                 += 1;
 
+	if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_IS_INCOMPRESSIBLE ) != 0 )
+	{
+		write_io_handle->number_of_incompressible_chunks += 1;
+	}
 	return( write_count );
 
 on_error:
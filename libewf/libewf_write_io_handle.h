@@ -161,6 +161,10 @@ struct libewf_write_io_handle
          */
         uint64_t number_of_chunks_written;
 
+        /* The number of chunks written uncompressed since their data is incompressible
+         */
+        uint64_t number_of_incompressible_chunks;
+
         /* The current segment file IO pool entry
          */
         int current_file_io_pool_entry;
@@ -0,0 +1,777 @@
+/*
+ * Write queue functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_queue.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a write queue
+ * Make sure the value write_queue is referencing, is set to NULL
+ * The pack chunk data callback is called from the worker threads and must be multi-thread safe
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_queue_initialize(
+     libewf_write_queue_t **write_queue,
+     int number_of_threads,
+     int (*pack_chunk_data)(
+            void *arguments,
+            libewf_chunk_data_t *chunk_data,
+            libcerror_error_t **error ),
+     void *arguments,
+     libcerror_error_t **error )
+{
+	static char *function          = "libewf_write_queue_initialize";
+	size_t entries_size            = 0;
+	int maximum_number_of_entries  = 0;
+
+	if( write_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > ( INT_MAX / LIBEWF_WRITE_QUEUE_ENTRIES_PER_THREAD ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( pack_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pack chunk data function.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_entries = number_of_threads * LIBEWF_WRITE_QUEUE_ENTRIES_PER_THREAD;
+
+	entries_size = sizeof( libewf_write_queue_entry_t ) * (size_t) maximum_number_of_entries;
+
+	if( entries_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid entries size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*write_queue = memory_allocate_structure(
+	                libewf_write_queue_t );
+
+	if( *write_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_queue,
+	     0,
+	     sizeof( libewf_write_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write queue.",
+		 function );
+
+		memory_free(
+		 *write_queue );
+
+		*write_queue = NULL;
+
+		return( -1 );
+	}
+	( *write_queue )->entries = (libewf_write_queue_entry_t *) memory_allocate(
+	                                                            entries_size );
+
+	if( ( *write_queue )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *write_queue )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *write_queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *write_queue )->entry_packed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize entry packed condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_queue )->number_of_threads         = number_of_threads;
+	( *write_queue )->maximum_number_of_entries = maximum_number_of_entries;
+	( *write_queue )->pack_chunk_data           = pack_chunk_data;
+	( *write_queue )->arguments                 = arguments;
+
+	/* The thread pool queue can hold all the entries so that pushing an entry does not block
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *write_queue )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     maximum_number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_write_queue_process_entry_callback,
+	     (void *) *write_queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *write_queue != NULL )
+	{
+		if( ( *write_queue )->entry_packed_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *write_queue )->entry_packed_condition ),
+			 NULL );
+		}
+		if( ( *write_queue )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *write_queue )->mutex ),
+			 NULL );
+		}
+		if( ( *write_queue )->entries != NULL )
+		{
+			memory_free(
+			 ( *write_queue )->entries );
+		}
+		memory_free(
+		 *write_queue );
+
+		*write_queue = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write queue
+ * Waits for the worker threads to finish, chunk data that was not dequeued is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_queue_free(
+     libewf_write_queue_t **write_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_queue_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( write_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_queue != NULL )
+	{
+		/* The worker threads grab the mutex hence the thread pool
+		 * is joined without holding it
+		 */
+		if( ( *write_queue )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *write_queue )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( entry_index = 0;
+		     entry_index < ( *write_queue )->maximum_number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *write_queue )->entries[ entry_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *write_queue )->entries[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk data of entry: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *write_queue )->entry_packed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entry packed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *write_queue )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *write_queue )->entries );
+
+		memory_free(
+		 *write_queue );
+
+		*write_queue = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the number of entries
+ * The entries are only pushed and popped by the thread that owns the write queue
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_queue_get_number_of_entries(
+     libewf_write_queue_t *write_queue,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_queue_get_number_of_entries";
+
+	if( write_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_entries = write_queue->number_of_entries;
+
+	return( 1 );
+}
+
+/* Determines if the write queue is full
+ * Returns 1 if full, 0 if not or -1 on error
+ */
+int libewf_write_queue_is_full(
+     libewf_write_queue_t *write_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_queue_is_full";
+
+	if( write_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_queue->number_of_entries >= write_queue->maximum_number_of_entries )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Pushes chunk data onto the write queue to be packed by a worker thread
+ * The write queue takes over the chunk data when successful
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_queue_push(
+     libewf_write_queue_t *write_queue,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_write_queue_entry_t *write_queue_entry = NULL;
+	static char *function                         = "libewf_write_queue_push";
+	int entry_index                               = 0;
+
+	if( write_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_queue->number_of_entries >= write_queue->maximum_number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid write queue - queue is full.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = ( write_queue->first_entry_index + write_queue->number_of_entries ) % write_queue->maximum_number_of_entries;
+
+	write_queue_entry = &( write_queue->entries[ entry_index ] );
+
+	/* The entry is not referenced by a worker thread until it has been pushed onto the thread pool
+	 */
+	write_queue_entry->chunk_index     = chunk_index;
+	write_queue_entry->chunk_data      = chunk_data;
+	write_queue_entry->input_data_size = input_data_size;
+	write_queue_entry->status          = LIBEWF_WRITE_QUEUE_ENTRY_STATUS_QUEUED;
+
+	if( libcthreads_thread_pool_push(
+	     write_queue->thread_pool,
+	     (intptr_t *) write_queue_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push entry onto thread pool queue.",
+		 function );
+
+		write_queue_entry->chunk_data = NULL;
+
+		return( -1 );
+	}
+	write_queue->number_of_entries += 1;
+
+	return( 1 );
+}
+
+/* Pops the first (oldest) chunk data from the write queue
+ * If wait for packed is set the function waits until the chunk data has been packed,
+ * otherwise 0 is returned if the chunk data has not yet been packed
+ * The caller takes over the chunk data when successful
+ * Returns 1 if successful, 0 if no packed chunk data is available or -1 on error
+ */
+int libewf_write_queue_pop(
+     libewf_write_queue_t *write_queue,
+     uint8_t wait_for_packed,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_write_queue_entry_t *write_queue_entry = NULL;
+	static char *function                         = "libewf_write_queue_pop";
+	int entry_status                              = 0;
+
+	if( write_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_queue->number_of_entries == 0 )
+	{
+		return( 0 );
+	}
+	write_queue_entry = &( write_queue->entries[ write_queue->first_entry_index ] );
+
+	if( libcthreads_mutex_grab(
+	     write_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( wait_for_packed != 0 )
+	    && ( write_queue_entry->status == LIBEWF_WRITE_QUEUE_ENTRY_STATUS_QUEUED ) )
+	{
+		if( libcthreads_condition_wait(
+		     write_queue->entry_packed_condition,
+		     write_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for entry packed condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 write_queue->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	entry_status = write_queue_entry->status;
+
+	if( libcthreads_mutex_release(
+	     write_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_status == LIBEWF_WRITE_QUEUE_ENTRY_STATUS_QUEUED )
+	{
+		return( 0 );
+	}
+	write_queue->first_entry_index = ( write_queue->first_entry_index + 1 ) % write_queue->maximum_number_of_entries;
+	write_queue->number_of_entries -= 1;
+
+	if( entry_status != LIBEWF_WRITE_QUEUE_ENTRY_STATUS_PACKED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 write_queue_entry->chunk_index );
+
+		libewf_chunk_data_free(
+		 &( write_queue_entry->chunk_data ),
+		 NULL );
+
+		return( -1 );
+	}
+	*chunk_index     = write_queue_entry->chunk_index;
+	*chunk_data      = write_queue_entry->chunk_data;
+	*input_data_size = write_queue_entry->input_data_size;
+
+	write_queue_entry->chunk_data = NULL;
+
+	return( 1 );
+}
+
+/* Processes a write queue entry
+ * Callback for the write queue thread pool
+ * Errors are reported when the entry is popped from the write queue
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_queue_process_entry_callback(
+     libewf_write_queue_entry_t *write_queue_entry,
+     libewf_write_queue_t *write_queue )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_write_queue_process_entry_callback";
+	int entry_status         = LIBEWF_WRITE_QUEUE_ENTRY_STATUS_PACKED;
+	int result               = 1;
+
+	if( write_queue_entry == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write queue entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( write_queue == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( write_queue->pack_chunk_data(
+	     write_queue->arguments,
+	     write_queue_entry->chunk_data,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 write_queue_entry->chunk_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		entry_status = LIBEWF_WRITE_QUEUE_ENTRY_STATUS_FAILED;
+		result       = -1;
+	}
+	if( libcthreads_mutex_grab(
+	     write_queue->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	write_queue_entry->status = entry_status;
+
+	if( libcthreads_condition_broadcast(
+	     write_queue->entry_packed_condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast entry packed condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 write_queue->mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     write_queue->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
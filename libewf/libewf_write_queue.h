@@ -0,0 +1,170 @@
+/*
+ * Write queue functions
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_WRITE_QUEUE_H )
+#define _LIBEWF_WRITE_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The number of queue entries per worker thread
+ */
+#define LIBEWF_WRITE_QUEUE_ENTRIES_PER_THREAD		2
+
+enum LIBEWF_WRITE_QUEUE_ENTRY_STATUS
+{
+	LIBEWF_WRITE_QUEUE_ENTRY_STATUS_QUEUED		= 0,
+	LIBEWF_WRITE_QUEUE_ENTRY_STATUS_PACKED		= 1,
+	LIBEWF_WRITE_QUEUE_ENTRY_STATUS_FAILED		= 2
+};
+
+typedef struct libewf_write_queue_entry libewf_write_queue_entry_t;
+
+struct libewf_write_queue_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The (unpacked) input data size
+	 */
+	size_t input_data_size;
+
+	/* The status
+	 */
+	int status;
+};
+
+typedef struct libewf_write_queue libewf_write_queue_t;
+
+/* The write queue has a pool of worker threads pack chunks,
+ * the packed chunks are dequeued in the order they were queued
+ */
+struct libewf_write_queue
+{
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The entries, used as a ring buffer
+	 */
+	libewf_write_queue_entry_t *entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The index of the first (oldest) entry
+	 */
+	int first_entry_index;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The callback function that packs the chunk data
+	 */
+	int (*pack_chunk_data)(
+	       void *arguments,
+	       libewf_chunk_data_t *chunk_data,
+	       libcerror_error_t **error );
+
+	/* The callback function arguments
+	 */
+	void *arguments;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that protects the entry status
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when an entry was packed
+	 */
+	libcthreads_condition_t *entry_packed_condition;
+};
+
+int libewf_write_queue_initialize(
+     libewf_write_queue_t **write_queue,
+     int number_of_threads,
+     int (*pack_chunk_data)(
+            void *arguments,
+            libewf_chunk_data_t *chunk_data,
+            libcerror_error_t **error ),
+     void *arguments,
+     libcerror_error_t **error );
+
+int libewf_write_queue_free(
+     libewf_write_queue_t **write_queue,
+     libcerror_error_t **error );
+
+int libewf_write_queue_get_number_of_entries(
+     libewf_write_queue_t *write_queue,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_write_queue_is_full(
+     libewf_write_queue_t *write_queue,
+     libcerror_error_t **error );
+
+int libewf_write_queue_push(
+     libewf_write_queue_t *write_queue,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error );
+
+int libewf_write_queue_pop(
+     libewf_write_queue_t *write_queue,
+     uint8_t wait_for_packed,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error );
+
+int libewf_write_queue_process_entry_callback(
+     libewf_write_queue_entry_t *write_queue_entry,
+     libewf_write_queue_t *write_queue );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_WRITE_QUEUE_H ) */
+
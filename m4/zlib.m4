@@ -1,6 +1,6 @@
 dnl Checks for zlib required headers and functions
 dnl
-dnl Version: 20201230
+dnl Version: 20230601
 
 dnl Function to detect if zlib is available
 AC_DEFUN([AX_ZLIB_CHECK_LIB],
@@ -265,12 +265,33 @@ AC_DEFUN([AX_ZLIB_CHECK_UNCOMPRESS2],
     ])
   ])
 
+dnl Function to detect if zlib is provided by zlib-ng in zlib compatible mode
+AC_DEFUN([AX_ZLIB_CHECK_ZLIB_NG],
+  [AS_IF(
+    [test "x$ac_cv_zlib" != xzlib],
+    [ac_cv_zlib_ng=no],
+    [AC_CHECK_DECL(
+      [ZLIBNG_VERSION],
+      [ac_cv_zlib_ng=yes],
+      [ac_cv_zlib_ng=no],
+      [#include <zlib.h>])
+
+    AS_IF(
+      [test "x$ac_cv_zlib_ng" = xyes],
+      [AC_DEFINE(
+        [HAVE_ZLIB_NG],
+        [1],
+        [Define to 1 if zlib is provided by zlib-ng in zlib compatible mode.])
+      ])
+    ])
+  ])
+
 dnl Function to detect how to enable zlib
 AC_DEFUN([AX_ZLIB_CHECK_ENABLE],
   [AX_COMMON_ARG_WITH(
     [zlib],
     [zlib],
-    [search for zlib in includedir and libdir or in the specified DIR, or no if not to use zlib],
+    [search for zlib in includedir and libdir or in the specified DIR, or no if not to use zlib, DIR can also contain zlib-ng build in zlib compatible mode],
     [auto-detect],
     [DIR])
 
@@ -0,0 +1,475 @@
+/*
+ * Library Adler-32 functions test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcnotify.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_adler32.h"
+
+/* Define to make ewf_test_adler32 generate verbose output
+#define EWF_TEST_ADLER32
+ */
+
+#define EWF_TEST_ADLER32_DATA_SIZE	( 4 * 5552 ) + 64
+
+uint8_t ewf_test_adler32_data[ EWF_TEST_ADLER32_DATA_SIZE ];
+
+uint8_t ewf_test_adler32_byte_stream[ 43 ] = {
+	0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20,
+	0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74,
+	0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67 };
+
+uint32_t ewf_test_adler32_initial_values[ 4 ] = {
+	0x00000001UL, 0x00000000UL, 0x12345678UL, 0xfff0fff0UL };
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Calculates the Adler-32 of a buffer one byte at a time
+ * Returns the Adler-32
+ */
+uint32_t ewf_test_adler32_calculate_reference(
+          const uint8_t *data,
+          size_t data_size,
+          uint32_t initial_value )
+{
+	size_t data_offset  = 0;
+	uint32_t lower_word = initial_value & 0xffff;
+	uint32_t upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		lower_word = ( lower_word + data[ data_offset ] ) % 65521;
+		upper_word = ( upper_word + lower_word ) % 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Fills the test data with pseudo random values
+ */
+void ewf_test_adler32_initialize_data(
+      uint8_t byte_value )
+{
+	size_t data_offset = 0;
+	uint32_t seed      = 0x5eed1234UL;
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_ADLER32_DATA_SIZE;
+	     data_offset++ )
+	{
+		if( byte_value != 0 )
+		{
+			ewf_test_adler32_data[ data_offset ] = byte_value;
+		}
+		else
+		{
+			seed = ( seed * 1103515245UL ) + 12345UL;
+
+			ewf_test_adler32_data[ data_offset ] = (uint8_t) ( seed >> 16 );
+		}
+	}
+}
+
+/* Tests if a calculate function is equivalent to the reference implementation
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_function(
+     libewf_adler32_calculate_function_t calculate_function )
+{
+	size_t data_sizes[ 10 ] = {
+		1000, 5551, 5552, 5553, 5584, 11104, 11137, 16656, 20000, 4 * 5552 };
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	size_t data_size         = 0;
+	uint32_t checksum        = 0;
+	int data_size_index      = 0;
+	int initial_value_index  = 0;
+	int pass                 = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = calculate_function(
+	          &checksum,
+	          ewf_test_adler32_byte_stream,
+	          43,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0x5bdc0fdaUL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with pseudo random data and with data that maximizes the sums
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		if( pass == 0 )
+		{
+			ewf_test_adler32_initialize_data(
+			 0 );
+		}
+		else
+		{
+			ewf_test_adler32_initialize_data(
+			 0xff );
+		}
+		for( initial_value_index = 0;
+		     initial_value_index < 4;
+		     initial_value_index++ )
+		{
+			/* Test small sizes at unaligned offsets
+			 */
+			for( data_offset = 0;
+			     data_offset < 4;
+			     data_offset++ )
+			{
+				for( data_size = 0;
+				     data_size <= 160;
+				     data_size++ )
+				{
+					result = calculate_function(
+					          &checksum,
+					          &( ewf_test_adler32_data[ data_offset ] ),
+					          data_size,
+					          ewf_test_adler32_initial_values[ initial_value_index ],
+					          &error );
+
+					EWF_TEST_ASSERT_EQUAL_INT(
+					 "result",
+					 result,
+					 1 );
+
+					EWF_TEST_ASSERT_EQUAL_UINT32(
+					 "checksum",
+					 checksum,
+					 ewf_test_adler32_calculate_reference(
+					  &( ewf_test_adler32_data[ data_offset ] ),
+					  data_size,
+					  ewf_test_adler32_initial_values[ initial_value_index ] ) );
+
+					EWF_TEST_ASSERT_IS_NULL(
+					 "error",
+					 error );
+				}
+			}
+			/* Test sizes around the reduction interval
+			 */
+			for( data_size_index = 0;
+			     data_size_index < 10;
+			     data_size_index++ )
+			{
+				data_offset = (size_t) ( data_size_index % 3 );
+
+				result = calculate_function(
+				          &checksum,
+				          &( ewf_test_adler32_data[ data_offset ] ),
+				          data_sizes[ data_size_index ],
+				          ewf_test_adler32_initial_values[ initial_value_index ],
+				          &error );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 1 );
+
+				EWF_TEST_ASSERT_EQUAL_UINT32(
+				 "checksum",
+				 checksum,
+				 ewf_test_adler32_calculate_reference(
+				  &( ewf_test_adler32_data[ data_offset ] ),
+				  data_sizes[ data_size_index ],
+				  ewf_test_adler32_initial_values[ initial_value_index ] ) );
+
+				EWF_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+			}
+		}
+	}
+	/* Test error cases
+	 */
+	result = calculate_function(
+	          NULL,
+	          ewf_test_adler32_byte_stream,
+	          43,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = calculate_function(
+	          &checksum,
+	          NULL,
+	          43,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = calculate_function(
+	          &checksum,
+	          ewf_test_adler32_byte_stream,
+	          (size_t) SSIZE_MAX + 1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_adler32_calculate_scalar function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_scalar(
+     void )
+{
+	return( ewf_test_adler32_calculate_function(
+	         &libewf_adler32_calculate_scalar ) );
+}
+
+#if defined( LIBEWF_ADLER32_HAVE_SSE2 )
+
+/* Tests the libewf_adler32_calculate_sse2 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_sse2(
+     void )
+{
+	return( ewf_test_adler32_calculate_function(
+	         &libewf_adler32_calculate_sse2 ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_SSE2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+/* Tests the libewf_adler32_calculate_avx2 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_avx2(
+     void )
+{
+	/* Skip the test if the CPU does not support AVX2
+	 */
+	if( libewf_adler32_cpu_supports_avx2() == 0 )
+	{
+		return( 1 );
+	}
+	return( ewf_test_adler32_calculate_function(
+	         &libewf_adler32_calculate_avx2 ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+/* Tests the libewf_adler32_calculate_neon function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_neon(
+     void )
+{
+	return( ewf_test_adler32_calculate_function(
+	         &libewf_adler32_calculate_neon ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+/* Tests the libewf_adler32_get_calculate_function function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_get_calculate_function(
+     void )
+{
+	libewf_adler32_calculate_function_t calculate_function = NULL;
+
+	/* Test regular cases
+	 */
+	calculate_function = libewf_adler32_get_calculate_function();
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "calculate_function",
+	 calculate_function );
+
+	/* Test if the same function is returned on subsequent calls
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "calculate_function",
+	 (int) ( calculate_function == libewf_adler32_get_calculate_function() ),
+	 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libewf_adler32_calculate function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate(
+     void )
+{
+	return( ewf_test_adler32_calculate_function(
+	         &libewf_adler32_calculate ) );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_ADLER32 )
+	libcnotify_verbose_set(
+	 1 );
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_scalar",
+	 ewf_test_adler32_calculate_scalar );
+
+#if defined( LIBEWF_ADLER32_HAVE_SSE2 )
+
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_sse2",
+	 ewf_test_adler32_calculate_sse2 );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_SSE2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_avx2",
+	 ewf_test_adler32_calculate_avx2 );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_neon",
+	 ewf_test_adler32_calculate_neon );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+	EWF_TEST_RUN(
+	 "libewf_adler32_get_calculate_function",
+	 ewf_test_adler32_get_calculate_function );
+
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate",
+	 ewf_test_adler32_calculate );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,560 @@
+/*
+ * Library async_io type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_async_io.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_async_io_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_io_initialize(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libewf_async_io_t *async_io = NULL;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_async_io_initialize(
+	          &async_io,
+	          4,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		/* Asynchronous IO is not supported
+		 */
+		EWF_TEST_ASSERT_IS_NULL(
+		 "async_io",
+		 async_io );
+	}
+	else
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "async_io",
+		 async_io );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "async_io->queue_depth",
+		 async_io->queue_depth,
+		 8 );
+
+		result = libewf_async_io_free(
+		          &async_io,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "async_io",
+		 async_io );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_async_io_initialize(
+	          NULL,
+	          4,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	async_io = (libewf_async_io_t *) 0x12345678UL;
+
+	result = libewf_async_io_initialize(
+	          &async_io,
+	          4,
+	          8,
+	          &error );
+
+	async_io = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_io_initialize(
+	          &async_io,
+	          0,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_io_initialize(
+	          &async_io,
+	          4,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_io_initialize(
+	          &async_io,
+	          4,
+	          LIBEWF_ASYNC_IO_MAXIMUM_QUEUE_DEPTH + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_io != NULL )
+	{
+		libewf_async_io_free(
+		 &async_io,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_async_io_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_io_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_async_io_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_async_io_open_file and libewf_async_io_read_buffers functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_io_read_buffers(
+     const char *filename )
+{
+	uint8_t buffer[ 16 ];
+
+	libewf_async_io_request_t requests[ 2 ];
+
+	libcerror_error_t *error    = NULL;
+	libewf_async_io_t *async_io = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_async_io_initialize(
+	          &async_io,
+	          2,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		/* Asynchronous IO is not supported
+		 */
+		return( 1 );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_async_io_open_file(
+	          async_io,
+	          1,
+	          "ewf_test_async_io_does_not_exist",
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( filename != NULL )
+	{
+		result = libewf_async_io_open_file(
+		          async_io,
+		          0,
+		          filename,
+		          &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	requests[ 0 ].file_index  = 0;
+	requests[ 0 ].offset      = 0;
+	requests[ 0 ].buffer      = buffer;
+	requests[ 0 ].buffer_size = 16;
+
+	requests[ 1 ].file_index  = 1;
+	requests[ 1 ].offset      = 0;
+	requests[ 1 ].buffer      = buffer;
+	requests[ 1 ].buffer_size = 16;
+
+	/* The queue depth of 1 requires the requests to be submitted one at a time
+	 */
+	result = libewf_async_io_read_buffers(
+	          async_io,
+	          requests,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The request of the file that is not opened is not processed
+	 */
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "requests[ 1 ].read_count",
+	 requests[ 1 ].read_count,
+	 (ssize_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_async_io_open_file(
+	          NULL,
+	          0,
+	          "ewf_test_async_io_does_not_exist",
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_io_open_file(
+	          async_io,
+	          2,
+	          "ewf_test_async_io_does_not_exist",
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_io_open_file(
+	          async_io,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_io_read_buffers(
+	          NULL,
+	          requests,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_io_read_buffers(
+	          async_io,
+	          NULL,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_io_read_buffers(
+	          async_io,
+	          requests,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_async_io_free(
+	          &async_io,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_io",
+	 async_io );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_io != NULL )
+	{
+		libewf_async_io_free(
+		 &async_io,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	const char *filename = NULL;
+#endif
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	/* The test program itself is used as the file to read
+	 */
+	if( argc > 0 )
+	{
+		filename = argv[ 0 ];
+	}
+#endif
+	EWF_TEST_RUN(
+	 "libewf_async_io_initialize",
+	 ewf_test_async_io_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_async_io_free",
+	 ewf_test_async_io_free );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "libewf_async_io_read_buffers",
+	 ewf_test_async_io_read_buffers,
+	 filename );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
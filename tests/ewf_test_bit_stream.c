@@ -378,6 +378,150 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_bit_stream_fill_bit_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_bit_stream_fill_bit_buffer(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_bit_stream_t *bit_stream = NULL;
+	uint32_t value_32bit            = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_bit_stream_initialize(
+	          &bit_stream,
+	          ewf_test_bit_stream_data,
+	          16,
+	          0,
+	          LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	libewf_bit_stream_fill_bit_buffer(
+	 bit_stream );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "bit_stream->byte_stream_offset",
+	 bit_stream->byte_stream_offset,
+	 (size_t) 7 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "bit_stream->bit_buffer",
+	 bit_stream->bit_buffer,
+	 (uint64_t) 0x00db8f6d59bdda78UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_stream->bit_buffer_size",
+	 bit_stream->bit_buffer_size,
+	 (uint8_t) 56 );
+
+	result = libewf_bit_stream_get_value(
+	          bit_stream,
+	          12,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 0x00000a78UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	libewf_bit_stream_fill_bit_buffer(
+	 bit_stream );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "bit_stream->byte_stream_offset",
+	 bit_stream->byte_stream_offset,
+	 (size_t) 9 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "bit_stream->bit_buffer",
+	 bit_stream->bit_buffer,
+	 (uint64_t) 0x011b8db8f6d59bddUL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_stream->bit_buffer_size",
+	 bit_stream->bit_buffer_size,
+	 (uint8_t) 60 );
+
+	/* Test at the end of the byte stream
+	 */
+	bit_stream->byte_stream_offset = 14;
+	bit_stream->bit_buffer         = 0;
+	bit_stream->bit_buffer_size    = 0;
+
+	libewf_bit_stream_fill_bit_buffer(
+	 bit_stream );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "bit_stream->byte_stream_offset",
+	 bit_stream->byte_stream_offset,
+	 (size_t) 16 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "bit_stream->bit_buffer",
+	 bit_stream->bit_buffer,
+	 (uint64_t) 0x000000000000b97eUL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_stream->bit_buffer_size",
+	 bit_stream->bit_buffer_size,
+	 (uint8_t) 16 );
+
+	/* Clean up
+	 */
+	result = libewf_bit_stream_free(
+	          &bit_stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( bit_stream != NULL )
+	{
+		libewf_bit_stream_free(
+		 &bit_stream,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_bit_stream_get_value function
  * Returns 1 if successful or 0 if not
  */
@@ -435,10 +579,10 @@ int ewf_test_bit_stream_get_value(
 	 bit_stream->byte_stream_offset,
 	 (size_t) 0 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream->bit_buffer",
 	 bit_stream->bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000UL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream->bit_buffer_size",
@@ -470,10 +614,10 @@ int ewf_test_bit_stream_get_value(
 	 bit_stream->byte_stream_offset,
 	 (size_t) 1 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream->bit_buffer",
 	 bit_stream->bit_buffer,
-	 (uint32_t) 0x00000007UL );
+	 (uint64_t) 0x00000007UL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream->bit_buffer_size",
@@ -505,10 +649,10 @@ int ewf_test_bit_stream_get_value(
 	 bit_stream->byte_stream_offset,
 	 (size_t) 2 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream->bit_buffer",
 	 bit_stream->bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000UL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream->bit_buffer_size",
@@ -540,10 +684,10 @@ int ewf_test_bit_stream_get_value(
 	 bit_stream->byte_stream_offset,
 	 (size_t) 6 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream->bit_buffer",
 	 bit_stream->bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000UL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream->bit_buffer_size",
@@ -691,6 +835,10 @@ int main(
 	 "libewf_bit_stream_free",
 	 ewf_test_bit_stream_free );
 
+	EWF_TEST_RUN(
+	 "libewf_bit_stream_fill_bit_buffer",
+	 ewf_test_bit_stream_fill_bit_buffer );
+
 	EWF_TEST_RUN(
 	 "libewf_bit_stream_get_value",
 	 ewf_test_bit_stream_get_value );
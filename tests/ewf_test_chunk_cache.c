@@ -0,0 +1,1093 @@
+/*
+ * Library chunk_cache type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_cache.h"
+#include "../libewf/libewf_chunk_data.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 2;
+	int number_of_memset_fail_tests   = 2;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          8 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          NULL,
+	          8 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_cache = (libewf_chunk_cache_t *) 0x12345678UL;
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          8 * 1024 * 1024,
+	          &error );
+
+	chunk_cache = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          8,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          8,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_insert_entry, libewf_chunk_cache_get_entry_by_index
+ * and libewf_chunk_cache_release_entry functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_insert_entry(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_chunk_cache_t *chunk_cache               = NULL;
+	libewf_chunk_cache_entry_t *chunk_cache_entry   = NULL;
+	libewf_chunk_cache_entry_t *evicted_cache_entry = NULL;
+	libewf_chunk_data_t *chunk_data                 = NULL;
+	uint64_t chunk_indexes[ 2 ]                     = { 3, 1 };
+	uint64_t chunk_index                            = 0;
+	int entry_index                                 = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	/* The maximum cache size fits 2 chunks of 512 bytes
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1536,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( chunk_index = 0;
+	     chunk_index < 3;
+	     chunk_index++ )
+	{
+		result = libewf_chunk_data_initialize(
+		          &chunk_data,
+		          512,
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_cache_insert_entry(
+		          chunk_cache,
+		          chunk_index,
+		          &chunk_data,
+		          &chunk_cache_entry,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_cache_entry",
+		 chunk_cache_entry );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Keep a reference to the first entry so that it is evicted while still in use
+		 */
+		if( chunk_index == 0 )
+		{
+			evicted_cache_entry = chunk_cache_entry;
+			chunk_cache_entry   = NULL;
+		}
+		else
+		{
+			result = libewf_chunk_cache_release_entry(
+			          chunk_cache,
+			          &chunk_cache_entry,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache_entry",
+			 chunk_cache_entry );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN ].number_of_entries",
+	 chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN ].number_of_entries,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "evicted_cache_entry->queue_type",
+	 evicted_cache_entry->queue_type,
+	 LIBEWF_CHUNK_CACHE_QUEUE_TYPE_NONE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "evicted_cache_entry->chunk_data",
+	 evicted_cache_entry->chunk_data );
+
+	result = libewf_chunk_cache_release_entry(
+	          chunk_cache,
+	          &evicted_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_entry_by_index(
+	          chunk_cache,
+	          0,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_entry_by_index(
+	          chunk_cache,
+	          2,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache_entry",
+	 chunk_cache_entry );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache_entry->chunk_index",
+	 chunk_cache_entry->chunk_index,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_entry(
+	          chunk_cache,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Chunk 1 is evicted to the out queue when chunk 3 is inserted and is
+	 * inserted again afterwards
+	 */
+	for( entry_index = 0;
+	     entry_index < 2;
+	     entry_index++ )
+	{
+		result = libewf_chunk_data_initialize(
+		          &chunk_data,
+		          512,
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_cache_insert_entry(
+		          chunk_cache,
+		          chunk_indexes[ entry_index ],
+		          &chunk_data,
+		          &chunk_cache_entry,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_cache_entry",
+		 chunk_cache_entry );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_cache_release_entry(
+		          chunk_cache,
+		          &chunk_cache_entry,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Chunk 1 is stored in the main queue when it is inserted again
+	 */
+	result = libewf_chunk_cache_get_entry_by_index(
+	          chunk_cache,
+	          1,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache_entry",
+	 chunk_cache_entry );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "chunk_cache_entry->queue_type",
+	 chunk_cache_entry->queue_type,
+	 LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_entry(
+	          chunk_cache,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN ].number_of_entries",
+	 chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_IN ].number_of_entries,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN ].number_of_entries",
+	 chunk_cache->queues[ LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN ].number_of_entries,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_insert_entry(
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_insert_entry(
+	          chunk_cache,
+	          0,
+	          NULL,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_entry_by_index(
+	          NULL,
+	          0,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_entry_by_index(
+	          chunk_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_release_entry(
+	          NULL,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_set_maximum_cache_size and libewf_chunk_cache_get_statistics functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_set_maximum_cache_size(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_chunk_cache_t *chunk_cache             = NULL;
+	libewf_chunk_cache_entry_t *chunk_cache_entry = NULL;
+	libewf_chunk_data_t *chunk_data               = NULL;
+	size64_t maximum_cache_size                   = 0;
+	uint64_t number_of_hits                       = 0;
+	uint64_t number_of_misses                     = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          8 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_insert_entry(
+	          chunk_cache,
+	          0,
+	          &chunk_data,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_entry(
+	          chunk_cache,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_entry_by_index(
+	          chunk_cache,
+	          0,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release_entry(
+	          chunk_cache,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_set_maximum_cache_size(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache->cache_size",
+	 (uint64_t) chunk_cache->cache_size,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->number_of_buckets",
+	 chunk_cache->number_of_buckets,
+	 LIBEWF_CHUNK_CACHE_MINIMUM_NUMBER_OF_BUCKETS );
+
+	result = libewf_chunk_cache_get_maximum_cache_size(
+	          chunk_cache,
+	          &maximum_cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_cache_size",
+	 (uint64_t) maximum_cache_size,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_entry_by_index(
+	          chunk_cache,
+	          0,
+	          &chunk_cache_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_statistics(
+	          chunk_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_set_maximum_cache_size(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_maximum_cache_size(
+	          chunk_cache,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_statistics(
+	          chunk_cache,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_statistics(
+	          chunk_cache,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_initialize",
+	 ewf_test_chunk_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_free",
+	 ewf_test_chunk_cache_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_insert_entry",
+	 ewf_test_chunk_cache_insert_entry );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_set_maximum_cache_size",
+	 ewf_test_chunk_cache_set_maximum_cache_size );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -3778,6 +3778,148 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_check_for_incompressible_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_check_for_incompressible_data(
+     void )
+{
+	uint8_t buffer[ 8192 ];
+
+	libcerror_error_t *error = NULL;
+	size_t buffer_offset     = 0;
+	uint32_t random_value    = 0x12345678UL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 8192;
+	     buffer_offset++ )
+	{
+		random_value ^= random_value << 13;
+		random_value ^= random_value >> 17;
+		random_value ^= random_value << 5;
+
+		buffer[ buffer_offset ] = (uint8_t) ( random_value >> 24 );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          8192,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_offset = 0;
+	     buffer_offset < 8192;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( buffer_offset & 0xff );
+	}
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          8192,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_offset = 0;
+	     buffer_offset < 8192;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( 'a' + ( buffer_offset % 26 ) );
+	}
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          8192,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          NULL,
+	          8192,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_data_write function
  * Returns 1 if successful or 0 if not
  */
@@ -5001,6 +5143,10 @@ int main(
 	 "libewf_chunk_data_check_for_64_bit_pattern_fill",
 	 ewf_test_chunk_data_check_for_64_bit_pattern_fill );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_check_for_incompressible_data",
+	 ewf_test_chunk_data_check_for_incompressible_data );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_write",
 	 ewf_test_chunk_data_write );
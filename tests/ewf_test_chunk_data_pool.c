@@ -0,0 +1,1210 @@
+/*
+ * Library chunk_data_pool type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_chunk_data_pool.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_data_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_initialize(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	int result                                = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests           = 3;
+	int number_of_memset_fail_tests           = 1;
+	int test_number                           = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          sizeof( libewf_chunk_data_t ),
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          NULL,
+	          sizeof( libewf_chunk_data_t ),
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_data_pool = (libewf_chunk_data_pool_t *) 0x12345678UL;
+
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          sizeof( libewf_chunk_data_t ),
+	          4,
+	          &error );
+
+	chunk_data_pool = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          0,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          sizeof( libewf_chunk_data_t ),
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_data_pool_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_data_pool_initialize(
+		          &chunk_data_pool,
+		          sizeof( libewf_chunk_data_t ),
+		          4,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_data_pool != NULL )
+			{
+				libewf_chunk_data_pool_free(
+				 &chunk_data_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_data_pool",
+			 chunk_data_pool );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_data_pool_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_data_pool_initialize(
+		          &chunk_data_pool,
+		          sizeof( libewf_chunk_data_t ),
+		          4,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_data_pool != NULL )
+			{
+				libewf_chunk_data_pool_free(
+				 &chunk_data_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_data_pool",
+			 chunk_data_pool );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_pool_empty_buffers function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_empty_buffers(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	uint8_t *buffer                           = NULL;
+	uint64_t number_of_allocations            = 0;
+	uint64_t number_of_reuses                 = 0;
+	size_t buffer_size                        = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          sizeof( libewf_chunk_data_t ),
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          32768 + 4,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_pool_empty_buffers(
+	          chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the pool buffer size is set by the next buffer that is grabbed
+	 */
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          65536 + 4,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_size",
+	 buffer_size,
+	 (size_t) 65552 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          65536 + 4,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a buffer that is in use when the pool is emptied is not retained
+	 */
+	result = libewf_chunk_data_pool_empty_buffers(
+	          chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer",
+	 buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_get_statistics(
+	          chunk_data_pool,
+	          &number_of_allocations,
+	          &number_of_reuses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_allocations",
+	 number_of_allocations,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_reuses",
+	 number_of_reuses,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_empty_buffers(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		libewf_chunk_data_pool_release_buffer(
+		 chunk_data_pool,
+		 &buffer,
+		 buffer_size,
+		 NULL );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_pool_grab_buffer and libewf_chunk_data_pool_release_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_grab_buffer(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	uint8_t *buffer                           = NULL;
+	uint8_t *reused_buffer                    = NULL;
+	uint64_t number_of_allocations            = 0;
+	uint64_t number_of_reuses                 = 0;
+	size_t buffer_size                        = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          sizeof( libewf_chunk_data_t ),
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          32768 + 4,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_size",
+	 buffer_size,
+	 (size_t) 32784 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	reused_buffer = buffer;
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer",
+	 buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          32768 + 4,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer == reused_buffer",
+	 (int) ( buffer == reused_buffer ),
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a smaller buffer is not taken from the pool
+	 */
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          8,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_size",
+	 buffer_size,
+	 (size_t) 16 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a larger buffer is allocated outside the pool and does not flush the pool
+	 */
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          65536 + 4,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_size",
+	 buffer_size,
+	 (size_t) 65552 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          32768 + 4,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer == reused_buffer",
+	 (int) ( buffer == reused_buffer ),
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_size",
+	 buffer_size,
+	 (size_t) 32784 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_get_statistics(
+	          chunk_data_pool,
+	          &number_of_allocations,
+	          &number_of_reuses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_allocations",
+	 number_of_allocations,
+	 (uint64_t) 3 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_reuses",
+	 number_of_reuses,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_grab_buffer(
+	          NULL,
+	          32768 + 4,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          0,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          32768 + 4,
+	          NULL,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_grab_buffer(
+	          chunk_data_pool,
+	          32768 + 4,
+	          &buffer,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          NULL,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          NULL,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_initialize_from_pool function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_chunk_data(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	uint64_t number_of_allocations            = 0;
+	uint64_t number_of_reuses                 = 0;
+	int chunk_data_index                      = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          sizeof( libewf_chunk_data_t ),
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( chunk_data_index = 0;
+	     chunk_data_index < 3;
+	     chunk_data_index++ )
+	{
+		result = libewf_chunk_data_initialize_from_pool(
+		          &chunk_data,
+		          chunk_data_pool,
+		          32768,
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "chunk_data->allocated_data_size",
+		 chunk_data->allocated_data_size,
+		 (size_t) 32784 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_data_free(
+		          &chunk_data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The structure and data buffer are allocated once and reused afterwards
+	 */
+	result = libewf_chunk_data_pool_get_statistics(
+	          chunk_data_pool,
+	          &number_of_allocations,
+	          &number_of_reuses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_allocations",
+	 number_of_allocations,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_reuses",
+	 number_of_reuses,
+	 (uint64_t) 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_get_statistics(
+	          NULL,
+	          &number_of_allocations,
+	          &number_of_reuses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_initialize",
+	 ewf_test_chunk_data_pool_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_free",
+	 ewf_test_chunk_data_pool_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_empty_buffers",
+	 ewf_test_chunk_data_pool_empty_buffers );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_grab_buffer",
+	 ewf_test_chunk_data_pool_grab_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_initialize_from_pool",
+	 ewf_test_chunk_data_pool_chunk_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
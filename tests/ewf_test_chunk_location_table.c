@@ -0,0 +1,936 @@
+/*
+ * Library chunk_location_table type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_location_table.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_location_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_location_table_initialize(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libewf_chunk_location_table_t *chunk_location_table = NULL;
+	int result                                           = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                      = 3;
+	int number_of_memset_fail_tests                      = 3;
+	int test_number                                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_location_table_initialize(
+	          &chunk_location_table,
+	          100,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_location_table",
+	 chunk_location_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_location_table->number_of_blocks",
+	 chunk_location_table->number_of_blocks,
+	 (uint64_t) 2 );
+
+	result = libewf_chunk_location_table_free(
+	          &chunk_location_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_location_table",
+	 chunk_location_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_location_table_initialize(
+	          NULL,
+	          100,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_location_table = (libewf_chunk_location_table_t *) 0x12345678UL;
+
+	result = libewf_chunk_location_table_initialize(
+	          &chunk_location_table,
+	          100,
+	          1024 * 1024,
+	          &error );
+
+	chunk_location_table = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_location_table_initialize(
+	          &chunk_location_table,
+	          0,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_location_table_initialize(
+	          &chunk_location_table,
+	          100,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_location_table_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_location_table_initialize(
+		          &chunk_location_table,
+		          100,
+		          1024 * 1024,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_location_table != NULL )
+			{
+				libewf_chunk_location_table_free(
+				 &chunk_location_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_location_table",
+			 chunk_location_table );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_location_table_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_location_table_initialize(
+		          &chunk_location_table,
+		          100,
+		          1024 * 1024,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_location_table != NULL )
+			{
+				libewf_chunk_location_table_free(
+				 &chunk_location_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_location_table",
+			 chunk_location_table );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_location_table != NULL )
+	{
+		libewf_chunk_location_table_free(
+		 &chunk_location_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_location_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_location_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_location_table_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_location_table_set_block and libewf_chunk_location_table_get_chunk_location functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_location_table_set_block(
+     void )
+{
+	int file_io_pool_entries[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	off64_t data_offsets[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	size64_t data_sizes[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	uint32_t range_flags[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+
+	libcerror_error_t *error                             = NULL;
+	libewf_chunk_location_table_t *chunk_location_table = NULL;
+	off64_t data_offset                                  = 0;
+	size64_t data_size                                   = 0;
+	uint32_t chunk_range_flags                           = 0;
+	uint8_t block_status                                 = 0;
+	int entry_index                                      = 0;
+	int file_io_pool_entry                               = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	for( entry_index = 0;
+	     entry_index < LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE;
+	     entry_index++ )
+	{
+		if( entry_index < 48 )
+		{
+			file_io_pool_entries[ entry_index ] = 3;
+			data_offsets[ entry_index ]         = 0x80000000UL + ( entry_index * 0x8010 );
+			range_flags[ entry_index ]          = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+		}
+		else
+		{
+			file_io_pool_entries[ entry_index ] = 4;
+			data_offsets[ entry_index ]         = 0x00000d00UL + ( ( entry_index - 48 ) * 0x2000 );
+			range_flags[ entry_index ]          = LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_IS_PACKED;
+		}
+		data_sizes[ entry_index ] = 0x8004;
+	}
+	result = libewf_chunk_location_table_initialize(
+	          &chunk_location_table,
+	          100,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_location_table",
+	 chunk_location_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_location_table_get_block_status(
+	          chunk_location_table,
+	          10,
+	          &block_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "block_status",
+	 block_status,
+	 LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_UNSET );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_location_table_get_chunk_location(
+	          chunk_location_table,
+	          10,
+	          &file_io_pool_entry,
+	          &data_offset,
+	          &data_size,
+	          &chunk_range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_location_table_set_block(
+	          chunk_location_table,
+	          10,
+	          file_io_pool_entries,
+	          data_offsets,
+	          data_sizes,
+	          range_flags,
+	          LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_location_table_get_chunk_location(
+	          chunk_location_table,
+	          10,
+	          &file_io_pool_entry,
+	          &data_offset,
+	          &data_size,
+	          &chunk_range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "data_offset",
+	 (int64_t) data_offset,
+	 (int64_t) 0x800500a0UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "data_size",
+	 (uint64_t) data_size,
+	 (uint64_t) 0x8004 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_range_flags",
+	 chunk_range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_HAS_CHECKSUM );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_location_table_get_chunk_location(
+	          chunk_location_table,
+	          50,
+	          &file_io_pool_entry,
+	          &data_offset,
+	          &data_size,
+	          &chunk_range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "data_offset",
+	 (int64_t) data_offset,
+	 (int64_t) 0x00004d00UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_range_flags",
+	 chunk_range_flags,
+	 (uint32_t) ( LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_IS_PACKED ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a block with a chunk location that cannot be packed
+	 */
+	data_sizes[ 0 ] = 0x01000000UL;
+
+	result = libewf_chunk_location_table_set_block(
+	          chunk_location_table,
+	          64,
+	          file_io_pool_entries,
+	          data_offsets,
+	          data_sizes,
+	          range_flags,
+	          36,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_location_table_get_block_status(
+	          chunk_location_table,
+	          99,
+	          &block_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "block_status",
+	 block_status,
+	 LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_NOT_INDEXED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_sizes[ 0 ] = 0x8004;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_location_table_set_block(
+	          NULL,
+	          0,
+	          file_io_pool_entries,
+	          data_offsets,
+	          data_sizes,
+	          range_flags,
+	          LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_location_table_set_block(
+	          chunk_location_table,
+	          100,
+	          file_io_pool_entries,
+	          data_offsets,
+	          data_sizes,
+	          range_flags,
+	          LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test setting a block that was already set
+	 */
+	result = libewf_chunk_location_table_set_block(
+	          chunk_location_table,
+	          0,
+	          file_io_pool_entries,
+	          data_offsets,
+	          data_sizes,
+	          range_flags,
+	          LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_location_table_get_chunk_location(
+	          NULL,
+	          10,
+	          &file_io_pool_entry,
+	          &data_offset,
+	          &data_size,
+	          &chunk_range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_location_table_get_chunk_location(
+	          chunk_location_table,
+	          100,
+	          &file_io_pool_entry,
+	          &data_offset,
+	          &data_size,
+	          &chunk_range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_location_table_get_chunk_location(
+	          chunk_location_table,
+	          10,
+	          NULL,
+	          &data_offset,
+	          &data_size,
+	          &chunk_range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_location_table_free(
+	          &chunk_location_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_location_table",
+	 chunk_location_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_location_table != NULL )
+	{
+		libewf_chunk_location_table_free(
+		 &chunk_location_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_location_table_set_block function with a maximum size
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_location_table_set_block_maximum_size(
+     void )
+{
+	int file_io_pool_entries[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	off64_t data_offsets[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	size64_t data_sizes[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+	uint32_t range_flags[ LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE ];
+
+	libcerror_error_t *error                             = NULL;
+	libewf_chunk_location_table_t *chunk_location_table = NULL;
+	uint8_t block_status                                 = 0;
+	int entry_index                                      = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	for( entry_index = 0;
+	     entry_index < LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE;
+	     entry_index++ )
+	{
+		file_io_pool_entries[ entry_index ] = 0;
+		data_offsets[ entry_index ]         = 0x00000d00UL + ( entry_index * 0x8004 );
+		data_sizes[ entry_index ]           = 0x8004;
+		range_flags[ entry_index ]          = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	}
+	/* The maximum size only fits the block index and a single block
+	 */
+	result = libewf_chunk_location_table_initialize(
+	          &chunk_location_table,
+	          128,
+	          ( 2 * ( sizeof( libewf_chunk_location_block_t * ) + 1 ) ) + sizeof( libewf_chunk_location_block_t ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_location_table",
+	 chunk_location_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_location_table_set_block(
+	          chunk_location_table,
+	          0,
+	          file_io_pool_entries,
+	          data_offsets,
+	          data_sizes,
+	          range_flags,
+	          LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_location_table_set_block(
+	          chunk_location_table,
+	          64,
+	          file_io_pool_entries,
+	          data_offsets,
+	          data_sizes,
+	          range_flags,
+	          LIBEWF_CHUNK_LOCATION_TABLE_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a block that is marked as not indexed
+	 */
+	result = libewf_chunk_location_table_set_block_not_indexed(
+	          chunk_location_table,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_location_table_get_block_status(
+	          chunk_location_table,
+	          0,
+	          &block_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "block_status",
+	 block_status,
+	 LIBEWF_CHUNK_LOCATION_BLOCK_STATUS_NOT_INDEXED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_location_table_free(
+	          &chunk_location_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_location_table",
+	 chunk_location_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_location_table != NULL )
+	{
+		libewf_chunk_location_table_free(
+		 &chunk_location_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_location_table_initialize",
+	 ewf_test_chunk_location_table_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_location_table_free",
+	 ewf_test_chunk_location_table_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_location_table_set_block",
+	 ewf_test_chunk_location_table_set_block );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_location_table_set_block_not_indexed",
+	 ewf_test_chunk_location_table_set_block_maximum_size );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -1430,10 +1430,10 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_chunk_table_get_chunk_data_by_offset function
+/* Tests the libewf_chunk_table_grab_chunk_data_by_offset function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_chunk_table_get_chunk_data_by_offset(
+int ewf_test_chunk_table_grab_chunk_data_by_offset(
      void )
 {
 	libcerror_error_t *error          = NULL;
@@ -1499,7 +1499,7 @@ int ewf_test_chunk_table_get_chunk_data_by_offset(
 
 	/* Test error cases
 	 */
-	result = libewf_chunk_table_get_chunk_data_by_offset(
+	result = libewf_chunk_table_grab_chunk_data_by_offset(
 	          NULL,
 	          NULL,
 	          NULL,
@@ -1522,6 +1522,193 @@ int ewf_test_chunk_table_get_chunk_data_by_offset(
 	libcerror_error_free(
 	 &error );
 
+	result = libewf_chunk_table_grab_chunk_data_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_table_free(
+	          &chunk_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &chunk_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_table_release_chunk_view function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_table_release_chunk_view(
+     void )
+{
+	uint8_t data[ 16 ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_table_t *chunk_table = NULL;
+	libewf_io_handle_t *io_handle     = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_table_initialize(
+	          &chunk_table,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_table_release_chunk_view(
+	          NULL,
+	          data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_release_chunk_view(
+	          chunk_table,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test release of data that is not a chunk view
+	 */
+	result = libewf_chunk_table_release_chunk_view(
+	          chunk_table,
+	          data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 	/* Clean up
 	 */
 	result = libewf_chunk_table_free(
@@ -1629,8 +1816,12 @@ int main(
 	 ewf_test_chunk_table_get_segment_file_chunk_group_by_offset );
 
 	EWF_TEST_RUN(
-	 "libewf_chunk_table_get_chunk_data_by_offset",
-	 ewf_test_chunk_table_get_chunk_data_by_offset );
+	 "libewf_chunk_table_grab_chunk_data_by_offset",
+	 ewf_test_chunk_table_grab_chunk_data_by_offset );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_table_release_chunk_view",
+	 ewf_test_chunk_table_release_chunk_view );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
@@ -0,0 +1,1166 @@
+/*
+ * Library compression context functions test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_compression.h"
+#include "../libewf/libewf_compression_context.h"
+
+#define EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE	32768
+
+uint8_t ewf_test_compression_context_uncompressed_data[ EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE ];
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Fills the test data with compressible data
+ */
+void ewf_test_compression_context_initialize_data(
+      void )
+{
+	size_t data_offset = 0;
+	uint32_t seed      = 0x5eed1234UL;
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE;
+	     data_offset++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345UL;
+
+		/* Restrict the values to a small alphabet to make the data compressible
+		 */
+		ewf_test_compression_context_uncompressed_data[ data_offset ] = (uint8_t) 'a' + (uint8_t) ( ( seed >> 16 ) % 8 );
+	}
+}
+
+/* Tests the libewf_compression_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	int result                                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                   = 1;
+	int number_of_memset_fail_tests                   = 1;
+	int test_number                                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compression_context = (libewf_compression_context_t *) 0x12345678UL;
+
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	compression_context = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_compression_context_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_compression_context_initialize(
+		          &compression_context,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( compression_context != NULL )
+			{
+				libewf_compression_context_free(
+				 &compression_context,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "compression_context",
+			 compression_context );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_compression_context_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_compression_context_initialize(
+		          &compression_context,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( compression_context != NULL )
+			{
+				libewf_compression_context_free(
+				 &compression_context,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "compression_context",
+			 compression_context );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_context_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WRITE_SUPPORT )
+
+/* Tests the libewf_compression_context_compress_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_compress_data(
+     void )
+{
+	int8_t compression_levels[ 6 ] = {
+		LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+		LIBEWF_COMPRESSION_LEVEL_FAST,
+		LIBEWF_COMPRESSION_LEVEL_BEST,
+		LIBEWF_COMPRESSION_LEVEL_BEST,
+		LIBEWF_COMPRESSION_LEVEL_NONE,
+		LIBEWF_COMPRESSION_LEVEL_DEFAULT };
+
+	uint8_t compressed_data[ EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024 ];
+	uint8_t expected_compressed_data[ EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024 ];
+	uint8_t uncompressed_data[ EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	size_t compressed_data_size                       = 0;
+	size_t expected_compressed_data_size              = 0;
+	size_t uncompressed_data_size                     = 0;
+	int level_index                                   = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	ewf_test_compression_context_initialize_data();
+
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases, where the context is reused and the compression level changes
+	 */
+	for( level_index = 0;
+	     level_index < 6;
+	     level_index++ )
+	{
+		compressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024;
+
+		result = libewf_compression_context_compress_data(
+		          compression_context,
+		          compressed_data,
+		          &compressed_data_size,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          compression_levels[ level_index ],
+		          ewf_test_compression_context_uncompressed_data,
+		          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The compressed data should be identical to that of libewf_compress_data
+		 */
+		expected_compressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024;
+
+		result = libewf_compress_data(
+		          expected_compressed_data,
+		          &expected_compressed_data_size,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          compression_levels[ level_index ],
+		          ewf_test_compression_context_uncompressed_data,
+		          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "compressed_data_size",
+		 compressed_data_size,
+		 expected_compressed_data_size );
+
+		result = memory_compare(
+		          compressed_data,
+		          expected_compressed_data,
+		          compressed_data_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		uncompressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE;
+
+		result = libewf_compression_context_decompress_data(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          uncompressed_data,
+		          &uncompressed_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "uncompressed_data_size",
+		 uncompressed_data_size,
+		 (size_t) EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE );
+
+		result = memory_compare(
+		          uncompressed_data,
+		          ewf_test_compression_context_uncompressed_data,
+		          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test compressed data buffer too small
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_compression_context_compress_data(
+	          compression_context,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "compressed_data_size",
+	 (ssize_t) compressed_data_size,
+	 (ssize_t) 16 );
+
+	/* Test error cases
+	 */
+	compressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024;
+
+	result = libewf_compression_context_compress_data(
+	          NULL,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_compress_data(
+	          compression_context,
+	          NULL,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_compress_data(
+	          compression_context,
+	          compressed_data,
+	          NULL,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_compress_data(
+	          compression_context,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          NULL,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_compress_data(
+	          compression_context,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          -2,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_context_compress_data_with_deflate_level function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_compress_data_with_deflate_level(
+     void )
+{
+	uint8_t compressed_data[ EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024 ];
+	uint8_t uncompressed_data[ EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	size_t compressed_data_size                       = 0;
+	size_t uncompressed_data_size                     = 0;
+	int deflate_level                                 = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	ewf_test_compression_context_initialize_data();
+
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases, where the context is reused and the deflate level changes
+	 */
+	for( deflate_level = 9;
+	     deflate_level >= 0;
+	     deflate_level-- )
+	{
+		compressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024;
+
+		result = libewf_compression_context_compress_data_with_deflate_level(
+		          compression_context,
+		          compressed_data,
+		          &compressed_data_size,
+		          deflate_level,
+		          ewf_test_compression_context_uncompressed_data,
+		          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		uncompressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE;
+
+		result = libewf_compression_context_decompress_data(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          uncompressed_data,
+		          &uncompressed_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "uncompressed_data_size",
+		 uncompressed_data_size,
+		 (size_t) EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE );
+
+		result = memory_compare(
+		          uncompressed_data,
+		          ewf_test_compression_context_uncompressed_data,
+		          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	compressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024;
+
+	result = libewf_compression_context_compress_data_with_deflate_level(
+	          NULL,
+	          compressed_data,
+	          &compressed_data_size,
+	          6,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_compress_data_with_deflate_level(
+	          compression_context,
+	          compressed_data,
+	          &compressed_data_size,
+	          -1,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_compress_data_with_deflate_level(
+	          compression_context,
+	          compressed_data,
+	          &compressed_data_size,
+	          10,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_compress_data_with_deflate_level(
+	          compression_context,
+	          NULL,
+	          &compressed_data_size,
+	          6,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WRITE_SUPPORT ) */
+
+/* Tests the libewf_compression_context_decompress_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_decompress_data(
+     void )
+{
+	uint8_t compressed_data[ EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024 ];
+	uint8_t uncompressed_data[ EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	size_t compressed_data_size                       = 0;
+	size_t uncompressed_data_size                     = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	ewf_test_compression_context_initialize_data();
+
+	compressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE + 1024;
+
+	result = libewf_compress_data(
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test uncompressed data buffer too small
+	 */
+	uncompressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE / 2;
+
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE );
+
+	/* Test regular cases, after the previous decompression was incomplete
+	 */
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          ewf_test_compression_context_uncompressed_data,
+	          EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	uncompressed_data_size = EWF_TEST_COMPRESSION_CONTEXT_DATA_SIZE;
+
+	result = libewf_compression_context_decompress_data(
+	          NULL,
+	          compressed_data,
+	          compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          NULL,
+	          compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          NULL,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test decompression of truncated compressed data
+	 */
+	result = libewf_compression_context_decompress_data(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size / 2,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
+	 */
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_initialize",
+	 ewf_test_compression_context_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_free",
+	 ewf_test_compression_context_free );
+
+#if defined( HAVE_WRITE_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_compress_data",
+	 ewf_test_compression_context_compress_data );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_compress_data_with_deflate_level",
+	 ewf_test_compression_context_compress_data_with_deflate_level );
+
+#endif /* defined( HAVE_WRITE_SUPPORT ) */
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_decompress_data",
+	 ewf_test_compression_context_decompress_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,878 @@
+/*
+ * Library compression_controller type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_compression_controller.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_compression_controller_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_controller_initialize(
+     void )
+{
+	libcerror_error_t *error                                = NULL;
+	libewf_compression_controller_t *compression_controller = NULL;
+	int result                                              = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                         = 2;
+	int number_of_memset_fail_tests                         = 1;
+	int test_number                                         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_controller_initialize(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_free(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_controller_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compression_controller = (libewf_compression_controller_t *) 0x12345678UL;
+
+	result = libewf_compression_controller_initialize(
+	          &compression_controller,
+	          &error );
+
+	compression_controller = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_compression_controller_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_compression_controller_initialize(
+		          &compression_controller,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( compression_controller != NULL )
+			{
+				libewf_compression_controller_free(
+				 &compression_controller,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "compression_controller",
+			 compression_controller );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_compression_controller_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_compression_controller_initialize(
+		          &compression_controller,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( compression_controller != NULL )
+			{
+				libewf_compression_controller_free(
+				 &compression_controller,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "compression_controller",
+			 compression_controller );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_controller != NULL )
+	{
+		libewf_compression_controller_free(
+		 &compression_controller,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_controller_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_controller_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_compression_controller_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_controller_start_compression and libewf_compression_controller_stop_compression functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_controller_start_compression(
+     void )
+{
+	libcerror_error_t *error                                = NULL;
+	libewf_compression_controller_t *compression_controller = NULL;
+	uint64_t number_of_chunks                               = 0;
+	int64_t start_time                                      = 0;
+	int deflate_level                                       = 0;
+	int result                                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_compression_controller_initialize(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_reset(
+	          compression_controller,
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_controller_start_compression(
+	          compression_controller,
+	          &deflate_level,
+	          &start_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "deflate_level",
+	 deflate_level,
+	 9 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_controller->number_of_compressions",
+	 compression_controller->number_of_compressions,
+	 1 );
+
+	result = libewf_compression_controller_stop_compression(
+	          compression_controller,
+	          deflate_level,
+	          start_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_controller->number_of_compressions",
+	 compression_controller->number_of_compressions,
+	 0 );
+
+	result = libewf_compression_controller_get_number_of_chunks(
+	          compression_controller,
+	          9,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_controller_start_compression(
+	          NULL,
+	          &deflate_level,
+	          &start_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_start_compression(
+	          compression_controller,
+	          NULL,
+	          &start_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_start_compression(
+	          compression_controller,
+	          &deflate_level,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_stop_compression(
+	          NULL,
+	          deflate_level,
+	          start_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_stop_compression(
+	          compression_controller,
+	          0,
+	          start_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_reset(
+	          compression_controller,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_get_number_of_chunks(
+	          compression_controller,
+	          9,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_controller_free(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_controller != NULL )
+	{
+		libewf_compression_controller_free(
+		 &compression_controller,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_controller_update_deflate_level function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_controller_update_deflate_level(
+     void )
+{
+	libcerror_error_t *error                                = NULL;
+	libewf_compression_controller_t *compression_controller = NULL;
+	int deflate_level                                       = 0;
+	int result                                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_compression_controller_initialize(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_reset(
+	          compression_controller,
+	          6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* A compressor that is busy 95% of the time lowers the deflate level
+	 */
+	compression_controller->window_start_time                     = 0;
+	compression_controller->window_compression_time               = 950;
+	compression_controller->window_maximum_number_of_compressions = 1;
+
+	result = libewf_compression_controller_update_deflate_level(
+	          compression_controller,
+	          1000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_controller_get_deflate_level(
+	          compression_controller,
+	          &deflate_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "deflate_level",
+	 deflate_level,
+	 5 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "compression_controller->window_start_time",
+	 compression_controller->window_start_time,
+	 (int64_t) 1000 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "compression_controller->window_compression_time",
+	 compression_controller->window_compression_time,
+	 (int64_t) 0 );
+
+	/* Two concurrent compressors that are busy 30% of the time raise the deflate level
+	 */
+	compression_controller->window_compression_time               = 600;
+	compression_controller->window_maximum_number_of_compressions = 2;
+
+	result = libewf_compression_controller_update_deflate_level(
+	          compression_controller,
+	          2000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_controller->deflate_level",
+	 compression_controller->deflate_level,
+	 6 );
+
+	/* A compressor that is busy 75% of the time retains the deflate level
+	 */
+	compression_controller->window_compression_time               = 750;
+	compression_controller->window_maximum_number_of_compressions = 1;
+
+	result = libewf_compression_controller_update_deflate_level(
+	          compression_controller,
+	          3000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_controller->deflate_level",
+	 compression_controller->deflate_level,
+	 6 );
+
+	/* The deflate level does not exceed the maximum
+	 */
+	compression_controller->deflate_level                         = 9;
+	compression_controller->window_compression_time               = 0;
+	compression_controller->window_maximum_number_of_compressions = 1;
+
+	result = libewf_compression_controller_update_deflate_level(
+	          compression_controller,
+	          4000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_controller->deflate_level",
+	 compression_controller->deflate_level,
+	 9 );
+
+	/* The deflate level does not go below the minimum
+	 */
+	compression_controller->deflate_level                         = 1;
+	compression_controller->window_compression_time               = 1000;
+	compression_controller->window_maximum_number_of_compressions = 1;
+
+	result = libewf_compression_controller_update_deflate_level(
+	          compression_controller,
+	          5000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_controller->deflate_level",
+	 compression_controller->deflate_level,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_controller_update_deflate_level(
+	          NULL,
+	          6000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_get_deflate_level(
+	          NULL,
+	          &deflate_level,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_controller_get_deflate_level(
+	          compression_controller,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_controller_free(
+	          &compression_controller,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_controller",
+	 compression_controller );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_controller != NULL )
+	{
+		libewf_compression_controller_free(
+		 &compression_controller,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_controller_initialize",
+	 ewf_test_compression_controller_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_controller_free",
+	 ewf_test_compression_controller_free );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_controller_start_compression",
+	 ewf_test_compression_controller_start_compression );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_controller_update_deflate_level",
+	 ewf_test_compression_controller_update_deflate_level );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -40,11 +42,18 @@
 #include "ewf_test_getopt.h"
 #include "ewf_test_libbfio.h"
 #include "ewf_test_libcerror.h"
+#include "ewf_test_libcfile.h"
 #include "ewf_test_libewf.h"
 #include "ewf_test_macros.h"
 #include "ewf_test_memory.h"
 
+#include "../libewf/ewf_segment_files_index.h"
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_definitions.h"
 #include "../libewf/libewf_handle.h"
+#include "../libewf/libewf_segment_file.h"
+#include "../libewf/libewf_segment_files_index.h"
+#include "../libewf/libewf_segment_table.h"
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
 #error Unsupported size of wchar_t
@@ -56,6 +65,11 @@
 
 #define EWF_TEST_HANDLE_READ_BUFFER_SIZE	4096
 
+#define EWF_TEST_HANDLE_INDEX_DATA_SIZE		1024 * 1024
+
+#define EWF_TEST_HANDLE_INDEX_FILENAME		"ewf_test_handle.idx"
+#define EWF_TEST_HANDLE_INDEX_FILENAME_WIDE	L"ewf_test_handle.idx"
+
 #if !defined( LIBEWF_HAVE_BFIO )
 
 LIBEWF_EXTERN \
@@ -1380,167 +1394,3588 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_close function
- * Returns 1 if successful or 0 if not
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Reads the segment files index file
+ * Returns 1 if successful, 0 if the file does not exist or -1 on error
  */
-int ewf_test_handle_close(
-     void )
+int ewf_test_handle_read_index_file(
+     uint8_t *data,
+     size_t data_size,
+     size_t *read_size,
+     libcerror_error_t **error )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
-
-	/* Test error cases
-	 */
-	result = libewf_handle_close(
-	          NULL,
-	          &error );
+	libcfile_file_t *file = NULL;
+	static char *function = "ewf_test_handle_read_index_file";
+	size64_t file_size    = 0;
+	ssize_t read_count    = 0;
+	int result            = 0;
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
 
-	libcerror_error_free(
-	 &error );
+		return( -1 );
+	}
+	result = libcfile_file_exists(
+	          EWF_TEST_HANDLE_INDEX_FILENAME,
+	          error );
 
-	return( 1 );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if index file exists.",
+		 function );
 
-on_error:
-	if( error != NULL )
+		return( -1 );
+	}
+	else if( result == 0 )
 	{
-		libcerror_error_free(
-		 &error );
+		return( 0 );
 	}
-	return( 0 );
-}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
 
-/* Tests the libewf_handle_open and libewf_handle_close functions
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_open_close(
-     const system_character_t *source )
-{
-	libcerror_error_t *error       = NULL;
-	libewf_handle_t *handle        = NULL;
-	system_character_t **filenames = NULL;
-	size_t source_length           = 0;
-	int number_of_filenames        = 0;
-	int result                     = 0;
+		goto on_error;
+	}
+	if( libcfile_file_open(
+	     file,
+	     EWF_TEST_HANDLE_INDEX_FILENAME,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
 
-	/* Initialize test
-	 */
-	source_length = system_string_length(
-	                 source );
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index file size.",
+		 function );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_glob_wide(
-	          source,
-	          source_length,
-	          LIBEWF_FORMAT_UNKNOWN,
-	          &filenames,
-	          &number_of_filenames,
-	          &error );
-#else
-	result = libewf_glob(
-	          source,
-	          source_length,
-	          LIBEWF_FORMAT_UNKNOWN,
-	          &filenames,
-	          &number_of_filenames,
-	          &error );
-#endif
+		goto on_error;
+	}
+	if( file_size > (size64_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index file size value out of bounds.",
+		 function );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+		goto on_error;
+	}
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              data,
+	              (size_t) file_size,
+	              error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "filenames",
-	 filenames );
+	if( read_count != (ssize_t) file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file.",
+		 function );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
 
-	result = libewf_handle_initialize(
-	          &handle,
-	          &error );
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+		goto on_error;
+	}
+	*read_size = (size_t) file_size;
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
+	return( 1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
 
-	/* Test open and close
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_handle_open_wide(
-	          handle,
-	          (wchar_t * const *) filenames,
-	          number_of_filenames,
-	          LIBEWF_OPEN_READ,
-	          &error );
-#else
-	result = libewf_handle_open(
-	          handle,
-	          (char * const *) filenames,
-	          number_of_filenames,
-	          LIBEWF_OPEN_READ,
-	          &error );
-#endif
+/* Writes the segment files index file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_write_index_file(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *file = NULL;
+	static char *function = "ewf_test_handle_write_index_file";
+	ssize_t write_count   = 0;
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		goto on_error;
+	}
+	if( libcfile_file_open(
+	     file,
+	     EWF_TEST_HANDLE_INDEX_FILENAME,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
 
-	result = libewf_handle_close(
-	          handle,
-	          &error );
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               data,
+	               data_size,
+	               error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 0 );
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file.",
+		 function );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
 
-	/* Test open and close a second time to validate clean up on close
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_handle_open_wide(
-	          handle,
-	          (wchar_t * const *) filenames,
-	          number_of_filenames,
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens and closes a handle that uses the segment files index
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_open_close_with_index(
+     char * const *filenames,
+     int number_of_filenames,
+     size64_t *media_size,
+     uint8_t *last_segment_file_read_from_index,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle             = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "ewf_test_handle_open_close_with_index";
+	uint32_t number_of_segments         = 0;
+
+	if( last_segment_file_read_from_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid last segment file read from index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_index_filename(
+	     handle,
+	     EWF_TEST_HANDLE_INDEX_FILENAME,
+	     narrow_string_length( EWF_TEST_HANDLE_INDEX_FILENAME ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set index filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	/* The last segment file is the one most recently read hence it is still cached
+	 */
+	if( libewf_segment_table_get_number_of_segments(
+	     ( (libewf_internal_handle_t *) handle )->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_table_get_segment_file_by_index(
+	     ( (libewf_internal_handle_t *) handle )->segment_table,
+	     number_of_segments - 1,
+	     ( (libewf_internal_handle_t *) handle )->file_io_pool,
+	     &segment_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve last segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing last segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_READ_FROM_INDEX ) != 0 )
+	{
+		*last_segment_file_read_from_index = 1;
+	}
+	else
+	{
+		*last_segment_file_read_from_index = 0;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests opening a handle with a segment files index
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_open_with_index(
+     const system_character_t *source )
+{
+	char narrow_source[ 256 ];
+
+	ewf_segment_files_index_entry_t *index_entry = NULL;
+	libcerror_error_t *error                     = NULL;
+	char **filenames                             = NULL;
+	uint8_t *index_data                          = NULL;
+	uint8_t *modified_index_data                 = NULL;
+	uint8_t *read_index_data                     = NULL;
+	size64_t index_media_size                    = 0;
+	size64_t media_size                          = 0;
+	size_t entry_offset                          = 0;
+	size_t index_data_size                       = 0;
+	size_t narrow_source_length                  = 0;
+	size_t read_index_data_size                  = 0;
+	uint64_t segment_file_size                   = 0;
+	uint32_t checksum                            = 0;
+	uint32_t entry_size                          = 0;
+	uint32_t number_of_entries                   = 0;
+	uint32_t segment_number                      = 0;
+	uint8_t last_segment_file_read_from_index    = 0;
+	int number_of_filenames                      = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	narrow_source_length = narrow_string_length(
+	                        narrow_source );
+
+	result = libewf_glob(
+	          narrow_source,
+	          narrow_source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	index_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * EWF_TEST_HANDLE_INDEX_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_data",
+	 index_data );
+
+	modified_index_data = (uint8_t *) memory_allocate(
+	                                   sizeof( uint8_t ) * EWF_TEST_HANDLE_INDEX_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "modified_index_data",
+	 modified_index_data );
+
+	read_index_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * EWF_TEST_HANDLE_INDEX_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_index_data",
+	 read_index_data );
+
+	/* Remove an index file left behind by a previous run
+	 */
+	libcfile_file_remove(
+	 EWF_TEST_HANDLE_INDEX_FILENAME,
+	 NULL );
+
+	/* Test if opening a handle writes the segment files index
+	 */
+	result = ewf_test_handle_open_close_with_index(
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          &media_size,
+	          &last_segment_file_read_from_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "last_segment_file_read_from_index",
+	 last_segment_file_read_from_index,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_read_index_file(
+	          index_data,
+	          EWF_TEST_HANDLE_INDEX_DATA_SIZE,
+	          &index_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The first segment file is read before the chunk size is known and has no entry,
+	 * hence there is no index file if the image consists of a single segment file
+	 */
+	if( result != 0 )
+	{
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "index_data_size",
+		 (int) index_data_size,
+		 (int) sizeof( ewf_segment_files_index_header_t ) );
+
+		result = memory_compare(
+		          ( (ewf_segment_files_index_header_t *) index_data )->signature,
+		          ewf_segment_files_index_signature,
+		          8 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_segment_files_index_header_t *) index_data )->number_of_entries,
+		 number_of_entries );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "number_of_entries",
+		 (int) number_of_entries,
+		 0 );
+
+		/* Test if reopening restores the segment files from the segment files index
+		 * The header padding is not covered by the checksum, a marker in the padding
+		 * is only preserved when the segment files index is not rewritten
+		 */
+		memory_copy(
+		 modified_index_data,
+		 index_data,
+		 index_data_size );
+
+		memory_set(
+		 ( (ewf_segment_files_index_header_t *) modified_index_data )->padding,
+		 0xff,
+		 4 );
+
+		result = ewf_test_handle_write_index_file(
+		          modified_index_data,
+		          index_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_open_close_with_index(
+		          (char * const *) filenames,
+		          number_of_filenames,
+		          &index_media_size,
+		          &last_segment_file_read_from_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "index_media_size",
+		 (uint64_t) index_media_size,
+		 (uint64_t) media_size );
+
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "last_segment_file_read_from_index",
+		 last_segment_file_read_from_index,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_read_index_file(
+		          read_index_data,
+		          EWF_TEST_HANDLE_INDEX_DATA_SIZE,
+		          &read_index_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "read_index_data_size",
+		 read_index_data_size,
+		 index_data_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          read_index_data,
+		          modified_index_data,
+		          index_data_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test if a stale entry of the last segment file is rejected and rewritten
+		 */
+		memory_copy(
+		 modified_index_data,
+		 index_data,
+		 index_data_size );
+
+		memory_set(
+		 ( (ewf_segment_files_index_header_t *) modified_index_data )->padding,
+		 0xff,
+		 4 );
+
+		entry_offset = sizeof( ewf_segment_files_index_header_t );
+
+		while( entry_offset < index_data_size )
+		{
+			index_entry = (ewf_segment_files_index_entry_t *) &( modified_index_data[ entry_offset ] );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 index_entry->entry_size,
+			 entry_size );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 index_entry->segment_number,
+			 segment_number );
+
+			if( ( entry_size == 0 )
+			 || ( segment_number == (uint32_t) number_of_filenames ) )
+			{
+				break;
+			}
+			entry_offset += entry_size;
+		}
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "segment_number",
+		 segment_number,
+		 (uint32_t) number_of_filenames );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_entry->segment_file_size,
+		 segment_file_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_entry->segment_file_size,
+		 segment_file_size + 1 );
+
+		result = libewf_checksum_calculate_adler32(
+		          &checksum,
+		          &( modified_index_data[ sizeof( ewf_segment_files_index_header_t ) ] ),
+		          index_data_size - sizeof( ewf_segment_files_index_header_t ),
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_segment_files_index_header_t *) modified_index_data )->checksum,
+		 checksum );
+
+		result = ewf_test_handle_write_index_file(
+		          modified_index_data,
+		          index_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_open_close_with_index(
+		          (char * const *) filenames,
+		          number_of_filenames,
+		          &index_media_size,
+		          &last_segment_file_read_from_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "index_media_size",
+		 (uint64_t) index_media_size,
+		 (uint64_t) media_size );
+
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "last_segment_file_read_from_index",
+		 last_segment_file_read_from_index,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_read_index_file(
+		          read_index_data,
+		          EWF_TEST_HANDLE_INDEX_DATA_SIZE,
+		          &read_index_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "read_index_data_size",
+		 read_index_data_size,
+		 index_data_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          read_index_data,
+		          index_data,
+		          index_data_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test if a segment files index with an invalid checksum is ignored and rewritten
+		 */
+		memory_copy(
+		 modified_index_data,
+		 index_data,
+		 index_data_size );
+
+		( (ewf_segment_files_index_header_t *) modified_index_data )->checksum[ 0 ] ^= 0xff;
+
+		result = ewf_test_handle_write_index_file(
+		          modified_index_data,
+		          index_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_open_close_with_index(
+		          (char * const *) filenames,
+		          number_of_filenames,
+		          &index_media_size,
+		          &last_segment_file_read_from_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "index_media_size",
+		 (uint64_t) index_media_size,
+		 (uint64_t) media_size );
+
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "last_segment_file_read_from_index",
+		 last_segment_file_read_from_index,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_read_index_file(
+		          read_index_data,
+		          EWF_TEST_HANDLE_INDEX_DATA_SIZE,
+		          &read_index_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          read_index_data,
+		          index_data,
+		          index_data_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Clean up
+	 */
+	libcfile_file_remove(
+	 EWF_TEST_HANDLE_INDEX_FILENAME,
+	 NULL );
+
+	memory_free(
+	 read_index_data );
+
+	read_index_data = NULL;
+
+	memory_free(
+	 modified_index_data );
+
+	modified_index_data = NULL;
+
+	memory_free(
+	 index_data );
+
+	index_data = NULL;
+
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libcfile_file_remove(
+	 EWF_TEST_HANDLE_INDEX_FILENAME,
+	 NULL );
+
+	if( read_index_data != NULL )
+	{
+		memory_free(
+		 read_index_data );
+	}
+	if( modified_index_data != NULL )
+	{
+		memory_free(
+		 modified_index_data );
+	}
+	if( index_data != NULL )
+	{
+		memory_free(
+		 index_data );
+	}
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* Tests the libewf_handle_close function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_close(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_close(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_open and libewf_handle_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_open_close(
+     const system_character_t *source )
+{
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *handle        = NULL;
+	system_character_t **filenames = NULL;
+	size_t source_length           = 0;
+	int number_of_filenames        = 0;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	source_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide(
+	          source,
+	          source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+#else
+	result = libewf_glob(
+	          source,
+	          source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+#endif
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "filenames",
+	 filenames );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          (wchar_t * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#endif
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          (wchar_t * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
 	          LIBEWF_OPEN_READ,
 	          &error );
-#else
-	result = libewf_handle_open(
+#endif
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+#else
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+#endif
+	filenames = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_signal_abort(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_signal_abort(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_signal_abort(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error      = NULL;
+	time_t timestamp              = 0;
+	size64_t media_size           = 0;
+	size64_t remaining_media_size = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	off64_t offset                = 0;
+	off64_t read_offset           = 0;
+	int number_of_tests           = 1024;
+	int random_number             = 0;
+	int result                    = 0;
+	int test_number               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+	if( media_size < EWF_TEST_HANDLE_READ_BUFFER_SIZE )
+	{
+		read_size = (size_t) media_size;
+	}
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 8 )
+	{
+		/* Set offset to media_size - 8
+		 */
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          -8,
+		          SEEK_END,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) media_size - 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Stress test read buffer
+	 */
+	timestamp = time(
+	             NULL );
+
+	srand(
+	 (unsigned int) timestamp );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	remaining_media_size = media_size;
+
+	for( test_number = 0;
+	     test_number < number_of_tests;
+	     test_number++ )
+	{
+		random_number = rand();
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "random_number",
+		 random_number,
+		 -1 );
+
+		read_size = (size_t) random_number % EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+#if defined( EWF_TEST_HANDLE_VERBOSE )
+		fprintf(
+		 stdout,
+		 "libewf_handle_read_buffer: at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
+		 read_offset,
+		 read_offset,
+		 read_size );
+#endif
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              &error );
+
+		if( read_size > remaining_media_size )
+		{
+			read_size = (size_t) remaining_media_size;
+		}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_offset += read_count;
+
+		result = libewf_handle_get_offset(
+		          handle,
+		          &offset,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 read_offset );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		remaining_media_size -= read_count;
+
+		if( remaining_media_size == 0 )
+		{
+			offset = libewf_handle_seek_offset(
+			          handle,
+			          0,
+			          SEEK_SET,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT64(
+			 "offset",
+			 offset,
+			 (int64_t) 0 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			read_offset = 0;
+
+			remaining_media_size = media_size;
+		}
+	}
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_buffer(
+	              NULL,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              NULL,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_RWLOCK )
+
+	/* Test libewf_handle_read_buffer with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	 */
+	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              buffer,
+	              EWF_TEST_PARTITION_READ_BUFFER_SIZE,
+	              &error );
+
+	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libewf_handle_read_buffer with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	 */
+	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              buffer,
+	              EWF_TEST_PARTITION_READ_BUFFER_SIZE,
+	              &error );
+
+	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error      = NULL;
+	time_t timestamp              = 0;
+	size64_t media_size           = 0;
+	size64_t remaining_media_size = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	off64_t current_offset        = 0;
+	off64_t offset                = 0;
+	off64_t read_offset           = 0;
+	int number_of_tests           = 1024;
+	int random_number             = 0;
+	int result                    = 0;
+	int test_number               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+	if( media_size < EWF_TEST_HANDLE_READ_BUFFER_SIZE )
+	{
+		read_size = (size_t) media_size;
+	}
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 8 )
+	{
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+		              media_size - 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+		              media_size + 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test that an abort signalled before the read does not apply to the read
+	 */
+	result = libewf_handle_signal_abort(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_offset(
+	          handle,
+	          &current_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Stress test read buffer
+	 */
+	timestamp = time(
+	             NULL );
+
+	srand(
+	 (unsigned int) timestamp );
+
+	for( test_number = 0;
+	     test_number < number_of_tests;
+	     test_number++ )
+	{
+		random_number = rand();
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "random_number",
+		 random_number,
+		 -1 );
+
+		if( media_size > 0 )
+		{
+			read_offset = (off64_t) random_number % media_size;
+		}
+		read_size = (size_t) random_number % EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+
+#if defined( EWF_TEST_HANDLE_VERBOSE )
+		fprintf(
+		 stdout,
+		 "libewf_handle_read_buffer_at_offset: at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
+		 read_offset,
+		 read_offset,
+		 read_size );
+#endif
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		remaining_media_size = media_size - read_offset;
+
+		if( read_size > remaining_media_size )
+		{
+			read_size = (size_t) remaining_media_size;
+		}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The current offset is not changed by a read at a specific offset
+		 */
+		result = libewf_handle_get_offset(
+		          handle,
+		          &offset,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 current_offset );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              NULL,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_RWLOCK )
+
+	/* Test libewf_handle_read_buffer_at_offset with pthread_rwlock_rdlock failing in libcthreads_read_write_lock_grab_for_read
+	 */
+	ewf_test_pthread_rwlock_rdlock_attempts_before_fail = 0;
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	if( ewf_test_pthread_rwlock_rdlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_rdlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libewf_handle_read_buffer_at_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_read
+	 */
+	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffers_at_offsets function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer1[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t buffer2[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t buffer3[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	void *buffers[ 3 ]            = { buffer1, buffer2, buffer3 };
+	size_t buffer_sizes[ 3 ]      = { EWF_TEST_HANDLE_READ_BUFFER_SIZE, EWF_TEST_HANDLE_READ_BUFFER_SIZE / 2, EWF_TEST_HANDLE_READ_BUFFER_SIZE };
+	off64_t offsets[ 3 ]          = { 0, 0, 0 };
+	ssize_t read_counts[ 3 ]      = { 0, 0, 0 };
+	libcerror_error_t *error      = NULL;
+	size64_t media_size           = 0;
+	ssize_t read_count            = 0;
+	int result                    = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	offsets[ 1 ] = (off64_t) ( media_size / 2 );
+	offsets[ 2 ] = (off64_t) media_size + 8;
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          3,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 2 ]",
+	 read_counts[ 2 ],
+	 (ssize_t) 0 );
+
+	/* The data must match that of individual reads
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              buffer_sizes[ 0 ],
+	              offsets[ 0 ],
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 read_counts[ 0 ] );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer1,
+	          expected_buffer,
+	          (size_t) read_count );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              buffer_sizes[ 1 ],
+	              offsets[ 1 ],
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 read_counts[ 1 ] );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer2,
+	          expected_buffer,
+	          (size_t) read_count );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that an abort signalled before the read does not apply to the read
+	 */
+	result = libewf_handle_signal_abort(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          3,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 1 ]",
+	 read_counts[ 1 ],
+	 read_count );
+
+	/* Test with no buffers
+	 */
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          0,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_read_buffers_at_offsets(
+	          NULL,
+	          3,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          -1,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          3,
+	          NULL,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          3,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 0 ] = -1;
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          3,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          &error );
+
+	offsets[ 0 ] = 0;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_view and libewf_handle_release_chunk_view functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_view(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	const uint8_t *data      = NULL;
+	size64_t media_size      = 0;
+	size_t data_size         = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 0 )
+	{
+		result = libewf_handle_get_chunk_view(
+		          handle,
+		          0,
+		          &data,
+		          &data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "data",
+		 data );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "data_size",
+		 (ssize_t) data_size,
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The view must contain the same data as a buffered read
+		 */
+		read_size = data_size;
+
+		if( read_size > EWF_TEST_HANDLE_READ_BUFFER_SIZE )
+		{
+			read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          data,
+		          buffer,
+		          read_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libewf_handle_release_chunk_view(
+		          handle,
+		          data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test releasing a view that was already released
+		 */
+		result = libewf_handle_release_chunk_view(
+		          handle,
+		          data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test view beyond media_size boundary
+	 */
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          (off64_t) media_size + 8,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_view(
+	          NULL,
+	          0,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          -1,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          &data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_release_chunk_view(
+	          NULL,
+	          buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_release_chunk_view(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_data_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_data_chunk(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_data_chunk_t *data_chunk = NULL;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          NULL,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_seek_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_RWLOCK )
+
+	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	 */
+	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	 */
+	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_offset(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_next_data_region function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_next_data_region(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t data_size       = 0;
+	size64_t media_size      = 0;
+	off64_t data_offset      = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_next_data_region(
+	          handle,
+	          0,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "data_size",
+		 (int64_t) data_size,
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_LESS_THAN_UINT64(
+		 "data_offset + data_size",
+		 (uint64_t) data_offset + data_size,
+		 (uint64_t) media_size + 1 );
+	}
+	result = libewf_handle_get_next_data_region(
+	          handle,
+	          (off64_t) media_size,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_next_data_region(
+	          NULL,
+	          0,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_next_data_region(
+	          handle,
+	          -1,
+	          &data_offset,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_next_data_region(
+	          handle,
+	          0,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_next_data_region(
+	          handle,
+	          0,
+	          &data_offset,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_information function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_information(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	size64_t media_size       = 0;
+	uint64_t number_of_chunks = 0;
+	uint32_t chunk_flags      = 0;
+	size32_t chunk_data_size  = 0;
+	size32_t chunk_size       = 0;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "chunk_size",
+	 (int) chunk_size,
+	 0 );
+
+	number_of_chunks = ( media_size + chunk_size - 1 ) / chunk_size;
+
+	/* Test regular cases
+	 */
+	if( number_of_chunks > 0 )
+	{
+		result = libewf_handle_get_chunk_information(
+		          handle,
+		          0,
+		          &chunk_data_size,
+		          &chunk_flags,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_get_chunk_information(
+		          handle,
+		          number_of_chunks - 1,
+		          &chunk_data_size,
+		          &chunk_flags,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_information(
+	          NULL,
+	          0,
+	          &chunk_data_size,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_information(
+	          handle,
+	          number_of_chunks,
+	          &chunk_data_size,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_information(
+	          handle,
+	          0,
+	          NULL,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_information(
+	          handle,
+	          0,
+	          &chunk_data_size,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_information_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_information_entries(
+     libewf_handle_t *handle )
+{
+	uint32_t chunk_flags[ 16 ];
+	size32_t chunk_data_sizes[ 16 ];
+
+	libcerror_error_t *error  = NULL;
+	size64_t media_size       = 0;
+	size_t number_of_entries  = 0;
+	uint64_t number_of_chunks = 0;
+	size32_t chunk_size       = 0;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "chunk_size",
+	 (int) chunk_size,
+	 0 );
+
+	number_of_chunks = ( media_size + chunk_size - 1 ) / chunk_size;
+
+	/* Test regular cases
+	 */
+	if( number_of_chunks > 0 )
+	{
+		result = libewf_handle_get_chunk_information_entries(
+		          handle,
+		          0,
+		          chunk_data_sizes,
+		          chunk_flags,
+		          16,
+		          &number_of_entries,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "number_of_entries",
+		 number_of_entries,
+		 (size_t) ( ( number_of_chunks < 16 ) ? number_of_chunks : 16 ) );
+	}
+	result = libewf_handle_get_chunk_information_entries(
+	          handle,
+	          number_of_chunks,
+	          chunk_data_sizes,
+	          chunk_flags,
+	          16,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "number_of_entries",
+	 number_of_entries,
+	 (size_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_information_entries(
+	          NULL,
+	          0,
+	          chunk_data_sizes,
+	          chunk_flags,
+	          16,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_information_entries(
+	          handle,
+	          0,
+	          NULL,
+	          chunk_flags,
+	          16,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_information_entries(
+	          handle,
+	          0,
+	          chunk_data_sizes,
+	          NULL,
+	          16,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_information_entries(
+	          handle,
+	          0,
+	          chunk_data_sizes,
+	          chunk_flags,
+	          (size_t) SSIZE_MAX + 1,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_information_entries(
 	          handle,
-	          (char * const *) filenames,
-	          number_of_filenames,
-	          LIBEWF_OPEN_READ,
+	          0,
+	          chunk_data_sizes,
+	          chunk_flags,
+	          16,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_maximum_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_maximum_cache_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error    = NULL;
+	size64_t maximum_cache_size = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_maximum_cache_size(
+	          handle,
+	          &maximum_cache_size,
 	          &error );
-#endif
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1551,23 +4986,101 @@ int ewf_test_handle_open_close(
 	 "error",
 	 error );
 
-	result = libewf_handle_close(
+	result = libewf_handle_set_maximum_cache_size(
 	          handle,
+	          maximum_cache_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Clean up
+	/* Test error cases
 	 */
-	result = libewf_handle_free(
-	          &handle,
+	result = libewf_handle_get_maximum_cache_size(
+	          NULL,
+	          &maximum_cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_maximum_cache_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_cache_size(
+	          NULL,
+	          maximum_cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_cache_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_cache_statistics(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          &number_of_misses,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1576,35 +5089,160 @@ int ewf_test_handle_open_close(
 	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_cache_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_data_pool_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_data_pool_statistics(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error       = NULL;
+	uint64_t number_of_allocations = 0;
+	uint64_t number_of_reuses      = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_chunk_data_pool_statistics(
+	          handle,
+	          &number_of_allocations,
+	          &number_of_reuses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_glob_wide_free(
-	          filenames,
-	          number_of_filenames,
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_data_pool_statistics(
+	          NULL,
+	          &number_of_allocations,
+	          &number_of_reuses,
 	          &error );
-#else
-	result = libewf_glob_free(
-	          filenames,
-	          number_of_filenames,
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_data_pool_statistics(
+	          handle,
+	          NULL,
+	          &number_of_reuses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_data_pool_statistics(
+	          handle,
+	          &number_of_allocations,
+	          NULL,
 	          &error );
-#endif
-	filenames = NULL;
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
+	libcerror_error_free(
+	 &error );
+
 	return( 1 );
 
 on_error:
@@ -1613,42 +5251,56 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( handle != NULL )
-	{
-		libewf_handle_free(
-		 &handle,
-		 NULL );
-	}
-	if( filenames != NULL )
-	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		libewf_glob_wide_free(
-		 filenames,
-		 number_of_filenames,
-		 NULL );
-#else
-		libewf_glob_free(
-		 filenames,
-		 number_of_filenames,
-		 NULL );
-#endif
-	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_signal_abort function
+/* Tests the libewf_handle_get_read_ahead_values and libewf_handle_set_read_ahead_values functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_signal_abort(
+int ewf_test_handle_get_read_ahead_values(
      libewf_handle_t *handle )
 {
 	libcerror_error_t *error = NULL;
+	int number_of_chunks     = 0;
+	int number_of_threads    = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_signal_abort(
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          &number_of_chunks,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_read_ahead_values(
 	          handle,
+	          number_of_chunks,
+	          number_of_threads,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1662,8 +5314,10 @@ int ewf_test_handle_signal_abort(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_signal_abort(
+	result = libewf_handle_get_read_ahead_values(
 	          NULL,
+	          &number_of_chunks,
+	          &number_of_threads,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1678,322 +5332,296 @@ int ewf_test_handle_signal_abort(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          NULL,
+	          &number_of_threads,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-/* Tests the libewf_handle_read_buffer function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_read_buffer(
-     libewf_handle_t *handle )
-{
-	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	libcerror_error_t *error      = NULL;
-	time_t timestamp              = 0;
-	size64_t media_size           = 0;
-	size64_t remaining_media_size = 0;
-	size_t read_size              = 0;
-	ssize_t read_count            = 0;
-	off64_t offset                = 0;
-	off64_t read_offset           = 0;
-	int number_of_tests           = 1024;
-	int random_number             = 0;
-	int result                    = 0;
-	int test_number               = 0;
+	libcerror_error_free(
+	 &error );
 
-	/* Determine size
-	 */
-	result = libewf_handle_get_media_size(
+	result = libewf_handle_get_read_ahead_values(
 	          handle,
-	          &media_size,
+	          &number_of_chunks,
+	          NULL,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_ahead_values(
+	          NULL,
+	          number_of_chunks,
+	          number_of_threads,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+	libcerror_error_free(
+	 &error );
 
-	if( media_size < EWF_TEST_HANDLE_READ_BUFFER_SIZE )
-	{
-		read_size = (size_t) media_size;
-	}
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              buffer,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-	              &error );
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          -1,
+	          number_of_threads,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) read_size );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	if( media_size > 8 )
-	{
-		/* Set offset to media_size - 8
-		 */
-		offset = libewf_handle_seek_offset(
-		          handle,
-		          -8,
-		          SEEK_END,
-		          &error );
+	libcerror_error_free(
+	 &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) media_size - 8 );
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          number_of_chunks,
+	          -1,
+	          &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-		              &error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+	libcerror_error_free(
+	 &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	return( 1 );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-		              &error );
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	/* Stress test read buffer
-	 */
-	timestamp = time(
-	             NULL );
+/* Tests the libewf_internal_handle_read_ahead_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_internal_handle_read_ahead_chunk(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
 
-	srand(
-	 (unsigned int) timestamp );
+	libcerror_error_t *error         = NULL;
+	size64_t media_size              = 0;
+	size32_t chunk_size              = 0;
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+	uint64_t chunk_index             = 0;
+	uint64_t number_of_hits          = 0;
+	uint64_t number_of_misses        = 0;
+	uint64_t read_number_of_hits     = 0;
+	uint64_t read_number_of_misses   = 0;
+	int number_of_read_ahead_chunks  = 0;
+	int number_of_read_ahead_threads = 0;
+	int read_ahead_values_changed    = 0;
+	int result                       = 0;
 
-	offset = libewf_handle_seek_offset(
+	/* Initialize test
+	 */
+	result = libewf_handle_get_media_size(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          &media_size,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	remaining_media_size = media_size;
-
-	for( test_number = 0;
-	     test_number < number_of_tests;
-	     test_number++ )
-	{
-		random_number = rand();
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
 
-		EWF_TEST_ASSERT_GREATER_THAN_INT(
-		 "random_number",
-		 random_number,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		read_size = (size_t) random_number % EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "chunk_size",
+	 (int) chunk_size,
+	 0 );
 
-#if defined( EWF_TEST_HANDLE_VERBOSE )
-		fprintf(
-		 stdout,
-		 "libewf_handle_read_buffer: at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
-		 read_offset,
-		 read_offset,
-		 read_size );
-#endif
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              read_size,
-		              &error );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		if( read_size > remaining_media_size )
-		{
-			read_size = (size_t) remaining_media_size;
-		}
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) read_size );
+	if( media_size == 0 )
+	{
+		return( 1 );
+	}
+	/* The read-ahead is disabled so that only the test reads chunks into the cache
+	 */
+	result = libewf_handle_get_read_ahead_values(
+	          handle,
+	          &number_of_read_ahead_chunks,
+	          &number_of_read_ahead_threads,
+	          &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		read_offset += read_count;
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		result = libewf_handle_get_offset(
-		          handle,
-		          &offset,
-		          &error );
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          0,
+	          0,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 read_offset );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	read_ahead_values_changed = 1;
 
-		remaining_media_size -= read_count;
+	/* Test that a chunk that was read ahead is served from the chunk cache
+	 */
+	chunk_index = ( media_size - 1 ) / chunk_size;
 
-		if( remaining_media_size == 0 )
-		{
-			offset = libewf_handle_seek_offset(
-			          handle,
-			          0,
-			          SEEK_SET,
-			          &error );
+	read_size = (size_t) ( media_size - ( chunk_index * chunk_size ) );
 
-			EWF_TEST_ASSERT_EQUAL_INT64(
-			 "offset",
-			 offset,
-			 (int64_t) 0 );
+	if( read_size > 16 )
+	{
+		read_size = 16;
+	}
+	result = libewf_internal_handle_read_ahead_chunk(
+	          (libewf_internal_handle_t *) handle,
+	          chunk_index,
+	          &error );
 
-			EWF_TEST_ASSERT_IS_NULL(
-			 "error",
-			 error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-			read_offset = 0;
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-			remaining_media_size = media_size;
-		}
-	}
-	/* Reset offset to 0
-	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_cache_statistics(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          &number_of_hits,
+	          &number_of_misses,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	read_count = libewf_handle_read_buffer(
-	              NULL,
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
 	              buffer,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              read_size,
+	              (off64_t) ( chunk_index * chunk_size ),
 	              &error );
 
 	EWF_TEST_ASSERT_EQUAL_SSIZE(
 	 "read_count",
 	 read_count,
-	 (ssize_t) -1 );
+	 (ssize_t) read_size );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              NULL,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-	              &error );
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          &read_number_of_hits,
+	          &read_number_of_misses,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_number_of_hits",
+	 read_number_of_hits,
+	 number_of_hits + 1 );
 
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              &error );
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_number_of_misses",
+	 read_number_of_misses,
+	 number_of_misses );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	/* Test error cases
+	 */
+	result = libewf_internal_handle_read_ahead_chunk(
+	          NULL,
+	          chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2002,65 +5630,41 @@ int ewf_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_EWF_TEST_RWLOCK )
-
-	/* Test libewf_handle_read_buffer with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
-	 */
-	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+	result = libewf_internal_handle_read_ahead_chunk(
+	          (libewf_internal_handle_t *) handle,
+	          (uint64_t) INT64_MAX,
+	          &error );
 
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              buffer,
-	              EWF_TEST_PARTITION_READ_BUFFER_SIZE,
-	              &error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) -1 );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	/* Test libewf_handle_read_buffer with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	/* Clean up
 	 */
-	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
-
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              buffer,
-	              EWF_TEST_PARTITION_READ_BUFFER_SIZE,
-	              &error );
+	read_ahead_values_changed = 0;
 
-	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) -1 );
+	result = libewf_handle_set_read_ahead_values(
+	          handle,
+	          number_of_read_ahead_chunks,
+	          number_of_read_ahead_threads,
+	          &error );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	return( 1 );
 
@@ -2070,35 +5674,34 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( read_ahead_values_changed != 0 )
+	{
+		libewf_handle_set_read_ahead_values(
+		 handle,
+		 number_of_read_ahead_chunks,
+		 number_of_read_ahead_threads,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_read_buffer_at_offset function
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Tests the libewf_handle_get_number_of_write_threads and libewf_handle_set_number_of_write_threads functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_read_buffer_at_offset(
+int ewf_test_handle_get_number_of_write_threads(
      libewf_handle_t *handle )
 {
-	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
-
-	libcerror_error_t *error      = NULL;
-	time_t timestamp              = 0;
-	size64_t media_size           = 0;
-	size64_t remaining_media_size = 0;
-	size_t read_size              = 0;
-	ssize_t read_count            = 0;
-	off64_t offset                = 0;
-	off64_t read_offset           = 0;
-	int number_of_tests           = 1024;
-	int random_number             = 0;
-	int result                    = 0;
-	int test_number               = 0;
+	libcerror_error_t *error = NULL;
+	int number_of_threads    = 0;
+	int result               = 0;
 
-	/* Determine size
+	/* Test regular cases
 	 */
-	result = libewf_handle_get_media_size(
+	result = libewf_handle_get_number_of_write_threads(
 	          handle,
-	          &media_size,
+	          &number_of_threads,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2110,176 +5713,152 @@ int ewf_test_handle_read_buffer_at_offset(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	read_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
-
-	if( media_size < EWF_TEST_HANDLE_READ_BUFFER_SIZE )
-	{
-		read_size = (size_t) media_size;
-	}
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-	              0,
-	              &error );
+	result = libewf_handle_set_number_of_write_threads(
+	          handle,
+	          number_of_threads,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) read_size );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	if( media_size > 8 )
-	{
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-		              media_size - 8,
-		              &error );
-
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+	/* Test error cases
+	 */
+	result = libewf_handle_get_number_of_write_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-		              media_size + 8,
-		              &error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
+	libcerror_error_free(
+	 &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	/* Stress test read buffer
-	 */
-	timestamp = time(
-	             NULL );
+	result = libewf_handle_get_number_of_write_threads(
+	          handle,
+	          NULL,
+	          &error );
 
-	srand(
-	 (unsigned int) timestamp );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	for( test_number = 0;
-	     test_number < number_of_tests;
-	     test_number++ )
-	{
-		random_number = rand();
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_GREATER_THAN_INT(
-		 "random_number",
-		 random_number,
-		 -1 );
+	libcerror_error_free(
+	 &error );
 
-		if( media_size > 0 )
-		{
-			read_offset = (off64_t) random_number % media_size;
-		}
-		read_size = (size_t) random_number % EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+	result = libewf_handle_set_number_of_write_threads(
+	          NULL,
+	          number_of_threads,
+	          &error );
 
-#if defined( EWF_TEST_HANDLE_VERBOSE )
-		fprintf(
-		 stdout,
-		 "libewf_handle_read_buffer_at_offset: at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
-		 read_offset,
-		 read_offset,
-		 read_size );
-#endif
-		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              read_size,
-		              read_offset,
-		              &error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		remaining_media_size = media_size - read_offset;
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		if( read_size > remaining_media_size )
-		{
-			read_size = (size_t) remaining_media_size;
-		}
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) read_size );
+	libcerror_error_free(
+	 &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	result = libewf_handle_set_number_of_write_threads(
+	          handle,
+	          -1,
+	          &error );
 
-		read_offset += read_count;
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		result = libewf_handle_get_offset(
-		          handle,
-		          &offset,
-		          &error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	libcerror_error_free(
+	 &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 read_offset );
+	return( 1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
 	}
-	/* Test error cases
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_maximum_chunk_location_table_size and libewf_handle_set_maximum_chunk_location_table_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_maximum_chunk_location_table_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t maximum_size    = 0;
+	int result               = 0;
+
+	/* Test regular cases
 	 */
-	read_count = libewf_handle_read_buffer_at_offset(
-	              NULL,
-	              buffer,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-	              0,
-	              &error );
+	result = libewf_handle_get_maximum_chunk_location_table_size(
+	          handle,
+	          &maximum_size,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libewf_handle_set_maximum_chunk_location_table_size(
+	          handle,
+	          maximum_size,
+	          &error );
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              NULL,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-	              0,
-	              &error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_maximum_chunk_location_table_size(
+	          NULL,
+	          &maximum_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2288,17 +5867,15 @@ int ewf_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              0,
-	              &error );
+	result = libewf_handle_get_maximum_chunk_location_table_size(
+	          handle,
+	          NULL,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2307,17 +5884,15 @@ int ewf_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-	              -1,
-	              &error );
+	result = libewf_handle_set_maximum_chunk_location_table_size(
+	          NULL,
+	          maximum_size,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2326,68 +5901,6 @@ int ewf_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_EWF_TEST_RWLOCK )
-
-	/* Test libewf_handle_read_buffer_at_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
-	 */
-	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
-
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-	              0,
-	              &error );
-
-	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-	/* Test libewf_handle_read_buffer_at_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
-	 */
-	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
-
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
-	              0,
-	              &error );
-
-	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
-
 	return( 1 );
 
 on_error:
@@ -2399,21 +5912,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_data_chunk function
+/* Tests the libewf_handle_get_use_memory_mapping and libewf_handle_set_use_memory_mapping functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_data_chunk(
+int ewf_test_handle_get_use_memory_mapping(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_data_chunk_t *data_chunk = NULL;
-	int result                      = 0;
+	libcerror_error_t *error   = NULL;
+	int result                 = 0;
+	uint8_t use_memory_mapping = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_use_memory_mapping(
 	          handle,
-	          &data_chunk,
+	          &use_memory_mapping,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2425,12 +5938,9 @@ int ewf_test_handle_get_data_chunk(
 	 "error",
 	 error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "data_chunk",
-	 data_chunk );
-
-	result = libewf_data_chunk_free(
-	          &data_chunk,
+	result = libewf_handle_set_use_memory_mapping(
+	          handle,
+	          use_memory_mapping,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2444,9 +5954,9 @@ int ewf_test_handle_get_data_chunk(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_use_memory_mapping(
 	          NULL,
-	          &data_chunk,
+	          &use_memory_mapping,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2454,10 +5964,6 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
-
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2465,7 +5971,7 @@ int ewf_test_handle_get_data_chunk(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_use_memory_mapping(
 	          handle,
 	          NULL,
 	          &error );
@@ -2475,9 +5981,22 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_use_memory_mapping(
+	          NULL,
+	          use_memory_mapping,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2494,101 +6013,188 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( data_chunk != NULL )
-	{
-		libewf_data_chunk_free(
-		 &data_chunk,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_seek_offset function
+/* Tests the libewf_handle_get_async_io_queue_depth and libewf_handle_set_async_io_queue_depth functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_seek_offset(
+int ewf_test_handle_get_async_io_queue_depth(
      libewf_handle_t *handle )
 {
 	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	int queue_depth          = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_async_io_queue_depth(
 	          handle,
-	          0,
-	          SEEK_END,
+	          &queue_depth,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
-
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_async_io_queue_depth(
 	          handle,
-	          1024,
-	          SEEK_SET,
+	          queue_depth,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
+	/* Test error cases
+	 */
+	result = libewf_handle_get_async_io_queue_depth(
+	          NULL,
+	          &queue_depth,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_async_io_queue_depth(
 	          handle,
-	          -512,
-	          SEEK_CUR,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_async_io_queue_depth(
+	          NULL,
+	          queue_depth,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_async_io_queue_depth(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_set_index_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_index_filename(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error    = NULL;
+	libewf_handle_t *new_handle = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_initialize(
+	          &new_handle,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "new_handle",
+	 new_handle );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_index_filename(
+	          new_handle,
+	          EWF_TEST_HANDLE_INDEX_FILENAME,
+	          narrow_string_length( EWF_TEST_HANDLE_INDEX_FILENAME ),
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
+	/* Test setting the filename a second time
 	 */
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
+	result = libewf_handle_set_index_filename(
+	          new_handle,
+	          EWF_TEST_HANDLE_INDEX_FILENAME,
+	          narrow_string_length( EWF_TEST_HANDLE_INDEX_FILENAME ),
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -2596,16 +6202,16 @@ int ewf_test_handle_seek_offset(
 
 	/* Test error cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_index_filename(
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          EWF_TEST_HANDLE_INDEX_FILENAME,
+	          narrow_string_length( EWF_TEST_HANDLE_INDEX_FILENAME ),
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2614,16 +6220,16 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_SET,
+	result = libewf_handle_set_index_filename(
+	          new_handle,
+	          NULL,
+	          narrow_string_length( EWF_TEST_HANDLE_INDEX_FILENAME ),
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2632,31 +6238,34 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_CUR,
+	result = libewf_handle_set_index_filename(
+	          new_handle,
+	          EWF_TEST_HANDLE_INDEX_FILENAME,
+	          0,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_index_filename(
+	          new_handle,
+	          EWF_TEST_HANDLE_INDEX_FILENAME,
+	          (size_t) SSIZE_MAX + 1,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2665,65 +6274,44 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_EWF_TEST_RWLOCK )
-
-	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	/* Test setting the filename on an open handle
 	 */
-	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
-
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_index_filename(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          EWF_TEST_HANDLE_INDEX_FILENAME,
+	          narrow_string_length( EWF_TEST_HANDLE_INDEX_FILENAME ),
 	          &error );
 
-	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
-	 */
-	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+	libcerror_error_free(
+	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &new_handle,
 	          &error );
 
-	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "new_handle",
+	 new_handle );
 
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	return( 1 );
 
@@ -2733,24 +6321,52 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( new_handle != NULL )
+	{
+		libewf_handle_free(
+		 &new_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_offset function
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libewf_handle_set_index_filename_wide function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_offset(
+int ewf_test_handle_set_index_filename_wide(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int result               = 0;
+	libcerror_error_t *error    = NULL;
+	libewf_handle_t *new_handle = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_initialize(
+	          &new_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "new_handle",
+	 new_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_offset(
-	          handle,
-	          &offset,
+	result = libewf_handle_set_index_filename_wide(
+	          new_handle,
+	          EWF_TEST_HANDLE_INDEX_FILENAME_WIDE,
+	          wide_string_length( EWF_TEST_HANDLE_INDEX_FILENAME_WIDE ),
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2764,9 +6380,84 @@ int ewf_test_handle_get_offset(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_set_index_filename_wide(
 	          NULL,
-	          &offset,
+	          EWF_TEST_HANDLE_INDEX_FILENAME_WIDE,
+	          wide_string_length( EWF_TEST_HANDLE_INDEX_FILENAME_WIDE ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_index_filename_wide(
+	          new_handle,
+	          NULL,
+	          wide_string_length( EWF_TEST_HANDLE_INDEX_FILENAME_WIDE ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_index_filename_wide(
+	          new_handle,
+	          EWF_TEST_HANDLE_INDEX_FILENAME_WIDE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_index_filename_wide(
+	          new_handle,
+	          EWF_TEST_HANDLE_INDEX_FILENAME_WIDE,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test setting the filename on an open handle
+	 */
+	result = libewf_handle_set_index_filename_wide(
+	          handle,
+	          EWF_TEST_HANDLE_INDEX_FILENAME_WIDE,
+	          wide_string_length( EWF_TEST_HANDLE_INDEX_FILENAME_WIDE ),
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2781,23 +6472,25 @@ int ewf_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_offset(
-	          handle,
-	          NULL,
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &new_handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
+	 "new_handle",
+	 new_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
 	return( 1 );
 
 on_error:
@@ -2806,9 +6499,17 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( new_handle != NULL )
+	{
+		libewf_handle_free(
+		 &new_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 /* Tests the libewf_handle_get_segment_filename_size function
  * Returns 1 if successful or 0 if not
  */
@@ -3333,9 +7034,244 @@ int ewf_test_handle_get_root_file_entry(
 #endif
 	/* Test error cases
 	 */
-	result = libewf_handle_get_root_file_entry(
+	result = libewf_handle_get_root_file_entry(
+	          NULL,
+	          &root_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "root_file_entry",
+	 root_file_entry );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( root_file_entry_is_set != 0 )
+	{
+		result = libewf_handle_get_root_file_entry(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "root_file_entry",
+		 root_file_entry );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( root_file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &root_file_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_sectors_per_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_sectors_per_chunk(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error   = NULL;
+	uint32_t sectors_per_chunk = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_sectors_per_chunk(
+	          handle,
+	          &sectors_per_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_sectors_per_chunk(
+	          NULL,
+	          &sectors_per_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_sectors_per_chunk(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_bytes_per_sector function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_bytes_per_sector(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	uint32_t bytes_per_sector = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_bytes_per_sector(
+	          handle,
+	          &bytes_per_sector,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_bytes_per_sector(
+	          NULL,
+	          &bytes_per_sector,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_bytes_per_sector(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_sectors function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_number_of_sectors(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error   = NULL;
+	uint64_t number_of_sectors = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_sectors(
+	          handle,
+	          &number_of_sectors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_number_of_sectors(
 	          NULL,
-	          &root_file_entry,
+	          &number_of_sectors,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3343,10 +7279,6 @@ int ewf_test_handle_get_root_file_entry(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "root_file_entry",
-	 root_file_entry );
-
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -3354,29 +7286,23 @@ int ewf_test_handle_get_root_file_entry(
 	libcerror_error_free(
 	 &error );
 
-	if( root_file_entry_is_set != 0 )
-	{
-		result = libewf_handle_get_root_file_entry(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_number_of_sectors(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "root_file_entry",
-		 root_file_entry );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3385,30 +7311,24 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( root_file_entry != NULL )
-	{
-		libewf_file_entry_free(
-		 &root_file_entry,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_sectors_per_chunk function
+/* Tests the libewf_handle_get_chunk_size function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_sectors_per_chunk(
+int ewf_test_handle_get_chunk_size(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error   = NULL;
-	uint32_t sectors_per_chunk = 0;
-	int result                 = 0;
+	libcerror_error_t *error = NULL;
+	size32_t chunk_size      = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_chunk_size(
 	          handle,
-	          &sectors_per_chunk,
+	          &chunk_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3422,9 +7342,9 @@ int ewf_test_handle_get_sectors_per_chunk(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_chunk_size(
 	          NULL,
-	          &sectors_per_chunk,
+	          &chunk_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3439,7 +7359,7 @@ int ewf_test_handle_get_sectors_per_chunk(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_chunk_size(
 	          handle,
 	          NULL,
 	          &error );
@@ -3467,21 +7387,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_bytes_per_sector function
+/* Tests the libewf_handle_get_error_granularity function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_bytes_per_sector(
+int ewf_test_handle_get_error_granularity(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error  = NULL;
-	uint32_t bytes_per_sector = 0;
-	int result                = 0;
+	libcerror_error_t *error   = NULL;
+	uint32_t error_granularity = 0;
+	int result                 = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_error_granularity(
 	          handle,
-	          &bytes_per_sector,
+	          &error_granularity,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3495,9 +7415,9 @@ int ewf_test_handle_get_bytes_per_sector(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_error_granularity(
 	          NULL,
-	          &bytes_per_sector,
+	          &error_granularity,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3512,7 +7432,7 @@ int ewf_test_handle_get_bytes_per_sector(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_error_granularity(
 	          handle,
 	          NULL,
 	          &error );
@@ -3540,21 +7460,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_number_of_sectors function
+/* Tests the libewf_handle_get_compression_method function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_number_of_sectors(
+int ewf_test_handle_get_compression_method(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error   = NULL;
-	uint64_t number_of_sectors = 0;
-	int result                 = 0;
+	libcerror_error_t *error    = NULL;
+	uint16_t compression_method = 0;
+	int result                  = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_compression_method(
 	          handle,
-	          &number_of_sectors,
+	          &compression_method,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3568,9 +7488,9 @@ int ewf_test_handle_get_number_of_sectors(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_compression_method(
 	          NULL,
-	          &number_of_sectors,
+	          &compression_method,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3585,7 +7505,7 @@ int ewf_test_handle_get_number_of_sectors(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_compression_method(
 	          handle,
 	          NULL,
 	          &error );
@@ -3613,27 +7533,27 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_chunk_size function
+/* Tests the libewf_handle_get_number_of_incompressible_chunks function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_chunk_size(
+int ewf_test_handle_get_number_of_incompressible_chunks(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size32_t chunk_size      = 0;
-	int result               = 0;
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_chunks = 0;
+	int result                = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_number_of_incompressible_chunks(
 	          handle,
-	          &chunk_size,
+	          &number_of_chunks,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -3641,9 +7561,9 @@ int ewf_test_handle_get_chunk_size(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_number_of_incompressible_chunks(
 	          NULL,
-	          &chunk_size,
+	          &number_of_chunks,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3658,7 +7578,7 @@ int ewf_test_handle_get_chunk_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_number_of_incompressible_chunks(
 	          handle,
 	          NULL,
 	          &error );
@@ -3686,27 +7606,27 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_error_granularity function
+/* Tests the libewf_handle_get_adaptive_deflate_level function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_error_granularity(
+int ewf_test_handle_get_adaptive_deflate_level(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error   = NULL;
-	uint32_t error_granularity = 0;
-	int result                 = 0;
+	libcerror_error_t *error = NULL;
+	int deflate_level        = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_adaptive_deflate_level(
 	          handle,
-	          &error_granularity,
+	          &deflate_level,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -3714,9 +7634,9 @@ int ewf_test_handle_get_error_granularity(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_adaptive_deflate_level(
 	          NULL,
-	          &error_granularity,
+	          &deflate_level,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3731,7 +7651,7 @@ int ewf_test_handle_get_error_granularity(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_adaptive_deflate_level(
 	          handle,
 	          NULL,
 	          &error );
@@ -3759,27 +7679,28 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_compression_method function
+/* Tests the libewf_handle_get_number_of_chunks_with_deflate_level function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_compression_method(
+int ewf_test_handle_get_number_of_chunks_with_deflate_level(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error    = NULL;
-	uint16_t compression_method = 0;
-	int result                  = 0;
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_chunks = 0;
+	int result                = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_get_number_of_chunks_with_deflate_level(
 	          handle,
-	          &compression_method,
+	          1,
+	          &number_of_chunks,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -3787,9 +7708,10 @@ int ewf_test_handle_get_compression_method(
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_get_number_of_chunks_with_deflate_level(
 	          NULL,
-	          &compression_method,
+	          1,
+	          &number_of_chunks,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3804,8 +7726,45 @@ int ewf_test_handle_get_compression_method(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_get_number_of_chunks_with_deflate_level(
+	          handle,
+	          0,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_number_of_chunks_with_deflate_level(
+	          handle,
+	          10,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_number_of_chunks_with_deflate_level(
 	          handle,
+	          1,
 	          NULL,
 	          &error );
 
@@ -4853,6 +8812,15 @@ int main(
 		 ewf_test_handle_open_close,
 		 source );
 
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_open_with_index",
+		 ewf_test_handle_open_with_index,
+		 source );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
 		/* Initialize handle for tests
 		 */
 		result = ewf_test_handle_open_source(
@@ -4900,6 +8868,16 @@ int main(
 		 ewf_test_handle_read_buffer_at_offset,
 		 handle );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffers_at_offsets",
+		 ewf_test_handle_read_buffers_at_offsets,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_view",
+		 ewf_test_handle_get_chunk_view,
+		 handle );
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 		/* TODO: add tests for libewf_internal_handle_write_buffer_to_file_io_pool */
@@ -4955,8 +8933,86 @@ int main(
 		 ewf_test_handle_get_offset,
 		 handle );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_next_data_region",
+		 ewf_test_handle_get_next_data_region,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_information",
+		 ewf_test_handle_get_chunk_information,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_information_entries",
+		 ewf_test_handle_get_chunk_information_entries,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_set_maximum_number_of_open_handles */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_maximum_cache_size",
+		 ewf_test_handle_get_maximum_cache_size,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_cache_statistics",
+		 ewf_test_handle_get_cache_statistics,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_data_pool_statistics",
+		 ewf_test_handle_get_chunk_data_pool_statistics,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_read_ahead_values",
+		 ewf_test_handle_get_read_ahead_values,
+		 handle );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_internal_handle_read_ahead_chunk",
+		 ewf_test_internal_handle_read_ahead_chunk,
+		 handle );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_number_of_write_threads",
+		 ewf_test_handle_get_number_of_write_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_maximum_chunk_location_table_size",
+		 ewf_test_handle_get_maximum_chunk_location_table_size,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_use_memory_mapping",
+		 ewf_test_handle_get_use_memory_mapping,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_async_io_queue_depth",
+		 ewf_test_handle_get_async_io_queue_depth,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_index_filename",
+		 ewf_test_handle_set_index_filename,
+		 handle );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_index_filename_wide",
+		 ewf_test_handle_set_index_filename_wide,
+		 handle );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 		/* TODO: add tests for libewf_handle_segment_files_corrupted */
 
 		/* TODO: add tests for libewf_handle_segment_files_encrypted */
@@ -5090,6 +9146,21 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_compression_values */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_number_of_incompressible_chunks",
+		 ewf_test_handle_get_number_of_incompressible_chunks,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_adaptive_deflate_level",
+		 ewf_test_handle_get_adaptive_deflate_level,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_number_of_chunks_with_deflate_level",
+		 ewf_test_handle_get_number_of_chunks_with_deflate_level,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_media_size",
 		 ewf_test_handle_get_media_size,
@@ -677,6 +677,257 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_huffman_tree_build_lookup_table function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_huffman_tree_build_lookup_table(
+     void )
+{
+	uint8_t code_size_array[ 13 ] = {
+		1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 12 };
+
+	uint8_t bit_stream_data[ 4 ] = {
+		0xff, 0xff, 0x7f, 0x00 };
+
+	libewf_bit_stream_t *bit_stream     = NULL;
+	libewf_huffman_tree_t *huffman_tree = NULL;
+	libcerror_error_t *error             = NULL;
+	uint16_t symbol                      = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_huffman_tree_initialize(
+	          &huffman_tree,
+	          13,
+	          15,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "huffman_tree",
+	 huffman_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_bit_stream_initialize(
+	          &bit_stream,
+	          bit_stream_data,
+	          4,
+	          0,
+	          LIBEWF_BIT_STREAM_STORAGE_TYPE_BYTE_BACK_TO_FRONT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "bit_stream",
+	 bit_stream );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_huffman_tree_build(
+	          huffman_tree,
+	          code_size_array,
+	          13,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "huffman_tree->lookup_table_number_of_bits",
+	 huffman_tree->lookup_table_number_of_bits,
+	 (uint8_t) 10 );
+
+	/* Codes larger than 10 bits are stored in a sub table
+	 */
+	result = libewf_huffman_tree_get_symbol_from_bit_stream(
+	          huffman_tree,
+	          bit_stream,
+	          &symbol,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "symbol",
+	 symbol,
+	 (uint16_t) 12 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_huffman_tree_get_symbol_from_bit_stream(
+	          huffman_tree,
+	          bit_stream,
+	          &symbol,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "symbol",
+	 symbol,
+	 (uint16_t) 11 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_huffman_tree_get_symbol_from_bit_stream(
+	          huffman_tree,
+	          bit_stream,
+	          &symbol,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "symbol",
+	 symbol,
+	 (uint16_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_huffman_tree_build_lookup_table(
+	          NULL,
+	          code_size_array,
+	          13,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_huffman_tree_build_lookup_table(
+	          huffman_tree,
+	          NULL,
+	          13,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_huffman_tree_build_lookup_table(
+	          huffman_tree,
+	          code_size_array,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_bit_stream_free(
+	          &bit_stream,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_huffman_tree_free(
+	          &huffman_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( bit_stream != NULL )
+	{
+		libewf_bit_stream_free(
+		 &bit_stream,
+		 NULL );
+	}
+	if( huffman_tree != NULL )
+	{
+		libewf_huffman_tree_free(
+		 &huffman_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_huffman_tree_get_symbol_from_bit_stream function
  * Returns 1 if successful or 0 if not
  */
@@ -964,6 +1215,10 @@ int main(
 	 "libewf_huffman_tree_build",
 	 ewf_test_huffman_tree_build );
 
+	EWF_TEST_RUN(
+	 "libewf_huffman_tree_build_lookup_table",
+	 ewf_test_huffman_tree_build_lookup_table );
+
 	EWF_TEST_RUN(
 	 "libewf_huffman_tree_get_symbol_from_bit_stream",
 	 ewf_test_huffman_tree_get_symbol_from_bit_stream );
@@ -0,0 +1,1023 @@
+/*
+ * Library read_ahead type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_read_ahead.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads a chunk ahead
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_ahead_read_chunk(
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED,
+     uint64_t chunk_index EWF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+	EWF_TEST_UNREFERENCED_PARAMETER( chunk_index )
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	return( 1 );
+}
+
+/* Tests the libewf_read_ahead_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_ahead_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_read_ahead_t *read_ahead = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 2;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_read_ahead_initialize(
+	          &read_ahead,
+	          4,
+	          2,
+	          8,
+	          &ewf_test_read_ahead_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_ahead_initialize(
+	          NULL,
+	          4,
+	          2,
+	          8,
+	          &ewf_test_read_ahead_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_ahead = (libewf_read_ahead_t *) 0x12345678UL;
+
+	result = libewf_read_ahead_initialize(
+	          &read_ahead,
+	          4,
+	          2,
+	          8,
+	          &ewf_test_read_ahead_read_chunk,
+	          NULL,
+	          &error );
+
+	read_ahead = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_ahead_initialize(
+	          &read_ahead,
+	          0,
+	          2,
+	          8,
+	          &ewf_test_read_ahead_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_ahead_initialize(
+	          &read_ahead,
+	          4,
+	          0,
+	          8,
+	          &ewf_test_read_ahead_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_ahead_initialize(
+	          &read_ahead,
+	          4,
+	          2,
+	          8,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_read_ahead_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_read_ahead_initialize(
+		          &read_ahead,
+		          4,
+		          2,
+		          8,
+		          &ewf_test_read_ahead_read_chunk,
+		          NULL,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( read_ahead != NULL )
+			{
+				libewf_read_ahead_free(
+				 &read_ahead,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "read_ahead",
+			 read_ahead );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_read_ahead_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_read_ahead_initialize(
+		          &read_ahead,
+		          4,
+		          2,
+		          8,
+		          &ewf_test_read_ahead_read_chunk,
+		          NULL,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( read_ahead != NULL )
+			{
+				libewf_read_ahead_free(
+				 &read_ahead,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "read_ahead",
+			 read_ahead );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libewf_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_ahead_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_ahead_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_read_ahead_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_ahead_notify_read function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_ahead_notify_read(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_read_ahead_t *read_ahead = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_read_ahead_initialize(
+	          &read_ahead,
+	          4,
+	          2,
+	          8,
+	          &ewf_test_read_ahead_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_read_ahead_notify_read(
+	          read_ahead,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A single read does not start the read-ahead
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_ahead->end_chunk_index",
+	 read_ahead->end_chunk_index,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead->thread_pool",
+	 read_ahead->thread_pool );
+
+	result = libewf_read_ahead_notify_read(
+	          read_ahead,
+	          1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The second sequential read starts the read-ahead of the 4 chunks after chunk 1
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_ahead->end_chunk_index",
+	 read_ahead->end_chunk_index,
+	 (uint64_t) 6 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead->thread_pool",
+	 read_ahead->thread_pool );
+
+	result = libewf_read_ahead_notify_read(
+	          read_ahead,
+	          2,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The read-ahead window does not exceed the number of chunks in the media
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_ahead->end_chunk_index",
+	 read_ahead->end_chunk_index,
+	 (uint64_t) 8 );
+
+	/* A non sequential read cancels the read-ahead
+	 */
+	result = libewf_read_ahead_notify_read(
+	          read_ahead,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ahead->number_of_sequential_reads",
+	 read_ahead->number_of_sequential_reads,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_read_ahead_notify_read(
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_ahead_notify_read(
+	          read_ahead,
+	          1,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libewf_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_ahead_get_next_chunk_index function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_ahead_get_next_chunk_index(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_read_ahead_t *read_ahead = NULL;
+	uint64_t chunk_index            = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_read_ahead_initialize(
+	          &read_ahead,
+	          4,
+	          2,
+	          8,
+	          &ewf_test_read_ahead_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_ahead->next_chunk_index          = 2;
+	read_ahead->end_chunk_index           = 4;
+	read_ahead->number_of_queued_requests = 2;
+
+	/* Test regular cases
+	 */
+	result = libewf_read_ahead_get_next_chunk_index(
+	          read_ahead,
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_index",
+	 chunk_index,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ahead->number_of_queued_requests",
+	 read_ahead->number_of_queued_requests,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A cancelled read-ahead has no more chunks to read
+	 */
+	read_ahead->end_chunk_index = read_ahead->next_chunk_index;
+
+	result = libewf_read_ahead_get_next_chunk_index(
+	          read_ahead,
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ahead->number_of_queued_requests",
+	 read_ahead->number_of_queued_requests,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_ahead_get_next_chunk_index(
+	          NULL,
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_ahead_get_next_chunk_index(
+	          read_ahead,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libewf_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_ahead_get_next_chunk_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_ahead_get_next_chunk_range(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_read_ahead_t *read_ahead = NULL;
+	uint64_t first_chunk_index      = 0;
+	int number_of_chunks            = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_read_ahead_initialize(
+	          &read_ahead,
+	          4,
+	          2,
+	          8,
+	          &ewf_test_read_ahead_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_ahead->next_chunk_index          = 2;
+	read_ahead->end_chunk_index           = 5;
+	read_ahead->number_of_queued_requests = 2;
+
+	/* Test regular cases
+	 */
+	result = libewf_read_ahead_get_next_chunk_range(
+	          read_ahead,
+	          2,
+	          &first_chunk_index,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "first_chunk_index",
+	 first_chunk_index,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The last range is limited by the end of the read-ahead window
+	 */
+	result = libewf_read_ahead_get_next_chunk_range(
+	          read_ahead,
+	          2,
+	          &first_chunk_index,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "first_chunk_index",
+	 first_chunk_index,
+	 (uint64_t) 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_ahead->number_of_queued_requests",
+	 read_ahead->number_of_queued_requests,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_ahead_get_next_chunk_range(
+	          read_ahead,
+	          2,
+	          &first_chunk_index,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_ahead_get_next_chunk_range(
+	          NULL,
+	          2,
+	          &first_chunk_index,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_ahead_get_next_chunk_range(
+	          read_ahead,
+	          0,
+	          &first_chunk_index,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_ahead_get_next_chunk_range(
+	          read_ahead,
+	          2,
+	          NULL,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_ahead_get_next_chunk_range(
+	          read_ahead,
+	          2,
+	          &first_chunk_index,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libewf_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_read_ahead_initialize",
+	 ewf_test_read_ahead_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_read_ahead_free",
+	 ewf_test_read_ahead_free );
+
+	EWF_TEST_RUN(
+	 "libewf_read_ahead_notify_read",
+	 ewf_test_read_ahead_notify_read );
+
+	EWF_TEST_RUN(
+	 "libewf_read_ahead_get_next_chunk_index",
+	 ewf_test_read_ahead_get_next_chunk_index );
+
+	EWF_TEST_RUN(
+	 "libewf_read_ahead_get_next_chunk_range",
+	 ewf_test_read_ahead_get_next_chunk_range );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+}
+
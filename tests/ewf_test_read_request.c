@@ -0,0 +1,256 @@
+/*
+ * Library read_request type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_read_request.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_read_request_compare function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_request_compare(
+     void )
+{
+	libewf_read_request_t first_read_request  = { 2, 0, 512, 1, 0 };
+	libewf_read_request_t second_read_request = { 2, 0, 512, 1, 0 };
+	int result                                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_read_request_compare(
+	          &first_read_request,
+	          &second_read_request );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	second_read_request.buffer_offset = 512;
+
+	result = libewf_read_request_compare(
+	          &first_read_request,
+	          &second_read_request );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	second_read_request.buffer_index = 0;
+
+	result = libewf_read_request_compare(
+	          &first_read_request,
+	          &second_read_request );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	second_read_request.chunk_index = 3;
+
+	result = libewf_read_request_compare(
+	          &first_read_request,
+	          &second_read_request );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	second_read_request.chunk_index = 1;
+
+	result = libewf_read_request_compare(
+	          &first_read_request,
+	          &second_read_request );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libewf_read_requests_sort function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_requests_sort(
+     void )
+{
+	libewf_read_request_t read_requests[ 5 ] = {
+		{ 7, 0, 100, 0, 0 },
+		{ 3, 16, 50, 1, 0 },
+		{ 7, 100, 100, 0, 100 },
+		{ 3, 0, 16, 0, 200 },
+		{ 0, 0, 32, 2, 0 } };
+
+	libcerror_error_t *error  = NULL;
+	size_t read_request_index = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_read_requests_sort(
+	          read_requests,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( read_request_index = 1;
+	     read_request_index < 5;
+	     read_request_index++ )
+	{
+		result = libewf_read_request_compare(
+		          &( read_requests[ read_request_index - 1 ] ),
+		          &( read_requests[ read_request_index ] ) );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+	}
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_requests[ 0 ].chunk_index",
+	 read_requests[ 0 ].chunk_index,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_requests[ 1 ].buffer_index",
+	 read_requests[ 1 ].buffer_index,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_requests[ 4 ].buffer_offset",
+	 read_requests[ 4 ].buffer_offset,
+	 (size_t) 100 );
+
+	/* Test error cases
+	 */
+	result = libewf_read_requests_sort(
+	          NULL,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_requests_sort(
+	          read_requests,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_read_request_compare",
+	 ewf_test_read_request_compare );
+
+	EWF_TEST_RUN(
+	 "libewf_read_requests_sort",
+	 ewf_test_read_requests_sort );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -34,6 +36,8 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/ewf_segment_files_index.h"
+#include "../libewf/libewf_definitions.h"
 #include "../libewf/libewf_segment_file.h"
 
 unsigned char ewf_test_segment_file_data1[ 13 ] = {
@@ -1203,6 +1207,404 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_segment_file_read_index_entry_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_read_index_entry_data(
+     void )
+{
+	uint8_t entry_data[ sizeof( ewf_segment_files_index_entry_t ) + sizeof( ewf_segment_files_index_section_t ) + sizeof( ewf_segment_files_index_chunk_group_t ) ];
+
+	ewf_segment_files_index_chunk_group_t *index_chunk_group = NULL;
+	ewf_segment_files_index_entry_t *index_entry             = NULL;
+	ewf_segment_files_index_section_t *index_section         = NULL;
+	libcerror_error_t *error                                 = NULL;
+	libewf_io_handle_t *io_handle                            = NULL;
+	libewf_segment_file_t *segment_file                      = NULL;
+	int number_of_sections                                   = 0;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	index_entry       = (ewf_segment_files_index_entry_t *) entry_data;
+	index_section     = (ewf_segment_files_index_section_t *) &( entry_data[ sizeof( ewf_segment_files_index_entry_t ) ] );
+	index_chunk_group = (ewf_segment_files_index_chunk_group_t *) &( entry_data[ sizeof( ewf_segment_files_index_entry_t ) + sizeof( ewf_segment_files_index_section_t ) ] );
+
+	memory_set(
+	 entry_data,
+	 0,
+	 sizeof( entry_data ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->number_of_sections,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->number_of_chunk_groups,
+	 1 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->current_offset,
+	 (uint64_t) 4096 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry->last_section_offset,
+	 (uint64_t) 4020 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_entry->device_information_section_index,
+	 0xffffffffUL );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_section->offset,
+	 (uint64_t) 4020 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_section->size,
+	 (uint64_t) 76 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_chunk_group->offset,
+	 (uint64_t) 1024 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_chunk_group->size,
+	 (uint64_t) 256 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_chunk_group->mapped_size,
+	 (uint64_t) 32768 );
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_file",
+	 segment_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_file_read_index_entry_data(
+	          segment_file,
+	          4096,
+	          entry_data,
+	          sizeof( entry_data ),
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_get_number_of_sections(
+	          segment_file,
+	          &number_of_sections,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sections",
+	 number_of_sections,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a section that exceeds the segment file size
+	 */
+	result = libewf_segment_file_read_index_entry_data(
+	          segment_file,
+	          4000,
+	          entry_data,
+	          sizeof( entry_data ),
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a section range that overflows
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 index_section->size,
+	 0xffffffffffffff00ULL );
+
+	result = libewf_segment_file_read_index_entry_data(
+	          segment_file,
+	          4096,
+	          entry_data,
+	          sizeof( entry_data ),
+	          0,
+	          &error );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_section->size,
+	 (uint64_t) 76 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a chunk group range that overflows
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 index_chunk_group->offset,
+	 0xffffffffffffff00ULL );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_chunk_group->size,
+	 (uint64_t) 512 );
+
+	result = libewf_segment_file_read_index_entry_data(
+	          segment_file,
+	          4096,
+	          entry_data,
+	          sizeof( entry_data ),
+	          0,
+	          &error );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_chunk_group->offset,
+	 (uint64_t) 1024 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_chunk_group->size,
+	 (uint64_t) 256 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with unsupported chunk group range flags
+	 */
+	byte_stream_copy_from_uint32_little_endian(
+	 index_chunk_group->range_flags,
+	 LIBEWF_RANGE_FLAG_IS_SPARSE );
+
+	result = libewf_segment_file_read_index_entry_data(
+	          segment_file,
+	          4096,
+	          entry_data,
+	          sizeof( entry_data ),
+	          0,
+	          &error );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_chunk_group->range_flags,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The rejected entries are not restored
+	 */
+	result = libewf_segment_file_get_number_of_sections(
+	          segment_file,
+	          &number_of_sections,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sections",
+	 number_of_sections,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_file_read_index_entry_data(
+	          NULL,
+	          4096,
+	          entry_data,
+	          sizeof( entry_data ),
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_read_index_entry_data(
+	          segment_file,
+	          4096,
+	          NULL,
+	          sizeof( entry_data ),
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_file",
+	 segment_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -1288,6 +1690,14 @@ int main(
 
 	/* TODO: add tests for libewf_segment_file_write_sections_correction */
 
+	/* TODO: add tests for libewf_segment_file_get_index_entry_data_size */
+
+	/* TODO: add tests for libewf_segment_file_write_index_entry_data */
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_read_index_entry_data",
+	 ewf_test_segment_file_read_index_entry_data );
+
 	/* TODO: add tests for libewf_segment_file_read_element_data */
 
 	/* TODO: add tests for libewf_segment_file_read_section_element_data */
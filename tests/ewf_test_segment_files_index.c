@@ -0,0 +1,1069 @@
+/*
+ * Library segment_files_index type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_segment_files_index.h"
+
+#include "../libewf/ewf_segment_files_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Fills a segment files index entry with test data
+ */
+void ewf_test_segment_files_index_fill_entry(
+      uint8_t *data,
+      size_t data_size,
+      uint32_t segment_number )
+{
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( segment_number + data_offset );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_files_index_entry_t *) data )->entry_size,
+	 (uint32_t) data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_files_index_entry_t *) data )->segment_number,
+	 segment_number );
+}
+
+/* Tests the libewf_segment_files_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_files_index_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_segment_files_index_t *segment_files_index = NULL;
+	int result                                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                   = 2;
+	int number_of_memset_fail_tests                   = 1;
+	int test_number                                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_files_index_initialize(
+	          &segment_files_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_files_index",
+	 segment_files_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_files_index_free(
+	          &segment_files_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_files_index",
+	 segment_files_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_files_index_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	segment_files_index = (libewf_segment_files_index_t *) 0x12345678UL;
+
+	result = libewf_segment_files_index_initialize(
+	          &segment_files_index,
+	          &error );
+
+	segment_files_index = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_segment_files_index_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_segment_files_index_initialize(
+		          &segment_files_index,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( segment_files_index != NULL )
+			{
+				libewf_segment_files_index_free(
+				 &segment_files_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "segment_files_index",
+			 segment_files_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_segment_files_index_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_segment_files_index_initialize(
+		          &segment_files_index,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( segment_files_index != NULL )
+			{
+				libewf_segment_files_index_free(
+				 &segment_files_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "segment_files_index",
+			 segment_files_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_files_index != NULL )
+	{
+		libewf_segment_files_index_free(
+		 &segment_files_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_files_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_files_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_segment_files_index_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_files_index_set_entry_data and libewf_segment_files_index_get_entry_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_files_index_entry_data(
+     void )
+{
+	uint8_t entry_data[ sizeof( ewf_segment_files_index_entry_t ) ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_segment_files_index_t *segment_files_index = NULL;
+	const uint8_t *data                               = NULL;
+	size_t data_size                                  = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_segment_files_index_initialize(
+	          &segment_files_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_files_index",
+	 segment_files_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_segment_files_index_fill_entry(
+	 entry_data,
+	 sizeof( ewf_segment_files_index_entry_t ),
+	 3 );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_files_index_get_entry_data(
+	          segment_files_index,
+	          3,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_files_index_set_entry_data(
+	          segment_files_index,
+	          3,
+	          entry_data,
+	          sizeof( ewf_segment_files_index_entry_t ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "segment_files_index->number_of_entries",
+	 segment_files_index->number_of_entries,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "segment_files_index->is_modified",
+	 segment_files_index->is_modified,
+	 1 );
+
+	/* Replacing an existing entry does not change the number of entries
+	 */
+	result = libewf_segment_files_index_set_entry_data(
+	          segment_files_index,
+	          3,
+	          entry_data,
+	          sizeof( ewf_segment_files_index_entry_t ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "segment_files_index->number_of_entries",
+	 segment_files_index->number_of_entries,
+	 1 );
+
+	result = libewf_segment_files_index_get_entry_data(
+	          segment_files_index,
+	          3,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) sizeof( ewf_segment_files_index_entry_t ) );
+
+	result = memory_compare(
+	          data,
+	          entry_data,
+	          sizeof( ewf_segment_files_index_entry_t ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* An entry before a set entry is not available
+	 */
+	result = libewf_segment_files_index_get_entry_data(
+	          segment_files_index,
+	          1,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_files_index_set_entry_data(
+	          NULL,
+	          3,
+	          entry_data,
+	          sizeof( ewf_segment_files_index_entry_t ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_set_entry_data(
+	          segment_files_index,
+	          0,
+	          entry_data,
+	          sizeof( ewf_segment_files_index_entry_t ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_set_entry_data(
+	          segment_files_index,
+	          3,
+	          NULL,
+	          sizeof( ewf_segment_files_index_entry_t ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_set_entry_data(
+	          segment_files_index,
+	          3,
+	          entry_data,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_get_entry_data(
+	          NULL,
+	          3,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_get_entry_data(
+	          segment_files_index,
+	          0,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_get_entry_data(
+	          segment_files_index,
+	          3,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_get_entry_data(
+	          segment_files_index,
+	          3,
+	          &data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_files_index_free(
+	          &segment_files_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_files_index",
+	 segment_files_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_files_index != NULL )
+	{
+		libewf_segment_files_index_free(
+		 &segment_files_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_files_index_write_data and libewf_segment_files_index_read_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_files_index_read_write_data(
+     void )
+{
+	uint8_t entry_data[ sizeof( ewf_segment_files_index_entry_t ) + sizeof( ewf_segment_files_index_section_t ) ];
+	uint8_t index_data[ sizeof( ewf_segment_files_index_header_t ) + ( 2 * ( sizeof( ewf_segment_files_index_entry_t ) + sizeof( ewf_segment_files_index_section_t ) ) ) ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_segment_files_index_t *segment_files_index = NULL;
+	const uint8_t *data                               = NULL;
+	size_t data_size                                  = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_segment_files_index_initialize(
+	          &segment_files_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_files_index",
+	 segment_files_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_segment_files_index_fill_entry(
+	 entry_data,
+	 sizeof( entry_data ),
+	 1 );
+
+	result = libewf_segment_files_index_set_entry_data(
+	          segment_files_index,
+	          1,
+	          entry_data,
+	          sizeof( entry_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_segment_files_index_fill_entry(
+	 entry_data,
+	 sizeof( entry_data ),
+	 2 );
+
+	result = libewf_segment_files_index_set_entry_data(
+	          segment_files_index,
+	          2,
+	          entry_data,
+	          sizeof( entry_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_files_index_get_data_size(
+	          segment_files_index,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) sizeof( index_data ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_files_index_write_data(
+	          segment_files_index,
+	          index_data,
+	          sizeof( index_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_files_index_read_data(
+	          segment_files_index,
+	          index_data,
+	          sizeof( index_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "segment_files_index->number_of_entries",
+	 segment_files_index->number_of_entries,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "segment_files_index->is_modified",
+	 segment_files_index->is_modified,
+	 0 );
+
+	result = libewf_segment_files_index_get_entry_data(
+	          segment_files_index,
+	          2,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) sizeof( entry_data ) );
+
+	result = memory_compare(
+	          data,
+	          entry_data,
+	          sizeof( entry_data ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test read data with a checksum mismatch
+	 */
+	index_data[ sizeof( index_data ) - 1 ] ^= 0xff;
+
+	result = libewf_segment_files_index_read_data(
+	          segment_files_index,
+	          index_data,
+	          sizeof( index_data ),
+	          &error );
+
+	index_data[ sizeof( index_data ) - 1 ] ^= 0xff;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "segment_files_index->number_of_entries",
+	 segment_files_index->number_of_entries,
+	 0 );
+
+	/* Test read data with an invalid signature
+	 */
+	index_data[ 0 ] = 'X';
+
+	result = libewf_segment_files_index_read_data(
+	          segment_files_index,
+	          index_data,
+	          sizeof( index_data ),
+	          &error );
+
+	index_data[ 0 ] = 'E';
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read data with truncated data
+	 */
+	result = libewf_segment_files_index_read_data(
+	          segment_files_index,
+	          index_data,
+	          sizeof( index_data ) - 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_files_index_read_data(
+	          NULL,
+	          index_data,
+	          sizeof( index_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_read_data(
+	          segment_files_index,
+	          NULL,
+	          sizeof( index_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_read_data(
+	          segment_files_index,
+	          index_data,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_write_data(
+	          NULL,
+	          index_data,
+	          sizeof( index_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_write_data(
+	          segment_files_index,
+	          NULL,
+	          sizeof( index_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_files_index_write_data(
+	          segment_files_index,
+	          index_data,
+	          sizeof( ewf_segment_files_index_header_t ) - 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_files_index_free(
+	          &segment_files_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_files_index",
+	 segment_files_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_files_index != NULL )
+	{
+		libewf_segment_files_index_free(
+		 &segment_files_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_segment_files_index_initialize",
+	 ewf_test_segment_files_index_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_files_index_free",
+	 ewf_test_segment_files_index_free );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_files_index_entry_data",
+	 ewf_test_segment_files_index_entry_data );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_files_index_read_write_data",
+	 ewf_test_segment_files_index_read_write_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
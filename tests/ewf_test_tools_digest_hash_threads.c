@@ -0,0 +1,1166 @@
+/*
+ * Tools digest_hash_threads functions test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/digest_hash_threads.h"
+#include "../ewftools/ewftools_libcthreads.h"
+#include "../ewftools/ewftools_libhmac.h"
+#include "../ewftools/sha1_context.h"
+#include "../ewftools/sha256_context.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests the digest_hash_threads_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_initialize(
+     void )
+{
+	digest_hash_threads_t *digest_hash_threads = NULL;
+	libcerror_error_t *error                   = NULL;
+	libcthreads_queue_t *queue                 = NULL;
+	libhmac_md5_context_t *md5_context         = NULL;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libhmac_md5_initialize(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "md5_context",
+	 md5_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_queue_initialize(
+	          &queue,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          NULL,
+	          queue,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_threads",
+	 digest_hash_threads );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_hash_threads_join(
+	          digest_hash_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_hash_threads_free(
+	          &digest_hash_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_hash_threads",
+	 digest_hash_threads );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_initialize(
+	          NULL,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          NULL,
+	          queue,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	digest_hash_threads = (digest_hash_threads_t *) 0x12345678UL;
+
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          NULL,
+	          queue,
+	          4,
+	          &error );
+
+	digest_hash_threads = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_hash_threads",
+	 digest_hash_threads );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          NULL,
+	          queue,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_hash_threads",
+	 digest_hash_threads );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_queue_free(
+	          &queue,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "queue",
+	 queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_md5_free(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "md5_context",
+	 md5_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_threads != NULL )
+	{
+		digest_hash_threads_free(
+		 &digest_hash_threads,
+		 NULL );
+	}
+	if( queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &queue,
+		 NULL,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_md5_callback function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_md5_callback(
+     void )
+{
+	uint8_t calculated_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t data[ 4096 ];
+	uint8_t expected_hash[ LIBHMAC_MD5_HASH_SIZE ];
+
+	digest_hash_threads_t digest_hash_threads;
+
+	digest_hash_block_t *digest_hash_block = NULL;
+	libcerror_error_t *error               = NULL;
+	libhmac_md5_context_t *md5_context     = NULL;
+	size_t data_offset                     = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = libhmac_md5_calculate(
+	          data,
+	          4096,
+	          expected_hash,
+	          LIBHMAC_MD5_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libhmac_md5_initialize(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "md5_context",
+	 md5_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &digest_hash_threads,
+	 0,
+	 sizeof( digest_hash_threads_t ) );
+
+	digest_hash_threads.md5_context = md5_context;
+
+	/* Test regular cases
+	 */
+	digest_hash_block = memory_allocate_structure(
+	                     digest_hash_block_t );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_block",
+	 digest_hash_block );
+
+	digest_hash_block->storage_media_buffer = NULL;
+	digest_hash_block->data                 = data;
+	digest_hash_block->data_size            = 4096;
+
+	/* The callback takes over the digest hash block
+	 */
+	result = digest_hash_threads_md5_callback(
+	          digest_hash_block,
+	          &digest_hash_threads );
+
+	digest_hash_block = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_hash_threads.update_failed",
+	 digest_hash_threads.update_failed,
+	 0 );
+
+	result = libhmac_md5_finalize(
+	          md5_context,
+	          calculated_hash,
+	          LIBHMAC_MD5_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          calculated_hash,
+	          expected_hash,
+	          LIBHMAC_MD5_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_md5_callback(
+	          NULL,
+	          &digest_hash_threads );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = digest_hash_threads_md5_callback(
+	          NULL,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = libhmac_md5_free(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "md5_context",
+	 md5_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_block != NULL )
+	{
+		memory_free(
+		 digest_hash_block );
+	}
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_sha1_callback function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_sha1_callback(
+     void )
+{
+	uint8_t calculated_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t data[ 4096 ];
+	uint8_t expected_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+
+	digest_hash_threads_t digest_hash_threads;
+
+	digest_hash_block_t *digest_hash_block = NULL;
+	libcerror_error_t *error               = NULL;
+	sha1_context_t *sha1_context           = NULL;
+	size_t data_offset                     = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = libhmac_sha1_calculate(
+	          data,
+	          4096,
+	          expected_hash,
+	          LIBHMAC_SHA1_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sha1_context_initialize(
+	          &sha1_context,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sha1_context",
+	 sha1_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &digest_hash_threads,
+	 0,
+	 sizeof( digest_hash_threads_t ) );
+
+	digest_hash_threads.sha1_context = sha1_context;
+
+	/* Test regular cases
+	 */
+	digest_hash_block = memory_allocate_structure(
+	                     digest_hash_block_t );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_block",
+	 digest_hash_block );
+
+	digest_hash_block->storage_media_buffer = NULL;
+	digest_hash_block->data                 = data;
+	digest_hash_block->data_size            = 4096;
+
+	/* The callback takes over the digest hash block
+	 */
+	result = digest_hash_threads_sha1_callback(
+	          digest_hash_block,
+	          &digest_hash_threads );
+
+	digest_hash_block = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_hash_threads.update_failed",
+	 digest_hash_threads.update_failed,
+	 0 );
+
+	result = sha1_context_finalize(
+	          sha1_context,
+	          calculated_hash,
+	          LIBHMAC_SHA1_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          calculated_hash,
+	          expected_hash,
+	          LIBHMAC_SHA1_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_sha1_callback(
+	          NULL,
+	          &digest_hash_threads );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = digest_hash_threads_sha1_callback(
+	          NULL,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = sha1_context_free(
+	          &sha1_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sha1_context",
+	 sha1_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_block != NULL )
+	{
+		memory_free(
+		 digest_hash_block );
+	}
+	if( sha1_context != NULL )
+	{
+		sha1_context_free(
+		 &sha1_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_sha256_callback function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_sha256_callback(
+     void )
+{
+	uint8_t calculated_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+	uint8_t data[ 4096 ];
+	uint8_t expected_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	digest_hash_threads_t digest_hash_threads;
+
+	digest_hash_block_t *digest_hash_block = NULL;
+	libcerror_error_t *error               = NULL;
+	sha256_context_t *sha256_context       = NULL;
+	size_t data_offset                     = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = libhmac_sha256_calculate(
+	          data,
+	          4096,
+	          expected_hash,
+	          LIBHMAC_SHA256_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sha256_context_initialize(
+	          &sha256_context,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sha256_context",
+	 sha256_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &digest_hash_threads,
+	 0,
+	 sizeof( digest_hash_threads_t ) );
+
+	digest_hash_threads.sha256_context = sha256_context;
+
+	/* Test regular cases
+	 */
+	digest_hash_block = memory_allocate_structure(
+	                     digest_hash_block_t );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_block",
+	 digest_hash_block );
+
+	digest_hash_block->storage_media_buffer = NULL;
+	digest_hash_block->data                 = data;
+	digest_hash_block->data_size            = 4096;
+
+	/* The callback takes over the digest hash block
+	 */
+	result = digest_hash_threads_sha256_callback(
+	          digest_hash_block,
+	          &digest_hash_threads );
+
+	digest_hash_block = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_hash_threads.update_failed",
+	 digest_hash_threads.update_failed,
+	 0 );
+
+	result = sha256_context_finalize(
+	          sha256_context,
+	          calculated_hash,
+	          LIBHMAC_SHA256_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          calculated_hash,
+	          expected_hash,
+	          LIBHMAC_SHA256_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_sha256_callback(
+	          NULL,
+	          &digest_hash_threads );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = digest_hash_threads_sha256_callback(
+	          NULL,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = sha256_context_free(
+	          &sha256_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sha256_context",
+	 sha256_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_block != NULL )
+	{
+		memory_free(
+		 digest_hash_block );
+	}
+	if( sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &sha256_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_release_block function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_release_block(
+     void )
+{
+	digest_hash_threads_t digest_hash_threads;
+
+	digest_hash_block_t *digest_hash_block = NULL;
+	libcerror_error_t *error               = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &digest_hash_threads,
+	 0,
+	 sizeof( digest_hash_threads_t ) );
+
+	digest_hash_block = memory_allocate_structure(
+	                     digest_hash_block_t );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_block",
+	 digest_hash_block );
+
+	digest_hash_block->storage_media_buffer = NULL;
+	digest_hash_block->data                 = NULL;
+	digest_hash_block->data_size            = 0;
+
+	/* Test regular cases
+	 */
+	result = digest_hash_threads_release_block(
+	          &digest_hash_threads,
+	          &digest_hash_block,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_hash_block",
+	 digest_hash_block );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A digest hash block that was already released is ignored
+	 */
+	result = digest_hash_threads_release_block(
+	          &digest_hash_threads,
+	          &digest_hash_block,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_release_block(
+	          NULL,
+	          &digest_hash_block,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_hash_threads_release_block(
+	          &digest_hash_threads,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_block != NULL )
+	{
+		memory_free(
+		 digest_hash_block );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_push_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_push_buffer(
+     void )
+{
+	uint8_t data[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_push_buffer(
+	          NULL,
+	          NULL,
+	          data,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_join function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_join(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_join(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_initialize",
+	 ewf_test_tools_digest_hash_threads_initialize );
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_free",
+	 ewf_test_tools_digest_hash_threads_free );
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_md5_callback",
+	 ewf_test_tools_digest_hash_threads_md5_callback );
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_sha1_callback",
+	 ewf_test_tools_digest_hash_threads_sha1_callback );
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_sha256_callback",
+	 ewf_test_tools_digest_hash_threads_sha256_callback );
+
+	/* TODO: add tests for digest_hash_threads_sha256_tree_callback */
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_release_block",
+	 ewf_test_tools_digest_hash_threads_release_block );
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_push_buffer",
+	 ewf_test_tools_digest_hash_threads_push_buffer );
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_join",
+	 ewf_test_tools_digest_hash_threads_join );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+on_error:
+	return( EXIT_FAILURE );
+#endif
+}
+
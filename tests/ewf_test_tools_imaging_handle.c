@@ -22,6 +22,7 @@
 #include <common.h>
 #include <file_stream.h>
 #include <memory.h>
+#include <system_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -29,12 +30,24 @@
 #endif
 
 #include "ewf_test_libcerror.h"
+#include "ewf_test_libcfile.h"
 #include "ewf_test_libewf.h"
 #include "ewf_test_macros.h"
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
 #include "../ewftools/imaging_handle.h"
+#include "../ewftools/process_status.h"
+#include "../ewftools/storage_media_buffer.h"
+#include "../ewftools/storage_media_buffer_queue.h"
+
+#define EWF_TEST_TOOLS_IMAGING_HANDLE_NUMBER_OF_BUFFERS		64
+
+#define EWF_TEST_TOOLS_IMAGING_HANDLE_PRIMARY_TARGET		_SYSTEM_STRING( "ewf_test_tools_imaging_handle_primary" )
+#define EWF_TEST_TOOLS_IMAGING_HANDLE_PRIMARY_IMAGE		_SYSTEM_STRING( "ewf_test_tools_imaging_handle_primary.E01" )
+
+#define EWF_TEST_TOOLS_IMAGING_HANDLE_SECONDARY_TARGET		_SYSTEM_STRING( "ewf_test_tools_imaging_handle_secondary" )
+#define EWF_TEST_TOOLS_IMAGING_HANDLE_SECONDARY_IMAGE		_SYSTEM_STRING( "ewf_test_tools_imaging_handle_secondary.E01" )
 
 /* Tests the imaging_handle_initialize function
  * Returns 1 if successful or 0 if not
@@ -332,6 +345,988 @@ on_error:
 	return( 0 );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Removes the segment file of a test image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_imaging_handle_remove_image(
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_tools_imaging_handle_remove_image";
+	int result            = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          filename,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          filename,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if image exists.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcfile_file_remove_wide(
+		          filename,
+		          error );
+#else
+		result = libcfile_file_remove(
+		          filename,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove image.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the media data of a test image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_imaging_handle_read_image(
+     const system_character_t *filename,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	system_character_t *filenames[ 1 ] = { NULL };
+	libewf_handle_t *handle            = NULL;
+	static char *function              = "ewf_test_tools_imaging_handle_read_image";
+	size64_t media_size                = 0;
+	ssize_t read_count                 = 0;
+	int result                         = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	filenames[ 0 ] = (system_character_t *) filename;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          filenames,
+	          1,
+	          LIBEWF_OPEN_READ,
+	          error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          filenames,
+	          1,
+	          LIBEWF_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( media_size != (size64_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: media size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              data,
+	              data_size,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read media data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Grabs a storage media buffer and fills it with test data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_imaging_handle_grab_buffer(
+     imaging_handle_t *imaging_handle,
+     const uint8_t *data,
+     size_t process_buffer_size,
+     int buffer_index,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_tools_imaging_handle_grab_buffer";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue_grab_buffer(
+	     imaging_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab storage media buffer from queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( *storage_media_buffer )->raw_buffer,
+	     &( data[ buffer_index * process_buffer_size ] ),
+	     process_buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data to storage media buffer.",
+		 function );
+
+		storage_media_buffer_queue_release_buffer(
+		 imaging_handle->storage_media_buffer_queue,
+		 *storage_media_buffer,
+		 NULL );
+
+		*storage_media_buffer = NULL;
+
+		return( -1 );
+	}
+	( *storage_media_buffer )->storage_media_offset = (off64_t) buffer_index * process_buffer_size;
+	( *storage_media_buffer )->sequence_number      = (uint64_t) buffer_index;
+	( *storage_media_buffer )->requested_size       = process_buffer_size;
+	( *storage_media_buffer )->raw_buffer_data_size = process_buffer_size;
+
+	return( 1 );
+}
+
+/* Opens the outputs of an imaging handle for the secondary output tests
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_imaging_handle_open_outputs(
+     imaging_handle_t **imaging_handle,
+     size_t *process_buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_tools_imaging_handle_open_outputs";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewf_test_tools_imaging_handle_remove_image(
+	     EWF_TEST_TOOLS_IMAGING_HANDLE_PRIMARY_IMAGE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 "%s: unable to remove primary image.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_tools_imaging_handle_remove_image(
+	     EWF_TEST_TOOLS_IMAGING_HANDLE_SECONDARY_IMAGE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 "%s: unable to remove secondary image.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_initialize(
+	     imaging_handle,
+	     0,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create imaging handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_open_output(
+	     *imaging_handle,
+	     EWF_TEST_TOOLS_IMAGING_HANDLE_PRIMARY_TARGET,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_open_secondary_output(
+	     *imaging_handle,
+	     EWF_TEST_TOOLS_IMAGING_HANDLE_SECONDARY_TARGET,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open secondary output.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_get_process_buffer_size(
+	     *imaging_handle,
+	     1,
+	     process_buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve process buffer size.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_threads_start(
+	     *imaging_handle,
+	     *process_buffer_size,
+	     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to start threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_start(
+	     *imaging_handle,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to start imaging handle.",
+		 function );
+
+		imaging_handle_threads_stop(
+		 *imaging_handle,
+		 NULL );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *imaging_handle != NULL )
+	{
+		imaging_handle_free(
+		 imaging_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the imaging_handle_secondary_output_storage_media_buffer_callback function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_imaging_handle_secondary_output_storage_media_buffer_callback(
+     void )
+{
+	imaging_handle_t *imaging_handle             = NULL;
+	libcerror_error_t *error                     = NULL;
+	libewf_handle_t *secondary_output_handle     = NULL;
+	libewf_handle_t *unopened_output_handle      = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	uint8_t *data                                = NULL;
+	uint8_t *read_data                           = NULL;
+	size_t data_index                            = 0;
+	size_t data_size                             = 0;
+	size_t process_buffer_size                   = 0;
+	ssize_t process_count                        = 0;
+	int buffer_index                             = 0;
+	int result                                   = 0;
+
+	/* Test if both outputs receive the same chunks
+	 */
+	result = ewf_test_tools_imaging_handle_open_outputs(
+	          &imaging_handle,
+	          &process_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "imaging_handle",
+	 imaging_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_size = process_buffer_size * EWF_TEST_TOOLS_IMAGING_HANDLE_NUMBER_OF_BUFFERS;
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	read_data = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_data",
+	 read_data );
+
+	for( data_index = 0;
+	     data_index < data_size;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( ( data_index * 31 ) + ( data_index >> 12 ) );
+	}
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_TOOLS_IMAGING_HANDLE_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		result = ewf_test_tools_imaging_handle_grab_buffer(
+		          imaging_handle,
+		          data,
+		          process_buffer_size,
+		          buffer_index,
+		          &storage_media_buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcthreads_thread_pool_push(
+		          imaging_handle->process_thread_pool,
+		          (intptr_t *) storage_media_buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		storage_media_buffer = NULL;
+	}
+	result = imaging_handle_threads_stop(
+	          imaging_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "imaging_handle->abort",
+	 imaging_handle->abort,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "imaging_handle->last_offset_written",
+	 (int64_t) imaging_handle->last_offset_written,
+	 (int64_t) data_size );
+
+	result = imaging_handle_stop(
+	          imaging_handle,
+	          0,
+	          PROCESS_STATUS_COMPLETED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = imaging_handle_close(
+	          imaging_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = imaging_handle_free(
+	          &imaging_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_imaging_handle_read_image(
+	          EWF_TEST_TOOLS_IMAGING_HANDLE_PRIMARY_IMAGE,
+	          read_data,
+	          data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_data,
+	          data,
+	          data_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_tools_imaging_handle_read_image(
+	          EWF_TEST_TOOLS_IMAGING_HANDLE_SECONDARY_IMAGE,
+	          read_data,
+	          data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_data,
+	          data,
+	          data_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test if an error writing the secondary output stops writing the primary output
+	 */
+	result = ewf_test_tools_imaging_handle_open_outputs(
+	          &imaging_handle,
+	          &process_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "imaging_handle",
+	 imaging_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Writing to a handle that was not opened fails
+	 */
+	result = libewf_handle_initialize(
+	          &unopened_output_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	secondary_output_handle                 = imaging_handle->secondary_output_handle;
+	imaging_handle->secondary_output_handle = unopened_output_handle;
+
+	result = ewf_test_tools_imaging_handle_grab_buffer(
+	          imaging_handle,
+	          data,
+	          process_buffer_size,
+	          0,
+	          &storage_media_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	process_count = storage_media_buffer_write_process(
+	                 storage_media_buffer,
+	                 &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "process_count",
+	 process_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The callback releases the storage media buffer on error
+	 */
+	result = imaging_handle_secondary_output_storage_media_buffer_callback(
+	          storage_media_buffer,
+	          imaging_handle );
+
+	storage_media_buffer = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "imaging_handle->abort",
+	 imaging_handle->abort,
+	 1 );
+
+	/* The primary output is no longer written after the secondary output failed
+	 */
+	result = ewf_test_tools_imaging_handle_grab_buffer(
+	          imaging_handle,
+	          data,
+	          process_buffer_size,
+	          0,
+	          &storage_media_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	process_count = storage_media_buffer_write_process(
+	                 storage_media_buffer,
+	                 &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "process_count",
+	 process_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The callback does not release the storage media buffer after an abort
+	 */
+	result = imaging_handle_output_storage_media_buffer_callback(
+	          storage_media_buffer,
+	          imaging_handle );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "imaging_handle->last_offset_written",
+	 (int64_t) imaging_handle->last_offset_written,
+	 (int64_t) 0 );
+
+	/* The secondary output is no longer written after an abort
+	 * and the callback releases the storage media buffer
+	 */
+	result = imaging_handle_secondary_output_storage_media_buffer_callback(
+	          storage_media_buffer,
+	          imaging_handle );
+
+	storage_media_buffer = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	imaging_handle->secondary_output_handle = secondary_output_handle;
+	secondary_output_handle                 = NULL;
+
+	result = libewf_handle_free(
+	          &unopened_output_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = imaging_handle_secondary_output_storage_media_buffer_callback(
+	          NULL,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = imaging_handle_secondary_output_storage_media_buffer_callback(
+	          NULL,
+	          imaging_handle );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = imaging_handle_threads_stop(
+	          imaging_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = imaging_handle_stop(
+	          imaging_handle,
+	          0,
+	          PROCESS_STATUS_ABORTED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = imaging_handle_close(
+	          imaging_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = imaging_handle_free(
+	          &imaging_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 read_data );
+
+	read_data = NULL;
+
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	result = ewf_test_tools_imaging_handle_remove_image(
+	          EWF_TEST_TOOLS_IMAGING_HANDLE_PRIMARY_IMAGE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_imaging_handle_remove_image(
+	          EWF_TEST_TOOLS_IMAGING_HANDLE_SECONDARY_IMAGE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( imaging_handle != NULL )
+	{
+		if( secondary_output_handle != NULL )
+		{
+			imaging_handle->secondary_output_handle = secondary_output_handle;
+		}
+		if( storage_media_buffer != NULL )
+		{
+			storage_media_buffer_queue_release_buffer(
+			 imaging_handle->storage_media_buffer_queue,
+			 storage_media_buffer,
+			 NULL );
+		}
+		imaging_handle_threads_stop(
+		 imaging_handle,
+		 NULL );
+		imaging_handle_free(
+		 &imaging_handle,
+		 NULL );
+	}
+	if( unopened_output_handle != NULL )
+	{
+		libewf_handle_free(
+		 &unopened_output_handle,
+		 NULL );
+	}
+	if( read_data != NULL )
+	{
+		memory_free(
+		 read_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	ewf_test_tools_imaging_handle_remove_image(
+	 EWF_TEST_TOOLS_IMAGING_HANDLE_PRIMARY_IMAGE,
+	 NULL );
+	ewf_test_tools_imaging_handle_remove_image(
+	 EWF_TEST_TOOLS_IMAGING_HANDLE_SECONDARY_IMAGE,
+	 NULL );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -420,7 +1415,11 @@ int main(
 
 	/* TODO add tests for imaging_handle_output_storage_media_buffer_callback */
 
-	/* TODO add tests for imaging_handle_empty_output_list */
+	EWF_TEST_RUN(
+	 "imaging_handle_secondary_output_storage_media_buffer_callback",
+	 ewf_test_tools_imaging_handle_secondary_output_storage_media_buffer_callback );
+
+	/* TODO add tests for imaging_handle_empty_output_ring */
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -0,0 +1,783 @@
+/*
+ * Tools sha1_context functions test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/digest_hash.h"
+#include "../ewftools/sha1_context.h"
+
+/* Calculates the SHA-1 of the data in parts of the specified size
+ * If hardware_flags is not 0 it overrides the instructions used by the context
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_sha1_context_calculate(
+     uint8_t use_hardware,
+     uint8_t hardware_flags,
+     const uint8_t *data,
+     size_t data_size,
+     size_t part_size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	sha1_context_t *context = NULL;
+	size_t data_offset      = 0;
+	size_t read_size        = 0;
+
+	if( sha1_context_initialize(
+	     &context,
+	     use_hardware,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ( context->use_hardware != 0 )
+	 && ( hardware_flags != 0 ) )
+	{
+		context->hardware_flags = hardware_flags;
+	}
+	while( data_offset < data_size )
+	{
+		read_size = data_size - data_offset;
+
+		if( read_size > part_size )
+		{
+			read_size = part_size;
+		}
+		if( sha1_context_update(
+		     context,
+		     &( data[ data_offset ] ),
+		     read_size,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		data_offset += read_size;
+	}
+	if( sha1_context_finalize(
+	     context,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( sha1_context_free(
+	     &context,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( context != NULL )
+	{
+		sha1_context_free(
+		 &context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the sha1_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sha1_context_initialize(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	sha1_context_t *context  = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = sha1_context_initialize(
+	          &context,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sha1_context_free(
+	          &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sha1_context_initialize(
+	          &context,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sha1_context_free(
+	          &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = sha1_context_initialize(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	context = (sha1_context_t *) 0x12345678UL;
+
+	result = sha1_context_initialize(
+	          &context,
+	          0,
+	          &error );
+
+	context = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		sha1_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the sha1_context_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sha1_context_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = sha1_context_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the sha1_context_update and sha1_context_finalize functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sha1_context_update(
+     void )
+{
+	uint8_t data[ 4099 ];
+	uint8_t hash[ 20 ];
+	uint8_t software_hash[ 20 ];
+
+	uint8_t expected_hash[ 20 ] = {
+		0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e, 0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c,
+		0x9c, 0xd0, 0xd8, 0x9d };
+
+	size_t part_sizes[ 5 ] = {
+		1, 55, 64, 1000, 4099 };
+
+	libcerror_error_t *error = NULL;
+	sha1_context_t *context  = NULL;
+	size_t data_index        = 0;
+	int part_size_index      = 0;
+	int result               = 0;
+
+	/* Test with the "abc" test vector
+	 */
+	result = ewf_test_tools_sha1_context_calculate(
+	          1,
+	          0,
+	          (uint8_t *) "abc",
+	          3,
+	          3,
+	          hash,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash,
+	          20 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test if the hash equals the hash calculated by libhmac
+	 */
+	for( data_index = 0;
+	     data_index < 4099;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( ( data_index * 131 ) + 7 );
+	}
+	result = ewf_test_tools_sha1_context_calculate(
+	          0,
+	          0,
+	          data,
+	          4099,
+	          4099,
+	          software_hash,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( part_size_index = 0;
+	     part_size_index < 5;
+	     part_size_index++ )
+	{
+		result = ewf_test_tools_sha1_context_calculate(
+		          1,
+		          0,
+		          data,
+		          4099,
+		          part_sizes[ part_size_index ],
+		          hash,
+		          20,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          hash,
+		          software_hash,
+		          20 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Initialize test
+	 */
+	result = sha1_context_initialize(
+	          &context,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = sha1_context_update(
+	          NULL,
+	          data,
+	          4099,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha1_context_update(
+	          context,
+	          NULL,
+	          4099,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha1_context_update(
+	          context,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha1_context_finalize(
+	          NULL,
+	          hash,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha1_context_finalize(
+	          context,
+	          NULL,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha1_context_finalize(
+	          context,
+	          hash,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = sha1_context_free(
+	          &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		sha1_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the sha1_context_update and sha1_context_finalize functions using the AVX2 instructions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sha1_context_update_avx2(
+     void )
+{
+	uint8_t data[ 4099 ];
+	uint8_t hash[ 20 ];
+	uint8_t software_hash[ 20 ];
+
+	uint8_t expected_hash1[ 20 ] = {
+		0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e, 0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c,
+		0x9c, 0xd0, 0xd8, 0x9d };
+
+	uint8_t expected_hash2[ 20 ] = {
+		0x84, 0x98, 0x3e, 0x44, 0x1c, 0x3b, 0xd2, 0x6e, 0xba, 0xae, 0x4a, 0xa1, 0xf9, 0x51, 0x29, 0xe5,
+		0xe5, 0x46, 0x70, 0xf1 };
+
+	size_t part_sizes[ 6 ] = {
+		1, 55, 64, 512, 1000, 4099 };
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	uint8_t hardware_flags   = 0;
+	int part_size_index      = 0;
+	int result               = 0;
+
+	result = digest_hash_get_hardware_flags(
+	          &hardware_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( ( hardware_flags & DIGEST_HASH_HARDWARE_FLAG_AVX2 ) == 0 )
+	{
+		return( 1 );
+	}
+	/* Test with the "abc" test vector
+	 */
+	result = ewf_test_tools_sha1_context_calculate(
+	          1,
+	          DIGEST_HASH_HARDWARE_FLAG_AVX2,
+	          (uint8_t *) "abc",
+	          3,
+	          3,
+	          hash,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash1,
+	          20 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test with the 448-bit test vector
+	 */
+	result = ewf_test_tools_sha1_context_calculate(
+	          1,
+	          DIGEST_HASH_HARDWARE_FLAG_AVX2,
+	          (uint8_t *) "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+	          56,
+	          56,
+	          hash,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash2,
+	          20 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test if the hash equals the hash calculated by libhmac, where parts
+	 * of 512 bytes or more contain groups of 8 blocks
+	 */
+	for( data_index = 0;
+	     data_index < 4099;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( ( data_index * 131 ) + 7 );
+	}
+	result = ewf_test_tools_sha1_context_calculate(
+	          0,
+	          0,
+	          data,
+	          4099,
+	          4099,
+	          software_hash,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( part_size_index = 0;
+	     part_size_index < 6;
+	     part_size_index++ )
+	{
+		result = ewf_test_tools_sha1_context_calculate(
+		          1,
+		          DIGEST_HASH_HARDWARE_FLAG_AVX2,
+		          data,
+		          4099,
+		          part_sizes[ part_size_index ],
+		          hash,
+		          20,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          hash,
+		          software_hash,
+		          20 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "sha1_context_initialize",
+	 ewf_test_tools_sha1_context_initialize );
+
+	EWF_TEST_RUN(
+	 "sha1_context_free",
+	 ewf_test_tools_sha1_context_free );
+
+	EWF_TEST_RUN(
+	 "sha1_context_update",
+	 ewf_test_tools_sha1_context_update );
+
+	EWF_TEST_RUN(
+	 "sha1_context_update_avx2",
+	 ewf_test_tools_sha1_context_update_avx2 );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,783 @@
+/*
+ * Tools sha256_context functions test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/digest_hash.h"
+#include "../ewftools/sha256_context.h"
+
+/* Calculates the SHA-256 of the data in parts of the specified size
+ * If hardware_flags is not 0 it overrides the instructions used by the context
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_sha256_context_calculate(
+     uint8_t use_hardware,
+     uint8_t hardware_flags,
+     const uint8_t *data,
+     size_t data_size,
+     size_t part_size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	sha256_context_t *context = NULL;
+	size_t data_offset        = 0;
+	size_t read_size          = 0;
+
+	if( sha256_context_initialize(
+	     &context,
+	     use_hardware,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ( context->use_hardware != 0 )
+	 && ( hardware_flags != 0 ) )
+	{
+		context->hardware_flags = hardware_flags;
+	}
+	while( data_offset < data_size )
+	{
+		read_size = data_size - data_offset;
+
+		if( read_size > part_size )
+		{
+			read_size = part_size;
+		}
+		if( sha256_context_update(
+		     context,
+		     &( data[ data_offset ] ),
+		     read_size,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		data_offset += read_size;
+	}
+	if( sha256_context_finalize(
+	     context,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( sha256_context_free(
+	     &context,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( context != NULL )
+	{
+		sha256_context_free(
+		 &context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the sha256_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sha256_context_initialize(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	sha256_context_t *context = NULL;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = sha256_context_initialize(
+	          &context,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sha256_context_free(
+	          &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sha256_context_initialize(
+	          &context,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sha256_context_free(
+	          &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = sha256_context_initialize(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	context = (sha256_context_t *) 0x12345678UL;
+
+	result = sha256_context_initialize(
+	          &context,
+	          0,
+	          &error );
+
+	context = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		sha256_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the sha256_context_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sha256_context_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = sha256_context_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the sha256_context_update and sha256_context_finalize functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sha256_context_update(
+     void )
+{
+	uint8_t data[ 4099 ];
+	uint8_t hash[ 32 ];
+	uint8_t software_hash[ 32 ];
+
+	uint8_t expected_hash[ 32 ] = {
+		0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+		0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+
+	size_t part_sizes[ 5 ] = {
+		1, 55, 64, 1000, 4099 };
+
+	libcerror_error_t *error  = NULL;
+	sha256_context_t *context = NULL;
+	size_t data_index         = 0;
+	int part_size_index       = 0;
+	int result                = 0;
+
+	/* Test with the "abc" test vector
+	 */
+	result = ewf_test_tools_sha256_context_calculate(
+	          1,
+	          0,
+	          (uint8_t *) "abc",
+	          3,
+	          3,
+	          hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test if the hash equals the hash calculated by libhmac
+	 */
+	for( data_index = 0;
+	     data_index < 4099;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( ( data_index * 131 ) + 7 );
+	}
+	result = ewf_test_tools_sha256_context_calculate(
+	          0,
+	          0,
+	          data,
+	          4099,
+	          4099,
+	          software_hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( part_size_index = 0;
+	     part_size_index < 5;
+	     part_size_index++ )
+	{
+		result = ewf_test_tools_sha256_context_calculate(
+		          1,
+		          0,
+		          data,
+		          4099,
+		          part_sizes[ part_size_index ],
+		          hash,
+		          32,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          hash,
+		          software_hash,
+		          32 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Initialize test
+	 */
+	result = sha256_context_initialize(
+	          &context,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = sha256_context_update(
+	          NULL,
+	          data,
+	          4099,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha256_context_update(
+	          context,
+	          NULL,
+	          4099,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha256_context_update(
+	          context,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha256_context_finalize(
+	          NULL,
+	          hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha256_context_finalize(
+	          context,
+	          NULL,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sha256_context_finalize(
+	          context,
+	          hash,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = sha256_context_free(
+	          &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		sha256_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the sha256_context_update and sha256_context_finalize functions using the AVX2 instructions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sha256_context_update_avx2(
+     void )
+{
+	uint8_t data[ 4099 ];
+	uint8_t hash[ 32 ];
+	uint8_t software_hash[ 32 ];
+
+	uint8_t expected_hash1[ 32 ] = {
+		0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+		0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+
+	uint8_t expected_hash2[ 32 ] = {
+		0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+		0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1 };
+
+	size_t part_sizes[ 6 ] = {
+		1, 55, 64, 512, 1000, 4099 };
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	uint8_t hardware_flags   = 0;
+	int part_size_index      = 0;
+	int result               = 0;
+
+	result = digest_hash_get_hardware_flags(
+	          &hardware_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( ( hardware_flags & DIGEST_HASH_HARDWARE_FLAG_AVX2 ) == 0 )
+	{
+		return( 1 );
+	}
+	/* Test with the "abc" test vector
+	 */
+	result = ewf_test_tools_sha256_context_calculate(
+	          1,
+	          DIGEST_HASH_HARDWARE_FLAG_AVX2,
+	          (uint8_t *) "abc",
+	          3,
+	          3,
+	          hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash1,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test with the 448-bit test vector
+	 */
+	result = ewf_test_tools_sha256_context_calculate(
+	          1,
+	          DIGEST_HASH_HARDWARE_FLAG_AVX2,
+	          (uint8_t *) "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+	          56,
+	          56,
+	          hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash2,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test if the hash equals the hash calculated by libhmac, where parts
+	 * of 512 bytes or more contain groups of 8 blocks
+	 */
+	for( data_index = 0;
+	     data_index < 4099;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( ( data_index * 131 ) + 7 );
+	}
+	result = ewf_test_tools_sha256_context_calculate(
+	          0,
+	          0,
+	          data,
+	          4099,
+	          4099,
+	          software_hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( part_size_index = 0;
+	     part_size_index < 6;
+	     part_size_index++ )
+	{
+		result = ewf_test_tools_sha256_context_calculate(
+		          1,
+		          DIGEST_HASH_HARDWARE_FLAG_AVX2,
+		          data,
+		          4099,
+		          part_sizes[ part_size_index ],
+		          hash,
+		          32,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          hash,
+		          software_hash,
+		          32 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "sha256_context_initialize",
+	 ewf_test_tools_sha256_context_initialize );
+
+	EWF_TEST_RUN(
+	 "sha256_context_free",
+	 ewf_test_tools_sha256_context_free );
+
+	EWF_TEST_RUN(
+	 "sha256_context_update",
+	 ewf_test_tools_sha256_context_update );
+
+	EWF_TEST_RUN(
+	 "sha256_context_update_avx2",
+	 ewf_test_tools_sha256_context_update_avx2 );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,687 @@
+/*
+ * Tools storage_media_buffer_ring functions test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/storage_media_buffer.h"
+#include "../ewftools/storage_media_buffer_ring.h"
+
+/* Tests the storage_media_buffer_ring_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_storage_media_buffer_ring_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	storage_media_buffer_ring_t *ring = NULL;
+	int result                        = 0;
+
+	/* Test regular cases
+	 */
+	result = storage_media_buffer_ring_initialize(
+	          &ring,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "ring",
+	 ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_ring_free(
+	          &ring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "ring",
+	 ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = storage_media_buffer_ring_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	ring = (storage_media_buffer_ring_t *) 0x12345678UL;
+
+	result = storage_media_buffer_ring_initialize(
+	          &ring,
+	          4,
+	          &error );
+
+	ring = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_ring_initialize(
+	          &ring,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "ring",
+	 ring );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( ring != NULL )
+	{
+		storage_media_buffer_ring_free(
+		 &ring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the storage_media_buffer_ring_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_storage_media_buffer_ring_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = storage_media_buffer_ring_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the storage_media_buffer_ring_insert_buffer and storage_media_buffer_ring_remove_next_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_storage_media_buffer_ring_insert_buffer(
+     void )
+{
+	storage_media_buffer_t buffers[ 8 ];
+
+	int insert_order[ 8 ] = {
+		2, 1, 3, 0, 5, 7, 6, 4 };
+
+	libcerror_error_t *error                     = NULL;
+	storage_media_buffer_ring_t *ring            = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	uint64_t expected_sequence_number            = 0;
+	int buffer_index                             = 0;
+	int result                                   = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < 8;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ].sequence_number = (uint64_t) buffer_index;
+	}
+	/* Initialize test
+	 */
+	result = storage_media_buffer_ring_initialize(
+	          &ring,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "ring",
+	 ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if the buffers are removed in sequence
+	 */
+	for( buffer_index = 0;
+	     buffer_index < 8;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_ring_insert_buffer(
+		          ring,
+		          &( buffers[ insert_order[ buffer_index ] ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		do
+		{
+			result = storage_media_buffer_ring_remove_next_buffer(
+			          ring,
+			          &storage_media_buffer,
+			          &error );
+
+			EWF_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( result != 0 )
+			{
+				EWF_TEST_ASSERT_EQUAL_UINT64(
+				 "storage_media_buffer->sequence_number",
+				 storage_media_buffer->sequence_number,
+				 expected_sequence_number );
+
+				expected_sequence_number += 1;
+			}
+		}
+		while( result != 0 );
+	}
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "expected_sequence_number",
+	 expected_sequence_number,
+	 (uint64_t) 8 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "ring->number_of_used_buffers",
+	 ring->number_of_used_buffers,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = storage_media_buffer_ring_insert_buffer(
+	          NULL,
+	          &( buffers[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_ring_insert_buffer(
+	          ring,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a sequence number that was already removed
+	 */
+	result = storage_media_buffer_ring_insert_buffer(
+	          ring,
+	          &( buffers[ 7 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a sequence number that exceeds the number of buffers
+	 */
+	buffers[ 0 ].sequence_number = 12;
+
+	result = storage_media_buffer_ring_insert_buffer(
+	          ring,
+	          &( buffers[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_ring_remove_next_buffer(
+	          NULL,
+	          &storage_media_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_ring_remove_next_buffer(
+	          ring,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = storage_media_buffer_ring_free(
+	          &ring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "ring",
+	 ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( ring != NULL )
+	{
+		storage_media_buffer_ring_free(
+		 &ring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the storage_media_buffer_ring_remove_buffer_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_storage_media_buffer_ring_remove_buffer_by_index(
+     void )
+{
+	storage_media_buffer_t buffers[ 2 ];
+
+	libcerror_error_t *error                     = NULL;
+	storage_media_buffer_ring_t *ring            = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	int buffer_index                             = 0;
+	int number_of_removed_buffers                = 0;
+	int result                                   = 0;
+
+	buffers[ 0 ].sequence_number = 1;
+	buffers[ 1 ].sequence_number = 3;
+
+	/* Initialize test
+	 */
+	result = storage_media_buffer_ring_initialize(
+	          &ring,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "ring",
+	 ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_index = 0;
+	     buffer_index < 2;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_ring_insert_buffer(
+		          ring,
+		          &( buffers[ buffer_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( buffer_index = 0;
+	     buffer_index < 4;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_ring_remove_buffer_by_index(
+		          ring,
+		          buffer_index,
+		          &storage_media_buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			number_of_removed_buffers++;
+		}
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_removed_buffers",
+	 number_of_removed_buffers,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "ring->number_of_used_buffers",
+	 ring->number_of_used_buffers,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = storage_media_buffer_ring_remove_buffer_by_index(
+	          NULL,
+	          0,
+	          &storage_media_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_ring_remove_buffer_by_index(
+	          ring,
+	          -1,
+	          &storage_media_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_ring_remove_buffer_by_index(
+	          ring,
+	          4,
+	          &storage_media_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_ring_remove_buffer_by_index(
+	          ring,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = storage_media_buffer_ring_free(
+	          &ring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "ring",
+	 ring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( ring != NULL )
+	{
+		storage_media_buffer_ring_free(
+		 &ring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_ring_initialize",
+	 ewf_test_tools_storage_media_buffer_ring_initialize );
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_ring_free",
+	 ewf_test_tools_storage_media_buffer_ring_free );
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_ring_insert_buffer",
+	 ewf_test_tools_storage_media_buffer_ring_insert_buffer );
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_ring_remove_buffer_by_index",
+	 ewf_test_tools_storage_media_buffer_ring_remove_buffer_by_index );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
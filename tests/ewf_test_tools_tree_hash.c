@@ -0,0 +1,649 @@
+/*
+ * Tools tree_hash functions test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/sha256_context.h"
+#include "../ewftools/tree_hash.h"
+
+/* Calculates the tree hash of the data in parts of the specified size
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_tree_hash_calculate(
+     const uint8_t *data,
+     size_t data_size,
+     size_t block_size,
+     size_t part_size,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	tree_hash_t *tree_hash = NULL;
+	size_t data_offset     = 0;
+	size_t read_size       = 0;
+
+	if( tree_hash_initialize(
+	     &tree_hash,
+	     block_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	while( data_offset < data_size )
+	{
+		read_size = data_size - data_offset;
+
+		if( read_size > part_size )
+		{
+			read_size = part_size;
+		}
+		if( tree_hash_update(
+		     tree_hash,
+		     &( data[ data_offset ] ),
+		     read_size,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		data_offset += read_size;
+	}
+	if( tree_hash_finalize(
+	     tree_hash,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( tree_hash_free(
+	     &tree_hash,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( tree_hash != NULL )
+	{
+		tree_hash_free(
+		 &tree_hash,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the tree_hash_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_tree_hash_initialize(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	tree_hash_t *tree_hash   = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = tree_hash_initialize(
+	          &tree_hash,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "tree_hash",
+	 tree_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = tree_hash_free(
+	          &tree_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "tree_hash",
+	 tree_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = tree_hash_initialize(
+	          NULL,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	tree_hash = (tree_hash_t *) 0x12345678UL;
+
+	result = tree_hash_initialize(
+	          &tree_hash,
+	          32768,
+	          &error );
+
+	tree_hash = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = tree_hash_initialize(
+	          &tree_hash,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( tree_hash != NULL )
+	{
+		tree_hash_free(
+		 &tree_hash,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the tree_hash_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_tree_hash_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = tree_hash_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the tree_hash_update and tree_hash_finalize functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_tree_hash_update(
+     void )
+{
+	uint8_t block_hashes[ 5 * 32 ];
+	uint8_t data[ 4099 ];
+	uint8_t expected_hash[ 32 ];
+	uint8_t hash[ 32 ];
+
+	size_t part_sizes[ 5 ] = {
+		1, 55, 1024, 1500, 4099 };
+
+	libcerror_error_t *error  = NULL;
+	sha256_context_t *context = NULL;
+	tree_hash_t *tree_hash    = NULL;
+	size_t block_offset       = 0;
+	size_t block_size         = 0;
+	size_t data_index         = 0;
+	int block_index           = 0;
+	int part_size_index       = 0;
+	int result                = 0;
+
+	for( data_index = 0;
+	     data_index < 4099;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( ( data_index * 131 ) + 7 );
+	}
+	/* Calculate the expected hash as the SHA-256 of the SHA-256 of every block of 1024 bytes
+	 */
+	for( block_index = 0;
+	     block_index < 5;
+	     block_index++ )
+	{
+		block_offset = (size_t) block_index * 1024;
+		block_size   = 4099 - block_offset;
+
+		if( block_size > 1024 )
+		{
+			block_size = 1024;
+		}
+		result = tree_hash_calculate_block_hash(
+		          &( data[ block_offset ] ),
+		          block_size,
+		          &( block_hashes[ block_index * 32 ] ),
+		          32,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = sha256_context_initialize(
+	          &context,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = sha256_context_update(
+	          context,
+	          block_hashes,
+	          5 * 32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = sha256_context_finalize(
+	          context,
+	          expected_hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = sha256_context_free(
+	          &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if the hash is independent of the size of the parts
+	 */
+	for( part_size_index = 0;
+	     part_size_index < 5;
+	     part_size_index++ )
+	{
+		result = ewf_test_tools_tree_hash_calculate(
+		          data,
+		          4099,
+		          1024,
+		          part_sizes[ part_size_index ],
+		          hash,
+		          32,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          hash,
+		          expected_hash,
+		          32 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test if block hashes calculated separately give the same hash
+	 */
+	result = tree_hash_initialize(
+	          &tree_hash,
+	          1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "tree_hash",
+	 tree_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_index = 0;
+	     block_index < 4;
+	     block_index++ )
+	{
+		result = tree_hash_update_block_hash(
+		          tree_hash,
+		          &( block_hashes[ block_index * 32 ] ),
+		          32,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The last partial block is provided as data
+	 */
+	result = tree_hash_update(
+	          tree_hash,
+	          &( data[ 4096 ] ),
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = tree_hash_update_block_hash(
+	          tree_hash,
+	          block_hashes,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = tree_hash_update_block_hash(
+	          NULL,
+	          block_hashes,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = tree_hash_update(
+	          NULL,
+	          data,
+	          4099,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = tree_hash_update(
+	          tree_hash,
+	          NULL,
+	          4099,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = tree_hash_finalize(
+	          tree_hash,
+	          hash,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = tree_hash_finalize(
+	          tree_hash,
+	          hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = tree_hash_free(
+	          &tree_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "tree_hash",
+	 tree_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( tree_hash != NULL )
+	{
+		tree_hash_free(
+		 &tree_hash,
+		 NULL );
+	}
+	if( context != NULL )
+	{
+		sha256_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "tree_hash_initialize",
+	 ewf_test_tools_tree_hash_initialize );
+
+	EWF_TEST_RUN(
+	 "tree_hash_free",
+	 ewf_test_tools_tree_hash_free );
+
+	EWF_TEST_RUN(
+	 "tree_hash_update",
+	 ewf_test_tools_tree_hash_update );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,841 @@
+/*
+ * Library write_queue type test program
+ *
+ * Copyright (C) 2006-2023, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_write_queue.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Packs chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_queue_pack_chunk_data(
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED,
+     libewf_chunk_data_t *chunk_data EWF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+	EWF_TEST_UNREFERENCED_PARAMETER( chunk_data )
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	return( 1 );
+}
+
+/* Fails to pack chunk data
+ * Returns -1 on error
+ */
+int ewf_test_write_queue_pack_chunk_data_failure(
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED,
+     libewf_chunk_data_t *chunk_data EWF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+	EWF_TEST_UNREFERENCED_PARAMETER( chunk_data )
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	return( -1 );
+}
+
+/* Tests the libewf_write_queue_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_queue_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_write_queue_t *write_queue = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 4;
+	int number_of_memset_fail_tests   = 2;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_write_queue_initialize(
+	          &write_queue,
+	          2,
+	          &ewf_test_write_queue_pack_chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_queue",
+	 write_queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_queue_free(
+	          &write_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_queue",
+	 write_queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_write_queue_initialize(
+	          NULL,
+	          2,
+	          &ewf_test_write_queue_pack_chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_queue = (libewf_write_queue_t *) 0x12345678UL;
+
+	result = libewf_write_queue_initialize(
+	          &write_queue,
+	          2,
+	          &ewf_test_write_queue_pack_chunk_data,
+	          NULL,
+	          &error );
+
+	write_queue = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_queue_initialize(
+	          &write_queue,
+	          0,
+	          &ewf_test_write_queue_pack_chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_queue_initialize(
+	          &write_queue,
+	          2,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_write_queue_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_write_queue_initialize(
+		          &write_queue,
+		          2,
+		          &ewf_test_write_queue_pack_chunk_data,
+		          NULL,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( write_queue != NULL )
+			{
+				libewf_write_queue_free(
+				 &write_queue,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "write_queue",
+			 write_queue );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_write_queue_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_write_queue_initialize(
+		          &write_queue,
+		          2,
+		          &ewf_test_write_queue_pack_chunk_data,
+		          NULL,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( write_queue != NULL )
+			{
+				libewf_write_queue_free(
+				 &write_queue,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "write_queue",
+			 write_queue );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_queue != NULL )
+	{
+		libewf_write_queue_free(
+		 &write_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_queue_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_queue_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_write_queue_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_queue_push and libewf_write_queue_pop functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_queue_push_and_pop(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	libewf_write_queue_t *write_queue = NULL;
+	size_t input_data_size            = 0;
+	uint64_t chunk_index              = 0;
+	uint64_t expected_chunk_index     = 0;
+	int number_of_entries             = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_write_queue_initialize(
+	          &write_queue,
+	          1,
+	          &ewf_test_write_queue_pack_chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_queue",
+	 write_queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( expected_chunk_index = 0;
+	     expected_chunk_index < LIBEWF_WRITE_QUEUE_ENTRIES_PER_THREAD;
+	     expected_chunk_index++ )
+	{
+		result = libewf_write_queue_is_full(
+		          write_queue,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_data_initialize(
+		          &chunk_data,
+		          512,
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_write_queue_push(
+		          write_queue,
+		          expected_chunk_index,
+		          chunk_data,
+		          512,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		chunk_data = NULL;
+	}
+	result = libewf_write_queue_is_full(
+	          write_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_queue_get_number_of_entries(
+	          write_queue,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 LIBEWF_WRITE_QUEUE_ENTRIES_PER_THREAD );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunk data is dequeued in the order it was queued
+	 */
+	for( expected_chunk_index = 0;
+	     expected_chunk_index < LIBEWF_WRITE_QUEUE_ENTRIES_PER_THREAD;
+	     expected_chunk_index++ )
+	{
+		result = libewf_write_queue_pop(
+		          write_queue,
+		          1,
+		          &chunk_index,
+		          &chunk_data,
+		          &input_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "chunk_index",
+		 chunk_index,
+		 expected_chunk_index );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "input_data_size",
+		 input_data_size,
+		 (size_t) 512 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_chunk_data_free(
+		          &chunk_data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_write_queue_pop(
+	          write_queue,
+	          1,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_write_queue_push(
+	          NULL,
+	          0,
+	          NULL,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_queue_push(
+	          write_queue,
+	          0,
+	          NULL,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_queue_pop(
+	          NULL,
+	          1,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_queue_pop(
+	          write_queue,
+	          1,
+	          NULL,
+	          &chunk_data,
+	          &input_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_queue_pop(
+	          write_queue,
+	          1,
+	          &chunk_index,
+	          NULL,
+	          &input_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_queue_pop(
+	          write_queue,
+	          1,
+	          &chunk_index,
+	          &chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_write_queue_free(
+	          &write_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_queue",
+	 write_queue );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test pop with a chunk that failed to pack
+	 */
+	result = libewf_write_queue_initialize(
+	          &write_queue,
+	          1,
+	          &ewf_test_write_queue_pack_chunk_data_failure,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_queue_push(
+	          write_queue,
+	          0,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data = NULL;
+
+	result = libewf_write_queue_pop(
+	          write_queue,
+	          1,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_queue_free(
+	          &write_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( write_queue != NULL )
+	{
+		libewf_write_queue_free(
+		 &write_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_write_queue_initialize",
+	 ewf_test_write_queue_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_write_queue_free",
+	 ewf_test_write_queue_free );
+
+	EWF_TEST_RUN(
+	 "libewf_write_queue_push",
+	 ewf_test_write_queue_push_and_pop );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-TOOLS_TESTS="byte_size_string device_handle digest_hash export_handle guid imaging_handle info_handle log_handle output platform signal storage_media_buffer system_string verification_handle";
+TOOLS_TESTS="byte_size_string device_handle digest_hash digest_hash_threads export_handle guid imaging_handle info_handle log_handle output platform sha1_context sha256_context signal storage_media_buffer storage_media_buffer_ring system_string tree_hash verification_handle";
 TOOLS_TESTS_WITH_INPUT="";
 OPTION_SETS="";
 